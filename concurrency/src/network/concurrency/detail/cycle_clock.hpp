@@ -0,0 +1,83 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_DETAIL_CYCLE_CLOCK_INC
+#define NETWORK_CONCURRENCY_DETAIL_CYCLE_CLOCK_INC
+
+#include <chrono>
+#include <cstdint>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define NETWORK_CONCURRENCY_HAS_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define NETWORK_CONCURRENCY_HAS_RDTSC
+#endif
+
+namespace network {
+  namespace concurrency {
+    namespace detail {
+
+      /**
+       * \brief A clock that is cheap to read, for timing every task.
+       *
+       * On x86 it reads the time stamp counter, which costs a few
+       * nanoseconds and has no fixed unit; elsewhere it counts steady_clock
+       * nanoseconds. Ticks are turned into nanoseconds with a
+       * tick_converter.
+       */
+      struct cycle_clock {
+	typedef std::uint64_t tick;
+
+	static tick now() {
+#if defined(NETWORK_CONCURRENCY_HAS_RDTSC)
+	  return __rdtsc();
+#else
+	  return static_cast<tick>(
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(
+	      std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+	}
+      };
+
+      /**
+       * \brief Turns cycle_clock ticks into nanoseconds, by comparing
+       *        cycle_clock with steady_clock over the time since it was
+       *        constructed. The longer that is, the more exact it gets.
+       */
+      class tick_converter {
+
+      public:
+
+	tick_converter()
+	  : ticks_(cycle_clock::now()),
+	    start_(std::chrono::steady_clock::now()) {
+
+	}
+
+	double nanoseconds_per_tick() const {
+#if defined(NETWORK_CONCURRENCY_HAS_RDTSC)
+	  cycle_clock::tick const ticks = cycle_clock::now() - ticks_;
+	  double const ns = static_cast<double>(
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(
+	      std::chrono::steady_clock::now() - start_).count());
+	  return ticks == 0 ? 1.0 : ns / static_cast<double>(ticks);
+#else
+	  return 1.0;
+#endif
+	}
+
+      private:
+
+	cycle_clock::tick ticks_;
+	std::chrono::steady_clock::time_point start_;
+
+      };
+
+    }  // namespace detail
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_DETAIL_CYCLE_CLOCK_INC
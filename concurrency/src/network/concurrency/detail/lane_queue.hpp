@@ -0,0 +1,172 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_DETAIL_LANE_QUEUE_INC
+#define NETWORK_CONCURRENCY_DETAIL_LANE_QUEUE_INC
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include <network/concurrency/priority_lane.hpp>
+
+namespace network {
+  namespace concurrency {
+    namespace detail {
+
+      /**
+       * \brief A FIFO of pointers for each priority_lane, behind one mutex.
+       *
+       * pop takes from the highest lane that isn't empty. Each time a lower
+       * lane that isn't empty is passed over, it is counted; when it has
+       * been passed over starvation_limit times, it is served next. The
+       * queue doesn't own the items.
+       */
+      template <class T>
+      class lane_queue {
+
+	lane_queue(lane_queue const&) = delete;
+	lane_queue& operator=(lane_queue const&) = delete;
+
+      public:
+
+	static std::size_t const lane_count = 3;
+	static std::size_t const starvation_limit = 16;
+
+	lane_queue()
+	  : size_(0) {
+	  for (std::size_t lane = 0; lane != lane_count; ++lane) {
+	    lanes_[lane].items.resize(64);
+	    lanes_[lane].head = 0;
+	    lanes_[lane].count.store(0, std::memory_order_relaxed);
+	    lanes_[lane].passed_over = 0;
+	  }
+	}
+
+	void push(priority_lane lane, T* item) {
+	  std::lock_guard<std::mutex> lock(mutex_);
+	  ring& r = lanes_[static_cast<std::size_t>(lane)];
+	  std::size_t const count = r.count.load(std::memory_order_relaxed);
+	  if (count == r.items.size()) {
+	    // Only allocates when it grows.
+	    std::vector<T*> larger(r.items.size() * 2);
+	    for (std::size_t index = 0; index != count; ++index) {
+	      larger[index] = r.items[(r.head + index) % r.items.size()];
+	    }
+	    r.items.swap(larger);
+	    r.head = 0;
+	  }
+	  r.items[(r.head + count) % r.items.size()] = item;
+	  r.count.store(count + 1, std::memory_order_relaxed);
+	  size_.store(size_.load(std::memory_order_relaxed) + 1,
+		      std::memory_order_relaxed);
+	}
+
+	/**
+	 * \brief Takes the next item, or returns nullptr if there is none.
+	 */
+	T* pop() {
+	  T* item = nullptr;
+	  pop(&item, 1);
+	  return item;
+	}
+
+	/**
+	 * \brief Takes up to max items from the lane that is next, and
+	 *        returns how many it took.
+	 *
+	 * Only the interactive lane is taken in batches. The others are
+	 * taken one at a time, so that whoever takes a batch doesn't queue
+	 * background work ahead of work in the higher lanes.
+	 */
+	std::size_t pop(T** items, std::size_t max) {
+	  if (size_.load(std::memory_order_relaxed) == 0) {
+	    return 0;
+	  }
+
+	  std::lock_guard<std::mutex> lock(mutex_);
+	  std::size_t const lane = next_lane();
+	  if (lane == lane_count) {
+	    return 0;
+	  }
+	  ring& r = lanes_[lane];
+	  std::size_t const count = r.count.load(std::memory_order_relaxed);
+	  if (lane != static_cast<std::size_t>(priority_lane::interactive)) {
+	    max = 1;
+	  }
+	  std::size_t const taken = count < max ? count : max;
+	  for (std::size_t index = 0; index != taken; ++index) {
+	    items[index] = r.items[(r.head + index) % r.items.size()];
+	  }
+	  r.head = (r.head + taken) % r.items.size();
+	  r.count.store(count - taken, std::memory_order_relaxed);
+	  size_.store(size_.load(std::memory_order_relaxed) - taken,
+		      std::memory_order_relaxed);
+	  return taken;
+	}
+
+	/**
+	 * \brief Returns the number of items in a lane. It is read without
+	 *        the lock, so it may be stale.
+	 */
+	std::size_t size(priority_lane lane) const {
+	  return lanes_[static_cast<std::size_t>(lane)].count.load(
+	    std::memory_order_relaxed);
+	}
+
+	/**
+	 * \brief Returns the number of items in all the lanes. It is read
+	 *        without the lock, so it may be stale.
+	 */
+	std::size_t size() const {
+	  return size_.load(std::memory_order_relaxed);
+	}
+
+      private:
+
+	struct ring {
+	  std::vector<T*> items;
+	  std::size_t head;
+	  std::atomic<std::size_t> count;
+	  std::size_t passed_over;
+	};
+
+	// Called with the lock held; returns lane_count if all are empty.
+	std::size_t next_lane() {
+	  // A starving lane first, the lowest one if there are several.
+	  for (std::size_t lane = lane_count; lane-- != 0; ) {
+	    if (lanes_[lane].passed_over >= starvation_limit) {
+	      lanes_[lane].passed_over = 0;
+	      return lane;
+	    }
+	  }
+
+	  std::size_t chosen = lane_count;
+	  for (std::size_t lane = 0; lane != lane_count; ++lane) {
+	    ring& r = lanes_[lane];
+	    if (r.count.load(std::memory_order_relaxed) == 0) {
+	      r.passed_over = 0;
+	    }
+	    else if (chosen == lane_count) {
+	      chosen = lane;
+	    }
+	    else {
+	      ++r.passed_over;
+	    }
+	  }
+	  return chosen;
+	}
+
+	std::mutex mutex_;
+	ring lanes_[lane_count];
+	std::atomic<std::size_t> size_;
+
+      };
+
+    }  // namespace detail
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_DETAIL_LANE_QUEUE_INC
@@ -0,0 +1,157 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_DETAIL_QUEUE_MONITOR_INC
+#define NETWORK_CONCURRENCY_DETAIL_QUEUE_MONITOR_INC
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <network/concurrency/thread_pool_options.hpp>
+#include <network/concurrency/thread_pool_statistics.hpp>
+
+namespace network {
+  namespace concurrency {
+    namespace detail {
+
+      /**
+       * \brief Counts the tasks waiting in the queue of a thread_pool,
+       *        applies the bound on them and measures how long they wait.
+       *
+       * The pool calls admit before it queues a task, and started when a
+       * worker takes it from the queue.
+       */
+      class queue_monitor {
+
+	queue_monitor(queue_monitor const&) = delete;
+	queue_monitor& operator=(queue_monitor const&) = delete;
+
+      public:
+
+	typedef std::chrono::steady_clock clock;
+
+	enum admission {
+	  enqueue,
+	  run_in_caller
+	};
+
+	explicit queue_monitor(thread_pool_options const& options);
+
+	/**
+	 * \brief Makes room in the queue for one task.
+	 * \param in_worker Whether the caller is a worker of the pool, which
+	 *        mustn't block.
+	 * \returns Whether to queue the task or to run it in the caller.
+	 * \throws std::system_error if the queue is full and the policy is
+	 *         to reject.
+	 */
+	admission admit(bool in_worker) {
+	  std::size_t const depth = depth_.fetch_add(1) + 1;
+	  if (max_depth_ != 0 && depth > max_depth_) {
+	    return admit_full(in_worker);
+	  }
+	  if (depth == 1) {
+	    nonempty_since_.store(clock::now().time_since_epoch().count(),
+				  std::memory_order_relaxed);
+	  }
+	  record_peak(depth);
+	  return enqueue;
+	}
+
+	/**
+	 * \brief Returns how long the task at the head of the queue has
+	 *        waited, at most; zero if the queue is empty.
+	 *
+	 * Tasks that are stuck in the queue, behind workers that are all
+	 * busy, don't call started, so this is how they are noticed.
+	 */
+	clock::duration head_wait(clock::time_point now) const {
+	  if (depth_.load(std::memory_order_relaxed) == 0) {
+	    return clock::duration::zero();
+	  }
+	  clock::rep const since =
+	    std::max(nonempty_since_.load(std::memory_order_relaxed),
+		     last_started_.load(std::memory_order_relaxed));
+	  return now.time_since_epoch() - clock::duration(since);
+	}
+
+	/**
+	 * \brief Records that a worker took a task from the queue.
+	 * \param queued When the task was queued.
+	 * \returns How long the task waited.
+	 */
+	clock::duration started(clock::time_point queued) {
+	  clock::time_point const now = clock::now();
+	  clock::duration const wait = now - queued;
+	  last_started_.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+	  std::uint64_t const ns = static_cast<std::uint64_t>(
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count());
+	  started_.fetch_add(1, std::memory_order_relaxed);
+	  total_wait_ns_.fetch_add(ns, std::memory_order_relaxed);
+	  std::uint64_t max = max_wait_ns_.load(std::memory_order_relaxed);
+	  while (ns > max &&
+		 !max_wait_ns_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+	  }
+
+	  make_room();
+	  return wait;
+	}
+
+	/**
+	 * \brief Gives back the place that admit made for a task that
+	 *        couldn't be queued after all.
+	 */
+	void withdraw() {
+	  make_room();
+	}
+
+	thread_pool_statistics statistics() const;
+
+      private:
+
+	admission admit_full(bool in_worker);
+	void record_peak(std::size_t depth);
+
+	void make_room() {
+	  // Pairs with admit_full: either the poster sees the room made here,
+	  // or this sees the poster waiting.
+	  depth_.fetch_sub(1);
+	  if (waiters_.load() != 0) {
+	    std::lock_guard<std::mutex> lock(mutex_);
+	    room_.notify_one();
+	  }
+	}
+
+	std::size_t const max_depth_;
+	rejection_policy const rejection_;
+
+	std::atomic<std::size_t> depth_;
+	std::atomic<std::size_t> peak_depth_;
+	std::atomic<std::uint64_t> started_;
+	std::atomic<std::uint64_t> rejected_;
+	std::atomic<std::uint64_t> ran_in_caller_;
+	std::atomic<std::uint64_t> total_wait_ns_;
+	std::atomic<std::uint64_t> max_wait_ns_;
+
+	// In clock ticks, for head_wait.
+	std::atomic<clock::rep> nonempty_since_;
+	std::atomic<clock::rep> last_started_;
+
+	// Posters that block on a full queue.
+	std::mutex mutex_;
+	std::condition_variable room_;
+	std::atomic<std::size_t> waiters_;
+
+      };
+
+    }  // namespace detail
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_DETAIL_QUEUE_MONITOR_INC
@@ -0,0 +1,95 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_DETAIL_QUEUE_MONITOR_IPP
+#define NETWORK_CONCURRENCY_DETAIL_QUEUE_MONITOR_IPP
+
+#include <system_error>
+#include <network/concurrency/detail/queue_monitor.hpp>
+
+namespace network {
+  namespace concurrency {
+    namespace detail {
+
+      queue_monitor::queue_monitor(thread_pool_options const& options)
+	: max_depth_(options.max_queue_depth()),
+	  rejection_(options.rejection()),
+	  depth_(0),
+	  peak_depth_(0),
+	  started_(0),
+	  rejected_(0),
+	  ran_in_caller_(0),
+	  total_wait_ns_(0),
+	  max_wait_ns_(0),
+	  nonempty_since_(0),
+	  last_started_(0),
+	  waiters_(0) {
+
+      }
+
+      queue_monitor::admission queue_monitor::admit_full(bool in_worker) {
+	// admit took a place that isn't there. A poster that is already
+	// waiting may have seen the queue as full only because of it, so
+	// it is woken like any other place that frees up.
+	make_room();
+
+	if (rejection_ == rejection_policy::reject) {
+	  rejected_.fetch_add(1, std::memory_order_relaxed);
+	  throw std::system_error(
+	    std::make_error_code(std::errc::resource_unavailable_try_again),
+	    "thread_pool: the queue is full");
+	}
+
+	if (rejection_ == rejection_policy::run_in_caller || in_worker) {
+	  ran_in_caller_.fetch_add(1, std::memory_order_relaxed);
+	  return run_in_caller;
+	}
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	waiters_.fetch_add(1);
+	for (;;) {
+	  std::size_t depth = depth_.load();
+	  while (depth < max_depth_) {
+	    if (depth_.compare_exchange_weak(depth, depth + 1)) {
+	      waiters_.fetch_sub(1);
+	      lock.unlock();
+	      if (depth == 0) {
+		nonempty_since_.store(clock::now().time_since_epoch().count(),
+				      std::memory_order_relaxed);
+	      }
+	      record_peak(depth + 1);
+	      return enqueue;
+	    }
+	  }
+	  room_.wait(lock);
+	}
+      }
+
+      void queue_monitor::record_peak(std::size_t depth) {
+	std::size_t peak = peak_depth_.load(std::memory_order_relaxed);
+	while (depth > peak &&
+	       !peak_depth_.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {
+	}
+      }
+
+      thread_pool_statistics queue_monitor::statistics() const {
+	thread_pool_statistics result;
+	result.queue_depth = depth_.load(std::memory_order_relaxed);
+	result.peak_queue_depth = peak_depth_.load(std::memory_order_relaxed);
+	result.tasks_started = started_.load(std::memory_order_relaxed);
+	result.tasks_rejected = rejected_.load(std::memory_order_relaxed);
+	result.tasks_run_in_caller = ran_in_caller_.load(std::memory_order_relaxed);
+	result.total_queue_wait = std::chrono::nanoseconds(
+	  total_wait_ns_.load(std::memory_order_relaxed));
+	result.max_queue_wait = std::chrono::nanoseconds(
+	  max_wait_ns_.load(std::memory_order_relaxed));
+	return result;
+      }
+
+    }  // namespace detail
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_DETAIL_QUEUE_MONITOR_IPP
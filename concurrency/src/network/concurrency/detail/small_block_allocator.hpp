@@ -0,0 +1,83 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_DETAIL_SMALL_BLOCK_ALLOCATOR_INC
+#define NETWORK_CONCURRENCY_DETAIL_SMALL_BLOCK_ALLOCATOR_INC
+
+#include <cstddef>
+#include <new>
+
+namespace network {
+  namespace concurrency {
+    namespace detail {
+
+      /**
+       * \brief The size of the blocks that allocate_small_block recycles.
+       */
+      std::size_t const small_block_size = 256;
+
+      /**
+       * \brief Allocates memory for a task.
+       *
+       * Requests of up to small_block_size bytes get a block from a cache
+       * local to the calling thread, which is refilled from (and overflows
+       * into) a process-wide list in batches, so that the memory freed by
+       * the threads that run tasks goes back to the threads that post them
+       * without a trip through the heap. Larger requests go to operator new.
+       */
+      void* allocate_small_block(std::size_t size);
+
+      /**
+       * \brief Frees memory from allocate_small_block. The size must be the
+       *        one that was allocated.
+       */
+      void deallocate_small_block(void* pointer, std::size_t size);
+
+      /**
+       * \brief A standard allocator on top of allocate_small_block, for the
+       *        memory Boost.Asio allocates for each posted handler.
+       */
+      template <class T>
+      class small_block_allocator {
+
+      public:
+
+	typedef T value_type;
+
+	small_block_allocator() {}
+
+	template <class U>
+	small_block_allocator(small_block_allocator<U> const&) {}
+
+	template <class U>
+	struct rebind {
+	  typedef small_block_allocator<U> other;
+	};
+
+	T* allocate(std::size_t count) {
+	  return static_cast<T*>(allocate_small_block(count * sizeof(T)));
+	}
+
+	void deallocate(T* pointer, std::size_t count) {
+	  deallocate_small_block(pointer, count * sizeof(T));
+	}
+
+	template <class U>
+	bool operator==(small_block_allocator<U> const&) const {
+	  return true;
+	}
+
+	template <class U>
+	bool operator!=(small_block_allocator<U> const&) const {
+	  return false;
+	}
+
+      };
+
+    }  // namespace detail
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_DETAIL_SMALL_BLOCK_ALLOCATOR_INC
@@ -0,0 +1,147 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_DETAIL_SMALL_BLOCK_ALLOCATOR_IPP
+#define NETWORK_CONCURRENCY_DETAIL_SMALL_BLOCK_ALLOCATOR_IPP
+
+#include <mutex>
+#include <network/concurrency/detail/small_block_allocator.hpp>
+
+namespace network {
+  namespace concurrency {
+    namespace detail {
+
+      namespace {
+	struct free_block {
+	  free_block* next;
+	  // In the first block of a batch on the central list:
+	  free_block* next_batch;
+	  std::size_t count;
+	};
+
+	// A list of free blocks.
+	struct batch {
+	  free_block* head;
+	  std::size_t count;
+	};
+
+	// The number of blocks moved between a thread's cache and the central
+	// list at once, and the most blocks a thread keeps.
+	std::size_t const batch_size = 32;
+	std::size_t const cache_limit = 2 * batch_size;
+
+	// The batches are kept in a list threaded through their first blocks,
+	// so that giving one back never allocates.
+	class central_list {
+
+	public:
+
+	  central_list() : batches_(nullptr) {}
+
+	  batch take() {
+	    std::lock_guard<std::mutex> lock(mutex_);
+	    if (batches_) {
+	      batch b = { batches_, batches_->count };
+	      batches_ = batches_->next_batch;
+	      return b;
+	    }
+
+	    // Carve a new batch out of one allocation. The memory is never
+	    // returned to the heap.
+	    char* chunk = static_cast<char*>(
+	      ::operator new(batch_size * small_block_size));
+	    free_block* head = nullptr;
+	    for (std::size_t index = batch_size; index != 0; --index) {
+	      free_block* block = reinterpret_cast<free_block*>(
+		chunk + (index - 1) * small_block_size);
+	      block->next = head;
+	      head = block;
+	    }
+	    batch b = { head, batch_size };
+	    return b;
+	  }
+
+	  void give(batch b) {
+	    std::lock_guard<std::mutex> lock(mutex_);
+	    b.head->count = b.count;
+	    b.head->next_batch = batches_;
+	    batches_ = b.head;
+	  }
+
+	private:
+
+	  std::mutex mutex_;
+	  free_block* batches_;
+
+	};
+
+	// The central list is never destroyed, so that the caches of threads
+	// that exit late can still give their blocks back.
+	central_list& central() {
+	  static central_list* list = new central_list;
+	  return *list;
+	}
+
+	struct thread_cache {
+	  thread_cache() : head(nullptr), count(0) {}
+
+	  ~thread_cache() {
+	    if (head) {
+	      batch b = { head, count };
+	      central().give(b);
+	    }
+	  }
+
+	  free_block* head;
+	  std::size_t count;
+	};
+
+	thread_local thread_cache cache;
+      }  // namespace
+
+      void* allocate_small_block(std::size_t size) {
+	if (size > small_block_size) {
+	  return ::operator new(size);
+	}
+
+	if (!cache.head) {
+	  batch b = central().take();
+	  cache.head = b.head;
+	  cache.count = b.count;
+	}
+	free_block* block = cache.head;
+	cache.head = block->next;
+	--cache.count;
+	return block;
+      }
+
+      void deallocate_small_block(void* pointer, std::size_t size) {
+	if (size > small_block_size) {
+	  ::operator delete(pointer);
+	  return;
+	}
+
+	free_block* block = static_cast<free_block*>(pointer);
+	block->next = cache.head;
+	cache.head = block;
+	if (++cache.count == cache_limit) {
+	  // Give the first half back.
+	  batch b = { cache.head, batch_size };
+	  free_block* last = cache.head;
+	  for (std::size_t index = 1; index != batch_size; ++index) {
+	    last = last->next;
+	  }
+	  cache.head = last->next;
+	  cache.count -= batch_size;
+	  last->next = nullptr;
+	  central().give(b);
+	}
+      }
+
+    }  // namespace detail
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_DETAIL_SMALL_BLOCK_ALLOCATOR_IPP
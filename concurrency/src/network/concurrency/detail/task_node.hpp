@@ -0,0 +1,78 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_DETAIL_TASK_NODE_INC
+#define NETWORK_CONCURRENCY_DETAIL_TASK_NODE_INC
+
+#include <new>
+#include <network/concurrency/task.hpp>
+#include <network/concurrency/detail/cycle_clock.hpp>
+#include <network/concurrency/detail/queue_monitor.hpp>
+#include <network/concurrency/detail/small_block_allocator.hpp>
+#include <network/concurrency/detail/worker_instruments.hpp>
+
+namespace network {
+  namespace concurrency {
+    namespace detail {
+
+      /**
+       * \brief A queued task and the time it was queued. The queues hold
+       *        pointers to nodes, which live in recycled small blocks.
+       */
+      struct task_node {
+	task_node(task f, cycle_clock::tick ticks)
+	  : t(std::move(f)),
+	    queued(queue_monitor::clock::now()),
+	    queued_ticks(ticks) {}
+
+	task t;
+	queue_monitor::clock::time_point queued;
+	// Only taken for instrumented pools.
+	cycle_clock::tick queued_ticks;
+      };
+
+      inline
+      task_node* make_task_node(task t, bool instrumented) {
+	void* block = allocate_small_block(sizeof(task_node));
+	return ::new (block) task_node(std::move(t),
+				       instrumented ? cycle_clock::now() : 0);
+      }
+
+      /**
+       * \brief Frees a node whose task won't run.
+       */
+      inline
+      void destroy_task_node(task_node* n) {
+	n->~task_node();
+	deallocate_small_block(n, sizeof(task_node));
+      }
+
+      /**
+       * \brief Runs the task and frees the node, even if the task throws.
+       *        The calling worker counts the task if it is instrumented.
+       */
+      inline
+      void run_task_node(task_node* n) {
+	struct release {
+	  ~release() {
+	    destroy_task_node(n);
+	  }
+	  task_node* n;
+	} guard = { n };
+	worker_counters* counters = worker_instruments::current();
+	if (counters) {
+	  counters->task_started(n->queued_ticks, cycle_clock::now());
+	}
+	n->t();
+	if (counters) {
+	  counters->task_finished(cycle_clock::now());
+	}
+      }
+
+    }  // namespace detail
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_DETAIL_TASK_NODE_INC
@@ -0,0 +1,170 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_DETAIL_WORK_STEALING_DEQUE_INC
+#define NETWORK_CONCURRENCY_DETAIL_WORK_STEALING_DEQUE_INC
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace network {
+  namespace concurrency {
+    namespace detail {
+
+      /**
+       * \brief A lock-free deque of pointers with a single owner.
+       *
+       * This is the Chase-Lev deque, with the memory orderings from Le,
+       * Pop, Cohen and Zappa Nardelli, "Correct and Efficient
+       * Work-Stealing for Weak Memory Models" (PPoPP 2013). The owner
+       * pushes and pops at the bottom; any thread may steal from the top.
+       * The deque doesn't own the items; it must be empty when it is
+       * destroyed.
+       */
+      template <class T>
+      class work_stealing_deque {
+
+	work_stealing_deque(work_stealing_deque const&) = delete;
+	work_stealing_deque& operator=(work_stealing_deque const&) = delete;
+
+      public:
+
+	explicit work_stealing_deque(std::size_t capacity = 256)
+	  : top_(0), bottom_(0) {
+	  std::size_t size = 1;
+	  while (size < capacity) {
+	    size <<= 1;
+	  }
+	  arrays_.emplace_back(new array(size));
+	  array_.store(arrays_.back().get(), std::memory_order_relaxed);
+	}
+
+	/**
+	 * \brief Pushes an item at the bottom. Only the owner may push.
+	 */
+	void push(T* item) {
+	  std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+	  std::int64_t top = top_.load(std::memory_order_acquire);
+	  array* a = array_.load(std::memory_order_relaxed);
+	  if (bottom - top > static_cast<std::int64_t>(a->mask)) {
+	    a = grow(a, top, bottom);
+	  }
+	  a->put(bottom, item);
+	  bottom_.store(bottom + 1, std::memory_order_release);
+	}
+
+	/**
+	 * \brief Pops the item at the bottom. Only the owner may pop.
+	 * \returns The item, or nullptr if the deque is empty.
+	 */
+	T* pop() {
+	  std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+	  array* a = array_.load(std::memory_order_relaxed);
+	  bottom_.store(bottom, std::memory_order_relaxed);
+	  std::atomic_thread_fence(std::memory_order_seq_cst);
+	  std::int64_t top = top_.load(std::memory_order_relaxed);
+
+	  if (top > bottom) {
+	    bottom_.store(bottom + 1, std::memory_order_relaxed);
+	    return nullptr;
+	  }
+
+	  T* item = a->get(bottom);
+	  if (top == bottom) {
+	    // The last item: race the thieves for it.
+	    if (!top_.compare_exchange_strong(top, top + 1,
+					      std::memory_order_seq_cst,
+					      std::memory_order_relaxed)) {
+	      item = nullptr;
+	    }
+	    bottom_.store(bottom + 1, std::memory_order_relaxed);
+	  }
+	  return item;
+	}
+
+	/**
+	 * \brief Steals the item at the top. Any thread may steal.
+	 * \returns The item, or nullptr if the deque is empty or another
+	 *          thread got there first.
+	 */
+	T* steal() {
+	  std::int64_t top = top_.load(std::memory_order_acquire);
+	  std::atomic_thread_fence(std::memory_order_seq_cst);
+	  std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+	  if (top >= bottom) {
+	    return nullptr;
+	  }
+
+	  array* a = array_.load(std::memory_order_acquire);
+	  T* item = a->get(top);
+	  if (!top_.compare_exchange_strong(top, top + 1,
+					    std::memory_order_seq_cst,
+					    std::memory_order_relaxed)) {
+	    return nullptr;
+	  }
+	  return item;
+	}
+
+	/**
+	 * \brief Returns true if the deque looks empty. This is only a hint
+	 *        when other threads are pushing or stealing.
+	 */
+	bool empty() const {
+	  return top_.load(std::memory_order_relaxed) >=
+	    bottom_.load(std::memory_order_relaxed);
+	}
+
+      private:
+
+	struct array {
+	  explicit array(std::size_t size)
+	    : mask(size - 1), slots(new std::atomic<T*>[size]) {
+
+	  }
+
+	  T* get(std::int64_t index) const {
+	    return slots[static_cast<std::size_t>(index) & mask]
+	      .load(std::memory_order_relaxed);
+	  }
+
+	  void put(std::int64_t index, T* item) {
+	    slots[static_cast<std::size_t>(index) & mask]
+	      .store(item, std::memory_order_relaxed);
+	  }
+
+	  std::size_t mask;
+	  std::unique_ptr<std::atomic<T*>[]> slots;
+	};
+
+	// Thieves may still be reading the old array, so it is kept until the
+	// deque is destroyed.
+	array* grow(array* old, std::int64_t top, std::int64_t bottom) {
+	  arrays_.emplace_back(new array((old->mask + 1) * 2));
+	  array* a = arrays_.back().get();
+	  for (std::int64_t index = top; index != bottom; ++index) {
+	    a->put(index, old->get(index));
+	  }
+	  array_.store(a, std::memory_order_release);
+	  return a;
+	}
+
+	// top_ and bottom_ are written by different threads; keep them on
+	// separate cache lines.
+	std::atomic<std::int64_t> top_;
+	char padding_[64 - sizeof(std::atomic<std::int64_t>)];
+	std::atomic<std::int64_t> bottom_;
+	std::atomic<array*> array_;
+	std::vector<std::unique_ptr<array>> arrays_;
+
+      };
+
+    }  // namespace detail
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_DETAIL_WORK_STEALING_DEQUE_INC
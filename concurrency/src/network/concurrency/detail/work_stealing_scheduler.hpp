@@ -0,0 +1,130 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_DETAIL_WORK_STEALING_SCHEDULER_INC
+#define NETWORK_CONCURRENCY_DETAIL_WORK_STEALING_SCHEDULER_INC
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <network/concurrency/detail/lane_queue.hpp>
+#include <network/concurrency/detail/queue_monitor.hpp>
+#include <network/concurrency/detail/task_node.hpp>
+#include <network/concurrency/detail/work_stealing_deque.hpp>
+#include <network/concurrency/detail/worker_instruments.hpp>
+#include <network/concurrency/detail/worker_placement.hpp>
+#include <network/concurrency/priority_lane.hpp>
+#include <network/concurrency/task.hpp>
+#include <network/concurrency/thread_pool_options.hpp>
+
+namespace network {
+  namespace concurrency {
+    namespace detail {
+
+      /**
+       * \brief The workers of a thread_pool with the work_stealing
+       *        scheduling policy.
+       *
+       * Each worker owns a work_stealing_deque. A task posted from a worker
+       * is pushed onto that worker's deque, where it is likely to run while
+       * what it touches is still in the worker's cache; a task posted from
+       * any other thread, or to a lane other than interactive, goes to a
+       * shared injection queue with a FIFO for each lane. A worker runs the
+       * io_completion tasks first, then the tasks in its own deque, then
+       * takes a batch from the injection queue, then steals from the other
+       * workers, and sleeps when there is nothing left to run. Every so
+       * many tasks from its own deque, it runs the oldest waiting task
+       * first, so that tasks which keep posting can't starve the others.
+       *
+       * Each worker allocates its own state after placing itself, so that
+       * the memory is local to the CPUs it runs on.
+       */
+      class work_stealing_scheduler {
+
+	work_stealing_scheduler(work_stealing_scheduler const&) = delete;
+	work_stealing_scheduler& operator=(work_stealing_scheduler const&) = delete;
+
+      public:
+
+	/**
+	 * \brief Constructor. Starts the worker threads, and waits for them to
+	 *        place themselves.
+	 * \param options The number of worker threads (at least one is
+	 *        started) and where they run.
+	 * \param monitor Told when each task leaves the queue.
+	 * \param instruments The counters of the workers, or nullptr.
+	 * \throws std::system_error if a worker can't be placed.
+	 */
+	work_stealing_scheduler(thread_pool_options const& options,
+				queue_monitor& monitor,
+				worker_instruments* instruments);
+
+	/**
+	 * \brief Destructor. Runs every task that was posted, including the
+	 *        ones those tasks post, and then joins the worker threads.
+	 */
+	~work_stealing_scheduler();
+
+	std::size_t thread_count() const;
+
+	void post(task t, priority_lane lane);
+
+	/**
+	 * \brief Returns whether the calling thread is one of the workers.
+	 */
+	bool in_worker() const;
+
+      private:
+
+	struct worker {
+	  explicit worker(std::size_t index)
+	    : random_state(static_cast<std::uint32_t>(index + 1)),
+	      local_runs(0) {}
+
+	  work_stealing_deque<task_node> deque;
+	  std::uint32_t random_state;
+	  // Tasks run in a row from the bottom of the deque.
+	  unsigned local_runs;
+	};
+
+	void run(std::size_t index, thread_pool_options const& options,
+		 startup_latch& latch);
+	task_node* find_task(worker& self);
+	task_node* take_injected(worker& self);
+	task_node* steal(worker& self);
+	bool has_work() const;
+	void wake_one();
+	void execute(task_node* n);
+
+	queue_monitor& monitor_;
+	worker_instruments* instruments_;
+
+	// Each worker fills in its own entry before the latch opens.
+	std::vector<std::unique_ptr<worker>> workers_;
+	std::vector<std::thread> threads_;
+
+	lane_queue<task_node> injected_;
+
+	// Tasks posted and not yet run, so that the destructor can wait for
+	// all of them.
+	std::atomic<std::size_t> pending_;
+	std::atomic<bool> stopping_;
+
+	std::mutex sleep_mutex_;
+	std::condition_variable wake_;
+	std::atomic<std::size_t> sleepers_;
+
+      };
+
+    }  // namespace detail
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_DETAIL_WORK_STEALING_SCHEDULER_INC
@@ -0,0 +1,273 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_DETAIL_WORK_STEALING_SCHEDULER_IPP
+#define NETWORK_CONCURRENCY_DETAIL_WORK_STEALING_SCHEDULER_IPP
+
+#include <algorithm>
+#include <system_error>
+#include <network/concurrency/detail/work_stealing_scheduler.hpp>
+
+namespace network {
+  namespace concurrency {
+    namespace detail {
+
+      namespace {
+	// The scheduler and worker that the calling thread belongs to, if
+	// any.
+	struct current_worker {
+	  work_stealing_scheduler const* scheduler;
+	  std::size_t index;
+	};
+
+	thread_local current_worker current = { nullptr, 0 };
+
+	// The most tasks a worker takes from the injection queue at once. The
+	// ones it doesn't run straight away go to its deque, where the other
+	// workers can steal them.
+	std::size_t const injection_batch = 32;
+
+	// The tasks a worker runs from the bottom of its own deque before it
+	// runs the oldest waiting task instead, so that tasks which keep
+	// posting more work can't starve the injection queue, or the tasks at
+	// the top of the deque.
+	unsigned const fairness_interval = 61;
+
+	// The times a worker looks for a task again before it goes to sleep.
+	unsigned const spin_count = 64;
+      }  // namespace
+
+      work_stealing_scheduler::work_stealing_scheduler(thread_pool_options const& options,
+						       queue_monitor& monitor,
+						       worker_instruments* instruments)
+	: monitor_(monitor), instruments_(instruments), pending_(0),
+	  stopping_(false), sleepers_(0) {
+	std::size_t const thread_count = std::max<std::size_t>(options.thread_count(), 1);
+	workers_.resize(thread_count);
+	// A worker may still be leaving wait() when the constructor returns,
+	// so the latch is shared.
+	auto latch = std::make_shared<startup_latch>(thread_count);
+	std::size_t index = 0;
+	try {
+	  for (; index < thread_count; ++index) {
+	    threads_.emplace_back([this, index, &options, latch]() {
+		run(index, options, *latch);
+	      });
+	  }
+	}
+	catch (...) {
+	  for (; index < thread_count; ++index) {
+	    latch->arrive(std::make_error_code(std::errc::resource_unavailable_try_again));
+	  }
+	  for (auto& thread : threads_) {
+	    thread.join();
+	  }
+	  throw;
+	}
+
+	if (std::error_code error = latch->wait()) {
+	  for (auto& thread : threads_) {
+	    thread.join();
+	  }
+	  throw std::system_error(error, "thread_pool: cannot place the worker threads");
+	}
+      }
+
+      work_stealing_scheduler::~work_stealing_scheduler() {
+	{
+	  std::lock_guard<std::mutex> lock(sleep_mutex_);
+	  stopping_.store(true);
+	  wake_.notify_all();
+	}
+	for (auto& thread : threads_) {
+	  thread.join();
+	}
+      }
+
+      std::size_t work_stealing_scheduler::thread_count() const {
+	return workers_.size();
+      }
+
+      void work_stealing_scheduler::post(task t, priority_lane lane) {
+	task_node* n = make_task_node(std::move(t), instruments_ != nullptr);
+	pending_.fetch_add(1, std::memory_order_relaxed);
+	try {
+	  if (current.scheduler == this && lane == priority_lane::interactive) {
+	    workers_[current.index]->deque.push(n);
+	  }
+	  else {
+	    injected_.push(lane, n);
+	  }
+	}
+	catch (...) {
+	  pending_.fetch_sub(1, std::memory_order_relaxed);
+	  destroy_task_node(n);
+	  throw;
+	}
+	wake_one();
+      }
+
+      bool work_stealing_scheduler::in_worker() const {
+	return current.scheduler == this;
+      }
+
+      void work_stealing_scheduler::execute(task_node* n) {
+	monitor_.started(n->queued);
+	run_task_node(n);
+      }
+
+      void work_stealing_scheduler::run(std::size_t index,
+					thread_pool_options const& options,
+					startup_latch& latch) {
+	std::error_code error = place_worker(options, index);
+	if (!error) {
+	  try {
+	    workers_[index].reset(new worker(index));
+	  }
+	  catch (std::bad_alloc const&) {
+	    error = std::make_error_code(std::errc::not_enough_memory);
+	  }
+	}
+	latch.arrive(error);
+	// The options are gone once the constructor returns.
+	if (latch.wait()) {
+	  return;
+	}
+
+	worker& self = *workers_[index];
+	current.scheduler = this;
+	current.index = index;
+	if (instruments_) {
+	  instruments_->attach(index);
+	}
+
+	for (;;) {
+	  task_node* t = nullptr;
+	  for (unsigned spin = 0; !t && spin != spin_count; ++spin) {
+	    t = find_task(self);
+	    if (!t && spin != 0) {
+	      std::this_thread::yield();
+	    }
+	  }
+
+	  if (t) {
+	    execute(t);
+	    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+		stopping_.load()) {
+	      // The last task is done: let the sleeping workers exit.
+	      std::lock_guard<std::mutex> lock(sleep_mutex_);
+	      wake_.notify_all();
+	    }
+	    continue;
+	  }
+
+	  std::unique_lock<std::mutex> lock(sleep_mutex_);
+	  sleepers_.fetch_add(1);
+	  while (!has_work()) {
+	    if (stopping_.load() && pending_.load() == 0) {
+	      sleepers_.fetch_sub(1);
+	      current.scheduler = nullptr;
+	      worker_instruments::detach();
+	      return;
+	    }
+	    wake_.wait(lock);
+	  }
+	  sleepers_.fetch_sub(1);
+	}
+      }
+
+      task_node* work_stealing_scheduler::find_task(worker& self) {
+	if (injected_.size(priority_lane::io_completion) != 0) {
+	  if (task_node* t = injected_.pop()) {
+	    return t;
+	  }
+	}
+	if (self.local_runs >= fairness_interval) {
+	  self.local_runs = 0;
+	  if (task_node* t = injected_.pop()) {
+	    return t;
+	  }
+	  if (task_node* t = self.deque.steal()) {
+	    return t;
+	  }
+	}
+	if (task_node* t = self.deque.pop()) {
+	  ++self.local_runs;
+	  return t;
+	}
+	self.local_runs = 0;
+	if (task_node* t = take_injected(self)) {
+	  return t;
+	}
+	return steal(self);
+      }
+
+      task_node* work_stealing_scheduler::take_injected(worker& self) {
+	task_node* batch[injection_batch];
+	std::size_t const count = injected_.pop(batch, injection_batch);
+	if (count == 0) {
+	  return nullptr;
+	}
+	for (std::size_t index = 1; index != count; ++index) {
+	  self.deque.push(batch[index]);
+	}
+	if (count > 1) {
+	  wake_one();
+	}
+	return batch[0];
+      }
+
+      task_node* work_stealing_scheduler::steal(worker& self) {
+	std::size_t const count = workers_.size();
+	if (count == 1) {
+	  return nullptr;
+	}
+
+	// Start from a random victim, so that the thieves spread out.
+	std::uint32_t& x = self.random_state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	std::size_t const start = x % count;
+	for (std::size_t offset = 0; offset != count; ++offset) {
+	  worker& victim = *workers_[(start + offset) % count];
+	  if (&victim == &self) {
+	    continue;
+	  }
+	  if (task_node* t = victim.deque.steal()) {
+	    return t;
+	  }
+	}
+	return nullptr;
+      }
+
+      bool work_stealing_scheduler::has_work() const {
+	// Pairs with the fence in wake_one: either the poster sees this
+	// worker in sleepers_, or this worker sees the posted task.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (injected_.size() != 0) {
+	  return true;
+	}
+	for (auto const& w : workers_) {
+	  if (!w->deque.empty()) {
+	    return true;
+	  }
+	}
+	return false;
+      }
+
+      void work_stealing_scheduler::wake_one() {
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (sleepers_.load(std::memory_order_relaxed) != 0) {
+	  std::lock_guard<std::mutex> lock(sleep_mutex_);
+	  wake_.notify_one();
+	}
+      }
+
+    }  // namespace detail
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_DETAIL_WORK_STEALING_SCHEDULER_IPP
@@ -0,0 +1,148 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_DETAIL_WORKER_INSTRUMENTS_INC
+#define NETWORK_CONCURRENCY_DETAIL_WORKER_INSTRUMENTS_INC
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <network/concurrency/thread_pool_statistics.hpp>
+#include <network/concurrency/detail/cycle_clock.hpp>
+
+namespace network {
+  namespace concurrency {
+    namespace detail {
+
+      /**
+       * \brief The counters of one worker. Only the worker writes them;
+       *        snapshots read them at any time.
+       */
+      class worker_counters {
+
+      public:
+
+	/**
+	 * \brief The number of buckets in the queue wait histogram. Bucket b
+	 *        counts the waits of less than 2^(b + 1) ticks, and at
+	 *        least 2^b ticks (except for bucket 0).
+	 */
+	static std::size_t const bucket_count = 48;
+
+	worker_counters();
+
+	/**
+	 * \brief Called when the worker starts, to begin its idle time.
+	 */
+	void reset(cycle_clock::tick now) {
+	  last_end_ = now;
+	}
+
+	void task_started(cycle_clock::tick queued, cycle_clock::tick now) {
+	  add(idle_ticks_, now - last_end_);
+	  cycle_clock::tick const wait = now > queued ? now - queued : 0;
+	  add(queue_wait_[bucket(wait)], 1);
+	  started_ = now;
+	}
+
+	void task_finished(cycle_clock::tick now) {
+	  add(busy_ticks_, now - started_);
+	  add(tasks_, 1);
+	  last_end_ = now;
+	}
+
+      private:
+
+	friend class worker_instruments;
+
+	// Only the owner adds, so there is no need for a read-modify-write.
+	static void add(std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+	  counter.store(counter.load(std::memory_order_relaxed) + value,
+			std::memory_order_relaxed);
+	}
+
+	static std::size_t bucket(cycle_clock::tick wait) {
+	  std::size_t b = 0;
+#if defined(__GNUC__)
+	  if (wait > 1) {
+	    b = 63 - static_cast<std::size_t>(__builtin_clzll(wait));
+	  }
+#else
+	  while (wait > 1) {
+	    wait >>= 1;
+	    ++b;
+	  }
+#endif
+	  return b < bucket_count ? b : bucket_count - 1;
+	}
+
+	std::atomic<std::uint64_t> tasks_;
+	std::atomic<std::uint64_t> busy_ticks_;
+	std::atomic<std::uint64_t> idle_ticks_;
+	std::atomic<std::uint64_t> queue_wait_[bucket_count];
+	cycle_clock::tick started_;
+	cycle_clock::tick last_end_;
+
+	// Keeps the counters of two workers off the same cache line.
+	char padding_[64];
+
+      };
+
+      /**
+       * \brief The counters of all the workers of a thread_pool that was
+       *        constructed with instrumentation on.
+       *
+       * Each worker calls attach when it starts, and from then on finds
+       * its counters with current. Tasks that run anywhere else, such as
+       * the ones run by the caller of a full pool, aren't counted.
+       */
+      class worker_instruments {
+
+	worker_instruments(worker_instruments const&) = delete;
+	worker_instruments& operator=(worker_instruments const&) = delete;
+
+      public:
+
+	/**
+	 * \brief Constructor.
+	 * \param worker_count The most workers the pool may have at once.
+	 */
+	explicit worker_instruments(std::size_t worker_count);
+
+	/**
+	 * \brief Makes the calling thread worker number index.
+	 */
+	void attach(std::size_t index);
+
+	/**
+	 * \brief Stops counting for the calling thread.
+	 */
+	static void detach();
+
+	/**
+	 * \brief Returns the counters of the calling thread, or nullptr if it
+	 *        isn't an instrumented worker.
+	 */
+	static worker_counters* current();
+
+	/**
+	 * \brief Adds the workers and the queue wait histogram to a snapshot.
+	 */
+	void fill(thread_pool_statistics& statistics) const;
+
+      private:
+
+	std::size_t count_;
+	std::unique_ptr<worker_counters[]> counters_;
+	tick_converter converter_;
+
+      };
+
+    }  // namespace detail
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_DETAIL_WORKER_INSTRUMENTS_INC
@@ -0,0 +1,91 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_DETAIL_WORKER_INSTRUMENTS_IPP
+#define NETWORK_CONCURRENCY_DETAIL_WORKER_INSTRUMENTS_IPP
+
+#include <network/concurrency/detail/worker_instruments.hpp>
+#include <boost/assert.hpp>
+
+namespace network {
+  namespace concurrency {
+    namespace detail {
+
+      namespace {
+	thread_local worker_counters* current_counters = nullptr;
+
+	std::chrono::nanoseconds to_nanoseconds(std::uint64_t ticks,
+						double nanoseconds_per_tick) {
+	  return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(
+	    static_cast<double>(ticks) * nanoseconds_per_tick));
+	}
+      }  // namespace
+
+      worker_counters::worker_counters()
+	: tasks_(0),
+	  busy_ticks_(0),
+	  idle_ticks_(0),
+	  started_(0),
+	  last_end_(0) {
+	for (auto& count : queue_wait_) {
+	  count.store(0, std::memory_order_relaxed);
+	}
+      }
+
+      worker_instruments::worker_instruments(std::size_t worker_count)
+	: count_(worker_count),
+	  counters_(new worker_counters[worker_count]) {
+
+      }
+
+      void worker_instruments::attach(std::size_t index) {
+	BOOST_ASSERT(index < count_);
+	current_counters = &counters_[index];
+	current_counters->reset(cycle_clock::now());
+      }
+
+      void worker_instruments::detach() {
+	current_counters = nullptr;
+      }
+
+      worker_counters* worker_instruments::current() {
+	return current_counters;
+      }
+
+      void worker_instruments::fill(thread_pool_statistics& statistics) const {
+	double const ns_per_tick = converter_.nanoseconds_per_tick();
+	std::uint64_t histogram[worker_counters::bucket_count] = {0};
+
+	statistics.workers.resize(count_);
+	for (std::size_t index = 0; index != count_; ++index) {
+	  worker_counters const& counters = counters_[index];
+	  worker_statistics& worker = statistics.workers[index];
+	  worker.tasks_executed = counters.tasks_.load(std::memory_order_relaxed);
+	  worker.busy = to_nanoseconds(
+	    counters.busy_ticks_.load(std::memory_order_relaxed), ns_per_tick);
+	  worker.idle = to_nanoseconds(
+	    counters.idle_ticks_.load(std::memory_order_relaxed), ns_per_tick);
+	  for (std::size_t b = 0; b != worker_counters::bucket_count; ++b) {
+	    histogram[b] += counters.queue_wait_[b].load(std::memory_order_relaxed);
+	  }
+	}
+
+	std::size_t used = worker_counters::bucket_count;
+	while (used != 0 && histogram[used - 1] == 0) {
+	  --used;
+	}
+	statistics.queue_wait_histogram.resize(used);
+	for (std::size_t b = 0; b != used; ++b) {
+	  queue_wait_bucket& bucket = statistics.queue_wait_histogram[b];
+	  bucket.upper_bound = to_nanoseconds(std::uint64_t(2) << b, ns_per_tick);
+	  bucket.count = histogram[b];
+	}
+      }
+
+    }  // namespace detail
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_DETAIL_WORKER_INSTRUMENTS_IPP
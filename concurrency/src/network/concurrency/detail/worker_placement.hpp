@@ -0,0 +1,85 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_DETAIL_WORKER_PLACEMENT_INC
+#define NETWORK_CONCURRENCY_DETAIL_WORKER_PLACEMENT_INC
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <system_error>
+#include <network/concurrency/thread_pool_options.hpp>
+
+namespace network {
+  namespace concurrency {
+    namespace detail {
+
+      /**
+       * \brief Applies the CPU affinity, name and priority in the options
+       *        to the calling thread, which is worker number index.
+       * \returns The first error, or an empty error code. Placement that
+       *          isn't supported on this platform is an error only if the
+       *          options ask for it.
+       */
+      std::error_code place_worker(thread_pool_options const& options,
+				   std::size_t index);
+
+      /**
+       * \brief Lets the workers of a pool report that they have placed
+       *        themselves, so that the pool isn't used (and doesn't finish
+       *        constructing) before all of them are ready, and so that an
+       *        error can be thrown from the constructor.
+       */
+      class startup_latch {
+
+	startup_latch(startup_latch const&) = delete;
+	startup_latch& operator=(startup_latch const&) = delete;
+
+      public:
+
+	explicit startup_latch(std::size_t count)
+	  : remaining_(count) {
+
+	}
+
+	/**
+	 * \brief Reports that a worker is ready, or failed to start.
+	 */
+	void arrive(std::error_code const& error) {
+	  std::lock_guard<std::mutex> lock(mutex_);
+	  if (error && !error_) {
+	    error_ = error;
+	  }
+	  if (--remaining_ == 0) {
+	    done_.notify_all();
+	  }
+	}
+
+	/**
+	 * \brief Waits for every worker to arrive.
+	 * \returns The first error reported, if any.
+	 */
+	std::error_code wait() {
+	  std::unique_lock<std::mutex> lock(mutex_);
+	  while (remaining_ != 0) {
+	    done_.wait(lock);
+	  }
+	  return error_;
+	}
+
+      private:
+
+	std::mutex mutex_;
+	std::condition_variable done_;
+	std::size_t remaining_;
+	std::error_code error_;
+
+      };
+
+    }  // namespace detail
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_DETAIL_WORKER_PLACEMENT_INC
@@ -0,0 +1,107 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_DETAIL_WORKER_PLACEMENT_IPP
+#define NETWORK_CONCURRENCY_DETAIL_WORKER_PLACEMENT_IPP
+
+#include <cerrno>
+#include <string>
+#include <network/concurrency/detail/worker_placement.hpp>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace network {
+  namespace concurrency {
+    namespace detail {
+
+#if defined(__linux__)
+
+      namespace {
+	std::error_code errno_code(int value) {
+	  return std::error_code(value, std::system_category());
+	}
+
+	std::error_code set_affinity(std::vector<unsigned> const& cpus) {
+	  cpu_set_t set;
+	  CPU_ZERO(&set);
+	  for (unsigned cpu : cpus) {
+	    if (cpu >= CPU_SETSIZE) {
+	      return errno_code(EINVAL);
+	    }
+	    CPU_SET(cpu, &set);
+	  }
+	  return errno_code(pthread_setaffinity_np(pthread_self(), sizeof(set), &set));
+	}
+
+	std::error_code set_name(std::string const& prefix, std::size_t index) {
+	  // Linux allows 15 chars and the terminating null; the prefix is cut
+	  // so that the worker number stays.
+	  std::string const suffix = "-" + std::to_string(index);
+	  std::string const name =
+	    prefix.substr(0, suffix.size() < 15 ? 15 - suffix.size() : 0) + suffix;
+	  return errno_code(pthread_setname_np(pthread_self(), name.c_str()));
+	}
+
+	std::error_code set_nice(int value) {
+	  // Linux keeps a nice value per thread, set through its thread id.
+	  pid_t const tid = static_cast<pid_t>(::syscall(SYS_gettid));
+	  if (::setpriority(PRIO_PROCESS, tid, value) != 0) {
+	    return errno_code(errno);
+	  }
+	  return std::error_code();
+	}
+
+	std::error_code set_realtime_priority(int priority) {
+	  sched_param param;
+	  param.sched_priority = priority;
+	  return errno_code(pthread_setschedparam(pthread_self(), SCHED_FIFO, &param));
+	}
+      }  // namespace
+
+      std::error_code place_worker(thread_pool_options const& options,
+				   std::size_t index) {
+	std::error_code error;
+	auto const& cpus = options.cpu_affinity();
+	if (!cpus.empty()) {
+	  error = set_affinity(cpus[index % cpus.size()]);
+	}
+	if (!error && !options.thread_name().empty()) {
+	  error = set_name(options.thread_name(), index);
+	}
+	if (!error && options.nice() != 0) {
+	  error = set_nice(options.nice());
+	}
+	if (!error && options.realtime_priority() != 0) {
+	  error = set_realtime_priority(options.realtime_priority());
+	}
+	return error;
+      }
+
+#else
+
+      std::error_code place_worker(thread_pool_options const& options,
+				   std::size_t) {
+	if (!options.cpu_affinity().empty() ||
+	    !options.thread_name().empty() ||
+	    options.nice() != 0 ||
+	    options.realtime_priority() != 0) {
+	  return std::make_error_code(std::errc::not_supported);
+	}
+	return std::error_code();
+      }
+
+#endif
+
+    }  // namespace detail
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_DETAIL_WORKER_PLACEMENT_IPP
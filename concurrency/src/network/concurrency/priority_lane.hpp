@@ -0,0 +1,48 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_PRIORITY_LANE_INC
+#define NETWORK_CONCURRENCY_PRIORITY_LANE_INC
+
+/**
+ * \file
+ * \brief Contains the priority lanes of a thread_pool.
+ */
+
+namespace network {
+  namespace concurrency {
+
+    /**
+     * \ingroup concurrency
+     * \brief The lanes a task can be posted to, from the highest priority
+     *        to the lowest.
+     *
+     * The workers take tasks from the highest lane that has any, but a
+     * lower lane that has been passed over many times in a row gets the
+     * next turn, so that it doesn't starve.
+     */
+    enum class priority_lane {
+      /**
+       * Short continuations that complete I/O and free its resources,
+       * such as write completion handlers.
+       */
+      io_completion,
+
+      /**
+       * Request handlers and other work that someone waits for. This is
+       * the lane thread_pool::post uses by default.
+       */
+      interactive,
+
+      /**
+       * Work that can wait for the others.
+       */
+      background
+    };
+
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_PRIORITY_LANE_INC
@@ -0,0 +1,227 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_TASK_INC
+#define NETWORK_CONCURRENCY_TASK_INC
+
+/**
+ * \file
+ * \brief Contains the task type that a thread_pool runs.
+ */
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <network/concurrency/detail/small_block_allocator.hpp>
+
+namespace network {
+  namespace concurrency {
+
+    /**
+     * \ingroup concurrency
+     * \class task network/concurrency/task.hpp
+     * \brief A move-only, type-erased function object taking no arguments.
+     *
+     * Unlike std::function, a task never copies the function object it
+     * holds, so it can hold move-only ones. Function objects of up to
+     * inline_size bytes (a bound member function with a shared_ptr and a
+     * couple of arguments) are kept inside the task; larger ones are kept
+     * in a recycled block from detail::allocate_small_block.
+     */
+    class task {
+
+      task(task const&) = delete;
+      task& operator=(task const&) = delete;
+
+    public:
+
+      /**
+       * \brief The largest function object kept inside the task.
+       */
+      static std::size_t const inline_size = 64;
+
+      /**
+       * \brief Constructs an empty task.
+       */
+      task() : ops_(nullptr) {
+
+      }
+
+      /**
+       * \brief Constructs a task from a function object.
+       * \param f A function object that can be called with no arguments.
+       */
+      template <class F,
+		class = typename std::enable_if<
+		  !std::is_same<typename std::decay<F>::type, task>::value>::type>
+      task(F&& f)
+	: ops_(nullptr) {
+	typedef typename std::decay<F>::type function_type;
+	construct<function_type>(std::forward<F>(f), fits_inline<function_type>());
+      }
+
+      /**
+       * \brief Move constructor. The other task is left empty.
+       */
+      task(task&& other)
+	: ops_(other.ops_) {
+	if (ops_) {
+	  ops_->move(storage_, other.storage_);
+	  other.ops_ = nullptr;
+	}
+      }
+
+      /**
+       * \brief Move assignment operator. The other task is left empty.
+       */
+      task& operator=(task&& other) {
+	if (this != &other) {
+	  reset();
+	  if (other.ops_) {
+	    other.ops_->move(storage_, other.storage_);
+	    ops_ = other.ops_;
+	    other.ops_ = nullptr;
+	  }
+	}
+	return *this;
+      }
+
+      /**
+       * \brief Destructor.
+       */
+      ~task() {
+	reset();
+      }
+
+      /**
+       * \brief Calls the function object.
+       */
+      void operator()() {
+	ops_->invoke(storage_);
+      }
+
+      /**
+       * \brief Returns true if the task holds a function object.
+       */
+      explicit operator bool() const {
+	return ops_ != nullptr;
+      }
+
+    private:
+
+      typedef std::aligned_storage<
+	inline_size, alignof(std::max_align_t)>::type storage_type;
+
+      template <class F>
+      struct fits_inline
+	: std::integral_constant<bool,
+				 sizeof(F) <= inline_size &&
+				 alignof(F) <= alignof(std::max_align_t) &&
+				 std::is_nothrow_move_constructible<F>::value> {};
+
+      struct operations {
+	void (*invoke)(storage_type&);
+	void (*move)(storage_type& to, storage_type& from);
+	void (*destroy)(storage_type&);
+      };
+
+      // The function object is in the storage.
+      template <class F>
+      struct inline_operations {
+	static F& get(storage_type& storage) {
+	  return *reinterpret_cast<F*>(&storage);
+	}
+
+	static void invoke(storage_type& storage) {
+	  get(storage)();
+	}
+
+	static void move(storage_type& to, storage_type& from) {
+	  ::new (static_cast<void*>(&to)) F(std::move(get(from)));
+	  get(from).~F();
+	}
+
+	static void destroy(storage_type& storage) {
+	  get(storage).~F();
+	}
+
+	static operations const table;
+      };
+
+      // The storage holds a pointer to the function object.
+      template <class F>
+      struct block_operations {
+	static F*& get(storage_type& storage) {
+	  return *reinterpret_cast<F**>(&storage);
+	}
+
+	static void invoke(storage_type& storage) {
+	  (*get(storage))();
+	}
+
+	static void move(storage_type& to, storage_type& from) {
+	  ::new (static_cast<void*>(&to)) F*(get(from));
+	}
+
+	static void destroy(storage_type& storage) {
+	  F* f = get(storage);
+	  f->~F();
+	  detail::deallocate_small_block(f, sizeof(F));
+	}
+
+	static operations const table;
+      };
+
+      template <class F, class Arg>
+      void construct(Arg&& f, std::true_type) {
+	::new (static_cast<void*>(&storage_)) F(std::forward<Arg>(f));
+	ops_ = &inline_operations<F>::table;
+      }
+
+      template <class F, class Arg>
+      void construct(Arg&& f, std::false_type) {
+	void* block = detail::allocate_small_block(sizeof(F));
+	try {
+	  ::new (block) F(std::forward<Arg>(f));
+	}
+	catch (...) {
+	  detail::deallocate_small_block(block, sizeof(F));
+	  throw;
+	}
+	::new (static_cast<void*>(&storage_)) F*(static_cast<F*>(block));
+	ops_ = &block_operations<F>::table;
+      }
+
+      void reset() {
+	if (ops_) {
+	  ops_->destroy(storage_);
+	  ops_ = nullptr;
+	}
+      }
+
+      storage_type storage_;
+      operations const* ops_;
+
+    };
+
+    template <class F>
+    task::operations const task::inline_operations<F>::table = {
+      &task::inline_operations<F>::invoke,
+      &task::inline_operations<F>::move,
+      &task::inline_operations<F>::destroy
+    };
+
+    template <class F>
+    task::operations const task::block_operations<F>::table = {
+      &task::block_operations<F>::invoke,
+      &task::block_operations<F>::move,
+      &task::block_operations<F>::destroy
+    };
+
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_TASK_INC
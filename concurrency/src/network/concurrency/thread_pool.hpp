@@ -24,6 +24,10 @@
 #include <functional>
 #include <vector>
 #include <boost/asio/io_service.hpp>
+#include <network/concurrency/priority_lane.hpp>
+#include <network/concurrency/task.hpp>
+#include <network/concurrency/thread_pool_options.hpp>
+#include <network/concurrency/thread_pool_statistics.hpp>
 
 namespace network {
   namespace concurrency {
@@ -54,9 +58,17 @@ namespace network {
 		  io_service_ptr io_service = io_service_ptr(),
 		  std::vector<std::thread> worker_threads = std::vector<std::thread>());
 
+      /**
+       * \brief Constructor.
+       * \param options The number of threads, how they grow, the bound on
+       *        the queue and the scheduling policy.
+       */
+      explicit thread_pool(thread_pool_options const& options);
+
       /**
        * \brief Move constuctor.
-       * \param other The other thread_pool object.
+       * \param other The other thread_pool object, which is left without
+       *        threads and may only be destroyed or assigned to.
        */
       thread_pool(thread_pool&& other);
 
@@ -78,19 +90,48 @@ namespace network {
       thread_pool& operator=(thread_pool&& other);
 
       /**
-       * \brief Returns the number of threads in the thread pool.
+       * \brief Returns the number of threads in the thread pool, which
+       *        changes if the pool grows.
        * \returns The number of threads in the thread pool.
        */
       std::size_t const thread_count() const;
 
+      /**
+       * \brief Returns the depth of the queue and how long tasks wait in
+       *        it.
+       */
+      thread_pool_statistics statistics() const;
+
       /**
        * \brief Posts a task to the thread pool.
-       * \param task The task to be executed.
+       * \param f The function object to be executed. It is moved (or
+       *          copied, if it is an lvalue) into a task once, and not
+       *          copied again on its way to a worker.
+       * \throws std::system_error if the queue is full and the rejection
+       *         policy is to reject.
+       */
+      template <class Function>
+      void post(Function&& f) {
+	post_task(task(std::forward<Function>(f)), priority_lane::interactive);
+      }
+
+      /**
+       * \brief Posts a task to one of the priority lanes of the thread
+       *        pool.
+       * \param f The function object to be executed.
+       * \param lane The lane; tasks in higher lanes are run first.
+       * \throws std::system_error if the queue is full and the rejection
+       *         policy is to reject.
        */
-      void post(std::function<void()> task);
+      template <class Function>
+      void post(Function&& f, priority_lane lane) {
+	post_task(task(std::forward<Function>(f)), lane);
+      }
 
     private:
 
+      void post_task(task t, priority_lane lane);
+
       struct impl;
       impl* pimpl_;
 
@@ -8,22 +8,114 @@
 #ifndef NETWORK_CONCURRENCY_THREAD_POOL_IPP_20111021
 #define NETWORK_CONCURRENCY_THREAD_POOL_IPP_20111021
 
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <mutex>
 #include <vector>
 #include <thread>
+#include <system_error>
 #include <network/concurrency/thread_pool.hpp>
+#include <network/concurrency/detail/lane_queue.hpp>
+#include <network/concurrency/detail/queue_monitor.hpp>
+#include <network/concurrency/detail/task_node.hpp>
+#include <network/concurrency/detail/work_stealing_scheduler.hpp>
+#include <network/concurrency/detail/worker_instruments.hpp>
+#include <network/concurrency/detail/worker_placement.hpp>
 #include <boost/scope_exit.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 106600
+#include <boost/asio/post.hpp>
+#endif
 
 namespace network {
   namespace concurrency {
 
     struct thread_pool::impl {
+
+      // The handler posted to the io_service, once for each task in the
+      // lanes. It runs whichever task is next, so that the lanes decide the
+      // order rather than the io_service. Boost.Asio allocates the
+      // operation that wraps it with the handler's associated allocator (or,
+      // in older versions, its allocation hooks), so that memory is
+      // recycled instead of coming from the heap on every post.
+      struct asio_token {
+	typedef detail::small_block_allocator<void> allocator_type;
+
+	explicit asio_token(impl* pool)
+	  : pool_(pool) {
+
+	}
+
+	allocator_type get_allocator() const {
+	  return allocator_type();
+	}
+
+	void operator()() const {
+	  pool_->run_next();
+	}
+
+	friend void* asio_handler_allocate(std::size_t size, asio_token*) {
+	  return detail::allocate_small_block(size);
+	}
+
+	friend void asio_handler_deallocate(void* pointer, std::size_t size,
+					    asio_token*) {
+	  detail::deallocate_small_block(pointer, size);
+	}
+
+	impl* pool_;
+      };
+
+      // A worker started because tasks waited too long. It stops when it
+      // has been idle for a while.
+      struct extra_worker {
+	explicit extra_worker(std::size_t index) : index(index), done(false) {}
+
+	std::size_t index;
+	std::thread thread;
+	std::atomic<bool> done;
+      };
+
       impl(std::size_t thread_count = 1,
 	    io_service_ptr io_service = io_service_ptr(),
 	    std::vector<std::thread> worker_threads = std::vector<std::thread>())
 	: thread_count_(thread_count),
 	  io_service_(io_service),
 	  worker_threads_(std::move(worker_threads)),
-	  sentinel_() {
+	  sentinel_(),
+	  options_(std::make_shared<thread_pool_options const>()),
+	  monitor_(*options_),
+	  last_grow_(),
+	  stopping_(false) {
+	start_shared_queue();
+      }
+
+      explicit impl(thread_pool_options const& options)
+	: thread_count_(options.thread_count()),
+	  io_service_(),
+	  worker_threads_(),
+	  sentinel_(),
+	  options_(std::make_shared<thread_pool_options const>(options)),
+	  monitor_(options),
+	  last_grow_(),
+	  stopping_(false) {
+	if (options.instrumentation()) {
+	  instruments_.reset(new detail::worker_instruments(
+	    std::max<std::size_t>(std::max(options.thread_count(),
+					   options.max_thread_count()), 1)));
+	}
+	if (options.scheduling() == scheduling_policy::work_stealing) {
+	  scheduler_.reset(new detail::work_stealing_scheduler(options, monitor_,
+							       instruments_.get()));
+	  thread_count_ = scheduler_->thread_count();
+	}
+	else {
+	  start_shared_queue();
+	}
+      }
+
+      void start_shared_queue() {
 	bool commit = false;
 
 	BOOST_SCOPE_EXIT((&commit)(&io_service_)(&worker_threads_)(&sentinel_)) {
@@ -48,21 +140,55 @@ namespace network {
 	  sentinel_.reset(new boost::asio::io_service::work(*io_service_));
 	}
 
+	// Each worker places itself before it runs anything; the pool is ready
+	// when all of them have.
 	auto local_io_service = io_service_;
-	for (std::size_t counter = 0; counter < thread_count_; ++counter) {
-	  worker_threads_.emplace_back([local_io_service]() {
-	      local_io_service->run();
-	    });
+	auto local_options = options_;
+	detail::worker_instruments* instruments = instruments_.get();
+	std::size_t const thread_count = thread_count_;
+	auto latch = std::make_shared<detail::startup_latch>(thread_count);
+	std::size_t counter = 0;
+	try {
+	  for (; counter < thread_count; ++counter) {
+	    worker_threads_.emplace_back([local_io_service, local_options, instruments,
+					  latch, counter]() {
+		latch->arrive(detail::place_worker(*local_options, counter));
+		if (!latch->wait()) {
+		  if (instruments) {
+		    instruments->attach(counter);
+		  }
+		  local_io_service->run();
+		  detail::worker_instruments::detach();
+		}
+	      });
+	  }
+	}
+	catch (...) {
+	  for (; counter < thread_count; ++counter) {
+	    latch->arrive(std::make_error_code(std::errc::resource_unavailable_try_again));
+	  }
+	  throw;
+	}
+
+	if (std::error_code error = latch->wait()) {
+	  throw std::system_error(error, "thread_pool: cannot place the worker threads");
 	}
 
 	commit = true;
       }
 
       ~impl() {
+	{
+	  // No more threads are started from here on.
+	  std::lock_guard<std::mutex> lock(resize_mutex_);
+	  stopping_ = true;
+	}
 	sentinel_.reset();
 	try {
 	  for (auto& thread : worker_threads_)
 	    thread.join();
+	  for (auto& extra : extra_workers_)
+	    extra->thread.join();
 	}
 	catch (...) {
 	  BOOST_ASSERT(false &&
@@ -71,27 +197,199 @@ namespace network {
 	}
       }
 
-      std::size_t thread_count_;
+      bool in_worker() const {
+	if (scheduler_) {
+	  return scheduler_->in_worker();
+	}
+#if BOOST_VERSION >= 106600
+	return io_service_->get_executor().running_in_this_thread();
+#else
+	return false;
+#endif
+      }
+
+      bool can_grow() const {
+	return thread_count_.load(std::memory_order_relaxed) < options_->max_thread_count();
+      }
+
+      void run_next() {
+	// There is a token for each node, so there is always one.
+	detail::task_node* n = lanes_.pop();
+	BOOST_ASSERT(n);
+	if (monitor_.started(n->queued) > options_->grow_after() && can_grow()) {
+	  grow();
+	}
+	detail::run_task_node(n);
+      }
+
+      void posted() {
+	// A task can also wait because every worker is stuck in a long one.
+	if (can_grow() &&
+	    monitor_.head_wait(detail::queue_monitor::clock::now()) > options_->grow_after()) {
+	  grow();
+	}
+      }
+
+      void grow() {
+#if BOOST_VERSION >= 106600
+	// Extra workers need io_service::run_one_for to notice that they are
+	// idle, so older versions of Boost don't grow.
+	std::unique_lock<std::mutex> lock(resize_mutex_, std::try_to_lock);
+	if (!lock || stopping_ || !sentinel_) {
+	  return;
+	}
+
+	auto const now = detail::queue_monitor::clock::now();
+	if (thread_count_.load() >= options_->max_thread_count() ||
+	    now - last_grow_ < options_->grow_after()) {
+	  return;
+	}
+
+	// Join the workers that have stopped, to reuse their places.
+	extra_workers_.remove_if([](std::unique_ptr<extra_worker> const& extra) {
+	    if (extra->done.load()) {
+	      extra->thread.join();
+	      return true;
+	    }
+	    return false;
+	  });
+
+	// The first place that no running worker has, for placing the worker
+	// and for its counters.
+	std::size_t index = worker_threads_.size();
+	while (std::any_of(extra_workers_.begin(), extra_workers_.end(),
+			   [index](std::unique_ptr<extra_worker> const& extra) {
+			     return extra->index == index;
+			   })) {
+	  ++index;
+	}
+	if (index >= options_->max_thread_count()) {
+	  return;
+	}
+
+	std::unique_ptr<extra_worker> extra(new extra_worker(index));
+	extra_worker* self = extra.get();
+	auto local_io_service = io_service_;
+	auto local_options = options_;
+	detail::worker_instruments* instruments = instruments_.get();
+	std::atomic<std::size_t>* count = &thread_count_;
+	thread_count_.fetch_add(1);
+	try {
+	  extra->thread = std::thread([local_io_service, local_options, instruments,
+				       count, self]() {
+	      // The worker still runs tasks if it can't be placed.
+	      detail::place_worker(*local_options, self->index);
+	      if (instruments) {
+		instruments->attach(self->index);
+	      }
+	      while (local_io_service->run_one_for(local_options->idle_timeout()) != 0) {
+	      }
+	      detail::worker_instruments::detach();
+	      // Joinable before it stops counting, so that grow, once it sees
+	      // room for a worker, can reuse this one's place.
+	      self->done.store(true);
+	      count->fetch_sub(1);
+	    });
+	}
+	catch (std::system_error const&) {
+	  // Growing is best effort.
+	  thread_count_.fetch_sub(1);
+	  return;
+	}
+	last_grow_ = now;
+	extra_workers_.push_back(std::move(extra));
+#endif
+      }
+
+      std::atomic<std::size_t> thread_count_;
       io_service_ptr io_service_;
       std::vector<std::thread> worker_threads_;
       sentinel_ptr sentinel_;
+      std::shared_ptr<thread_pool_options const> options_;
+      detail::queue_monitor monitor_;
+      detail::lane_queue<detail::task_node> lanes_;
+      std::unique_ptr<detail::worker_instruments> instruments_;
+      std::unique_ptr<detail::work_stealing_scheduler> scheduler_;
+
+      std::mutex resize_mutex_;
+      std::list<std::unique_ptr<extra_worker>> extra_workers_;
+      detail::queue_monitor::clock::time_point last_grow_;
+      bool stopping_;
 
     };
 
   thread_pool::thread_pool(std::size_t thread_count,
 			   io_service_ptr io_service,
 			   std::vector<std::thread> worker_threads)
-    : pimpl_(new (std::nothrow)
-	     impl(thread_count, io_service, std::move(worker_threads))) {
+    : pimpl_(new impl(thread_count, io_service, std::move(worker_threads))) {
+
+  }
+
+  thread_pool::thread_pool(thread_pool_options const& options)
+    : pimpl_(new impl(options)) {
 
   }
 
+  thread_pool::thread_pool(thread_pool&& other)
+    : pimpl_(other.pimpl_) {
+    other.pimpl_ = nullptr;
+  }
+
+  thread_pool& thread_pool::operator=(thread_pool&& other) {
+    thread_pool(std::move(other)).swap(*this);
+    return *this;
+  }
+
   std::size_t const thread_pool::thread_count() const {
-    return pimpl_->thread_count_;
+    return pimpl_->thread_count_.load();
+  }
+
+  thread_pool_statistics thread_pool::statistics() const {
+    thread_pool_statistics result = pimpl_->monitor_.statistics();
+    result.thread_count = pimpl_->thread_count_.load();
+    if (pimpl_->instruments_) {
+      pimpl_->instruments_->fill(result);
+    }
+    return result;
   }
 
-  void thread_pool::post(std::function<void()> f) {
-    pimpl_->io_service_->post(f);
+  void thread_pool::post_task(task t, priority_lane lane) {
+    if (pimpl_->monitor_.admit(pimpl_->in_worker()) ==
+	detail::queue_monitor::run_in_caller) {
+      t();
+      return;
+    }
+
+    if (pimpl_->scheduler_) {
+      try {
+	pimpl_->scheduler_->post(std::move(t), lane);
+      }
+      catch (...) {
+	pimpl_->monitor_.withdraw();
+	throw;
+      }
+    }
+    else {
+      // The queue keeps the place admit made only if the task gets in.
+      detail::task_node* n = nullptr;
+      try {
+	n = detail::make_task_node(std::move(t), pimpl_->instruments_ != nullptr);
+	pimpl_->lanes_.push(lane, n);
+      }
+      catch (...) {
+	if (n) {
+	  detail::destroy_task_node(n);
+	}
+	pimpl_->monitor_.withdraw();
+	throw;
+      }
+#if BOOST_VERSION >= 106600
+      boost::asio::post(*pimpl_->io_service_, impl::asio_token(pimpl_));
+#else
+      pimpl_->io_service_->post(impl::asio_token(pimpl_));
+#endif
+      pimpl_->posted();
+    }
   }
 
   void thread_pool::swap(thread_pool& other) {
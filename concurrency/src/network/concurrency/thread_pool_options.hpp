@@ -0,0 +1,339 @@
+// Copyright (c) Glyn Matthews 2012, 2013, 2014.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_THREAD_POOL_OPTIONS_INC
+#define NETWORK_CONCURRENCY_THREAD_POOL_OPTIONS_INC
+
+/**
+ * \file
+ * \brief Contains the options used to construct a thread_pool.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace network {
+  namespace concurrency {
+
+    /**
+     * \ingroup concurrency
+     * \brief How a thread_pool hands tasks to its worker threads.
+     */
+    enum class scheduling_policy {
+      /**
+       * All the workers run a single Boost.Asio io_service, and every task
+       * goes through its queue.
+       */
+      shared_queue,
+
+      /**
+       * Each worker has its own deque of tasks, and idle workers steal from
+       * the others. Tasks posted from a worker go to that worker's deque.
+       */
+      work_stealing
+    };
+
+    /**
+     * \ingroup concurrency
+     * \brief What thread_pool::post does when the queue is full.
+     */
+    enum class rejection_policy {
+      /**
+       * Wait until a worker takes a task from the queue. A worker that
+       * posts to its own pool runs the task itself instead, because all
+       * the workers could be waiting.
+       */
+      block,
+
+      /**
+       * Throw std::system_error, with std::errc::resource_unavailable_try_again.
+       */
+      reject,
+
+      /**
+       * Run the task in the thread that posts it, which also slows down
+       * whoever is posting.
+       */
+      run_in_caller
+    };
+
+    /**
+     * \ingroup concurrency
+     * \class thread_pool_options network/concurrency/thread_pool_options.hpp
+     * \brief Options for constructing a thread_pool.
+     *
+     * The setters return *this so that they can be chained:
+     *
+     * \code
+     * thread_pool pool(thread_pool_options()
+     *                  .thread_count(8)
+     *                  .scheduling(scheduling_policy::work_stealing));
+     * \endcode
+     */
+    class thread_pool_options {
+
+    public:
+
+      /**
+       * \brief Constructor.
+       *
+       * The defaults are one thread that never grows, a shared queue with
+       * no bound, and the workers left unnamed and unplaced.
+       */
+      thread_pool_options()
+	: thread_count_(1),
+	  max_thread_count_(0),
+	  grow_after_(std::chrono::milliseconds(1)),
+	  idle_timeout_(std::chrono::seconds(1)),
+	  scheduling_(scheduling_policy::shared_queue),
+	  max_queue_depth_(0),
+	  rejection_(rejection_policy::block),
+	  instrumentation_(false),
+	  nice_(0),
+	  realtime_priority_(0) {
+
+      }
+
+      /**
+       * \brief Sets the number of worker threads.
+       * \param count The number of worker threads.
+       */
+      thread_pool_options& thread_count(std::size_t count) {
+	thread_count_ = count;
+	return *this;
+      }
+
+      /**
+       * \brief Returns the number of worker threads.
+       */
+      std::size_t thread_count() const {
+	return thread_count_;
+      }
+
+      /**
+       * \brief Lets the pool start more worker threads when tasks wait too
+       *        long in the queue.
+       * \param count The most worker threads; thread_count() of them
+       *        always run, and the others stop again when they are idle.
+       *        0 (the default), or a value not above thread_count(), keeps
+       *        the number of threads fixed.
+       *
+       * Only the shared_queue policy grows.
+       */
+      thread_pool_options& max_thread_count(std::size_t count) {
+	max_thread_count_ = count;
+	return *this;
+      }
+
+      /**
+       * \brief Returns the most worker threads.
+       */
+      std::size_t max_thread_count() const {
+	return max_thread_count_;
+      }
+
+      /**
+       * \brief Sets how long a task may wait in the queue before the pool
+       *        starts another worker thread.
+       * \param wait The queue wait; 1ms by default. The pool starts at
+       *        most one thread in each such interval.
+       */
+      thread_pool_options& grow_after(std::chrono::microseconds wait) {
+	grow_after_ = wait;
+	return *this;
+      }
+
+      /**
+       * \brief Returns how long a task may wait before the pool grows.
+       */
+      std::chrono::microseconds grow_after() const {
+	return grow_after_;
+      }
+
+      /**
+       * \brief Sets how long an extra worker thread stays idle before it
+       *        stops.
+       * \param timeout The idle time; 1s by default.
+       */
+      thread_pool_options& idle_timeout(std::chrono::milliseconds timeout) {
+	idle_timeout_ = timeout;
+	return *this;
+      }
+
+      /**
+       * \brief Returns how long an extra worker thread stays idle.
+       */
+      std::chrono::milliseconds idle_timeout() const {
+	return idle_timeout_;
+      }
+
+      /**
+       * \brief Sets how tasks are handed to the worker threads.
+       * \param policy The scheduling policy.
+       */
+      thread_pool_options& scheduling(scheduling_policy policy) {
+	scheduling_ = policy;
+	return *this;
+      }
+
+      /**
+       * \brief Returns how tasks are handed to the worker threads.
+       */
+      scheduling_policy scheduling() const {
+	return scheduling_;
+      }
+
+      /**
+       * \brief Bounds the number of tasks that wait to run.
+       * \param depth The most tasks posted and not yet started. 0 (the
+       *        default) leaves the queue unbounded.
+       */
+      thread_pool_options& max_queue_depth(std::size_t depth) {
+	max_queue_depth_ = depth;
+	return *this;
+      }
+
+      /**
+       * \brief Returns the most tasks that wait to run.
+       */
+      std::size_t max_queue_depth() const {
+	return max_queue_depth_;
+      }
+
+      /**
+       * \brief Sets what post does when the queue is full.
+       * \param policy The rejection policy; block by default.
+       */
+      thread_pool_options& rejection(rejection_policy policy) {
+	rejection_ = policy;
+	return *this;
+      }
+
+      /**
+       * \brief Returns what post does when the queue is full.
+       */
+      rejection_policy rejection() const {
+	return rejection_;
+      }
+
+      /**
+       * \brief Counts what each worker does, and how long each task waits
+       *        in the queue, for thread_pool::statistics.
+       * \param enabled Off by default. When it is on, each task costs
+       *        three more reads of the time stamp counter.
+       */
+      thread_pool_options& instrumentation(bool enabled) {
+	instrumentation_ = enabled;
+	return *this;
+      }
+
+      /**
+       * \brief Returns whether the workers are instrumented.
+       */
+      bool instrumentation() const {
+	return instrumentation_;
+      }
+
+      /**
+       * \brief Sets the CPUs each worker may run on.
+       * \param cpus The CPU numbers for each worker: worker i is bound to
+       *        cpus[i % cpus.size()]. Empty (the default) leaves the
+       *        workers free to run anywhere.
+       *
+       * A worker pins itself before it allocates its state (its deque,
+       * with the work_stealing policy), so on Linux that memory comes from
+       * the NUMA node of the CPUs it is bound to. To keep a pool on one
+       * node, give every worker the CPUs of that node.
+       */
+      thread_pool_options& cpu_affinity(std::vector<std::vector<unsigned>> cpus) {
+	cpu_affinity_ = std::move(cpus);
+	return *this;
+      }
+
+      /**
+       * \brief Returns the CPUs each worker may run on.
+       */
+      std::vector<std::vector<unsigned>> const& cpu_affinity() const {
+	return cpu_affinity_;
+      }
+
+      /**
+       * \brief Names the worker threads, for top, perf and debuggers.
+       * \param prefix The workers are named prefix-0, prefix-1 and so on,
+       *        cut to the 15 chars Linux allows. Empty (the default) leaves
+       *        them unnamed.
+       */
+      thread_pool_options& thread_name(std::string prefix) {
+	thread_name_ = std::move(prefix);
+	return *this;
+      }
+
+      /**
+       * \brief Returns the prefix of the worker thread names.
+       */
+      std::string const& thread_name() const {
+	return thread_name_;
+      }
+
+      /**
+       * \brief Sets the nice value of the worker threads.
+       * \param value From -20 (highest priority) to 19 (lowest); 0 (the
+       *        default) leaves it as it is. Values below the current one
+       *        usually need privileges.
+       */
+      thread_pool_options& nice(int value) {
+	nice_ = value;
+	return *this;
+      }
+
+      /**
+       * \brief Returns the nice value of the worker threads.
+       */
+      int nice() const {
+	return nice_;
+      }
+
+      /**
+       * \brief Runs the worker threads with the SCHED_FIFO real-time
+       *        policy.
+       * \param priority From 1 to 99; 0 (the default) keeps the normal
+       *        policy. This usually needs privileges.
+       */
+      thread_pool_options& realtime_priority(int priority) {
+	realtime_priority_ = priority;
+	return *this;
+      }
+
+      /**
+       * \brief Returns the real-time priority of the worker threads.
+       */
+      int realtime_priority() const {
+	return realtime_priority_;
+      }
+
+    private:
+
+      std::size_t thread_count_;
+      std::size_t max_thread_count_;
+      std::chrono::microseconds grow_after_;
+      std::chrono::milliseconds idle_timeout_;
+      scheduling_policy scheduling_;
+      std::size_t max_queue_depth_;
+      rejection_policy rejection_;
+      bool instrumentation_;
+      std::vector<std::vector<unsigned>> cpu_affinity_;
+      std::string thread_name_;
+      int nice_;
+      int realtime_priority_;
+
+    };
+
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_THREAD_POOL_OPTIONS_INC
@@ -0,0 +1,158 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_CONCURRENCY_THREAD_POOL_STATISTICS_INC
+#define NETWORK_CONCURRENCY_THREAD_POOL_STATISTICS_INC
+
+/**
+ * \file
+ * \brief Contains the statistics reported by a thread_pool.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace network {
+  namespace concurrency {
+
+    /**
+     * \ingroup concurrency
+     * \brief What one worker of a thread_pool has done.
+     */
+    struct worker_statistics {
+
+      worker_statistics()
+	: tasks_executed(0), busy(0), idle(0) {
+
+      }
+
+      /**
+       * \brief The number of tasks the worker ran.
+       */
+      std::uint64_t tasks_executed;
+
+      /**
+       * \brief The time spent running them.
+       */
+      std::chrono::nanoseconds busy;
+
+      /**
+       * \brief The time spent between them, up to the start of the last
+       *        one.
+       */
+      std::chrono::nanoseconds idle;
+
+    };
+
+    /**
+     * \ingroup concurrency
+     * \brief A bucket of the queue wait histogram of a thread_pool.
+     */
+    struct queue_wait_bucket {
+
+      queue_wait_bucket()
+	: upper_bound(0), count(0) {
+
+      }
+
+      /**
+       * \brief The bucket counts the waits shorter than this, and at least
+       *        as long as the upper bound of the bucket before.
+       */
+      std::chrono::nanoseconds upper_bound;
+
+      /**
+       * \brief The number of tasks that waited that long.
+       */
+      std::uint64_t count;
+
+    };
+
+    /**
+     * \ingroup concurrency
+     * \brief A snapshot of the queue of a thread_pool and, with
+     *        instrumentation, of its workers.
+     *
+     * The counters are read one at a time while the pool runs, so they
+     * needn't add up exactly.
+     */
+    struct thread_pool_statistics {
+
+      thread_pool_statistics()
+	: thread_count(0),
+	  queue_depth(0),
+	  peak_queue_depth(0),
+	  tasks_started(0),
+	  tasks_rejected(0),
+	  tasks_run_in_caller(0),
+	  total_queue_wait(0),
+	  max_queue_wait(0) {
+
+      }
+
+      /**
+       * \brief The number of worker threads.
+       */
+      std::size_t thread_count;
+
+      /**
+       * \brief The number of tasks posted and not yet started.
+       */
+      std::size_t queue_depth;
+
+      /**
+       * \brief The largest queue_depth so far.
+       */
+      std::size_t peak_queue_depth;
+
+      /**
+       * \brief The number of tasks that were taken from the queue.
+       */
+      std::uint64_t tasks_started;
+
+      /**
+       * \brief The number of tasks rejected because the queue was full.
+       */
+      std::uint64_t tasks_rejected;
+
+      /**
+       * \brief The number of tasks run by the thread that posted them,
+       *        because the queue was full.
+       */
+      std::uint64_t tasks_run_in_caller;
+
+      /**
+       * \brief The time the started tasks spent in the queue, added up.
+       *        Divide by tasks_started for the mean.
+       */
+      std::chrono::nanoseconds total_queue_wait;
+
+      /**
+       * \brief The longest time a task spent in the queue.
+       */
+      std::chrono::nanoseconds max_queue_wait;
+
+      /**
+       * \brief What each worker has done, if the pool was constructed with
+       *        instrumentation on; otherwise empty. A pool that grows has
+       *        an entry for each place an extra worker may take.
+       */
+      std::vector<worker_statistics> workers;
+
+      /**
+       * \brief How long the tasks the workers ran waited in the queue, in
+       *        buckets that double in size, up to the last bucket that
+       *        isn't empty; empty without instrumentation.
+       */
+      std::vector<queue_wait_bucket> queue_wait_histogram;
+
+    };
+
+  }  // namespace concurrency
+}  // namespace network
+
+#endif // NETWORK_CONCURRENCY_THREAD_POOL_STATISTICS_INC
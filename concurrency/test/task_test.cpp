@@ -0,0 +1,133 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+#include <network/concurrency/task.hpp>
+#include <network/concurrency/thread_pool.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+#include <boost/ref.hpp>
+
+// Every allocation in the program is counted, so that the tests can check
+// that posting a task doesn't touch the heap.
+namespace {
+std::atomic<std::size_t> allocations(0);
+}
+
+void* operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+using network::concurrency::scheduling_policy;
+using network::concurrency::task;
+using network::concurrency::thread_pool;
+using network::concurrency::thread_pool_options;
+
+TEST(task_test, default_constructed_task_is_empty) {
+  task t;
+  ASSERT_FALSE(t);
+}
+
+TEST(task_test, holds_move_only_function_objects) {
+  std::unique_ptr<int> value(new int(42));
+  int result = 0;
+  int* destination = &result;
+  struct move_only {
+    std::unique_ptr<int> value;
+    int* destination;
+    void operator()() { *destination = *value; }
+  };
+  task t(move_only{std::move(value), destination});
+  task moved(std::move(t));
+  ASSERT_FALSE(t);
+  ASSERT_TRUE(moved);
+  moved();
+  ASSERT_EQ(42, result);
+}
+
+TEST(task_test, holds_large_function_objects) {
+  struct large {
+    char padding[task::inline_size * 2];
+    int* destination;
+    void operator()() { *destination = sizeof(padding); }
+  };
+  int result = 0;
+  large f;
+  f.destination = &result;
+  task t(f);
+  task assigned;
+  assigned = std::move(t);
+  assigned();
+  ASSERT_EQ(int(task::inline_size * 2), result);
+}
+
+TEST(task_test, small_tasks_do_not_allocate) {
+  std::shared_ptr<int> shared(new int(1));
+  std::function<void(int const&, std::shared_ptr<int>)> handler =
+      [](int const&, std::shared_ptr<int>) {};
+  int request = 0;
+  std::size_t const before = allocations.load();
+  {
+    task t(std::bind(handler, boost::cref(request), shared));
+    t();
+  }
+  ASSERT_EQ(before, allocations.load());
+}
+
+namespace {
+
+// Stands in for async_server_connection: the server posts the request
+// handler bound to the request and to the connection's shared_ptr.
+struct connection : std::enable_shared_from_this<connection> {
+  int request;
+};
+
+void server_request_path(scheduling_policy policy) {
+  std::atomic<std::size_t> handled(0);
+  std::function<void(int const&, std::shared_ptr<connection>)> handler =
+      [&handled](int const&, std::shared_ptr<connection>) { ++handled; };
+  std::shared_ptr<connection> c(new connection);
+
+  thread_pool pool(thread_pool_options().thread_count(2).scheduling(policy));
+  auto post_requests = [&] {
+    // One request at a time, as if each came from a different read.
+    for (std::size_t i = 0; i < 1000; ++i) {
+      std::size_t const target = handled.load() + 1;
+      pool.post(std::bind(handler, boost::cref(c->request),
+                          c->shared_from_this()));
+      while (handled.load() != target) {
+        std::this_thread::yield();
+      }
+    }
+  };
+
+  // The first round fills the recycled blocks and grows the queues.
+  post_requests();
+  std::size_t const before = allocations.load();
+  post_requests();
+  ASSERT_EQ(before, allocations.load());
+}
+
+}  // namespace
+
+TEST(task_test, server_request_path_does_not_allocate_shared_queue) {
+  server_request_path(scheduling_policy::shared_queue);
+}
+
+TEST(task_test, server_request_path_does_not_allocate_work_stealing) {
+  server_request_path(scheduling_policy::work_stealing);
+}
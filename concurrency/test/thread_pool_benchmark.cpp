@@ -0,0 +1,100 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the tasks per second that a thread_pool runs, with the
+// shared_queue and work_stealing scheduling policies, for 1 to 64 threads:
+//  - external: one thread outside the pool posts every task, the way the
+//    server's I/O threads post handlers,
+//  - fan-out: each task posts two more until a depth is reached, so that
+//    most tasks are posted from the workers.
+// The time includes the destruction of the pool, which waits for every task
+// to run.
+//
+// Usage: cpp-netlib-thread_pool_benchmark [tasks in thousands (default 1000)]
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <network/concurrency/thread_pool.hpp>
+
+namespace {
+
+using network::concurrency::scheduling_policy;
+using network::concurrency::thread_pool;
+using network::concurrency::thread_pool_options;
+
+std::atomic<std::size_t> executed(0);
+
+void work() {
+  executed.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <class Function>
+double tasks_per_second(std::size_t tasks, Function f) {
+  executed.store(0);
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  if (executed.load() != tasks) {
+    std::fprintf(stderr, "ran %zu tasks out of %zu\n", executed.load(), tasks);
+    std::exit(1);
+  }
+  return tasks / std::chrono::duration<double>(elapsed).count();
+}
+
+double external(scheduling_policy policy, std::size_t threads,
+                std::size_t tasks) {
+  return tasks_per_second(tasks, [&] {
+    thread_pool pool(thread_pool_options().thread_count(threads)
+                     .scheduling(policy));
+    for (std::size_t i = 0; i < tasks; ++i) {
+      pool.post(work);
+    }
+  });
+}
+
+void fan_out_task(thread_pool& pool, int depth) {
+  work();
+  if (depth > 0) {
+    pool.post(std::bind(fan_out_task, std::ref(pool), depth - 1));
+    pool.post(std::bind(fan_out_task, std::ref(pool), depth - 1));
+  }
+}
+
+double fan_out(scheduling_policy policy, std::size_t threads,
+               std::size_t tasks) {
+  // Each root runs 2^(depth + 1) - 1 tasks.
+  int const depth = 12;
+  std::size_t const per_root = (std::size_t(1) << (depth + 1)) - 1;
+  std::size_t const roots = (tasks + per_root - 1) / per_root;
+  return tasks_per_second(roots * per_root, [&] {
+    thread_pool pool(thread_pool_options().thread_count(threads)
+                     .scheduling(policy));
+    for (std::size_t i = 0; i < roots; ++i) {
+      pool.post(std::bind(fan_out_task, std::ref(pool), depth));
+    }
+  });
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t const tasks =
+      (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000) * 1000;
+
+  std::printf("%8s %18s %18s %18s %18s\n", "threads", "external/shared",
+              "external/stealing", "fan-out/shared", "fan-out/stealing");
+  for (std::size_t threads = 1; threads <= 64; threads *= 2) {
+    std::printf(
+        "%8zu %18.0f %18.0f %18.0f %18.0f\n", threads,
+        external(scheduling_policy::shared_queue, threads, tasks),
+        external(scheduling_policy::work_stealing, threads, tasks),
+        fan_out(scheduling_policy::shared_queue, threads, tasks),
+        fan_out(scheduling_policy::work_stealing, threads, tasks));
+  }
+  return 0;
+}
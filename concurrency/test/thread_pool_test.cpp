@@ -8,7 +8,19 @@
 
 #include <gtest/gtest.h>
 #include <network/concurrency/thread_pool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <functional>
+#include <future>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 using network::concurrency::thread_pool;
 
@@ -43,3 +55,457 @@ TEST(concurrency_test, post_work) {
   }
   ASSERT_EQ(3, instance.val());
 }
+
+TEST(concurrency_test, options_constructor) {
+  thread_pool pool(network::concurrency::thread_pool_options().thread_count(3));
+  ASSERT_EQ(pool.thread_count(), std::size_t(3));
+}
+
+TEST(concurrency_test, work_stealing_post_work) {
+  foo instance;
+  {
+    thread_pool pool(network::concurrency::thread_pool_options()
+                     .thread_count(4)
+                     .scheduling(network::concurrency::scheduling_policy::work_stealing));
+    ASSERT_EQ(pool.thread_count(), std::size_t(4));
+    ASSERT_NO_THROW(pool.post(std::bind(&foo::bar, &instance, 1)));
+    ASSERT_NO_THROW(pool.post(std::bind(&foo::bar, &instance, 2)));
+  }
+  ASSERT_EQ(3, instance.val());
+}
+
+TEST(concurrency_test, work_stealing_nested_posts) {
+  // Tasks posted from the workers go to their own deques; the pool has to
+  // run all of them, including the ones posted while it is being destroyed.
+  std::atomic<int> count(0);
+  {
+    std::function<void(int)> spawn;
+    thread_pool pool(network::concurrency::thread_pool_options()
+                     .thread_count(4)
+                     .scheduling(network::concurrency::scheduling_policy::work_stealing));
+    spawn = [&](int depth) {
+      ++count;
+      if (depth > 0) {
+        pool.post(std::bind(spawn, depth - 1));
+        pool.post(std::bind(spawn, depth - 1));
+      }
+    };
+    for (int i = 0; i < 8; ++i) {
+      pool.post(std::bind(spawn, 10));
+    }
+  }
+  ASSERT_EQ(8 * ((1 << 11) - 1), count.load());
+}
+
+TEST(concurrency_test, move_constructor) {
+  foo instance;
+  {
+    thread_pool pool(2);
+    thread_pool moved(std::move(pool));
+    ASSERT_EQ(moved.thread_count(), std::size_t(2));
+    moved.post(std::bind(&foo::bar, &instance, 1));
+  }
+  ASSERT_EQ(1, instance.val());
+}
+
+TEST(concurrency_test, move_assignment) {
+  foo instance;
+  {
+    thread_pool pool(2);
+    thread_pool assigned;
+    assigned.post(std::bind(&foo::bar, &instance, 1));
+    assigned = std::move(pool);
+    ASSERT_EQ(assigned.thread_count(), std::size_t(2));
+    assigned.post(std::bind(&foo::bar, &instance, 2));
+  }
+  ASSERT_EQ(3, instance.val());
+}
+
+namespace {
+
+// Keeps the only worker of a pool busy until it is opened.
+struct gate {
+  gate() : opened(promise.get_future().share()) {}
+
+  void hold(thread_pool& pool) {
+    std::promise<void> entered;
+    std::future<void> inside = entered.get_future();
+    std::shared_future<void> wait = opened;
+    std::shared_ptr<std::promise<void>> signal(new std::promise<void>(std::move(entered)));
+    pool.post([wait, signal] {
+        signal->set_value();
+        wait.wait();
+      });
+    inside.wait();
+  }
+
+  void open() { promise.set_value(); }
+
+  std::promise<void> promise;
+  std::shared_future<void> opened;
+};
+
+}  // namespace
+
+TEST(concurrency_test, full_queue_rejects) {
+  gate g;
+  thread_pool pool(network::concurrency::thread_pool_options()
+                   .max_queue_depth(2)
+                   .rejection(network::concurrency::rejection_policy::reject));
+  g.hold(pool);
+  pool.post([] {});
+  pool.post([] {});
+  ASSERT_THROW(pool.post([] {}), std::system_error);
+  ASSERT_EQ(std::size_t(2), pool.statistics().queue_depth);
+  ASSERT_EQ(std::uint64_t(1), pool.statistics().tasks_rejected);
+  g.open();
+}
+
+TEST(concurrency_test, full_queue_runs_in_caller) {
+  gate g;
+  thread_pool pool(network::concurrency::thread_pool_options()
+                   .max_queue_depth(1)
+                   .rejection(network::concurrency::rejection_policy::run_in_caller));
+  g.hold(pool);
+  pool.post([] {});
+  std::thread::id ran_on;
+  pool.post([&ran_on] { ran_on = std::this_thread::get_id(); });
+  ASSERT_EQ(std::this_thread::get_id(), ran_on);
+  ASSERT_EQ(std::uint64_t(1), pool.statistics().tasks_run_in_caller);
+  g.open();
+}
+
+TEST(concurrency_test, full_queue_blocks) {
+  gate g;
+  std::atomic<int> count(0);
+  {
+    thread_pool pool(network::concurrency::thread_pool_options()
+                     .max_queue_depth(1)
+                     .rejection(network::concurrency::rejection_policy::block));
+    g.hold(pool);
+    pool.post([&count] { ++count; });
+    std::thread opener([&g] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        g.open();
+      });
+    // Waits for the worker to take the first task.
+    pool.post([&count] { ++count; });
+    opener.join();
+  }
+  ASSERT_EQ(2, count.load());
+}
+
+TEST(concurrency_test, full_queue_wakes_posters_when_workers_post) {
+  // A worker that posts to the full queue overshoots it for a moment;
+  // the posters outside that wait meanwhile must still be woken.
+  std::atomic<int> count(0);
+  {
+    thread_pool pool(network::concurrency::thread_pool_options()
+                     .thread_count(2)
+                     .max_queue_depth(1)
+                     .rejection(network::concurrency::rejection_policy::block));
+    auto post_nested = [&pool, &count] {
+      for (int i = 0; i != 2000; ++i) {
+        pool.post([&pool, &count] {
+            ++count;
+            pool.post([&count] { ++count; });
+          });
+      }
+    };
+    std::thread other(post_nested);
+    post_nested();
+    other.join();
+  }
+  ASSERT_EQ(8000, count.load());
+}
+
+TEST(concurrency_test, full_queue_blocks_work_stealing) {
+  // The workers mustn't block on their own queue: the nested tasks run in
+  // the worker that posts them.
+  std::atomic<int> count(0);
+  {
+    std::function<void(int)> spawn;
+    thread_pool pool(network::concurrency::thread_pool_options()
+                     .thread_count(2)
+                     .max_queue_depth(4)
+                     .scheduling(network::concurrency::scheduling_policy::work_stealing));
+    spawn = [&](int depth) {
+      ++count;
+      if (depth > 0) {
+        pool.post(std::bind(spawn, depth - 1));
+        pool.post(std::bind(spawn, depth - 1));
+      }
+    };
+    pool.post(std::bind(spawn, 8));
+  }
+  ASSERT_EQ((1 << 9) - 1, count.load());
+}
+
+TEST(concurrency_test, statistics_measure_queue_wait) {
+  gate g;
+  thread_pool pool(network::concurrency::thread_pool_options().thread_count(1));
+  g.hold(pool);
+  std::promise<void> done;
+  pool.post([] {});
+  pool.post([&done] { done.set_value(); });
+  ASSERT_EQ(std::size_t(2), pool.statistics().peak_queue_depth);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  g.open();
+  done.get_future().wait();
+  network::concurrency::thread_pool_statistics stats = pool.statistics();
+  ASSERT_EQ(std::size_t(1), stats.thread_count);
+  ASSERT_EQ(std::size_t(0), stats.queue_depth);
+  ASSERT_EQ(std::uint64_t(3), stats.tasks_started);
+  ASSERT_GE(stats.max_queue_wait, std::chrono::milliseconds(5));
+  ASSERT_GE(stats.total_queue_wait, stats.max_queue_wait);
+}
+
+TEST(concurrency_test, grows_when_tasks_wait_and_shrinks_when_idle) {
+  gate g;
+  thread_pool pool(network::concurrency::thread_pool_options()
+                   .thread_count(1)
+                   .max_thread_count(2)
+                   .grow_after(std::chrono::microseconds(100))
+                   .idle_timeout(std::chrono::milliseconds(20)));
+  g.hold(pool);
+  // The only worker is busy, so this task waits until another starts.
+  std::promise<void> done;
+  pool.post([] {});
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  pool.post([&done] { done.set_value(); });
+  done.get_future().wait();
+  ASSERT_EQ(std::size_t(2), pool.thread_count());
+  g.open();
+
+  for (int i = 0; i < 500 && pool.thread_count() != 1; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(std::size_t(1), pool.thread_count());
+}
+
+namespace {
+
+std::vector<int> lane_order(network::concurrency::scheduling_policy policy) {
+  using network::concurrency::priority_lane;
+  std::vector<int> order;
+  gate g;
+  {
+    thread_pool pool(network::concurrency::thread_pool_options()
+                     .thread_count(1)
+                     .scheduling(policy));
+    g.hold(pool);
+    pool.post([&order] { order.push_back(3); }, priority_lane::background);
+    pool.post([&order] { order.push_back(2); });
+    pool.post([&order] { order.push_back(1); }, priority_lane::io_completion);
+    g.open();
+  }
+  return order;
+}
+
+std::size_t background_position(network::concurrency::scheduling_policy policy) {
+  using network::concurrency::priority_lane;
+  std::vector<int> order;
+  gate g;
+  {
+    thread_pool pool(network::concurrency::thread_pool_options()
+                     .thread_count(1)
+                     .scheduling(policy));
+    g.hold(pool);
+    pool.post([&order] { order.push_back(0); }, priority_lane::background);
+    for (int i = 0; i < 100; ++i) {
+      pool.post([&order] { order.push_back(1); }, priority_lane::io_completion);
+    }
+    g.open();
+  }
+  return std::find(order.begin(), order.end(), 0) - order.begin();
+}
+
+}  // namespace
+
+TEST(concurrency_test, higher_lanes_run_first) {
+  std::vector<int> expected = {1, 2, 3};
+  ASSERT_EQ(expected, lane_order(network::concurrency::scheduling_policy::shared_queue));
+}
+
+TEST(concurrency_test, higher_lanes_run_first_work_stealing) {
+  std::vector<int> expected = {1, 2, 3};
+  ASSERT_EQ(expected, lane_order(network::concurrency::scheduling_policy::work_stealing));
+}
+
+TEST(concurrency_test, lower_lanes_do_not_starve) {
+  ASSERT_LT(background_position(network::concurrency::scheduling_policy::shared_queue),
+            std::size_t(20));
+  ASSERT_LT(background_position(network::concurrency::scheduling_policy::work_stealing),
+            std::size_t(20));
+}
+
+TEST(concurrency_test, reposting_tasks_do_not_starve_others_work_stealing) {
+  // A task that posts itself again stays on its worker's deque; the
+  // task batched onto that deque behind it, and the one left in the
+  // injection queue, must still get their turn.
+  using network::concurrency::priority_lane;
+  std::atomic<int> reposts(0);
+  std::atomic<int> others(0);
+  std::atomic<int> others_after(0);
+  gate g;
+  {
+    std::function<void()> repost;
+    thread_pool pool(network::concurrency::thread_pool_options()
+                     .thread_count(1)
+                     .scheduling(network::concurrency::scheduling_policy::work_stealing));
+    repost = [&] {
+      if (others.load() != 2 && ++reposts < 10000000) {
+        pool.post(repost);
+      }
+    };
+    g.hold(pool);
+    pool.post(repost);
+    pool.post([&] { ++others; others_after = reposts.load(); },
+              priority_lane::background);
+    g.open();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    pool.post([&] { ++others; others_after = reposts.load(); },
+              priority_lane::background);
+  }
+  ASSERT_EQ(2, others.load());
+  ASSERT_LT(others_after.load(), 10000000);
+}
+
+namespace {
+
+// Runs tasks that each take at least a millisecond, and returns the
+// snapshot once the workers have counted all of them.
+network::concurrency::thread_pool_statistics
+instrumented_run(network::concurrency::scheduling_policy policy) {
+  thread_pool pool(network::concurrency::thread_pool_options()
+                   .thread_count(2)
+                   .scheduling(policy)
+                   .instrumentation(true));
+  for (int i = 0; i < 10; ++i) {
+    pool.post([] { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+  }
+
+  network::concurrency::thread_pool_statistics stats;
+  for (int attempt = 0; attempt < 1000; ++attempt) {
+    stats = pool.statistics();
+    std::uint64_t executed = 0;
+    for (auto const& worker : stats.workers) {
+      executed += worker.tasks_executed;
+    }
+    if (executed == 10) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return stats;
+}
+
+void check_instrumented_run(network::concurrency::thread_pool_statistics const& stats) {
+  ASSERT_EQ(std::size_t(2), stats.workers.size());
+  std::uint64_t executed = 0;
+  std::chrono::nanoseconds busy(0);
+  for (auto const& worker : stats.workers) {
+    executed += worker.tasks_executed;
+    busy += worker.busy;
+  }
+  ASSERT_EQ(std::uint64_t(10), executed);
+  ASSERT_GE(busy, std::chrono::milliseconds(9));
+
+  std::uint64_t waited = 0;
+  for (auto const& bucket : stats.queue_wait_histogram) {
+    waited += bucket.count;
+  }
+  ASSERT_EQ(std::uint64_t(10), waited);
+  ASSERT_FALSE(stats.queue_wait_histogram.empty());
+  ASSERT_NE(0u, stats.queue_wait_histogram.back().count);
+}
+
+}  // namespace
+
+TEST(concurrency_test, uninstrumented_pool_has_no_worker_statistics) {
+  thread_pool pool(network::concurrency::thread_pool_options().thread_count(2));
+  ASSERT_TRUE(pool.statistics().workers.empty());
+  ASSERT_TRUE(pool.statistics().queue_wait_histogram.empty());
+}
+
+TEST(concurrency_test, instrumented_workers_count_tasks) {
+  check_instrumented_run(instrumented_run(network::concurrency::scheduling_policy::shared_queue));
+}
+
+TEST(concurrency_test, instrumented_workers_count_tasks_work_stealing) {
+  check_instrumented_run(instrumented_run(network::concurrency::scheduling_policy::work_stealing));
+}
+
+#if defined(__linux__)
+
+namespace {
+
+// What a worker sees of its own placement.
+struct placement {
+  placement() : only_cpu_0(false) {}
+  bool only_cpu_0;
+  std::string name;
+};
+
+placement placement_of_worker(network::concurrency::scheduling_policy policy) {
+  placement result;
+  {
+    thread_pool pool(network::concurrency::thread_pool_options()
+                     .thread_count(2)
+                     .scheduling(policy)
+                     .cpu_affinity({{0}})
+                     .thread_name("netlib"));
+    pool.post([&result] {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+        result.only_cpu_0 = CPU_ISSET(0, &set) && CPU_COUNT(&set) == 1;
+        char name[16] = {0};
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+        result.name = name;
+      });
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(concurrency_test, shared_queue_places_workers) {
+  placement p = placement_of_worker(network::concurrency::scheduling_policy::shared_queue);
+  ASSERT_TRUE(p.only_cpu_0);
+  ASSERT_EQ(0u, p.name.find("netlib-"));
+}
+
+TEST(concurrency_test, work_stealing_places_workers) {
+  placement p = placement_of_worker(network::concurrency::scheduling_policy::work_stealing);
+  ASSERT_TRUE(p.only_cpu_0);
+  ASSERT_EQ(0u, p.name.find("netlib-"));
+}
+
+TEST(concurrency_test, long_thread_names_are_cut) {
+  std::string name;
+  {
+    thread_pool pool(network::concurrency::thread_pool_options()
+                     .thread_name("a-very-long-thread-pool-name"));
+    pool.post([&name] {
+        char buffer[16] = {0};
+        pthread_getname_np(pthread_self(), buffer, sizeof(buffer));
+        name = buffer;
+      });
+  }
+  ASSERT_EQ("a-very-long-t-0", name);
+}
+
+TEST(concurrency_test, invalid_cpu_throws) {
+  ASSERT_THROW(thread_pool(network::concurrency::thread_pool_options()
+                           .thread_count(2)
+                           .cpu_affinity({{100000}})),
+               std::system_error);
+  ASSERT_THROW(thread_pool(network::concurrency::thread_pool_options()
+                           .thread_count(2)
+                           .scheduling(network::concurrency::scheduling_policy::work_stealing)
+                           .cpu_affinity({{100000}})),
+               std::system_error);
+}
+
+#endif
@@ -0,0 +1,291 @@
+// Copyright 2026 (c) agent <agent@local>
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <http/src/http/server/form_data.hpp>
+#include <fstream>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/mime/push_parser.hpp>
+#include <network/message/ascii.hpp>
+
+namespace network {
+namespace http {
+
+namespace {
+
+boost::string_ref trim(boost::string_ref value) {
+  while (!value.empty() &&
+         (value.front() == ' ' || value.front() == '\t' ||
+          value.front() == '\r' || value.front() == '\n'))
+    value.remove_prefix(1);
+  while (!value.empty() &&
+         (value.back() == ' ' || value.back() == '\t' ||
+          value.back() == '\r' || value.back() == '\n'))
+    value.remove_suffix(1);
+  return value;
+}
+
+// Reads the parameters of a Content-Disposition header, e.g.
+//   form-data; name="field"; filename="a.txt"
+// calling parameter(name, value) for each. Quoted values are unescaped.
+template <class Function>
+void parse_disposition(boost::string_ref value, Function parameter) {
+  std::size_t pos = value.find(';');
+  while (pos != boost::string_ref::npos) {
+    value.remove_prefix(pos + 1);
+    std::size_t equals = value.find('=');
+    std::size_t semicolon = value.find(';');
+    if (equals == boost::string_ref::npos || equals > semicolon) {
+      pos = semicolon;
+      continue;
+    }
+    boost::string_ref name = trim(value.substr(0, equals));
+    boost::string_ref rest = trim(value.substr(equals + 1));
+    std::string unquoted;
+    if (!rest.empty() && rest.front() == '"') {
+      std::size_t i = 1;
+      for (; i < rest.size() && rest[i] != '"'; ++i) {
+        if (rest[i] == '\\' && i + 1 < rest.size()) ++i;
+        unquoted += rest[i];
+      }
+      value = rest.substr(i < rest.size() ? i + 1 : i);
+    } else {
+      semicolon = rest.find(';');
+      unquoted = static_cast<std::string>(trim(rest.substr(0, semicolon)));
+      value = rest.substr(semicolon == boost::string_ref::npos ? rest.size()
+                                                              : semicolon);
+    }
+    parameter(name, unquoted);
+    pos = value.find(';');
+  }
+}
+
+}  // namespace
+
+class form_data_decoder_pimpl {
+ public:
+  form_data_decoder_pimpl(form_data_options const& options)
+      : options_(options),
+        field_size_(0),
+        total_field_size_(0),
+        parts_seen_(0),
+        failed_(false),
+        finished_(false),
+        parser_(*this) {
+    if (options_.spool_directory().empty())
+      options_.spool_directory(
+          boost::filesystem::temp_directory_path().string());
+    parser_.max_header_size(options_.max_header_size());
+  }
+
+  ~form_data_decoder_pimpl() {
+    if (!finished_) remove_spooled_files();
+  }
+
+  void start(boost::string_ref content_type) {
+    std::string headers = "Content-Type: ";
+    headers.append(content_type.begin(), content_type.end());
+    headers += "\r\n\r\n";
+    feed(headers);
+    if (parts_.size() != 1 || parts_.back().kind != envelope_part)
+      throw form_data_error("The body is not multipart/form-data");
+  }
+
+  void feed(boost::string_ref data) {
+    if (failed_) throw form_data_error("The form data could not be decoded");
+    try {
+      parser_.feed(data.data(), data.size());
+    }
+    catch (form_data_error const&) {
+      failed_ = true;
+      throw;
+    }
+    catch (std::runtime_error const& e) {  // the errors of the mime parser
+      failed_ = true;
+      throw form_data_error(e.what());
+    }
+    catch (...) {
+      failed_ = true;
+      throw;
+    }
+  }
+
+  void finish() {
+    if (failed_) throw form_data_error("The form data could not be decoded");
+    try {
+      parser_.finish();
+      finished_ = true;
+    }
+    catch (form_data_error const&) {
+      failed_ = true;
+      throw;
+    }
+    catch (std::runtime_error const& e) {  // the errors of the mime parser
+      failed_ = true;
+      throw form_data_error(e.what());
+    }
+    catch (...) {
+      failed_ = true;
+      throw;
+    }
+  }
+
+  form_data const& result() const { return result_; }
+
+  // The events of the push_parser.
+  void part_begin() { parts_.push_back(part()); }
+
+  void header(std::string const& name, std::string const& value) {
+    part& current = parts_.back();
+    if (ascii::iequals(name, "Content-Disposition"))
+      current.disposition = static_cast<std::string>(trim(value));
+    else if (ascii::iequals(name, "Content-Type"))
+      current.content_type = static_cast<std::string>(trim(value));
+  }
+
+  void headers_end() {
+    part& current = parts_.back();
+    bool multipart = ascii::iequals(
+        boost::string_ref(current.content_type).substr(0, 10), "multipart/");
+    if (parts_.size() == 1) {
+      if (!ascii::iequals(
+              boost::string_ref(current.content_type).substr(0, 19),
+              "multipart/form-data"))
+        throw form_data_error("The body is not multipart/form-data");
+      current.kind = envelope_part;
+      return;
+    }
+
+    if (parts_seen_ == options_.max_fields())
+      throw form_data_error("The form has too many fields");
+    ++parts_seen_;
+
+    // A part without a name of its own (a file of a multipart/mixed field)
+    // belongs to the enclosing field.
+    bool has_filename = false;
+    parse_disposition(current.disposition,
+                      [&](boost::string_ref name, std::string const& value) {
+      if (ascii::iequals(name, "name"))
+        current.name = value;
+      else if (ascii::iequals(name, "filename")) {
+        current.filename = value;
+        has_filename = true;
+      }
+    });
+    if (current.name.empty()) current.name = parts_[parts_.size() - 2].name;
+
+    if (multipart)
+      current.kind = other_part;
+    else if (has_filename)
+      begin_file(current);
+    else {
+      current.kind = field_part;
+      field_size_ = 0;
+      result_.fields.push_back(std::make_pair(current.name, std::string()));
+    }
+  }
+
+  void body(char const* data, std::size_t size) {
+    part& current = parts_.back();
+    if (current.kind == field_part) {
+      field_size_ += size;
+      total_field_size_ += size;
+      if (field_size_ > options_.max_field_size())
+        throw form_data_error("Form field '" + current.name + "' is too large");
+      if (total_field_size_ > options_.max_total_field_size())
+        throw form_data_error("The form fields are too large");
+      result_.fields.back().second.append(data, size);
+    } else if (current.kind == file_part) {
+      file_.size += size;
+      if (options_.file_handler()) {
+        options_.file_handler()(file_, boost::string_ref(data, size));
+      } else if (!spool_.write(data, size)) {
+        throw form_data_error("Can't write to '" + file_.path + "'");
+      }
+    }
+  }
+
+  void epilog(char const*, std::size_t) {}
+
+  void part_end() {
+    if (parts_.back().kind == file_part) end_file();
+    parts_.pop_back();
+  }
+
+ private:
+  enum part_kind { envelope_part, field_part, file_part, other_part };
+
+  struct part {
+    part() : kind(other_part) {}
+    part_kind kind;
+    std::string disposition, content_type, name, filename;
+  };
+
+  void begin_file(part& current) {
+    current.kind = file_part;
+    file_ = form_file();
+    file_.name = current.name;
+    file_.filename = current.filename;
+    file_.content_type = current.content_type;
+    if (options_.file_handler()) return;
+
+    boost::filesystem::path path =
+        boost::filesystem::path(options_.spool_directory()) /
+        boost::filesystem::unique_path("cpp-netlib-upload-%%%%-%%%%-%%%%-%%%%");
+    file_.path = path.string();
+    spool_.open(file_.path.c_str(), std::ios::out | std::ios::binary);
+    if (!spool_) throw form_data_error("Can't create '" + file_.path + "'");
+  }
+
+  void end_file() {
+    if (options_.file_handler()) {
+      options_.file_handler()(file_, boost::string_ref());
+    } else {
+      spool_.close();
+      if (!spool_) throw form_data_error("Can't write to '" + file_.path + "'");
+    }
+    result_.files.push_back(file_);
+    file_ = form_file();
+  }
+
+  void remove_spooled_files() {
+    boost::system::error_code ignored;
+    if (spool_.is_open()) {
+      spool_.close();
+      boost::filesystem::remove(file_.path, ignored);
+    }
+    for (form_file const& file : result_.files)
+      if (!file.path.empty()) boost::filesystem::remove(file.path, ignored);
+  }
+
+  form_data_options options_;
+  form_data result_;
+  std::vector<part> parts_;
+  form_file file_;
+  std::ofstream spool_;
+  std::size_t field_size_;
+  std::size_t total_field_size_;
+  std::size_t parts_seen_;
+  bool failed_;
+  bool finished_;  // the spooled files belong to the caller
+  boost::mime::push_parser<form_data_decoder_pimpl> parser_;
+};
+
+form_data_decoder::form_data_decoder(boost::string_ref content_type,
+                                     form_data_options const& options)
+    : pimpl_(new form_data_decoder_pimpl(options)) {
+  pimpl_->start(content_type);
+}
+
+form_data_decoder::~form_data_decoder() {}
+
+void form_data_decoder::feed(boost::string_ref data) { pimpl_->feed(data); }
+
+void form_data_decoder::finish() { pimpl_->finish(); }
+
+form_data const& form_data_decoder::result() const { return pimpl_->result(); }
+
+}  // namespace http
+}  // namespace network
@@ -0,0 +1,145 @@
+// Copyright 2026 (c) agent <agent@local>
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_HTTP_SERVER_FORM_DATA_HPP_20261018
+#define NETWORK_HTTP_SERVER_FORM_DATA_HPP_20261018
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/utility/string_ref.hpp>
+
+namespace network {
+namespace http {
+
+// A file uploaded in a multipart/form-data body.
+struct form_file {
+  form_file() : size(0) {}
+
+  std::string name;          // the name of the form field
+  std::string filename;      // the name of the file, as sent by the client
+  std::string content_type;  // empty if the part had no Content-Type
+  std::string path;          // where the file was spooled; empty if it was
+                             // passed to a file handler
+  std::size_t size;
+};
+
+// The decoded form: the fields in the order they were sent, and the files.
+struct form_data {
+  std::vector<std::pair<std::string, std::string>> fields;
+  std::vector<form_file> files;
+};
+
+struct form_data_error : std::runtime_error {
+  explicit form_data_error(std::string const& what)
+      : std::runtime_error(what) {}
+};
+
+class form_data_options {
+ public:
+  // Called with each chunk of a file as it arrives, and then once with an
+  // empty chunk when the file is complete. The chunk is only valid during
+  // the call.
+  typedef std::function<void(form_file const&, boost::string_ref)>
+      file_handler_function;
+
+  form_data_options()
+      : max_field_size_(64 * 1024),
+        max_total_field_size_(1024 * 1024),
+        max_fields_(1000),
+        max_header_size_(16 * 1024) {}
+
+  // The directory where files are spooled when there is no file handler.
+  // Defaults to the system's temporary directory.
+  form_data_options& spool_directory(std::string const& directory) {
+    spool_directory_ = directory;
+    return *this;
+  }
+  std::string const& spool_directory() const { return spool_directory_; }
+
+  // The largest field kept in memory; a larger field is an error.
+  form_data_options& max_field_size(std::size_t size) {
+    max_field_size_ = size;
+    return *this;
+  }
+  std::size_t max_field_size() const { return max_field_size_; }
+
+  // The most bytes all the fields together may keep in memory.
+  form_data_options& max_total_field_size(std::size_t size) {
+    max_total_field_size_ = size;
+    return *this;
+  }
+  std::size_t max_total_field_size() const { return max_total_field_size_; }
+
+  // The most parts a form may have: fields, files, and the multipart/mixed
+  // parts that group files.
+  form_data_options& max_fields(std::size_t count) {
+    max_fields_ = count;
+    return *this;
+  }
+  std::size_t max_fields() const { return max_fields_; }
+
+  // The most bytes the headers of a single part may take.
+  form_data_options& max_header_size(std::size_t size) {
+    max_header_size_ = size;
+    return *this;
+  }
+  std::size_t max_header_size() const { return max_header_size_; }
+
+  // Passes the files to a handler instead of spooling them to disk.
+  form_data_options& file_handler(file_handler_function handler) {
+    file_handler_ = handler;
+    return *this;
+  }
+  file_handler_function const& file_handler() const { return file_handler_; }
+
+ private:
+  std::string spool_directory_;
+  std::size_t max_field_size_;
+  std::size_t max_total_field_size_;
+  std::size_t max_fields_;
+  std::size_t max_header_size_;
+  file_handler_function file_handler_;
+};
+
+class form_data_decoder_pimpl;
+
+// Decodes a multipart/form-data body that is fed in chunks of any size, as
+// it comes off the connection. Only the fields are kept in memory: each file
+// is written to a file in the spool directory, or passed to the file handler,
+// as it arrives. Once finish succeeds, the spooled files are the caller's to
+// remove; until then, the decoder removes them when it is destroyed, so that
+// a body that fails to decode, or is abandoned, leaves nothing behind.
+class form_data_decoder {
+ public:
+  // Throws form_data_error unless the content type is multipart/form-data
+  // with a boundary.
+  explicit form_data_decoder(boost::string_ref content_type,
+                             form_data_options const& options =
+                                 form_data_options());
+  ~form_data_decoder();
+
+  // Both throw form_data_error if the body is malformed, goes over one of
+  // the limits of the options, or a file can't be written.
+  void feed(boost::string_ref data);
+  void finish();
+
+  form_data const& result() const;
+
+ private:
+  form_data_decoder(form_data_decoder const&) = delete;
+  form_data_decoder& operator=(form_data_decoder const&) = delete;
+
+  std::unique_ptr<form_data_decoder_pimpl> pimpl_;
+};
+
+}  // namespace http
+}  // namespace network
+
+#endif /* end of include guard: NETWORK_HTTP_SERVER_FORM_DATA_HPP_20261018 */
@@ -3,6 +3,8 @@
 // (See accompanying file LICENSE_1_0.txt or copy at
 // http://www.boost.org/LICENSE_1_0.txt)
 
+#include <algorithm>
+#include <mutex>
 #include <boost/asio/strand.hpp>
 #include <boost/asio/deadline_timer.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -16,6 +18,11 @@
 #include <network/http/v2/client/response.hpp>
 #include <network/http/v2/client/connection/tcp_resolver.hpp>
 #include <network/http/v2/client/connection/normal_connection.hpp>
+#include <network/http/v2/client/connection/endpoint_selector.hpp>
+#ifdef NETWORK_ENABLE_HTTPS
+#include <network/http/v2/client/connection/ssl_connection.hpp>
+#include <network/http/v2/client/connection/kernel_tls_connection.hpp>
+#endif // NETWORK_ENABLE_HTTPS
 
 namespace network {
   namespace http {
@@ -36,6 +43,23 @@ namespace network {
 
         std::uint64_t total_bytes_written_, total_bytes_read_;
 
+        // The resolved endpoints, in the order given by the endpoint
+        // selector, and the one currently in use.
+        std::string host_;
+        std::vector<tcp::endpoint> endpoints_;
+        std::size_t endpoint_index_;
+        bool endpoint_in_use_;
+        std::chrono::steady_clock::time_point endpoint_start_;
+
+        // Lets the request through the circuit breaker and concurrency
+        // limit of its origin.
+        origin_permit origin_permit_;
+
+        // The time spent in each phase of the request.
+        request_timings timings_;
+        std::chrono::steady_clock::time_point start_, lap_start_;
+        bool finished_;
+
         request_context(
             std::shared_ptr<client_connection::async_connection> connection,
             request request, request_options options)
@@ -43,7 +67,29 @@ namespace network {
               request_(request),
               options_(options),
               total_bytes_written_(0),
-              total_bytes_read_(0) {}
+              total_bytes_read_(0),
+              endpoint_index_(0),
+              endpoint_in_use_(false),
+              start_(std::chrono::steady_clock::now()),
+              lap_start_(start_),
+              finished_(false) {}
+
+        // Adds the time since the last lap to a phase of the request.
+        void lap(std::chrono::microseconds request_timings::*phase) {
+          auto now = std::chrono::steady_clock::now();
+          timings_.*phase +=
+              std::chrono::duration_cast<std::chrono::microseconds>(now - lap_start_);
+          lap_start_ = now;
+        }
+
+        // Moves the connection's handshake from the connect phase, which
+        // includes it, to its own.
+        void move_handshake_time() {
+          auto handshake = std::min(connection_->handshake_duration(),
+                                    timings_.connect);
+          timings_.connect -= handshake;
+          timings_.tls_handshake += handshake;
+        }
       };
 
       struct client::impl {
@@ -68,6 +114,17 @@ namespace network {
                      tcp::resolver::iterator endpoint_iterator,
                      std::shared_ptr<request_context> context);
 
+        void connect_endpoint(std::shared_ptr<request_context> context);
+
+        void release_endpoint(std::shared_ptr<request_context> context,
+                              bool success);
+
+        void release_origin(std::shared_ptr<request_context> context,
+                            bool success);
+
+        void finish_timings(std::shared_ptr<request_context> context,
+                            bool success);
+
         void write_request(const boost::system::error_code &ec,
                            std::shared_ptr<request_context> context);
 
@@ -99,6 +156,13 @@ namespace network {
         boost::asio::io_service::strand strand_;
         std::unique_ptr<client_connection::async_resolver> resolver_;
         std::shared_ptr<client_connection::async_connection> mock_connection_;
+        std::unique_ptr<client_connection::endpoint_selector> selector_;
+        origin_guards origin_guards_;
+        mutable std::mutex metrics_mutex_;
+        client_metrics metrics_;
+#ifdef NETWORK_ENABLE_HTTPS
+        std::shared_ptr<client_connection::client_ssl_context> ssl_context_;
+#endif // NETWORK_ENABLE_HTTPS
         bool timedout_;
         boost::asio::deadline_timer timer_;
         std::thread lifetime_thread_;
@@ -111,6 +175,13 @@ namespace network {
             strand_(io_service_),
             resolver_(new client_connection::tcp_resolver(
                 io_service_, options_.cache_resolved())),
+            selector_(client_connection::make_endpoint_selector(options_)),
+            origin_guards_(options_.circuit_breaker(),
+                           options_.concurrency_limit()),
+#ifdef NETWORK_ENABLE_HTTPS
+            ssl_context_(std::make_shared<client_connection::client_ssl_context>(
+                options_)),
+#endif // NETWORK_ENABLE_HTTPS
             timedout_(false),
             timer_(io_service_),
             lifetime_thread_([=]() { io_service_.run(); }) {}
@@ -123,6 +194,10 @@ namespace network {
             sentinel_(new boost::asio::io_service::work(io_service_)),
             strand_(io_service_),
             resolver_(std::move(mock_resolver)),
+            mock_connection_(std::move(mock_connection)),
+            selector_(client_connection::make_endpoint_selector(options_)),
+            origin_guards_(options_.circuit_breaker(),
+                           options_.concurrency_limit()),
             timedout_(false),
             timer_(io_service_),
             lifetime_thread_([=]() { io_service_.run(); }) {}
@@ -135,6 +210,9 @@ namespace network {
 
       void client::impl::set_error(const boost::system::error_code &ec,
                                    std::shared_ptr<request_context> context) {
+        release_endpoint(context, false);
+        release_origin(context, false);
+        finish_timings(context, false);
         context->response_promise_.set_exception(std::make_exception_ptr(
             std::system_error(ec.value(), std::system_category())));
         timer_.cancel();
@@ -155,7 +233,20 @@ namespace network {
         auto host = url.host() ? uri::string_type(std::begin(*url.host()),
                                                   std::end(*url.host()))
                                : uri::string_type();
-        auto port = url.port<std::uint16_t>() ? *url.port<std::uint16_t>() : 80;
+        auto port = url.port<std::uint16_t>() ? *url.port<std::uint16_t>()
+                                               : (context->request_.is_https()? 443 : 80);
+
+        // Fail fast if the origin is failing or already has too many
+        // requests in progress.
+        auto origin = (context->request_.is_https()? "https://" : "http://") +
+                      host + ":" + std::to_string(port);
+        auto permit = origin_guards_.get(origin)->admit();
+        if (!permit) {
+          context->response_promise_.set_exception(
+              std::make_exception_ptr(client_exception(*permit.error())));
+          return res;
+        }
+        context->origin_permit_ = std::move(permit);
 
         resolver_->async_resolve(
             host, port,
@@ -190,19 +281,50 @@ namespace network {
           return;
         }
 
-        // make a connection to an endpoint
+        context->lap(&request_timings::resolve);
+
+        // order the resolved endpoints according to the load balancing
+        // policy
         auto host = context->request_.url().host();
-        tcp::endpoint endpoint(*endpoint_iterator);
+        if (!host) {
+          // Not the origin's fault, so it doesn't count against it.
+          release_origin(context, true);
+          finish_timings(context, false);
+          context->response_promise_.set_exception(std::make_exception_ptr(
+              client_exception(client_error::invalid_request)));
+          timer_.cancel();
+          return;
+        }
+        context->host_ = std::string(std::begin(*host), std::end(*host));
+        context->endpoints_ = selector_->select(context->host_, endpoint_iterator);
+        context->endpoint_index_ = 0;
+        if (context->endpoints_.empty()) {
+          set_error(boost::asio::error::host_not_found, context);
+          return;
+        }
+
+        connect_endpoint(context);
+      }
+
+      void client::impl::connect_endpoint(
+          std::shared_ptr<request_context> context) {
+        // make a connection to an endpoint
+        auto endpoint = context->endpoints_[context->endpoint_index_];
+        selector_->request_started(context->host_, endpoint);
+        context->endpoint_in_use_ = true;
+        context->endpoint_start_ = std::chrono::steady_clock::now();
         context->connection_->async_connect(
-            endpoint, std::string(std::begin(*host), std::end(*host)),
+            endpoint, context->host_,
             strand_.wrap([=](const boost::system::error_code &ec) {
+              context->lap(&request_timings::connect);
+              context->move_handshake_time();
+
               // If there is no connection, try again on another endpoint
-              if (ec && endpoint_iterator != tcp::resolver::iterator()) {
-                // copy iterator because it is const after the lambda
-                // capture
-                auto it = endpoint_iterator;
-                boost::system::error_code ignore;
-                connect(ignore, ++it, context);
+              if (ec && !timedout_ &&
+                  (context->endpoint_index_ + 1 < context->endpoints_.size())) {
+                release_endpoint(context, false);
+                ++context->endpoint_index_;
+                connect_endpoint(context);
                 return;
               }
 
@@ -210,6 +332,49 @@ namespace network {
             }));
       }
 
+      void client::impl::release_endpoint(
+          std::shared_ptr<request_context> context, bool success) {
+        if (!context->endpoint_in_use_) {
+          return;
+        }
+
+        context->endpoint_in_use_ = false;
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - context->endpoint_start_);
+        selector_->request_finished(
+            context->host_, context->endpoints_[context->endpoint_index_],
+            success, latency);
+      }
+
+      void client::impl::release_origin(
+          std::shared_ptr<request_context> context, bool success) {
+        context->origin_permit_.release(success);
+      }
+
+      void client::impl::finish_timings(
+          std::shared_ptr<request_context> context, bool success) {
+        if (context->finished_) {
+          return;
+        }
+
+        context->finished_ = true;
+        auto &timings = context->timings_;
+        timings.total = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - context->start_);
+        timings.bytes_written = context->total_bytes_written_;
+        timings.bytes_read = context->total_bytes_read_;
+        timings.success = success;
+
+        if (options_.collect_metrics()) {
+          std::lock_guard<std::mutex> lock(metrics_mutex_);
+          metrics_.record(timings);
+        }
+
+        if (auto handler = options_.timings()) {
+          handler(timings);
+        }
+      }
+
       void client::impl::write_request(
           const boost::system::error_code &ec,
           std::shared_ptr<request_context> context) {
@@ -295,6 +460,7 @@ namespace network {
           progress(client_message::transfer_direction::bytes_written,
                    context->total_bytes_written_);
         }
+        context->lap(&request_timings::write);
 
         // Create a response object and fill it with the status from the server.
         context->connection_->async_read_until(
@@ -318,6 +484,8 @@ namespace network {
           return;
         }
 
+        context->lap(&request_timings::time_to_first_byte);
+
         // Update the reponse status.
         std::istream is(&context->response_buffer_);
         string_type version;
@@ -430,6 +598,12 @@ namespace network {
 
         // If there's no data else to read, then set the response and exit.
         if (bytes_read == 0) {
+          // Server errors count as failures of the origin.
+          auto server_error = static_cast<int>(res->status()) >= 500;
+          release_endpoint(context, true);
+          release_origin(context, !server_error);
+          context->lap(&request_timings::body);
+          finish_timings(context, true);
           context->response_promise_.set_value(*res);
           timer_.cancel();
           return;
@@ -467,8 +641,22 @@ namespace network {
         std::shared_ptr<client_connection::async_connection> connection;
         if (pimpl_->mock_connection_) {
           connection = pimpl_->mock_connection_;
-        } else {
-          // TODO factory based on HTTP or HTTPS
+        }
+#ifdef NETWORK_ENABLE_HTTPS
+        else if (req.is_https()) {
+          // all SSL connections share the client's context and session
+          // cache
+          if (pimpl_->ssl_context_->kernel_tls()) {
+            connection = std::make_shared<client_connection::kernel_tls_connection>(
+                pimpl_->io_service_, pimpl_->ssl_context_);
+          }
+          else {
+            connection = std::make_shared<client_connection::ssl_connection>(
+                pimpl_->io_service_, pimpl_->ssl_context_);
+          }
+        }
+#endif // NETWORK_ENABLE_HTTPS
+        else {
           connection = std::make_shared<client_connection::normal_connection>(
               pimpl_->io_service_);
         }
@@ -507,6 +695,15 @@ namespace network {
         req.method(method::options);
         return execute(req, options);
       }
+
+      std::vector<origin_status> client::origins() const {
+        return pimpl_->origin_guards_.status();
+      }
+
+      client_metrics client::metrics() const {
+        std::lock_guard<std::mutex> lock(pimpl_->metrics_mutex_);
+        return pimpl_->metrics_;
+      }
     }  // namespace v2
   }    // namespace http
 }  // namespace network
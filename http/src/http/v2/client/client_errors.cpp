@@ -36,6 +36,10 @@ namespace network {
             return "Invalid HTTP request.";
           case client_error::invalid_response:
             return "Invalid HTTP response.";
+          case client_error::circuit_open:
+            return "The circuit breaker for this origin is open.";
+          case client_error::concurrency_limit_exceeded:
+            return "Too many requests in progress to this origin.";
           default:
             break;
         }
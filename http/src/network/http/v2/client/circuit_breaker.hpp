@@ -0,0 +1,982 @@
+// Copyright (C) 2026 agent (agent@local)
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_HTTP_V2_CLIENT_CIRCUIT_BREAKER_INC
+#define NETWORK_HTTP_V2_CLIENT_CIRCUIT_BREAKER_INC
+
+/**
+ * \file
+ * \brief Per-origin circuit breakers and concurrency limits, used by
+ *        the client to fail fast when a server is failing.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/optional.hpp>
+#include <network/config.hpp>
+#include <network/http/v2/client/client_errors.hpp>
+
+namespace network {
+namespace http {
+inline namespace v2 {
+/**
+ * \ingroup http_client
+ * \enum circuit_state network/http/v2/client/circuit_breaker.hpp network/http/v2/client.hpp
+ * \brief The state of a circuit breaker.
+ */
+enum class circuit_state {
+  closed, open, half_open,
+};
+
+/**
+ * \ingroup http_client
+ * \class circuit_breaker_options network/http/v2/client/circuit_breaker.hpp network/http/v2/client.hpp
+ * \brief A set of options to configure the circuit breaker of each
+ *        origin.
+ */
+class circuit_breaker_options {
+
+public:
+
+  /**
+   * \brief Constructor.
+   */
+  circuit_breaker_options()
+    : enabled_(false)
+    , window_size_(100)
+    , minimum_requests_(20)
+    , failure_rate_threshold_(0.5)
+    , slow_request_threshold_(0)
+    , open_time_(5000)
+    , half_open_requests_(1) { }
+
+  /**
+   * \brief Enables the circuit breaker.
+   * \returns \c *this
+   */
+  circuit_breaker_options &enabled(bool enabled) {
+    enabled_ = enabled;
+    return *this;
+  }
+
+  /**
+   * \brief Tests if the circuit breaker is enabled.
+   */
+  bool enabled() const {
+    return enabled_;
+  }
+
+  /**
+   * \brief Sets the number of recent requests from which the failure
+   *        rate is measured.
+   * \returns \c *this
+   */
+  circuit_breaker_options &window_size(std::size_t window_size) {
+    window_size_ = std::max<std::size_t>(window_size, 1);
+    return *this;
+  }
+
+  /**
+   * \brief Gets the number of recent requests from which the failure
+   *        rate is measured.
+   */
+  std::size_t window_size() const {
+    return window_size_;
+  }
+
+  /**
+   * \brief Sets the number of requests needed in the window before the
+   *        circuit can open.
+   * \returns \c *this
+   */
+  circuit_breaker_options &minimum_requests(std::size_t minimum_requests) {
+    minimum_requests_ = minimum_requests;
+    return *this;
+  }
+
+  /**
+   * \brief Gets the number of requests needed in the window before the
+   *        circuit can open.
+   */
+  std::size_t minimum_requests() const {
+    return minimum_requests_;
+  }
+
+  /**
+   * \brief Sets the failure rate, between 0 and 1, at which the circuit
+   *        opens.
+   * \returns \c *this
+   */
+  circuit_breaker_options &failure_rate_threshold(double threshold) {
+    failure_rate_threshold_ = threshold;
+    return *this;
+  }
+
+  /**
+   * \brief Gets the failure rate at which the circuit opens.
+   */
+  double failure_rate_threshold() const {
+    return failure_rate_threshold_;
+  }
+
+  /**
+   * \brief Sets the latency above which a successful request is
+   *        counted as a failure. Zero disables the latency check.
+   * \returns \c *this
+   */
+  circuit_breaker_options &slow_request_threshold(std::chrono::milliseconds threshold) {
+    slow_request_threshold_ = threshold;
+    return *this;
+  }
+
+  /**
+   * \brief Gets the latency above which a request is counted as a
+   *        failure.
+   */
+  std::chrono::milliseconds slow_request_threshold() const {
+    return slow_request_threshold_;
+  }
+
+  /**
+   * \brief Sets how long the circuit stays open before probing the
+   *        origin again.
+   * \returns \c *this
+   */
+  circuit_breaker_options &open_time(std::chrono::milliseconds open_time) {
+    open_time_ = open_time;
+    return *this;
+  }
+
+  /**
+   * \brief Gets how long the circuit stays open.
+   */
+  std::chrono::milliseconds open_time() const {
+    return open_time_;
+  }
+
+  /**
+   * \brief Sets the number of probe requests that must succeed in the
+   *        half-open state for the circuit to close.
+   * \returns \c *this
+   */
+  circuit_breaker_options &half_open_requests(std::size_t half_open_requests) {
+    half_open_requests_ = std::max<std::size_t>(half_open_requests, 1);
+    return *this;
+  }
+
+  /**
+   * \brief Gets the number of probe requests in the half-open state.
+   */
+  std::size_t half_open_requests() const {
+    return half_open_requests_;
+  }
+
+private:
+
+  bool enabled_;
+  std::size_t window_size_;
+  std::size_t minimum_requests_;
+  double failure_rate_threshold_;
+  std::chrono::milliseconds slow_request_threshold_;
+  std::chrono::milliseconds open_time_;
+  std::size_t half_open_requests_;
+
+};
+
+/**
+ * \ingroup http_client
+ * \class concurrency_limit_options network/http/v2/client/circuit_breaker.hpp network/http/v2/client.hpp
+ * \brief A set of options to configure the adaptive concurrency limit
+ *        of each origin.
+ */
+class concurrency_limit_options {
+
+public:
+
+  /**
+   * \brief Constructor.
+   */
+  concurrency_limit_options()
+    : enabled_(false)
+    , initial_limit_(20)
+    , min_limit_(1)
+    , max_limit_(1000)
+    , backoff_ratio_(0.9)
+    , rtt_tolerance_(2.0) { }
+
+  /**
+   * \brief Enables the concurrency limit.
+   * \returns \c *this
+   */
+  concurrency_limit_options &enabled(bool enabled) {
+    enabled_ = enabled;
+    return *this;
+  }
+
+  /**
+   * \brief Tests if the concurrency limit is enabled.
+   */
+  bool enabled() const {
+    return enabled_;
+  }
+
+  /**
+   * \brief Sets the initial number of concurrent requests.
+   * \returns \c *this
+   */
+  concurrency_limit_options &initial_limit(std::size_t limit) {
+    initial_limit_ = limit;
+    return *this;
+  }
+
+  /**
+   * \brief Gets the initial number of concurrent requests.
+   */
+  std::size_t initial_limit() const {
+    return initial_limit_;
+  }
+
+  /**
+   * \brief Sets the lowest number of concurrent requests.
+   * \returns \c *this
+   */
+  concurrency_limit_options &min_limit(std::size_t limit) {
+    min_limit_ = std::max<std::size_t>(limit, 1);
+    return *this;
+  }
+
+  /**
+   * \brief Gets the lowest number of concurrent requests.
+   */
+  std::size_t min_limit() const {
+    return min_limit_;
+  }
+
+  /**
+   * \brief Sets the highest number of concurrent requests.
+   * \returns \c *this
+   */
+  concurrency_limit_options &max_limit(std::size_t limit) {
+    max_limit_ = limit;
+    return *this;
+  }
+
+  /**
+   * \brief Gets the highest number of concurrent requests.
+   */
+  std::size_t max_limit() const {
+    return max_limit_;
+  }
+
+  /**
+   * \brief Sets the ratio by which the limit is multiplied when the
+   *        origin is congested.
+   * \returns \c *this
+   */
+  concurrency_limit_options &backoff_ratio(double ratio) {
+    backoff_ratio_ = ratio;
+    return *this;
+  }
+
+  /**
+   * \brief Gets the ratio by which the limit is multiplied when the
+   *        origin is congested.
+   */
+  double backoff_ratio() const {
+    return backoff_ratio_;
+  }
+
+  /**
+   * \brief Sets the multiple of the lowest observed round trip time
+   *        above which the origin is considered congested.
+   * \returns \c *this
+   */
+  concurrency_limit_options &rtt_tolerance(double tolerance) {
+    rtt_tolerance_ = tolerance;
+    return *this;
+  }
+
+  /**
+   * \brief Gets the multiple of the lowest observed round trip time
+   *        above which the origin is considered congested.
+   */
+  double rtt_tolerance() const {
+    return rtt_tolerance_;
+  }
+
+private:
+
+  bool enabled_;
+  std::size_t initial_limit_;
+  std::size_t min_limit_;
+  std::size_t max_limit_;
+  double backoff_ratio_;
+  double rtt_tolerance_;
+
+};
+
+class circuit_breaker;
+
+/**
+ * \ingroup http_client
+ * \class circuit_permit network/http/v2/client/circuit_breaker.hpp network/http/v2/client.hpp
+ * \brief Lets a single request through a circuit_breaker, and records
+ *        its outcome.
+ *
+ * A permit that is destroyed without recording an outcome, or being
+ * cancelled, counts as a failure, so that a half-open probe which is
+ * abandoned doesn't keep the circuit half-open for good.
+ */
+class circuit_permit {
+
+  circuit_permit(const circuit_permit &) = delete;
+  circuit_permit &operator = (const circuit_permit &) = delete;
+
+public:
+
+  /**
+   * \brief Constructor. The permit lets nothing through.
+   */
+  circuit_permit()
+    : breaker_(nullptr)
+    , generation_(0) { }
+
+  /**
+   * \brief Move constructor.
+   */
+  circuit_permit(circuit_permit &&other)
+    : breaker_(other.breaker_)
+    , generation_(other.generation_) {
+    other.breaker_ = nullptr;
+  }
+
+  /**
+   * \brief Move assignment. A permit that is replaced counts as a
+   *        failure.
+   */
+  circuit_permit &operator = (circuit_permit &&other) {
+    if (this != &other) {
+      abandon();
+      breaker_ = other.breaker_;
+      generation_ = other.generation_;
+      other.breaker_ = nullptr;
+    }
+    return *this;
+  }
+
+  /**
+   * \brief Destructor. Counts as a failure if no outcome was recorded.
+   */
+  ~circuit_permit() {
+    abandon();
+  }
+
+  /**
+   * \brief Tests if the request may be sent.
+   */
+  explicit operator bool () const {
+    return breaker_ != nullptr;
+  }
+
+  /**
+   * \brief Records the outcome of the request, and gives up the permit.
+   */
+  void record(bool success, std::chrono::microseconds latency,
+              std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+  /**
+   * \brief Gives up the permit of a request that was never sent.
+   */
+  void cancel();
+
+private:
+
+  friend class circuit_breaker;
+
+  circuit_permit(circuit_breaker *breaker, std::uint64_t generation)
+    : breaker_(breaker)
+    , generation_(generation) { }
+
+  void abandon() {
+    if (breaker_) {
+      record(false, std::chrono::microseconds(0));
+    }
+  }
+
+  circuit_breaker *breaker_;
+  std::uint64_t generation_;
+
+};
+
+/**
+ * \ingroup http_client
+ * \class circuit_breaker network/http/v2/client/circuit_breaker.hpp network/http/v2/client.hpp
+ * \brief Stops requests to an origin when too many recent requests
+ *        have failed.
+ *
+ * The breaker records the outcome of the last \c window_size requests.
+ * When at least \c minimum_requests have been recorded and the failure
+ * rate reaches \c failure_rate_threshold, the circuit opens and every
+ * request is refused for \c open_time. The circuit then becomes
+ * half-open and lets \c half_open_requests probes through: if they all
+ * succeed the circuit closes, and if one fails it opens again.
+ *
+ * Each change of state starts a new generation, and each permit is
+ * tagged with the generation that issued it: the outcome of a request
+ * that was let through before the last change is ignored, so that a
+ * slow request sent while the circuit was closed isn't taken for a
+ * probe.
+ */
+class circuit_breaker {
+
+  circuit_breaker(const circuit_breaker &) = delete;
+  circuit_breaker &operator = (const circuit_breaker &) = delete;
+
+public:
+
+  /**
+   * \typedef clock
+   */
+  typedef std::chrono::steady_clock clock;
+
+  /**
+   * \brief Constructor.
+   */
+  explicit circuit_breaker(circuit_breaker_options options)
+    : options_(options)
+    , state_(circuit_state::closed)
+    , outcomes_(options.window_size(), false)
+    , next_(0)
+    , recorded_(0)
+    , failures_(0)
+    , probes_(0)
+    , probe_successes_(0)
+    , generation_(0) { }
+
+  /**
+   * \brief Asks whether a request may be sent.
+   * \returns A permit that lets nothing through if the circuit is open.
+   */
+  circuit_permit try_acquire(clock::time_point now = clock::now()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!options_.enabled()) {
+      return circuit_permit(this, generation_);
+    }
+
+    if ((state_ == circuit_state::open) && (now >= open_until_)) {
+      state_ = circuit_state::half_open;
+      probes_ = 0;
+      probe_successes_ = 0;
+      ++generation_;
+    }
+
+    switch (state_) {
+    case circuit_state::closed:
+      return circuit_permit(this, generation_);
+    case circuit_state::half_open:
+      if (probes_ < options_.half_open_requests()) {
+        ++probes_;
+        return circuit_permit(this, generation_);
+      }
+      return circuit_permit();
+    case circuit_state::open:
+    default:
+      return circuit_permit();
+    }
+  }
+
+  /**
+   * \brief Gets the state of the circuit. An open circuit whose open
+   *        time is over is reported as half-open, as the next request
+   *        will find it.
+   */
+  circuit_state state(clock::time_point now = clock::now()) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if ((state_ == circuit_state::open) && (now >= open_until_)) {
+      return circuit_state::half_open;
+    }
+    return state_;
+  }
+
+  /**
+   * \brief Gets the failure rate over the recorded window.
+   */
+  double failure_rate() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rate();
+  }
+
+private:
+
+  friend class circuit_permit;
+
+  void record(std::uint64_t generation, bool success,
+              std::chrono::microseconds latency, clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!options_.enabled() || (generation != generation_)) {
+      return;
+    }
+
+    auto slow = (options_.slow_request_threshold().count() != 0) &&
+      (latency > options_.slow_request_threshold());
+    auto failed = !success || slow;
+
+    if (state_ == circuit_state::half_open) {
+      if (failed) {
+        trip(now);
+      }
+      else if (++probe_successes_ >= options_.half_open_requests()) {
+        reset();
+      }
+      return;
+    }
+
+    if (state_ == circuit_state::open) {
+      return;
+    }
+
+    if (recorded_ == outcomes_.size()) {
+      failures_ -= outcomes_[next_]? 1 : 0;
+    }
+    else {
+      ++recorded_;
+    }
+    outcomes_[next_] = failed;
+    failures_ += failed? 1 : 0;
+    next_ = (next_ + 1) % outcomes_.size();
+
+    if ((recorded_ >= options_.minimum_requests()) &&
+        (rate() >= options_.failure_rate_threshold())) {
+      trip(now);
+    }
+  }
+
+  void cancel(std::uint64_t generation) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if ((generation == generation_) &&
+        (state_ == circuit_state::half_open) && (probes_ != 0)) {
+      --probes_;
+    }
+  }
+
+  double rate() const {
+    return (recorded_ == 0)? 0.0 : static_cast<double>(failures_) / recorded_;
+  }
+
+  void trip(clock::time_point now) {
+    state_ = circuit_state::open;
+    open_until_ = now + options_.open_time();
+    ++generation_;
+  }
+
+  void reset() {
+    state_ = circuit_state::closed;
+    ++generation_;
+    std::fill(std::begin(outcomes_), std::end(outcomes_), false);
+    next_ = 0;
+    recorded_ = 0;
+    failures_ = 0;
+  }
+
+  circuit_breaker_options options_;
+  mutable std::mutex mutex_;
+  circuit_state state_;
+  std::vector<bool> outcomes_;
+  std::size_t next_, recorded_, failures_;
+  std::size_t probes_, probe_successes_;
+  std::uint64_t generation_;
+  clock::time_point open_until_;
+
+};
+
+inline
+void circuit_permit::record(bool success, std::chrono::microseconds latency,
+                            std::chrono::steady_clock::time_point now) {
+  if (breaker_) {
+    auto breaker = breaker_;
+    breaker_ = nullptr;
+    breaker->record(generation_, success, latency, now);
+  }
+}
+
+inline
+void circuit_permit::cancel() {
+  if (breaker_) {
+    auto breaker = breaker_;
+    breaker_ = nullptr;
+    breaker->cancel(generation_);
+  }
+}
+
+/**
+ * \ingroup http_client
+ * \class concurrency_limiter network/http/v2/client/circuit_breaker.hpp network/http/v2/client.hpp
+ * \brief Limits the number of requests in progress to an origin, and
+ *        adapts the limit to the observed round trip time.
+ *
+ * The limit grows additively, by one for each \c limit requests that
+ * complete without congestion, and shrinks multiplicatively by
+ * \c backoff_ratio when a request fails or its round trip time exceeds
+ * \c rtt_tolerance times the lowest round trip time observed.
+ */
+class concurrency_limiter {
+
+  concurrency_limiter(const concurrency_limiter &) = delete;
+  concurrency_limiter &operator = (const concurrency_limiter &) = delete;
+
+public:
+
+  /**
+   * \brief Constructor.
+   */
+  explicit concurrency_limiter(concurrency_limit_options options)
+    : options_(options)
+    , limit_(clamp(static_cast<double>(options.initial_limit())))
+    , in_flight_(0)
+    , samples_(0)
+    , min_rtt_(0) { }
+
+  /**
+   * \brief Asks whether another request may be sent.
+   * \returns \c false if the limit has been reached.
+   */
+  bool try_acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (options_.enabled() && (in_flight_ >= static_cast<std::size_t>(limit_))) {
+      return false;
+    }
+    ++in_flight_;
+    return true;
+  }
+
+  /**
+   * \brief Releases a request that was allowed by \c try_acquire.
+   * \param success \c true if the request succeeded.
+   * \param rtt The round trip time of the request.
+   */
+  void release(bool success, std::chrono::microseconds rtt) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (in_flight_ != 0) {
+      --in_flight_;
+    }
+
+    if (!options_.enabled()) {
+      return;
+    }
+
+    // Forget the lowest round trip time from time to time, so that the
+    // limit follows a change of route or of server capacity.
+    if (success && ((++samples_ % 1000 == 0) || (min_rtt_.count() == 0) || (rtt < min_rtt_))) {
+      min_rtt_ = rtt;
+    }
+
+    auto congested = !success ||
+      (rtt.count() > options_.rtt_tolerance() * min_rtt_.count());
+    if (congested) {
+      limit_ = clamp(limit_ * options_.backoff_ratio());
+    }
+    else {
+      limit_ = clamp(limit_ + 1.0 / limit_);
+    }
+  }
+
+  /**
+   * \brief Releases a request that was allowed by \c try_acquire but
+   *        never sent.
+   */
+  void cancel() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (in_flight_ != 0) {
+      --in_flight_;
+    }
+  }
+
+  /**
+   * \brief Gets the current limit.
+   */
+  std::size_t limit() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<std::size_t>(limit_);
+  }
+
+  /**
+   * \brief Gets the number of requests in progress.
+   */
+  std::size_t in_flight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+  }
+
+private:
+
+  double clamp(double limit) const {
+    return std::min(std::max(limit, static_cast<double>(options_.min_limit())),
+                    static_cast<double>(std::max(options_.max_limit(), options_.min_limit())));
+  }
+
+  concurrency_limit_options options_;
+  mutable std::mutex mutex_;
+  double limit_;
+  std::size_t in_flight_;
+  std::uint64_t samples_;
+  std::chrono::microseconds min_rtt_;
+
+};
+
+/**
+ * \ingroup http_client
+ * \class origin_status network/http/v2/client/circuit_breaker.hpp network/http/v2/client.hpp
+ * \brief A snapshot of the circuit breaker and concurrency limit of an
+ *        origin, for monitoring.
+ */
+struct origin_status {
+  std::string origin;
+  circuit_state state;
+  double failure_rate;
+  std::size_t in_flight;
+  std::size_t concurrency_limit;
+};
+
+class origin_guard;
+
+/**
+ * \ingroup http_client
+ * \class origin_permit network/http/v2/client/circuit_breaker.hpp network/http/v2/client.hpp
+ * \brief Lets a single request through the guard of an origin, and
+ *        records its outcome.
+ *
+ * A permit that is destroyed without being released counts as a failed
+ * request.
+ */
+class origin_permit {
+
+  origin_permit(const origin_permit &) = delete;
+  origin_permit &operator = (const origin_permit &) = delete;
+
+public:
+
+  /**
+   * \brief Constructor. The permit lets nothing through.
+   */
+  origin_permit() { }
+
+  /**
+   * \brief Move constructor.
+   */
+  origin_permit(origin_permit &&other)
+    : guard_(std::move(other.guard_))
+    , breaker_permit_(std::move(other.breaker_permit_))
+    , error_(other.error_)
+    , start_(other.start_) { }
+
+  /**
+   * \brief Move assignment. A permit that is replaced counts as a
+   *        failed request.
+   */
+  origin_permit &operator = (origin_permit &&other) {
+    if (this != &other) {
+      abandon();
+      guard_ = std::move(other.guard_);
+      breaker_permit_ = std::move(other.breaker_permit_);
+      error_ = other.error_;
+      start_ = other.start_;
+    }
+    return *this;
+  }
+
+  /**
+   * \brief Destructor. Counts as a failed request if the permit wasn't
+   *        released.
+   */
+  ~origin_permit() {
+    abandon();
+  }
+
+  /**
+   * \brief Tests if the request may be sent.
+   */
+  explicit operator bool () const {
+    return static_cast<bool>(guard_);
+  }
+
+  /**
+   * \brief Gets the reason the request was refused, if it was.
+   */
+  boost::optional<client_error> error() const {
+    return error_;
+  }
+
+  /**
+   * \brief Records the outcome of the request, and gives up the permit.
+   *        The latency is measured from the admission of the request.
+   */
+  void release(bool success);
+
+private:
+
+  friend class origin_guard;
+
+  void abandon() {
+    if (guard_) {
+      release(false);
+    }
+  }
+
+  std::shared_ptr<origin_guard> guard_;
+  circuit_permit breaker_permit_;
+  boost::optional<client_error> error_;
+  std::chrono::steady_clock::time_point start_;
+
+};
+
+/**
+ * \ingroup http_client
+ * \class origin_guard network/http/v2/client/circuit_breaker.hpp network/http/v2/client.hpp
+ * \brief Combines the circuit breaker and the concurrency limiter of a
+ *        single origin. Guards are shared, and each permit keeps its
+ *        guard alive.
+ */
+class origin_guard : public std::enable_shared_from_this<origin_guard> {
+
+  origin_guard(const origin_guard &) = delete;
+  origin_guard &operator = (const origin_guard &) = delete;
+
+public:
+
+  /**
+   * \brief Constructor.
+   */
+  origin_guard(circuit_breaker_options breaker_options,
+               concurrency_limit_options limit_options)
+    : breaker_(breaker_options)
+    , limiter_(limit_options) { }
+
+  /**
+   * \brief Asks whether a request may be sent to the origin.
+   * \returns A permit, which tells the reason if the request is
+   *          refused.
+   */
+  origin_permit admit() {
+    origin_permit permit;
+    auto breaker_permit = breaker_.try_acquire();
+    if (!breaker_permit) {
+      permit.error_ = client_error::circuit_open;
+      return permit;
+    }
+
+    if (!limiter_.try_acquire()) {
+      breaker_permit.cancel();
+      permit.error_ = client_error::concurrency_limit_exceeded;
+      return permit;
+    }
+
+    permit.guard_ = shared_from_this();
+    permit.breaker_permit_ = std::move(breaker_permit);
+    permit.start_ = std::chrono::steady_clock::now();
+    return permit;
+  }
+
+  /**
+   * \brief Gets a snapshot of the state of the origin.
+   */
+  origin_status status(const std::string &origin) const {
+    origin_status status;
+    status.origin = origin;
+    status.state = breaker_.state();
+    status.failure_rate = breaker_.failure_rate();
+    status.in_flight = limiter_.in_flight();
+    status.concurrency_limit = limiter_.limit();
+    return status;
+  }
+
+private:
+
+  friend class origin_permit;
+
+  circuit_breaker breaker_;
+  concurrency_limiter limiter_;
+
+};
+
+inline
+void origin_permit::release(bool success) {
+  if (!guard_) {
+    return;
+  }
+
+  auto guard = std::move(guard_);
+  auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start_);
+  breaker_permit_.record(success, latency);
+  guard->limiter_.release(success, latency);
+}
+
+/**
+ * \ingroup http_client
+ * \class origin_guards network/http/v2/client/circuit_breaker.hpp network/http/v2/client.hpp
+ * \brief The guards of every origin used by a client.
+ */
+class origin_guards {
+
+  origin_guards(const origin_guards &) = delete;
+  origin_guards &operator = (const origin_guards &) = delete;
+
+public:
+
+  /**
+   * \brief Constructor.
+   */
+  origin_guards(circuit_breaker_options breaker_options,
+                concurrency_limit_options limit_options)
+    : breaker_options_(breaker_options)
+    , limit_options_(limit_options) { }
+
+  /**
+   * \brief Gets the guard for an origin, creating it if necessary.
+   *        Origins that differ only in case share a guard.
+   */
+  std::shared_ptr<origin_guard> get(const std::string &origin) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &guard = guards_[boost::to_lower_copy(origin)];
+    if (!guard) {
+      guard = std::make_shared<origin_guard>(breaker_options_, limit_options_);
+    }
+    return guard;
+  }
+
+  /**
+   * \brief Gets a snapshot of the state of every origin.
+   */
+  std::vector<origin_status> status() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<origin_status> statuses;
+    statuses.reserve(guards_.size());
+    for (const auto &guard : guards_) {
+      statuses.push_back(guard.second->status(guard.first));
+    }
+    return statuses;
+  }
+
+private:
+
+  circuit_breaker_options breaker_options_;
+  concurrency_limit_options limit_options_;
+  mutable std::mutex mutex_;
+  std::map<std::string, std::shared_ptr<origin_guard>> guards_;
+
+};
+} // namespace v2
+} // namespace http
+} // namespace network
+
+#endif // NETWORK_HTTP_V2_CLIENT_CIRCUIT_BREAKER_INC
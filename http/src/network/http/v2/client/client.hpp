@@ -14,6 +14,7 @@
 #define NETWORK_HTTP_V2_CLIENT_CLIENT_INC
 
 #include <future>
+#include <functional>
 #include <memory>
 #include <cstdint>
 #include <algorithm>
@@ -25,6 +26,8 @@
 #include <network/version.hpp>
 #include <network/http/v2/client/request.hpp>
 #include <network/http/v2/client/response.hpp>
+#include <network/http/v2/client/circuit_breaker.hpp>
+#include <network/http/v2/client/request_metrics.hpp>
 
 namespace network {
 namespace http {
@@ -34,6 +37,16 @@ class async_resolver;
 class async_connection;
 } // namespace client_connection
 
+/**
+ * \ingroup http_client
+ * \enum load_balancing_policy network/http/v2/client/client.hpp network/http/v2/client.hpp
+ * \brief The policy used to choose between the endpoints of a host
+ *        that resolves to more than one address.
+ */
+enum class load_balancing_policy {
+  first_available, round_robin, least_outstanding, power_of_two_choices,
+};
+
 /**
  * \ingroup http_client
  * \class client_options network/http/v2/client/client.hpp network/http/v2/client.hpp
@@ -51,8 +64,13 @@ public:
     , cache_resolved_(false)
     , use_proxy_(false)
     , always_verify_peer_(false)
+    , kernel_tls_(false)
     , user_agent_(std::string("cpp-netlib/") + NETLIB_VERSION)
-    , timeout_(30000) { }
+    , timeout_(30000)
+    , load_balancing_(load_balancing_policy::first_available)
+    , max_endpoint_failures_(5)
+    , endpoint_ejection_time_(30000)
+    , collect_metrics_(false) { }
 
   /**
    * \brief Copy constructor.
@@ -86,10 +104,19 @@ public:
     swap(cache_resolved_, other.cache_resolved_);
     swap(use_proxy_, other.use_proxy_);
     swap(always_verify_peer_, other.always_verify_peer_);
+    swap(kernel_tls_, other.kernel_tls_);
     swap(user_agent_, other.user_agent_);
     swap(timeout_, other.timeout_);
     swap(openssl_certificate_paths_, other.openssl_certificate_paths_);
     swap(openssl_verify_paths_, other.openssl_verify_paths_);
+    swap(alpn_protocols_, other.alpn_protocols_);
+    swap(load_balancing_, other.load_balancing_);
+    swap(max_endpoint_failures_, other.max_endpoint_failures_);
+    swap(endpoint_ejection_time_, other.endpoint_ejection_time_);
+    swap(circuit_breaker_, other.circuit_breaker_);
+    swap(concurrency_limit_, other.concurrency_limit_);
+    swap(collect_metrics_, other.collect_metrics_);
+    swap(timings_handler_, other.timings_handler_);
   }
 
   /**
@@ -207,6 +234,25 @@ public:
     return openssl_verify_paths_;
   }
 
+  /**
+   * \brief Adds a protocol to offer during TLS application layer
+   *        protocol negotiation (ALPN), in order of preference.
+   * \param protocol The protocol name, e.g. \c "http/1.1".
+   * \returns \c *this
+   */
+  client_options &alpn_protocol(std::string protocol) {
+    alpn_protocols_.emplace_back(std::move(protocol));
+    return *this;
+  }
+
+  /**
+   * \brief Returns the list of protocols offered during ALPN.
+   * \returns A list of protocol names.
+   */
+  std::vector<std::string> alpn_protocols() const {
+    return alpn_protocols_;
+  }
+
   /**
    * \brief
    * \returns \c *this
@@ -224,6 +270,32 @@ public:
     return always_verify_peer_;
   }
 
+  /**
+   * \brief Tells the client to offload TLS record encryption to the
+   *        kernel (kTLS) on Linux, when the kernel and the negotiated
+   *        cipher support it.
+   *
+   * HTTPS connections then run OpenSSL on the socket rather than through
+   * asio's SSL stream, and fall back to encrypting in user space when
+   * kernel TLS isn't available.
+   * \param kernel_tls If \c true, then the client must try to use
+   *        kernel TLS, if \c false it doesn't.
+   * \returns \c *this
+   */
+  client_options &kernel_tls(bool kernel_tls) {
+    kernel_tls_ = kernel_tls;
+    return *this;
+  }
+
+  /**
+   * \brief Tests if the client tries to use kernel TLS.
+   * \returns \c true if the client tries to use kernel TLS, \c false
+   *          otherwise.
+   */
+  bool kernel_tls() const {
+    return kernel_tls_;
+  }
+
   /**
    * \brief
    * \returns \c *this
@@ -241,16 +313,160 @@ public:
     return user_agent_;
   }
 
+  /**
+   * \brief Sets the policy used to choose between the resolved
+   *        endpoints of a host.
+   * \param policy The load balancing policy.
+   * \returns \c *this
+   */
+  client_options &load_balancing(load_balancing_policy policy) {
+    load_balancing_ = policy;
+    return *this;
+  }
+
+  /**
+   * \brief Gets the load balancing policy.
+   * \returns The load balancing policy.
+   */
+  load_balancing_policy load_balancing() const {
+    return load_balancing_;
+  }
+
+  /**
+   * \brief Sets the number of consecutive failures after which an
+   *        endpoint is ejected.
+   * \param max_failures The number of consecutive failures.
+   * \returns \c *this
+   */
+  client_options &max_endpoint_failures(std::size_t max_failures) {
+    max_endpoint_failures_ = max_failures;
+    return *this;
+  }
+
+  /**
+   * \brief Gets the number of consecutive failures after which an
+   *        endpoint is ejected.
+   * \returns The number of consecutive failures.
+   */
+  std::size_t max_endpoint_failures() const {
+    return max_endpoint_failures_;
+  }
+
+  /**
+   * \brief Sets the length of time an ejected endpoint is avoided.
+   * \param ejection_time The ejection time in milliseconds.
+   * \returns \c *this
+   */
+  client_options &endpoint_ejection_time(std::chrono::milliseconds ejection_time) {
+    endpoint_ejection_time_ = ejection_time;
+    return *this;
+  }
+
+  /**
+   * \brief Gets the length of time an ejected endpoint is avoided.
+   * \returns The ejection time in milliseconds.
+   */
+  std::chrono::milliseconds endpoint_ejection_time() const {
+    return endpoint_ejection_time_;
+  }
+
+  /**
+   * \brief Sets the options of the circuit breaker used for each
+   *        origin.
+   * \param options The circuit breaker options.
+   * \returns \c *this
+   */
+  client_options &circuit_breaker(circuit_breaker_options options) {
+    circuit_breaker_ = options;
+    return *this;
+  }
+
+  /**
+   * \brief Gets the circuit breaker options.
+   * \returns The circuit breaker options.
+   */
+  circuit_breaker_options circuit_breaker() const {
+    return circuit_breaker_;
+  }
+
+  /**
+   * \brief Sets the options of the concurrency limit used for each
+   *        origin.
+   * \param options The concurrency limit options.
+   * \returns \c *this
+   */
+  client_options &concurrency_limit(concurrency_limit_options options) {
+    concurrency_limit_ = options;
+    return *this;
+  }
+
+  /**
+   * \brief Gets the concurrency limit options.
+   * \returns The concurrency limit options.
+   */
+  concurrency_limit_options concurrency_limit() const {
+    return concurrency_limit_;
+  }
+
+  /**
+   * \brief Tells the client to aggregate request timings into
+   *        histograms.
+   * \param collect_metrics If \c true, then the client must
+   *        collect metrics, if \c false it doesn't.
+   * \returns \c *this
+   */
+  client_options &collect_metrics(bool collect_metrics) {
+    collect_metrics_ = collect_metrics;
+    return *this;
+  }
+
+  /**
+   * \brief Tests if the client collects metrics.
+   * \returns \c true if the client collects metrics, \c false
+   *          otherwise.
+   */
+  bool collect_metrics() const {
+    return collect_metrics_;
+  }
+
+  /**
+   * \brief Sets a handler called with the timings of each request
+   *        when it completes.
+   * \param handler The handler, called on the client's I/O thread.
+   * \returns \c *this
+   */
+  client_options &timings(std::function<void (const request_timings &)> handler) {
+    timings_handler_ = handler;
+    return *this;
+  }
+
+  /**
+   * \brief Gets the request timings handler.
+   * \returns The request timings handler.
+   */
+  std::function<void (const request_timings &)> timings() const {
+    return timings_handler_;
+  }
+
 private:
 
   bool follow_redirects_;
   bool cache_resolved_;
   bool use_proxy_;
   bool always_verify_peer_;
+  bool kernel_tls_;
   std::string user_agent_;
   std::chrono::milliseconds timeout_;
   std::vector<std::string> openssl_certificate_paths_;
   std::vector<std::string> openssl_verify_paths_;
+  std::vector<std::string> alpn_protocols_;
+  load_balancing_policy load_balancing_;
+  std::size_t max_endpoint_failures_;
+  std::chrono::milliseconds endpoint_ejection_time_;
+  circuit_breaker_options circuit_breaker_;
+  concurrency_limit_options concurrency_limit_;
+  bool collect_metrics_;
+  std::function<void (const request_timings &)> timings_handler_;
 
 };
 
@@ -351,6 +567,20 @@ public:
    */
   std::future<response> options(request req, request_options options = request_options());
 
+  /**
+   * \brief Gets the circuit breaker state and concurrency limit of
+   *        every origin used by this client.
+   * \returns A list of origin states.
+   */
+  std::vector<origin_status> origins() const;
+
+  /**
+   * \brief Gets the request timings aggregated by this client.
+   * \returns The client metrics, empty unless
+   *          client_options::collect_metrics is set.
+   */
+  client_metrics metrics() const;
+
 private:
 
   struct impl;
@@ -30,6 +30,10 @@ enum class client_error {
 
   // response
   invalid_response,
+
+  // origin
+  circuit_open,
+  concurrency_limit_exceeded,
 };
 
 /**
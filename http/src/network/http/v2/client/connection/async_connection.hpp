@@ -11,6 +11,7 @@
  * \brief
  */
 
+#include <chrono>
 #include <functional>
 #include <string>
 #include <boost/asio/ip/tcp.hpp>
@@ -94,6 +95,16 @@ namespace network {
           virtual void async_read(boost::asio::streambuf &command_streambuf,
                                   read_callback callback) = 0;
 
+          /**
+           * \brief Gets the time the last \c async_connect spent in a
+           *        handshake after the socket was connected, such as a
+           *        TLS handshake.
+           * \returns The duration, or zero if there was none.
+           */
+          virtual std::chrono::microseconds handshake_duration() const {
+            return std::chrono::microseconds(0);
+          }
+
           /**
            * \brief Breaks the connection.
            */
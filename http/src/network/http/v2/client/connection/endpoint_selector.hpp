@@ -0,0 +1,454 @@
+// Copyright (C) 2026 agent (agent@local)
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_HTTP_V2_CLIENT_CONNECTION_ENDPOINT_SELECTOR_INC
+#define NETWORK_HTTP_V2_CLIENT_CONNECTION_ENDPOINT_SELECTOR_INC
+
+/**
+ * \file
+ * \brief Endpoint selection policies used to balance requests across
+ *        the addresses returned by the resolver.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <network/config.hpp>
+#include <network/http/v2/client/client.hpp>
+
+namespace network {
+  namespace http {
+    inline namespace v2 {
+      namespace client_connection {
+        /**
+         * \class endpoint_health network/http/v2/client/connection/endpoint_selector.hpp
+         * \brief The health of a single resolved endpoint, as observed by
+         *        the client.
+         */
+        struct endpoint_health {
+
+          /**
+           * \typedef clock
+           */
+          typedef std::chrono::steady_clock clock;
+
+          explicit endpoint_health(const boost::asio::ip::tcp::endpoint &endpoint)
+            : endpoint(endpoint)
+            , outstanding(0)
+            , latency(0)
+            , consecutive_failures(0)
+            , ejected_until() { }
+
+          /**
+           * \brief Tests if the endpoint is currently ejected.
+           */
+          bool ejected(clock::time_point now) const {
+            return now < ejected_until;
+          }
+
+          boost::asio::ip::tcp::endpoint endpoint;
+
+          /**
+           * \brief The number of requests currently using this endpoint.
+           */
+          std::size_t outstanding;
+
+          /**
+           * \brief An exponentially weighted moving average of the
+           *        request latency.
+           */
+          std::chrono::duration<double, std::micro> latency;
+
+          /**
+           * \brief The number of failures since the last success.
+           */
+          std::size_t consecutive_failures;
+
+          /**
+           * \brief The endpoint is not preferred until this time.
+           */
+          clock::time_point ejected_until;
+
+        };
+
+        /**
+         * \class endpoint_selector network/http/v2/client/connection/endpoint_selector.hpp
+         * \brief Chooses the order in which resolved endpoints are tried,
+         *        and tracks their health.
+         *
+         * An endpoint that fails \c max_failures consecutive times is
+         * ejected for \c ejection_time: it is moved to the back of the
+         * list so that it is only tried when every other endpoint has
+         * failed.  Once the ejection time has passed, the endpoint is
+         * selected again and is ejected again on its next failure.
+         */
+        class endpoint_selector {
+
+          endpoint_selector(const endpoint_selector &) = delete;
+          endpoint_selector &operator = (const endpoint_selector &) = delete;
+
+        public:
+
+          /**
+           * \typedef resolver_iterator
+           */
+          typedef boost::asio::ip::tcp::resolver::iterator resolver_iterator;
+
+          /**
+           * \typedef clock
+           */
+          typedef endpoint_health::clock clock;
+
+          /**
+           * \brief Constructor.
+           * \param max_failures The number of consecutive failures after
+           *        which an endpoint is ejected.
+           * \param ejection_time The length of time an endpoint is ejected.
+           */
+          explicit endpoint_selector(std::size_t max_failures = 5,
+                                     std::chrono::milliseconds ejection_time =
+                                     std::chrono::milliseconds(30000))
+            : max_failures_(max_failures)
+            , ejection_time_(ejection_time) { }
+
+          /**
+           * \brief Destructor.
+           */
+          virtual ~endpoint_selector() noexcept { }
+
+          /**
+           * \brief Returns the endpoints for a host in the order in which
+           *        they should be tried.
+           * \param host The host name.
+           * \param endpoints The endpoints returned by the resolver.
+           */
+          std::vector<boost::asio::ip::tcp::endpoint>
+          select(const std::string &host,
+                 const std::vector<boost::asio::ip::tcp::endpoint> &endpoints) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto &entries = hosts_[boost::to_lower_copy(host)];
+            update(entries, endpoints);
+
+            auto now = clock::now();
+            std::vector<endpoint_health *> candidates, ejected;
+            for (auto &entry : entries) {
+              if (entry.ejected(now)) {
+                ejected.push_back(&entry);
+              }
+              else {
+                candidates.push_back(&entry);
+              }
+            }
+
+            if (!candidates.empty()) {
+              order(host, candidates);
+            }
+
+            std::stable_sort(std::begin(ejected), std::end(ejected),
+                             [] (const endpoint_health *lhs, const endpoint_health *rhs) {
+                               return lhs->ejected_until < rhs->ejected_until;
+                             });
+
+            std::vector<boost::asio::ip::tcp::endpoint> selected;
+            selected.reserve(entries.size());
+            for (auto entry : candidates) {
+              selected.push_back(entry->endpoint);
+            }
+            for (auto entry : ejected) {
+              selected.push_back(entry->endpoint);
+            }
+            return selected;
+          }
+
+          /**
+           * \brief Returns the endpoints for a host in the order in which
+           *        they should be tried.
+           * \param host The host name.
+           * \param endpoint_iterator The resolver result.
+           */
+          std::vector<boost::asio::ip::tcp::endpoint>
+          select(const std::string &host, resolver_iterator endpoint_iterator) {
+            std::vector<boost::asio::ip::tcp::endpoint> endpoints;
+            for (; endpoint_iterator != resolver_iterator(); ++endpoint_iterator) {
+              endpoints.push_back(endpoint_iterator->endpoint());
+            }
+            return select(host, endpoints);
+          }
+
+          /**
+           * \brief Records that a request has started on an endpoint.
+           */
+          void request_started(const std::string &host,
+                               const boost::asio::ip::tcp::endpoint &endpoint) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (auto entry = find(host, endpoint)) {
+              ++entry->outstanding;
+            }
+          }
+
+          /**
+           * \brief Records that a request has finished on an endpoint.
+           * \param host The host name.
+           * \param endpoint The endpoint used by the request.
+           * \param success \c true if the request succeeded.
+           * \param latency The time taken by the request.
+           */
+          void request_finished(const std::string &host,
+                                const boost::asio::ip::tcp::endpoint &endpoint,
+                                bool success,
+                                std::chrono::microseconds latency) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto entry = find(host, endpoint);
+            if (!entry) {
+              return;
+            }
+
+            if (entry->outstanding != 0) {
+              --entry->outstanding;
+            }
+
+            if (success) {
+              static const double alpha = 0.3;
+              entry->latency = (entry->latency.count() == 0)?
+                latency : (entry->latency + alpha * (latency - entry->latency));
+              entry->consecutive_failures = 0;
+            }
+            else if (++entry->consecutive_failures >= max_failures_) {
+              entry->ejected_until = clock::now() + ejection_time_;
+            }
+          }
+
+          /**
+           * \brief Returns a snapshot of the health of each endpoint
+           *        known for a host.
+           */
+          std::vector<endpoint_health> health(const std::string &host) const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = hosts_.find(boost::to_lower_copy(host));
+            if (it == hosts_.end()) {
+              return std::vector<endpoint_health>();
+            }
+            return it->second;
+          }
+
+        protected:
+
+          /**
+           * \brief Orders the healthy endpoints of a host, the preferred
+           *        endpoint first.
+           * \param host The host name.
+           * \param candidates A non-empty list of endpoints that are not
+           *        ejected, in resolver order.
+           */
+          virtual void order(const std::string &host,
+                             std::vector<endpoint_health *> &candidates) = 0;
+
+        private:
+
+          void update(std::vector<endpoint_health> &entries,
+                      const std::vector<boost::asio::ip::tcp::endpoint> &endpoints) {
+            // Keep the state of endpoints that are still resolved, in
+            // the order given by the resolver.
+            std::vector<endpoint_health> updated;
+            updated.reserve(endpoints.size());
+            for (const auto &endpoint : endpoints) {
+              auto it = std::find_if(std::begin(entries), std::end(entries),
+                                     [&endpoint] (const endpoint_health &entry) {
+                                       return entry.endpoint == endpoint;
+                                     });
+              if (it != std::end(entries)) {
+                updated.push_back(*it);
+              }
+              else {
+                updated.push_back(endpoint_health(endpoint));
+              }
+            }
+            entries.swap(updated);
+          }
+
+          endpoint_health *find(const std::string &host,
+                                const boost::asio::ip::tcp::endpoint &endpoint) {
+            auto it = hosts_.find(boost::to_lower_copy(host));
+            if (it == hosts_.end()) {
+              return nullptr;
+            }
+
+            for (auto &entry : it->second) {
+              if (entry.endpoint == endpoint) {
+                return &entry;
+              }
+            }
+            return nullptr;
+          }
+
+          std::size_t max_failures_;
+          std::chrono::milliseconds ejection_time_;
+          mutable std::mutex mutex_;
+          std::unordered_map<std::string, std::vector<endpoint_health>> hosts_;
+
+        };
+
+        /**
+         * \class first_available_selector network/http/v2/client/connection/endpoint_selector.hpp
+         * \brief Tries the endpoints in the order given by the resolver.
+         */
+        class first_available_selector : public endpoint_selector {
+
+        public:
+
+          using endpoint_selector::endpoint_selector;
+
+          virtual ~first_available_selector() noexcept { }
+
+        protected:
+
+          virtual void order(const std::string &,
+                             std::vector<endpoint_health *> &) { }
+
+        };
+
+        /**
+         * \class round_robin_selector network/http/v2/client/connection/endpoint_selector.hpp
+         * \brief Rotates through the endpoints of each host.
+         */
+        class round_robin_selector : public endpoint_selector {
+
+        public:
+
+          using endpoint_selector::endpoint_selector;
+
+          virtual ~round_robin_selector() noexcept { }
+
+        protected:
+
+          virtual void order(const std::string &host,
+                             std::vector<endpoint_health *> &candidates) {
+            auto &next = next_[boost::to_lower_copy(host)];
+            auto first = next++ % candidates.size();
+            std::rotate(std::begin(candidates),
+                        std::begin(candidates) + first,
+                        std::end(candidates));
+          }
+
+        private:
+
+          std::unordered_map<std::string, std::size_t> next_;
+
+        };
+
+        /**
+         * \class least_outstanding_selector network/http/v2/client/connection/endpoint_selector.hpp
+         * \brief Prefers the endpoints with the fewest requests in
+         *        progress.
+         */
+        class least_outstanding_selector : public endpoint_selector {
+
+        public:
+
+          using endpoint_selector::endpoint_selector;
+
+          virtual ~least_outstanding_selector() noexcept { }
+
+        protected:
+
+          virtual void order(const std::string &,
+                             std::vector<endpoint_health *> &candidates) {
+            std::stable_sort(std::begin(candidates), std::end(candidates),
+                             [] (const endpoint_health *lhs, const endpoint_health *rhs) {
+                               return lhs->outstanding < rhs->outstanding;
+                             });
+          }
+
+        };
+
+        /**
+         * \class power_of_two_choices_selector network/http/v2/client/connection/endpoint_selector.hpp
+         * \brief Picks two endpoints at random and prefers the one with
+         *        the lower expected cost, which is the latency moving
+         *        average weighted by the number of requests in progress.
+         *
+         * Endpoints with no latency sample yet have zero cost, so that
+         * new endpoints are explored first.
+         */
+        class power_of_two_choices_selector : public endpoint_selector {
+
+        public:
+
+          explicit power_of_two_choices_selector(std::size_t max_failures = 5,
+                                                 std::chrono::milliseconds ejection_time =
+                                                 std::chrono::milliseconds(30000),
+                                                 std::uint32_t seed = std::random_device()())
+            : endpoint_selector(max_failures, ejection_time)
+            , engine_(seed) { }
+
+          virtual ~power_of_two_choices_selector() noexcept { }
+
+        protected:
+
+          virtual void order(const std::string &,
+                             std::vector<endpoint_health *> &candidates) {
+            if (candidates.size() < 2) {
+              return;
+            }
+
+            std::uniform_int_distribution<std::size_t> distribution(0, candidates.size() - 1);
+            auto first = distribution(engine_);
+            auto second = distribution(engine_);
+            while (second == first) {
+              second = distribution(engine_);
+            }
+
+            auto chosen = (cost(*candidates[second]) < cost(*candidates[first]))? second : first;
+            std::swap(candidates[0], candidates[chosen]);
+          }
+
+        private:
+
+          static double cost(const endpoint_health &entry) {
+            return entry.latency.count() * (entry.outstanding + 1);
+          }
+
+          std::minstd_rand engine_;
+
+        };
+
+        /**
+         * \brief Creates an endpoint selector for a load balancing policy.
+         * \param options The client options.
+         */
+        inline
+        std::unique_ptr<endpoint_selector> make_endpoint_selector(const client_options &options) {
+          auto max_failures = options.max_endpoint_failures();
+          auto ejection_time = options.endpoint_ejection_time();
+          switch (options.load_balancing()) {
+          case load_balancing_policy::round_robin:
+            return std::unique_ptr<endpoint_selector>(
+                new round_robin_selector(max_failures, ejection_time));
+          case load_balancing_policy::least_outstanding:
+            return std::unique_ptr<endpoint_selector>(
+                new least_outstanding_selector(max_failures, ejection_time));
+          case load_balancing_policy::power_of_two_choices:
+            return std::unique_ptr<endpoint_selector>(
+                new power_of_two_choices_selector(max_failures, ejection_time));
+          case load_balancing_policy::first_available:
+          default:
+            return std::unique_ptr<endpoint_selector>(
+                new first_available_selector(max_failures, ejection_time));
+          }
+        }
+      } // namespace client_connection
+    } // namespace v2
+  } // namespace http
+} // namespace network
+
+#endif // NETWORK_HTTP_V2_CLIENT_CONNECTION_ENDPOINT_SELECTOR_INC
@@ -0,0 +1,450 @@
+// Copyright (C) 2026 agent (agent@local)
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_HTTP_V2_CLIENT_CONNECTION_KERNEL_TLS_CONNECTION_INC
+#define NETWORK_HTTP_V2_CLIENT_CONNECTION_KERNEL_TLS_CONNECTION_INC
+
+/**
+ * \file
+ * \brief A TLS connection on which OpenSSL can hand record encryption to
+ *        the kernel.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <boost/asio/write.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/ssl/error.hpp>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+#include <network/config.hpp>
+#include <network/http/v2/client/connection/async_connection.hpp>
+#include <network/http/v2/client/connection/ssl_context.hpp>
+
+namespace network {
+  namespace http {
+    inline namespace v2 {
+      namespace client_connection {
+      /**
+       * \class kernel_tls_connection network/http/v2/client/connection/kernel_tls_connection.hpp
+       * \brief Manages a TLS connection with OpenSSL working on the socket
+       *        itself.
+       *
+       * asio's SSL stream feeds OpenSSL through memory buffers, and
+       * OpenSSL only enables kernel TLS (kTLS) on a socket.  This
+       * connection gives OpenSSL the socket, so that, with a context that
+       * asks for kernel TLS, OpenSSL installs the session keys in the
+       * kernel after the handshake and then sends and receives plain text
+       * on the socket.  OpenSSL keeps encrypting in user space when the
+       * kernel, its build or the negotiated cipher doesn't support it.
+       *
+       * The socket is non-blocking: whenever OpenSSL needs to read or
+       * write, the connection waits for the socket to be ready and tries
+       * again.
+       */
+      class kernel_tls_connection : public async_connection {
+
+        kernel_tls_connection(const kernel_tls_connection &) = delete;
+        kernel_tls_connection &operator = (const kernel_tls_connection &) = delete;
+
+      public:
+
+        /**
+         * \brief Constructor.
+         * \param io_service The I/O service.
+         * \param context The SSL context shared by the client's
+         *        connections.
+         */
+        kernel_tls_connection(boost::asio::io_service &io_service,
+                              std::shared_ptr<client_ssl_context> context)
+          : socket_(io_service)
+          , stream_(*this)
+          , context_(context)
+          , handshake_duration_(0)
+          , session_reused_(false)
+          , kernel_tls_send_(false)
+          , kernel_tls_recv_(false) {
+
+        }
+
+        /**
+         * \brief Destructor.
+         */
+        virtual ~kernel_tls_connection() noexcept {
+
+        }
+
+        virtual void async_connect(const boost::asio::ip::tcp::endpoint &endpoint,
+                                   const std::string &host,
+                                   connect_callback callback) {
+          host_ = host;
+          handshake_duration_ = std::chrono::microseconds(0);
+          session_reused_ = false;
+          kernel_tls_send_ = false;
+          kernel_tls_recv_ = false;
+          negotiated_protocol_.clear();
+          boost::system::error_code ec;
+          socket_.close(ec);
+          ssl_.reset(SSL_new(context_->context().native_handle()));
+          if (!ssl_) {
+            boost::asio::post(socket_.get_executor(), [=] () {
+                callback(boost::asio::error::no_memory);
+              });
+            return;
+          }
+          context_->prepare(ssl_.get(), host_);
+          if (context_->verify_peer()) {
+            X509_VERIFY_PARAM_set1_host(SSL_get0_param(ssl_.get()), host_.c_str(), 0);
+          }
+
+          socket_.async_connect(endpoint,
+                                [=] (const boost::system::error_code &ec) {
+                                  handle_connected(ec, callback);
+                                });
+        }
+
+        virtual void async_write(boost::asio::streambuf &command_streambuf,
+                                 write_callback callback) {
+          boost::asio::async_write(stream_, command_streambuf, callback);
+        }
+
+        virtual void async_read_until(boost::asio::streambuf &command_streambuf,
+                                      const std::string &delim,
+                                      read_callback callback) {
+          boost::asio::async_read_until(stream_, command_streambuf, delim, callback);
+        }
+
+        virtual void async_read(boost::asio::streambuf &command_streambuf,
+                                read_callback callback) {
+          boost::asio::async_read(stream_, command_streambuf,
+                                  boost::asio::transfer_at_least(1), callback);
+        }
+
+        virtual void disconnect() {
+          if (socket_.is_open()) {
+            boost::system::error_code ec;
+            socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+            if (!ec) {
+              socket_.close(ec);
+            }
+          }
+        }
+
+        virtual void cancel() {
+          socket_.cancel();
+        }
+
+        virtual std::chrono::microseconds handshake_duration() const {
+          return handshake_duration_;
+        }
+
+        /**
+         * \brief Tests if the last handshake resumed a cached session.
+         */
+        bool session_reused() const {
+          return session_reused_;
+        }
+
+        /**
+         * \brief Gets the protocol selected by the server during ALPN.
+         * \returns The protocol name, or an empty string if none was
+         *          negotiated.
+         */
+        std::string negotiated_protocol() const {
+          return negotiated_protocol_;
+        }
+
+        /**
+         * \brief Tests if the kernel encrypts what is written.
+         */
+        bool kernel_tls_send() const {
+          return kernel_tls_send_;
+        }
+
+        /**
+         * \brief Tests if the kernel decrypts what is read.
+         */
+        bool kernel_tls_recv() const {
+          return kernel_tls_recv_;
+        }
+
+        /**
+         * \brief Gets the OpenSSL connection, or \c nullptr before the
+         *        first \c async_connect.
+         */
+        SSL *native_handle() {
+          return ssl_.get();
+        }
+
+      private:
+
+        /**
+         * \brief Lets asio's composed operations read and write through
+         *        OpenSSL.
+         */
+        class stream {
+
+        public:
+
+          typedef boost::asio::ip::tcp::socket::executor_type executor_type;
+
+          explicit stream(kernel_tls_connection &connection)
+            : connection_(connection) {
+
+          }
+
+          executor_type get_executor() {
+            return connection_.socket_.get_executor();
+          }
+
+          template <class MutableBuffers, class Handler>
+          void async_read_some(const MutableBuffers &buffers, Handler &&handler) {
+            connection_.start(first_buffer<boost::asio::mutable_buffer>(buffers),
+                              std::forward<Handler>(handler));
+          }
+
+          template <class ConstBuffers, class Handler>
+          void async_write_some(const ConstBuffers &buffers, Handler &&handler) {
+            connection_.start(first_buffer<boost::asio::const_buffer>(buffers),
+                              std::forward<Handler>(handler));
+          }
+
+        private:
+
+          // OpenSSL reads or writes one buffer at a time.
+          template <class Buffer, class Buffers>
+          static Buffer first_buffer(const Buffers &buffers) {
+            auto end = boost::asio::buffer_sequence_end(buffers);
+            for (auto it = boost::asio::buffer_sequence_begin(buffers); it != end; ++it) {
+              Buffer buffer(*it);
+              if (buffer.size() != 0) {
+                return buffer;
+              }
+            }
+            return Buffer();
+          }
+
+          kernel_tls_connection &connection_;
+
+        };
+
+        /**
+         * \brief Reads or writes a buffer, waiting for the socket as often
+         *        as OpenSSL needs to.
+         */
+        template <class Buffer, class Handler>
+        struct transfer_op {
+
+          void operator () (boost::system::error_code ec, bool initiating = false) {
+            std::size_t bytes_transferred = 0;
+            if (!ec && buffer.size() != 0) {
+              connection->clear_errors();
+              int result = transfer(connection->ssl_.get(), buffer);
+              if (result > 0) {
+                bytes_transferred = static_cast<std::size_t>(result);
+              }
+              else {
+                boost::asio::ip::tcp::socket::wait_type wait;
+                if (connection->would_block(result, wait, ec)) {
+                  auto &socket = connection->socket_;
+                  socket.async_wait(wait, std::move(*this));
+                  return;
+                }
+              }
+            }
+
+            if (initiating) {
+              // The handler mustn't be called before async_read_some or
+              // async_write_some returns.
+              boost::asio::post(connection->socket_.get_executor(),
+                                completion{std::move(handler), ec, bytes_transferred});
+            }
+            else {
+              handler(ec, bytes_transferred);
+            }
+          }
+
+          static int transfer(SSL *ssl, boost::asio::mutable_buffer buffer) {
+            return SSL_read(ssl, buffer.data(), clamp(buffer.size()));
+          }
+
+          static int transfer(SSL *ssl, boost::asio::const_buffer buffer) {
+            return SSL_write(ssl, buffer.data(), clamp(buffer.size()));
+          }
+
+          static int clamp(std::size_t size) {
+            return static_cast<int>(std::min<std::size_t>(size, INT_MAX));
+          }
+
+          struct completion {
+            void operator () () {
+              handler(ec, bytes_transferred);
+            }
+
+            Handler handler;
+            boost::system::error_code ec;
+            std::size_t bytes_transferred;
+          };
+
+          kernel_tls_connection *connection;
+          Buffer buffer;
+          Handler handler;
+
+        };
+
+        template <class Buffer, class Handler>
+        void start(Buffer buffer, Handler &&handler) {
+          typedef transfer_op<Buffer, typename std::decay<Handler>::type> op;
+          op{this, buffer, std::forward<Handler>(handler)}(boost::system::error_code(), true);
+        }
+
+        void handle_connected(const boost::system::error_code &ec, connect_callback callback) {
+          if (ec) {
+            callback(ec);
+            return;
+          }
+
+          boost::system::error_code error;
+          socket_.non_blocking(true, error);
+          if (!error && SSL_set_fd(ssl_.get(), socket_.native_handle()) != 1) {
+            error = boost::asio::error::no_memory;
+          }
+          if (error) {
+            callback(error);
+            return;
+          }
+
+          handshake_start_ = std::chrono::steady_clock::now();
+          handshake(callback);
+        }
+
+        void handshake(connect_callback callback) {
+          boost::system::error_code ec;
+          clear_errors();
+          int result = SSL_connect(ssl_.get());
+          if (result != 1) {
+            boost::asio::ip::tcp::socket::wait_type wait;
+            if (would_block(result, wait, ec)) {
+              socket_.async_wait(wait,
+                                 [=] (const boost::system::error_code &ec) {
+                                   if (ec) {
+                                     handle_handshake(ec, callback);
+                                   }
+                                   else {
+                                     handshake(callback);
+                                   }
+                                 });
+              return;
+            }
+          }
+          handle_handshake(ec, callback);
+        }
+
+        void handle_handshake(const boost::system::error_code &ec, connect_callback callback) {
+          handshake_duration_ = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - handshake_start_);
+          if (!ec) {
+            auto ssl = ssl_.get();
+            session_reused_ = SSL_session_reused(ssl) != 0;
+#if OPENSSL_VERSION_NUMBER >= 0x10002000L
+            const unsigned char *protocol = nullptr;
+            unsigned int length = 0;
+            SSL_get0_alpn_selected(ssl, &protocol, &length);
+            if (protocol) {
+              negotiated_protocol_.assign(reinterpret_cast<const char *>(protocol), length);
+            }
+#endif // OPENSSL_VERSION_NUMBER >= 0x10002000L
+#ifdef SSL_OP_ENABLE_KTLS
+            kernel_tls_send_ = BIO_get_ktls_send(SSL_get_wbio(ssl)) != 0;
+            kernel_tls_recv_ = BIO_get_ktls_recv(SSL_get_rbio(ssl)) != 0;
+#endif // SSL_OP_ENABLE_KTLS
+          }
+          callback(ec);
+        }
+
+        void clear_errors() {
+          ERR_clear_error();
+          errno = 0;
+        }
+
+        // Works out, from what an OpenSSL call returned, whether to wait
+        // for the socket and try again, or the error to report.  End of
+        // stream is reported as asio's SSL stream does.
+        bool would_block(int result,
+                         boost::asio::ip::tcp::socket::wait_type &wait,
+                         boost::system::error_code &ec) {
+          int error = SSL_get_error(ssl_.get(), result);
+          switch (error) {
+          case SSL_ERROR_WANT_READ:
+            wait = boost::asio::ip::tcp::socket::wait_read;
+            return true;
+          case SSL_ERROR_WANT_WRITE:
+            wait = boost::asio::ip::tcp::socket::wait_write;
+            return true;
+          case SSL_ERROR_ZERO_RETURN:
+            ec = boost::asio::error::eof;
+            break;
+          case SSL_ERROR_SYSCALL:
+            if (errno != 0) {
+              ec = boost::system::error_code(errno, boost::system::system_category());
+            }
+            else {
+              ec = boost::asio::ssl::error::stream_truncated;
+            }
+            break;
+          case SSL_ERROR_SSL: {
+            auto code = ERR_get_error();
+#ifdef SSL_R_UNEXPECTED_EOF_WHILE_READING
+            if (ERR_GET_REASON(code) == SSL_R_UNEXPECTED_EOF_WHILE_READING) {
+              ec = boost::asio::ssl::error::stream_truncated;
+              break;
+            }
+#endif // SSL_R_UNEXPECTED_EOF_WHILE_READING
+            ec = boost::system::error_code(static_cast<int>(code),
+                                           boost::asio::error::get_ssl_category());
+            break;
+          }
+          default:
+            ec = boost::system::error_code(error, boost::asio::error::get_ssl_category());
+            break;
+          }
+          return false;
+        }
+
+        struct ssl_deleter {
+          void operator () (SSL *ssl) const {
+            SSL_free(ssl);
+          }
+        };
+
+        boost::asio::ip::tcp::socket socket_;
+        stream stream_;
+        std::shared_ptr<client_ssl_context> context_;
+        std::unique_ptr<SSL, ssl_deleter> ssl_;
+        std::string host_;
+        std::chrono::steady_clock::time_point handshake_start_;
+        std::chrono::microseconds handshake_duration_;
+        bool session_reused_;
+        bool kernel_tls_send_, kernel_tls_recv_;
+        std::string negotiated_protocol_;
+
+      };
+      } // namespace client_connection
+    } // namespace v2
+  } // namespace http
+} // namespace network
+
+#endif // NETWORK_HTTP_V2_CLIENT_CONNECTION_KERNEL_TLS_CONNECTION_INC
@@ -11,8 +11,13 @@
  * \brief
  */
 
+#include <chrono>
 #include <memory>
+#include <string>
 #include <vector>
+#include <boost/asio/write.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/ssl.hpp>
@@ -20,14 +25,15 @@
 #include <network/config.hpp>
 #include <network/http/v2/client/connection/async_connection.hpp>
 #include <network/http/v2/client/client.hpp>
+#include <network/http/v2/client/connection/ssl_context.hpp>
 
 namespace network {
   namespace http {
     inline namespace v2 {
       namespace client_connection {
       /**
-       * \class
-       * \brief
+       * \class ssl_connection network/http/v2/client/connection/ssl_connection.hpp
+       * \brief Manages an SSL connection through a socket.
        */
       class ssl_connection : public async_connection {
 
@@ -37,11 +43,29 @@ namespace network {
       public:
 
         /**
-         * \brief
+         * \brief Constructor.
+         * \param io_service The I/O service.
+         * \param context The SSL context shared by the client's
+         *        connections.
+         */
+        ssl_connection(boost::asio::io_service &io_service,
+                       std::shared_ptr<client_ssl_context> context)
+          : io_service_(io_service)
+          , context_(context)
+          , handshake_duration_(0)
+          , session_reused_(false) {
+
+        }
+
+        /**
+         * \brief Constructor, using an SSL context that belongs to this
+         *        connection.
          */
         ssl_connection(boost::asio::io_service &io_service, const client_options &options)
           : io_service_(io_service)
-          , options_(options) {
+          , context_(std::make_shared<client_ssl_context>(options))
+          , handshake_duration_(0)
+          , session_reused_(false) {
 
         }
 
@@ -55,28 +79,17 @@ namespace network {
         virtual void async_connect(const boost::asio::ip::tcp::endpoint &endpoint,
                                    const std::string &host,
                                    connect_callback callback) {
-          context_.reset(new boost::asio::ssl::context(boost::asio::ssl::context::sslv23));
-          auto certificate_paths = options_.openssl_certificate_paths();
-          auto verifier_paths = options_.openssl_verify_paths();
-          bool use_default_verification = certificate_paths.empty() && verifier_paths.empty();
-          if (!use_default_verification) {
-            for (auto path : certificate_paths) {
-              context_->load_verify_file(path);
-            }
-            for (auto path : verifier_paths) {
-              context_->add_verify_path(path);
-            }
-            context_->set_verify_mode(boost::asio::ssl::context::verify_peer);
-            context_->set_verify_callback(boost::asio::ssl::rfc2818_verification(host));
-          }
-          else {
-            context_->set_default_verify_paths();
-            context_->set_verify_mode(boost::asio::ssl::context::verify_none);
-          }
+          host_ = host;
+          handshake_duration_ = std::chrono::microseconds(0);
+          session_reused_ = false;
+          negotiated_protocol_.clear();
           socket_.reset(new boost::asio::ssl::stream<
-                          boost::asio::ip::tcp::socket>(io_service_, *context_));
+                          boost::asio::ip::tcp::socket>(io_service_, context_->context()));
+          context_->prepare(socket_->native_handle(), host_);
+          if (context_->verify_peer()) {
+            socket_->set_verify_callback(boost::asio::ssl::rfc2818_verification(host_));
+          }
 
-          using namespace std::placeholders;
           socket_->lowest_layer().async_connect(endpoint,
                                                 [=] (const boost::system::error_code &ec) {
                                                   handle_connected(ec, callback);
@@ -114,28 +127,66 @@ namespace network {
           socket_->lowest_layer().cancel();
         }
 
+        virtual std::chrono::microseconds handshake_duration() const {
+          return handshake_duration_;
+        }
+
+        /**
+         * \brief Tests if the last handshake resumed a cached session.
+         */
+        bool session_reused() const {
+          return session_reused_;
+        }
+
+        /**
+         * \brief Gets the protocol selected by the server during ALPN.
+         * \returns The protocol name, or an empty string if none was
+         *          negotiated.
+         */
+        std::string negotiated_protocol() const {
+          return negotiated_protocol_;
+        }
+
       private:
 
         void handle_connected(const boost::system::error_code &ec, connect_callback callback) {
+          if (ec) {
+            callback(ec);
+            return;
+          }
+
+          handshake_start_ = std::chrono::steady_clock::now();
+          socket_->async_handshake(boost::asio::ssl::stream_base::client,
+                                   [=] (const boost::system::error_code &ec) {
+                                     handle_handshake(ec, callback);
+                                   });
+        }
+
+        void handle_handshake(const boost::system::error_code &ec, connect_callback callback) {
+          handshake_duration_ = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - handshake_start_);
           if (!ec) {
-            auto existing_session = SSL_get1_session(socket_->native_handle());
-            if (existing_session) {
-              socket_->async_handshake(boost::asio::ssl::stream_base::client, callback);
+            auto ssl = socket_->native_handle();
+            session_reused_ = SSL_session_reused(ssl) != 0;
+#if OPENSSL_VERSION_NUMBER >= 0x10002000L
+            const unsigned char *protocol = nullptr;
+            unsigned int length = 0;
+            SSL_get0_alpn_selected(ssl, &protocol, &length);
+            if (protocol) {
+              negotiated_protocol_.assign(reinterpret_cast<const char *>(protocol), length);
             }
-            else {
-              SSL_set_session(socket_->native_handle(), existing_session);
-              SSL_connect(socket_->native_handle());
-              callback(ec);
-            }
-          }
-          else {
-            callback(ec);
+#endif // OPENSSL_VERSION_NUMBER >= 0x10002000L
           }
+          callback(ec);
         }
 
         boost::asio::io_service &io_service_;
-        client_options options_;
-        std::unique_ptr<boost::asio::ssl::context> context_;
+        std::shared_ptr<client_ssl_context> context_;
+        std::string host_;
+        std::chrono::steady_clock::time_point handshake_start_;
+        std::chrono::microseconds handshake_duration_;
+        bool session_reused_;
+        std::string negotiated_protocol_;
         std::unique_ptr<
           boost::asio::ssl::stream<boost::asio::ip::tcp::socket>> socket_;
 
@@ -0,0 +1,309 @@
+// Copyright (C) 2026 agent (agent@local)
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_HTTP_V2_CLIENT_CONNECTION_SSL_CONTEXT_INC
+#define NETWORK_HTTP_V2_CLIENT_CONNECTION_SSL_CONTEXT_INC
+
+/**
+ * \file
+ * \brief An SSL context shared by all the connections of a client,
+ *        with a TLS session cache.
+ */
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <boost/asio/ssl.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <network/config.hpp>
+#include <network/http/v2/client/client.hpp>
+
+namespace network {
+  namespace http {
+    inline namespace v2 {
+      namespace client_connection {
+        /**
+         * \class ssl_session_cache network/http/v2/client/connection/ssl_context.hpp
+         * \brief Keeps the most recent TLS session of each host, so
+         *        that new connections can resume it.
+         */
+        class ssl_session_cache {
+
+          ssl_session_cache(const ssl_session_cache &) = delete;
+          ssl_session_cache &operator = (const ssl_session_cache &) = delete;
+
+        public:
+
+          /**
+           * \brief Constructor.
+           */
+          ssl_session_cache() { }
+
+          /**
+           * \brief Destructor.
+           */
+          ~ssl_session_cache() noexcept {
+            clear();
+          }
+
+          /**
+           * \brief Stores a session for a host, taking ownership of it.
+           */
+          void put(const std::string &host, SSL_SESSION *session) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto &entry = sessions_[boost::to_lower_copy(host)];
+            if (entry) {
+              SSL_SESSION_free(entry);
+            }
+            entry = session;
+          }
+
+          /**
+           * \brief Gets the session for a host.
+           * \returns A new reference to the session, which the caller
+           *          must free, or \c nullptr.
+           */
+          SSL_SESSION *get(const std::string &host) const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = sessions_.find(boost::to_lower_copy(host));
+            if (it == sessions_.end()) {
+              return nullptr;
+            }
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+            SSL_SESSION_up_ref(it->second);
+#else
+            CRYPTO_add(&it->second->references, 1, CRYPTO_LOCK_SSL_SESSION);
+#endif // OPENSSL_VERSION_NUMBER >= 0x10100000L
+            return it->second;
+          }
+
+          /**
+           * \brief Removes the session of a host.
+           */
+          void remove(const std::string &host) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = sessions_.find(boost::to_lower_copy(host));
+            if (it != sessions_.end()) {
+              SSL_SESSION_free(it->second);
+              sessions_.erase(it);
+            }
+          }
+
+          /**
+           * \brief Removes every session.
+           */
+          void clear() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto &entry : sessions_) {
+              SSL_SESSION_free(entry.second);
+            }
+            sessions_.clear();
+          }
+
+          /**
+           * \brief Gets the number of hosts with a session.
+           */
+          std::size_t size() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return sessions_.size();
+          }
+
+        private:
+
+          mutable std::mutex mutex_;
+          std::unordered_map<std::string, SSL_SESSION *> sessions_;
+
+        };
+
+        /**
+         * \class client_ssl_context network/http/v2/client/connection/ssl_context.hpp
+         * \brief The SSL context of a client, configured once from the
+         *        client options and shared by all its connections.
+         *
+         * Sessions are stored by OpenSSL's new session callback rather
+         * than read back after the handshake, because TLS 1.3 session
+         * tickets are only received after the handshake has completed.
+         *
+         * When kernel TLS is requested, the context lets OpenSSL hand the
+         * session keys to the kernel after the handshake. This only takes
+         * effect on connections that give OpenSSL the socket itself, such
+         * as \c kernel_tls_connection.
+         */
+        class client_ssl_context {
+
+          client_ssl_context(const client_ssl_context &) = delete;
+          client_ssl_context &operator = (const client_ssl_context &) = delete;
+
+        public:
+
+          /**
+           * \brief Constructor.
+           * \param options The client options.
+           */
+          explicit client_ssl_context(const client_options &options)
+            : context_(boost::asio::ssl::context::sslv23)
+            , verify_peer_(false)
+            , kernel_tls_(options.kernel_tls()) {
+            auto certificate_paths = options.openssl_certificate_paths();
+            auto verifier_paths = options.openssl_verify_paths();
+            bool use_default_verification = certificate_paths.empty() && verifier_paths.empty();
+            if (!use_default_verification) {
+              for (auto path : certificate_paths) {
+                context_.load_verify_file(path);
+              }
+              for (auto path : verifier_paths) {
+                context_.add_verify_path(path);
+              }
+            }
+            else {
+              context_.set_default_verify_paths();
+            }
+
+            verify_peer_ = !use_default_verification || options.always_verify_peer();
+            context_.set_verify_mode(verify_peer_?
+                                     boost::asio::ssl::context::verify_peer :
+                                     boost::asio::ssl::context::verify_none);
+
+            auto native = context_.native_handle();
+            SSL_CTX_set_session_cache_mode(native, SSL_SESS_CACHE_CLIENT |
+                                           SSL_SESS_CACHE_NO_INTERNAL_STORE);
+            SSL_CTX_set_ex_data(native, context_index(), this);
+            SSL_CTX_sess_set_new_cb(native, &client_ssl_context::new_session);
+
+            alpn_protocols(options.alpn_protocols());
+
+#ifdef SSL_OP_ENABLE_KTLS
+            if (kernel_tls_) {
+              SSL_CTX_set_options(native, SSL_OP_ENABLE_KTLS);
+            }
+#endif // SSL_OP_ENABLE_KTLS
+          }
+
+          /**
+           * \brief Destructor.
+           */
+          ~client_ssl_context() noexcept {
+            SSL_CTX_set_ex_data(context_.native_handle(), context_index(), nullptr);
+          }
+
+          /**
+           * \brief Gets the underlying context.
+           */
+          boost::asio::ssl::context &context() {
+            return context_;
+          }
+
+          /**
+           * \brief Gets the session cache.
+           */
+          ssl_session_cache &session_cache() {
+            return session_cache_;
+          }
+
+          /**
+           * \brief Tests if peers are verified.
+           */
+          bool verify_peer() const {
+            return verify_peer_;
+          }
+
+          /**
+           * \brief Tests if connections should try to use kernel TLS.
+           */
+          bool kernel_tls() const {
+            return kernel_tls_;
+          }
+
+          /**
+           * \brief Prepares an SSL connection to a host before its
+           *        handshake: sets the server name and the session to
+           *        resume, if any.
+           * \param ssl The connection.
+           * \param host The host name. It must stay valid until the
+           *        connection is closed.
+           */
+          void prepare(SSL *ssl, const std::string &host) {
+            SSL_set_tlsext_host_name(ssl, host.c_str());
+            SSL_set_ex_data(ssl, host_index(), const_cast<std::string *>(&host));
+            if (auto session = session_cache_.get(host)) {
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+              if (SSL_SESSION_is_resumable(session)) {
+                SSL_set_session(ssl, session);
+              }
+#else
+              SSL_set_session(ssl, session);
+#endif // OPENSSL_VERSION_NUMBER >= 0x10101000L
+              SSL_SESSION_free(session);
+            }
+          }
+
+        private:
+
+          void alpn_protocols(const std::vector<std::string> &protocols) {
+#if OPENSSL_VERSION_NUMBER >= 0x10002000L
+            if (protocols.empty()) {
+              return;
+            }
+
+            // ALPN protocols are sent as a list of length-prefixed
+            // strings.
+            std::vector<unsigned char> wire;
+            for (const auto &protocol : protocols) {
+              wire.push_back(static_cast<unsigned char>(protocol.size()));
+              wire.insert(wire.end(), protocol.begin(), protocol.end());
+            }
+            SSL_CTX_set_alpn_protos(context_.native_handle(), wire.data(),
+                                    static_cast<unsigned int>(wire.size()));
+#endif // OPENSSL_VERSION_NUMBER >= 0x10002000L
+          }
+
+          static int new_session(SSL *ssl, SSL_SESSION *session) {
+            auto self = static_cast<client_ssl_context *>(
+                SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), context_index()));
+            auto host = static_cast<std::string *>(SSL_get_ex_data(ssl, host_index()));
+            if (!self || !host) {
+              return 0;
+            }
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+            // OpenSSL marks the session of a connection that is freed
+            // without a TLS shutdown as not resumable, so the cache
+            // keeps its own copy.
+            if (auto copy = SSL_SESSION_dup(session)) {
+              self->session_cache_.put(*host, copy);
+            }
+            return 0;
+#else
+            // Returning 1 transfers the ownership of the session to the
+            // cache.
+            self->session_cache_.put(*host, session);
+            return 1;
+#endif // OPENSSL_VERSION_NUMBER >= 0x10101000L
+          }
+
+          static int context_index() {
+            static int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+            return index;
+          }
+
+          static int host_index() {
+            static int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+            return index;
+          }
+
+          boost::asio::ssl::context context_;
+          bool verify_peer_;
+          bool kernel_tls_;
+          ssl_session_cache session_cache_;
+
+        };
+      } // namespace client_connection
+    } // namespace v2
+  } // namespace http
+} // namespace network
+
+#endif // NETWORK_HTTP_V2_CLIENT_CONNECTION_SSL_CONTEXT_INC
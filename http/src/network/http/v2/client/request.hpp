@@ -26,7 +26,7 @@
 #include <boost/range/iterator_range.hpp>
 #include <boost/range/algorithm/equal.hpp>
 #include <boost/range/as_literal.hpp>
-#include <boost/algorithm/string/predicate.hpp>
+#include <network/message/ascii.hpp>
 #include <boost/optional.hpp>
 #include <network/config.hpp>
 #include <network/http/v2/method.hpp>
@@ -492,7 +492,7 @@ public:
    */
   boost::optional<string_type> header(const string_type &name) {
     for (auto header : headers_) {
-      if (boost::iequals(header.first, name)) {
+      if (ascii::iequals(header.first, name)) {
         return header.second;
       }
     }
@@ -533,7 +533,7 @@ public:
   void remove_header(const string_type &name) {
     auto it = std::remove_if(std::begin(headers_), std::end(headers_),
                              [&name] (const std::pair<string_type, string_type> &header) {
-                               return boost::iequals(header.first, name);
+                               return ascii::iequals(header.first, name);
                              });
     headers_.erase(it, std::end(headers_));
   }
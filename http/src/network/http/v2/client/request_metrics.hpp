@@ -0,0 +1,268 @@
+// Copyright (C) 2026 agent (agent@local)
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_HTTP_V2_CLIENT_REQUEST_METRICS_INC
+#define NETWORK_HTTP_V2_CLIENT_REQUEST_METRICS_INC
+
+/**
+ * \file
+ * \brief Per-request timings and latency histograms collected by the
+ *        client.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <network/config.hpp>
+
+namespace network {
+namespace http {
+inline namespace v2 {
+/**
+ * \ingroup http_client
+ * \class request_timings network/http/v2/client/request_metrics.hpp network/http/v2/client.hpp
+ * \brief The time spent in each phase of a single request.
+ */
+struct request_timings {
+
+  request_timings()
+    : resolve(0)
+    , connect(0)
+    , tls_handshake(0)
+    , write(0)
+    , time_to_first_byte(0)
+    , body(0)
+    , total(0)
+    , bytes_written(0)
+    , bytes_read(0)
+    , connection_reused(false)
+    , success(false) { }
+
+  /**
+   * \brief The time taken to resolve the host.
+   */
+  std::chrono::microseconds resolve;
+
+  /**
+   * \brief The time taken to connect, including failed attempts on
+   *        other endpoints.
+   */
+  std::chrono::microseconds connect;
+
+  /**
+   * \brief The time taken by the TLS handshake, which is not counted in
+   *        \c connect.
+   */
+  std::chrono::microseconds tls_handshake;
+
+  /**
+   * \brief The time taken to write the request.
+   */
+  std::chrono::microseconds write;
+
+  /**
+   * \brief The time between the end of the request and the response
+   *        status line.
+   */
+  std::chrono::microseconds time_to_first_byte;
+
+  /**
+   * \brief The time taken to read the response headers and body.
+   */
+  std::chrono::microseconds body;
+
+  /**
+   * \brief The time taken by the whole request.
+   */
+  std::chrono::microseconds total;
+
+  std::uint64_t bytes_written;
+  std::uint64_t bytes_read;
+
+  /**
+   * \brief \c true if the request used an existing connection.
+   */
+  bool connection_reused;
+
+  /**
+   * \brief \c true if a response was received.
+   */
+  bool success;
+
+};
+
+/**
+ * \ingroup http_client
+ * \class latency_histogram network/http/v2/client/request_metrics.hpp network/http/v2/client.hpp
+ * \brief A histogram of durations with power of two buckets.
+ *
+ * Bucket \c i counts the durations in [2^i, 2^(i+1)) microseconds, and
+ * bucket 0 also counts durations under a microsecond.  The last bucket
+ * counts everything above it, and the largest recorded duration is kept
+ * to bound it.
+ */
+class latency_histogram {
+
+public:
+
+  /**
+   * \brief The number of buckets.
+   */
+  static const std::size_t bucket_count = 32;
+
+  /**
+   * \brief Constructor.
+   */
+  latency_histogram()
+    : count_(0)
+    , sum_(0)
+    , max_(0) {
+    buckets_.fill(0);
+  }
+
+  /**
+   * \brief Records a duration.
+   */
+  void record(std::chrono::microseconds duration) {
+    auto value = static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0));
+    ++buckets_[bucket_index(value)];
+    ++count_;
+    sum_ += value;
+    max_ = std::max(max_, value);
+  }
+
+  /**
+   * \brief Adds the counts of another histogram to this one.
+   */
+  void merge(const latency_histogram &other) {
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = std::max(max_, other.max_);
+  }
+
+  /**
+   * \brief Gets the number of recorded durations.
+   */
+  std::uint64_t count() const {
+    return count_;
+  }
+
+  /**
+   * \brief Gets the number of durations in a bucket.
+   */
+  std::uint64_t bucket(std::size_t index) const {
+    return buckets_[index];
+  }
+
+  /**
+   * \brief Gets the mean of the recorded durations.
+   */
+  std::chrono::microseconds mean() const {
+    return std::chrono::microseconds((count_ == 0)? 0 : sum_ / count_);
+  }
+
+  /**
+   * \brief Gets the largest recorded duration.
+   */
+  std::chrono::microseconds max() const {
+    return std::chrono::microseconds(max_);
+  }
+
+  /**
+   * \brief Gets an upper bound of a percentile of the recorded
+   *        durations.
+   * \param percentile A value between 0 and 100.
+   */
+  std::chrono::microseconds percentile(double percentile) const {
+    if (count_ == 0) {
+      return std::chrono::microseconds(0);
+    }
+
+    auto rank = static_cast<std::uint64_t>(percentile / 100.0 * count_);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      seen += buckets_[i];
+      if (seen > rank || seen == count_) {
+        if (i == bucket_count - 1) {
+          return std::chrono::microseconds(max_);
+        }
+        return std::chrono::microseconds((std::uint64_t(1) << (i + 1)) - 1);
+      }
+    }
+    return std::chrono::microseconds::max();
+  }
+
+private:
+
+  static std::size_t bucket_index(std::uint64_t value) {
+    std::size_t index = 0;
+    while ((value >>= 1) != 0) {
+      ++index;
+    }
+    return std::min(index, bucket_count - 1);
+  }
+
+  std::array<std::uint64_t, bucket_count> buckets_;
+  std::uint64_t count_;
+  std::uint64_t sum_;
+  std::uint64_t max_;
+
+};
+
+/**
+ * \ingroup http_client
+ * \class client_metrics network/http/v2/client/request_metrics.hpp network/http/v2/client.hpp
+ * \brief Request timings aggregated by a client.
+ */
+struct client_metrics {
+
+  client_metrics()
+    : requests(0)
+    , failures(0)
+    , reused_connections(0)
+    , bytes_written(0)
+    , bytes_read(0) { }
+
+  /**
+   * \brief Adds the timings of a request.
+   */
+  void record(const request_timings &timings) {
+    ++requests;
+    failures += timings.success? 0 : 1;
+    reused_connections += timings.connection_reused? 1 : 0;
+    bytes_written += timings.bytes_written;
+    bytes_read += timings.bytes_read;
+    resolve.record(timings.resolve);
+    connect.record(timings.connect);
+    tls_handshake.record(timings.tls_handshake);
+    write.record(timings.write);
+    time_to_first_byte.record(timings.time_to_first_byte);
+    body.record(timings.body);
+    total.record(timings.total);
+  }
+
+  std::uint64_t requests;
+  std::uint64_t failures;
+  std::uint64_t reused_connections;
+  std::uint64_t bytes_written;
+  std::uint64_t bytes_read;
+  latency_histogram resolve;
+  latency_histogram connect;
+  latency_histogram tls_handshake;
+  latency_histogram write;
+  latency_histogram time_to_first_byte;
+  latency_histogram body;
+  latency_histogram total;
+
+};
+} // namespace v2
+} // namespace http
+} // namespace network
+
+#endif // NETWORK_HTTP_V2_CLIENT_REQUEST_METRICS_INC
@@ -16,6 +16,8 @@
 #include <boost/optional.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/range/algorithm/copy.hpp>
+#include <network/message/ascii.hpp>
+#include <boost/utility/string_ref.hpp>
 
 namespace network {
 namespace http {
@@ -125,22 +127,17 @@ BOOST_CONCEPT_REQUIRES(((ClientRequest<Request>)), (OutputIterator))
     boost::copy(default_accept_encoding, oi);
     boost::copy(crlf, oi);
   }
-  typedef headers_wrapper::container_type headers_container;
-  typedef headers_container::const_iterator headers_iterator;
-  headers_container const& request_headers = network::headers(request);
-  headers_iterator iterator = boost::begin(request_headers),
-                              end = boost::end(request_headers);
   bool has_user_agent = false;
-  for (; iterator != end; ++iterator) {
-    string_type header_name = name(*iterator), header_value = value(*iterator);
-    boost::copy(header_name, oi);
+  request.visit_headers([&](boost::string_ref header_name,
+                            boost::string_ref header_value) {
+    oi = std::copy(header_name.begin(), header_name.end(), oi);
     *oi = consts::colon_char();
     *oi = consts::space_char();
-    boost::copy(header_value, oi);
-    boost::copy(crlf, oi);
-    boost::to_lower(header_name);
-    has_user_agent = has_user_agent || header_name == "user-agent";
-  }
+    oi = std::copy(header_value.begin(), header_value.end(), oi);
+    oi = boost::copy(crlf, oi);
+    has_user_agent =
+        has_user_agent || ascii::iequals(header_name, "user-agent");
+  });
   if (!has_user_agent) {
     boost::copy(user_agent, oi);
     *oi = consts::colon_char();
@@ -149,8 +146,10 @@ BOOST_CONCEPT_REQUIRES(((ClientRequest<Request>)), (OutputIterator))
     boost::copy(crlf, oi);
   }
   boost::copy(crlf, oi);
-  auto body_data = network::body(request);
-  return std::copy(body_data.begin(), body_data.end(), oi);
+  request.visit_body([&oi](boost::string_ref chunk) {
+    oi = std::copy(chunk.begin(), chunk.end(), oi);
+  });
+  return oi;
 }
 
 }  // namespace http
@@ -680,7 +680,7 @@ struct http_async_connection_pimpl
         boost::make_iterator_range(headers_part), result_range;
     boost::logic::tribool parsed_ok;
     response_parser headers_parser(response_parser::http_header_line_done);
-    std::multimap<std::string, std::string> headers;
+    header_map headers;
     std::pair<std::string, std::string> header_pair;
     while (!boost::empty(input_range)) {
       boost::fusion::tie(parsed_ok, result_range) =
@@ -703,23 +703,23 @@ struct http_async_connection_pimpl
         header_pair.first.erase(header_pair.first.size() - 1);
       }
       boost::trim(header_pair.second);
-      headers.insert(header_pair);
+      headers.append(header_pair.first, header_pair.second);
     }
     // Set content length
     content_length_ = boost::none;
-    auto it = headers.find("Content-Length");
-    if (it != headers.end()) {
+    auto length = headers.find("Content-Length");
+    if (length) {
       try {
-        content_length_ = std::stoul(it->second);
+        content_length_ = std::stoul(length->to_string());
         NETWORK_MESSAGE("Content-Length: " << *content_length_);
       }
       catch (const std::invalid_argument&) {
         NETWORK_MESSAGE("invalid argument exception while interpreting "
-                        << it->second << " as content length");
+                        << *length << " as content length");
       }
       catch (const std::out_of_range&) {
         NETWORK_MESSAGE("out of range exception while interpreting "
-                        << it->second << " as content length");
+                        << *length << " as content length");
       }
     }
     headers_promise.set_value(headers);
@@ -795,7 +795,7 @@ struct http_async_connection_pimpl
   std::promise<std::string> version_promise;
   std::promise<boost::uint16_t> status_promise;
   std::promise<std::string> status_message_promise;
-  std::promise<std::multimap<std::string, std::string>> headers_promise;
+  std::promise<header_map> headers_promise;
   boost::optional<size_t> content_length_;
   std::promise<std::string> source_promise;
   std::promise<std::string> destination_promise;
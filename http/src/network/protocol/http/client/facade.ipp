@@ -9,6 +9,7 @@
 
 #include <network/protocol/http/client/facade.hpp>
 #include <network/detail/debug.hpp>
+#include <network/message/ascii.hpp>
 #include <boost/lexical_cast.hpp>
 
 namespace network {
@@ -52,20 +53,25 @@ response const basic_client_facade::post(
   NETWORK_MESSAGE("basic_client_facade::post(...)");
   if (body) {
     NETWORK_MESSAGE("using body provided.");
-    request << remove_header("Content-Length")
-            << header("Content-Length",
-                      boost::lexical_cast<std::string>(body->size()))
-            << network::body(*body);
+    request << batch(remove_header("Content-Length"),
+                     header("Content-Length",
+                            boost::lexical_cast<std::string>(body->size())),
+                     network::body(*body));
   }
 
-  headers_wrapper::container_type const& headers_ = headers(request);
+  bool has_content_type = false;
+  request.visit_headers([&has_content_type](boost::string_ref name,
+                                            boost::string_ref) {
+    has_content_type =
+        has_content_type || ascii::iequals(name, "Content-Type");
+  });
   if (content_type) {
     NETWORK_MESSAGE("using provided content type.");
-    request << remove_header("Content-Type")
-            << header("Content-Type", *content_type);
+    request << batch(remove_header("Content-Type"),
+                     header("Content-Type", *content_type));
   } else {
     NETWORK_MESSAGE("using default content type.");
-    if (boost::empty(headers_.equal_range("Content-Type"))) {
+    if (!has_content_type) {
       static char default_content_type[] = "x-application/octet-stream";
       request << header("Content-Type", default_content_type);
     }
@@ -82,20 +88,25 @@ response const basic_client_facade::put(
   NETWORK_MESSAGE("basic_client_facade::put(...)");
   if (body) {
     NETWORK_MESSAGE("using body provided.");
-    request << remove_header("Content-Length")
-            << header("Content-Length",
-                      boost::lexical_cast<std::string>(body->size()))
-            << network::body(*body);
+    request << batch(remove_header("Content-Length"),
+                     header("Content-Length",
+                            boost::lexical_cast<std::string>(body->size())),
+                     network::body(*body));
   }
 
-  headers_wrapper::container_type const& headers_ = headers(request);
+  bool has_content_type = false;
+  request.visit_headers([&has_content_type](boost::string_ref name,
+                                            boost::string_ref) {
+    has_content_type =
+        has_content_type || ascii::iequals(name, "Content-Type");
+  });
   if (content_type) {
     NETWORK_MESSAGE("using provided content type.");
-    request << remove_header("Content-Type")
-            << header("Content-Type", *content_type);
+    request << batch(remove_header("Content-Type"),
+                     header("Content-Type", *content_type));
   } else {
     NETWORK_MESSAGE("using default content type.");
-    if (boost::empty(headers_.equal_range("Content-Type"))) {
+    if (!has_content_type) {
       static char default_content_type[] = "x-application/octet-stream";
       request << header("Content-Type", default_content_type);
     }
@@ -10,6 +10,7 @@
 #include <future>
 #include <map>
 #include <boost/cstdint.hpp>
+#include <network/message/header_map.hpp>
 
 namespace network {
 namespace http {
@@ -22,9 +23,7 @@ struct setter_access {
   void set_version_promise(response& r, std::promise<std::string>& p);
   void set_status_promise(response& r, std::promise<boost::uint16_t>& p);
   void set_status_message_promise(response& r, std::promise<std::string>& p);
-  void set_headers_promise(
-      response& r,
-      std::promise<std::multimap<std::string, std::string>>& p);
+  void set_headers_promise(response& r, std::promise<header_map>& p);
   void set_source_promise(response& r, std::promise<std::string>& p);
   void set_destination_promise(response& r, std::promise<std::string>& p);
   void set_body_promise(response& r, std::promise<std::string>& p);
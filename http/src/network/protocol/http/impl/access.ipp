@@ -25,9 +25,8 @@ void setter_access::set_status_message_promise(response& r,
   return r.set_status_message_promise(p);
 }
 
-void setter_access::set_headers_promise(
-    response& r,
-    std::promise<std::multimap<std::string, std::string>>& p) {
+void setter_access::set_headers_promise(response& r,
+                                        std::promise<header_map>& p) {
   return r.set_headers_promise(p);
 }
 
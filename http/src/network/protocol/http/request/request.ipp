@@ -9,6 +9,7 @@
 
 #include <network/protocol/http/request/request.hpp>
 #include <network/protocol/http/request/request_concept.hpp>
+#include <network/message/header_map.hpp>
 #include <boost/scoped_array.hpp>
 
 #ifdef NETWORK_DEBUG
@@ -53,38 +54,49 @@ struct request_pimpl {
   void get_uri( ::network::uri& uri) { uri = uri_; }
 
   void append_header(std::string const& name, std::string const& value) {
-    headers_.insert(std::make_pair(name, value));
+    headers_.append(name, value);
   }
 
+  void remove_headers(std::string const& name) { headers_.erase(name); }
+
+  void remove_headers() { headers_.clear(); }
+
+  void apply(header_edit const& edit) { headers_.apply(edit); }
+
   void get_headers(
       std::function<bool(std::string const&, std::string const&)> predicate,
       std::function<
           void(std::string const&, std::string const&)> inserter) const {
-    headers_type::const_iterator it = headers_.begin();
-    for (; it != headers_.end(); ++it) {
-      if (predicate(it->first, it->second)) {
-        inserter(it->first, it->second);
+    headers_.for_each([&](header_map::string_ref name,
+                          header_map::string_ref value) {
+      std::string name_string = name.to_string(),
+                  value_string = value.to_string();
+      if (predicate(name_string, value_string)) {
+        inserter(name_string, value_string);
       }
-    }
+    });
   }
 
   void get_headers(std::function<
       void(std::string const&, std::string const&)> inserter) const {
-    headers_type::const_iterator it = headers_.begin();
-    for (; it != headers_.end(); ++it) {
-      inserter(it->first, it->second);
-    }
+    headers_.for_each([&](header_map::string_ref name,
+                          header_map::string_ref value) {
+      inserter(name.to_string(), value.to_string());
+    });
   }
 
   void get_headers(std::string const& name,
                    std::function<void(std::string const&,
                                       std::string const&)> inserter) const {
-    headers_type::const_iterator it = headers_.begin();
-    for (; it != headers_.end(); ++it) {
-      if (it->first == name) {
-        inserter(it->first, it->second);
-      }
-    }
+    headers_.for_each(name, [&](header_map::string_ref name,
+                                header_map::string_ref value) {
+      inserter(name.to_string(), value.to_string());
+    });
+  }
+
+  void visit_headers(std::function<
+      void(boost::string_ref, boost::string_ref)> const& visitor) const {
+    headers_.for_each(visitor);
   }
 
   void set_source(std::string const& source) { source_ = source; }
@@ -126,7 +138,7 @@ struct request_pimpl {
   }
 
  private:
-  typedef std::multimap<std::string, std::string> headers_type;
+  typedef header_map headers_type;
 
   ::network::uri uri_;
   size_t read_offset_;
@@ -185,9 +197,13 @@ void request::append_header(std::string const& name, std::string const& value) {
   pimpl_->append_header(name, value);
 }
 
-void request::remove_headers(std::string const& name) {}
+void request::remove_headers(std::string const& name) {
+  pimpl_->remove_headers(name);
+}
+
+void request::remove_headers() { pimpl_->remove_headers(); }
 
-void request::remove_headers() {}
+void request::apply(header_edit const& edit) { pimpl_->apply(edit); }
 
 void request::set_body(std::string const& body) {
   this->clear();
@@ -198,6 +214,17 @@ void request::append_body(std::string const& data) {
   this->append(data.data(), data.size());
 }
 
+void request::set_body(std::string&& body) {
+  this->clear();
+  this->append(std::move(body));
+}
+
+void request::append_body(std::string&& data) { this->append(std::move(data)); }
+
+void request::append_body(std::shared_ptr<std::string const> data) {
+  this->append(data);
+}
+
 // Retrievers
 void request::get_destination(std::string& destination) const {
   pimpl_->get_destination(destination);
@@ -242,6 +269,16 @@ void request::get_body(std::function<
   this->get_body(chunk_reader, NETWORK_DEFAULT_CHUNK_SIZE);
 }
 
+void request::visit_headers(std::function<
+    void(boost::string_ref, boost::string_ref)> visitor) const {
+  pimpl_->visit_headers(visitor);
+}
+
+void request::visit_body(
+    std::function<void(boost::string_ref)> visitor) const {
+  this->visit(visitor);
+}
+
 // From request_base...
 // Setters
 void request::set_method(std::string const& method) {}
@@ -12,6 +12,7 @@
 #endif
 
 #include <network/message/message_base.hpp>
+#include <network/message/shared_body.hpp>
 #include <network/uri.hpp>
 
 namespace network {
@@ -29,10 +30,13 @@ struct request_storage_base {
   request_storage_base(size_t chunk_size = NETWORK_BUFFER_CHUNK);
   request_storage_base(request_storage_base const& other);
   virtual void append(char const* data, size_t size);
+  virtual void append(std::string&& data);
+  virtual void append(shared_body::buffer data);
   virtual size_t read(std::string& destination,
                       size_t offset,
                       size_t size) const;
   virtual void flatten(std::string& destination) const;
+  virtual void visit(std::function<void(boost::string_ref)> visitor) const;
   virtual void clear();
   virtual bool equals(request_storage_base const& other) const;
   virtual void swap(request_storage_base& other);
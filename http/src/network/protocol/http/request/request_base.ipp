@@ -8,9 +8,7 @@
 #define NETWORK_RPTOCOL_HTTP_REQUEST_BASE_IPP_20111102
 
 #include <network/protocol/http/request/request_base.hpp>
-#include <vector>
-#include <thread>
-#include <cstring>
+#include <mutex>
 
 namespace network {
 namespace http {
@@ -23,18 +21,19 @@ struct request_storage_base_pimpl {
   explicit request_storage_base_pimpl(size_t chunk_size);
   request_storage_base_pimpl* clone() const;
   void append(char const* data, size_t size);
+  void append(std::string&& data);
+  void append(shared_body::buffer const& data);
   size_t read(std::string& destination, size_t offset, size_t size) const;
   void flatten(std::string& destination) const;
+  void visit(std::function<void(boost::string_ref)> const& visitor) const;
   void clear();
   bool equals(request_storage_base_pimpl const& other) const;
   void swap(request_storage_base_pimpl& other);
-  ~request_storage_base_pimpl();
 
  private:
-  size_t chunk_size_;
-  typedef std::vector<std::pair<char*, size_t>> chunks_vector;
-  chunks_vector chunks_;
-  mutable std::mutex chunk_mutex_;
+  // Copies of a request share the body segments.
+  shared_body body_;
+  mutable std::mutex body_mutex_;
 
   request_storage_base_pimpl(request_storage_base_pimpl const& other);
 };
@@ -51,6 +50,14 @@ void request_storage_base::append(char const* data, size_t size) {
   pimpl_->append(data, size);
 }
 
+void request_storage_base::append(std::string&& data) {
+  pimpl_->append(std::move(data));
+}
+
+void request_storage_base::append(shared_body::buffer data) {
+  pimpl_->append(data);
+}
+
 size_t request_storage_base::read(std::string& destination,
                                   size_t offset,
                                   size_t size) const {
@@ -61,6 +68,11 @@ void request_storage_base::flatten(std::string& destination) const {
   pimpl_->flatten(destination);
 }
 
+void request_storage_base::visit(
+    std::function<void(boost::string_ref)> visitor) const {
+  pimpl_->visit(visitor);
+}
+
 void request_storage_base::clear() { pimpl_->clear(); }
 
 bool request_storage_base::equals(request_storage_base const& other) const {
@@ -72,24 +84,14 @@ void request_storage_base::swap(request_storage_base& other) {
 }
 
 request_storage_base_pimpl::request_storage_base_pimpl(size_t chunk_size)
-    : chunk_size_(chunk_size),
-      chunks_() {
+    : body_(chunk_size) {
   // do nothing here.
 }
 
 request_storage_base_pimpl::request_storage_base_pimpl(
-    request_storage_base_pimpl const& other)
-    : chunk_size_(other.chunk_size_),
-      chunks_(0) {
-  std::lock_guard<std::mutex> scoped_lock(other.chunk_mutex_);
-  chunks_.reserve(other.chunks_.size());
-  chunks_vector::const_iterator it = other.chunks_.begin();
-  for (; it != other.chunks_.end(); ++it) {
-    chunks_vector::value_type pair =
-        std::make_pair(new (std::nothrow) char[other.chunk_size_], it->second);
-    std::memcpy(pair.first, it->first, it->second);
-    chunks_.push_back(pair);
-  }
+    request_storage_base_pimpl const& other) {
+  std::lock_guard<std::mutex> scoped_lock(other.body_mutex_);
+  body_ = other.body_;
 }
 
 request_storage_base_pimpl* request_storage_base_pimpl::clone() const {
@@ -97,112 +99,67 @@ request_storage_base_pimpl* request_storage_base_pimpl::clone() const {
 }
 
 void request_storage_base_pimpl::append(char const* data, size_t size) {
-  std::lock_guard<std::mutex> scoped_lock(chunk_mutex_);
-  if (chunks_.empty()) {
-    chunks_.push_back(std::make_pair(new (std::nothrow) char[chunk_size_], 0));
-  }
-  std::pair<char*, size_t>* chunk = &chunks_.back();
-  BOOST_ASSERT(chunk_size_ >= chunk->second);
-  size_t remaining = chunk_size_ - chunk->second;
-  while (remaining < size) {
-    size_t bytes_to_write = std::min(size - remaining, chunk_size_);
-    std::memcpy(chunk->first + chunk->second, data, bytes_to_write);
-    chunk->second += bytes_to_write;
-    BOOST_ASSERT(chunk->second <= chunk_size_);
-    data += bytes_to_write;
-    size -= bytes_to_write;
-    chunks_.push_back(std::make_pair(new (std::nothrow) char[chunk_size_], 0));
-    chunk = &chunks_.back();
-    remaining = chunk_size_;
-  }
-  if (size > 0) {
-    std::memcpy(chunk->first + chunk->second, data, size);
-    chunk->second += size;
-  }
+  std::lock_guard<std::mutex> scoped_lock(body_mutex_);
+  body_.append(data, size);
+}
+
+void request_storage_base_pimpl::append(std::string&& data) {
+  std::lock_guard<std::mutex> scoped_lock(body_mutex_);
+  body_.append(std::move(data));
+}
+
+void request_storage_base_pimpl::append(shared_body::buffer const& data) {
+  std::lock_guard<std::mutex> scoped_lock(body_mutex_);
+  body_.append(data);
 }
 
 size_t request_storage_base_pimpl::read(std::string& destination,
                                         size_t offset,
                                         size_t size) const {
-  std::lock_guard<std::mutex> scoped_lock(chunk_mutex_);
-  if (chunks_.empty())
-    return 0;
-  // First we find which chunk we're going to read from using the provided
-  // offset and some arithmetic to determine the correct one.
-  size_t chunk_index = offset / chunk_size_;
-  offset = offset % chunk_size_;
-
-  // Then we start copying up to size data either until we've reached the end
-  size_t chunks_count = chunks_.size();
-  size_t read_count = 0;
-  while (size > 0 && chunk_index < chunks_count) {
-    size_t bytes_to_read = std::min(chunks_[chunk_index].second, size);
-    destination.append(chunks_[chunk_index].first + offset,
-                       chunks_[chunk_index].first + offset + bytes_to_read);
-    read_count += bytes_to_read;
-    size -= bytes_to_read;
-    offset = 0;
-    ++chunk_index;
-  }
-  return read_count;
+  std::lock_guard<std::mutex> scoped_lock(body_mutex_);
+  return body_.read(destination, offset, size);
 }
 
 void request_storage_base_pimpl::flatten(std::string& destination) const {
-  std::lock_guard<std::mutex> scpoped_lock(chunk_mutex_);
-  chunks_vector::const_iterator chunk_iterator = chunks_.begin();
-  for (; chunk_iterator != chunks_.end(); ++chunk_iterator) {
-    destination.append(chunk_iterator->first, chunk_iterator->second);
+  std::lock_guard<std::mutex> scoped_lock(body_mutex_);
+  body_.flatten(destination);
+}
+
+void request_storage_base_pimpl::visit(
+    std::function<void(boost::string_ref)> const& visitor) const {
+  // Take a copy of the body, which only shares its segments, so that the
+  // visitor runs unlocked and may use the request again. The copy keeps the
+  // segments alive and stops appends from growing them meanwhile.
+  shared_body body;
+  {
+    std::lock_guard<std::mutex> scoped_lock(body_mutex_);
+    body = body_;
   }
+  body.for_each(visitor);
 }
 
 void request_storage_base_pimpl::clear() {
-  std::lock_guard<std::mutex> scoped_lock(chunk_mutex_);
-  chunks_vector::const_iterator chunk_iterator = chunks_.begin();
-  for (; chunk_iterator != chunks_.end(); ++chunk_iterator) {
-    delete[] chunk_iterator->first;
-  }
-  chunks_vector().swap(chunks_);
+  std::lock_guard<std::mutex> scoped_lock(body_mutex_);
+  body_.clear();
 }
 
 bool request_storage_base_pimpl::equals(
     request_storage_base_pimpl const& other) const {
-  std::lock(other.chunk_mutex_, this->chunk_mutex_);
-  if (other.chunk_size_ != chunk_size_ ||
-      other.chunks_.size() != chunks_.size()) {
-    other.chunk_mutex_.unlock();
-    this->chunk_mutex_.unlock();
-    return false;
-  }
-  chunks_vector::const_iterator chunk_iterator = chunks_.begin();
-  chunks_vector::const_iterator other_iterator = other.chunks_.begin();
-  for (; chunk_iterator != chunks_.begin() && other_iterator != other.chunks_
-           .end();
-       ++chunk_iterator,
-++other_iterator) {
-    if (chunk_iterator->second != other_iterator->second ||
-        strncmp(chunk_iterator->first,
-                other_iterator->first,
-                chunk_iterator->second)) {
-      other.chunk_mutex_.unlock();
-      this->chunk_mutex_.unlock();
-      return false;
-    }
-  }
-  other.chunk_mutex_.unlock();
-  this->chunk_mutex_.unlock();
-  return true;
+  if (this == &other)
+    return true;
+  std::lock(other.body_mutex_, this->body_mutex_);
+  std::lock_guard<std::mutex> other_lock(other.body_mutex_, std::adopt_lock);
+  std::lock_guard<std::mutex> this_lock(this->body_mutex_, std::adopt_lock);
+  return body_ == other.body_;
 }
 
 void request_storage_base_pimpl::swap(request_storage_base_pimpl& other) {
-  std::lock(other.chunk_mutex_, this->chunk_mutex_);
-  std::swap(chunk_size_, other.chunk_size_);
-  std::swap(chunks_, other.chunks_);
-  other.chunk_mutex_.unlock();
-  this->chunk_mutex_.unlock();
+  std::lock(other.body_mutex_, this->body_mutex_);
+  std::lock_guard<std::mutex> other_lock(other.body_mutex_, std::adopt_lock);
+  std::lock_guard<std::mutex> this_lock(this->body_mutex_, std::adopt_lock);
+  body_.swap(other.body_);
 }
 
-request_storage_base_pimpl::~request_storage_base_pimpl() { clear(); }
-
 }  // namespace http
 }  // namespace network
 
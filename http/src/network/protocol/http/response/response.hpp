@@ -31,6 +31,9 @@ struct response : response_base {
   virtual void remove_headers();
   virtual void set_body(std::string const& body);
   virtual void append_body(std::string const& data);
+  virtual void set_body(std::string&& body);
+  virtual void append_body(std::string&& data);
+  virtual void append_body(std::shared_ptr<std::string const> data);
 
   // Retrievers
   virtual void get_destination(std::string& destination) const;
@@ -50,6 +53,12 @@ struct response : response_base {
       std::function<void(std::string::const_iterator, size_t)> chunk_reader,
       size_t size) const;
 
+  // Views
+  virtual void visit_headers(std::function<
+      void(boost::string_ref, boost::string_ref)> visitor) const;
+  virtual void visit_body(
+      std::function<void(boost::string_ref)> visitor) const;
+
   // From response_base...
   virtual void set_status(uint16_t new_status);
   virtual void set_status_message(std::string const& new_status_message);
@@ -66,8 +75,7 @@ struct response : response_base {
   void set_version_promise(std::promise<std::string>&);
   void set_status_promise(std::promise<uint16_t>&);
   void set_status_message_promise(std::promise<std::string>&);
-  void set_headers_promise(
-      std::promise<std::multimap<std::string, std::string>>&);
+  void set_headers_promise(std::promise<header_map>&);
   void set_source_promise(std::promise<std::string>&);
   void set_destination_promise(std::promise<std::string>&);
   void set_body_promise(std::promise<std::string>&);
@@ -7,18 +7,19 @@
 #ifndef NETWORK_PROTOCOL_HTTP_RESPONSE_RESPONSE_IPP_20111206
 #define NETWORK_PROTOCOL_HTTP_RESPONSE_RESPONSE_IPP_20111206
 
-#include <boost/algorithm/string/predicate.hpp>
+#include <network/message/ascii.hpp>
 #include <network/protocol/http/response/response.hpp>
+#include <network/message/header_map.hpp>
+#include <network/message/shared_body.hpp>
 
 #include <algorithm>
-#include <set>
 #include <sstream>
 
 namespace network {
 namespace http {
 
 struct response_pimpl {
-  response_pimpl() {}
+  response_pimpl() : body_read_pos_(0) {}
 
   response_pimpl* clone() { return new (std::nothrow) response_pimpl(*this); }
 
@@ -52,66 +53,62 @@ struct response_pimpl {
   }
 
   void append_header(std::string const& name, std::string const& value) {
-    added_headers_.insert(std::make_pair(name, value));
+    added_headers_.append(name, value);
   }
 
   void remove_headers(std::string const& name) {
-    removed_headers_.insert(name);
+    if (!removed_headers_.contains(name))
+      removed_headers_.append(name, "");
   }
 
   void remove_headers() {
     if (!headers_future_.valid()) {
-      std::promise<std::multimap<std::string, std::string>> headers_promise;
-      headers_promise.set_value(std::multimap<std::string, std::string>());
-      std::future<std::multimap<std::string, std::string>> tmp =
-          headers_promise.get_future();
-      std::multimap<std::string, std::string>().swap(added_headers_);
-      std::set<std::string>().swap(removed_headers_);
+      std::promise<header_map> headers_promise;
+      headers_promise.set_value(header_map());
+      std::future<header_map> tmp = headers_promise.get_future();
+      added_headers_.clear();
+      removed_headers_.clear();
       headers_future_ = std::move(tmp);
     }
   }
 
   void get_headers(
       std::function<void(std::string const&, std::string const&)> inserter) {
-    std::multimap<std::string, std::string>::const_iterator it;
-    if (!headers_future_.valid()) {
-      it = added_headers_.begin();
-      for (; it != added_headers_.end(); ++it) {
-        if (removed_headers_.find(it->first) == removed_headers_.end()) {
-          inserter(it->first, it->second);
-        }
-      }
-    } else {
-      std::multimap<std::string, std::string> const& headers_ =
-          headers_future_.get();
-      it = headers_.begin();
-      for (; it != headers_.end(); ++it) {
-        if (removed_headers_.find(it->first) == removed_headers_.end()) {
-          inserter(it->first, it->second);
-        }
-      }
-    }
+    visit_headers([&](boost::string_ref name, boost::string_ref value) {
+      inserter(name.to_string(), value.to_string());
+    });
   }
   void get_headers(
       std::string const& name,
       std::function<void(std::string const&, std::string const&)> inserter) {
-    if (removed_headers_.find(name) != removed_headers_.end())
+    visit_headers([&](boost::string_ref name, boost::string_ref value) {
+      inserter(name.to_string(), value.to_string());
+    }, name);
+  }
+
+  void visit_headers(std::function<
+      void(boost::string_ref, boost::string_ref)> const& visitor) {
+    header_map const& headers_ =
+        headers_future_.valid() ? headers_future_.get() : added_headers_;
+    if (removed_headers_.empty()) {
+      headers_.for_each(visitor);
       return;
-    
-    std::pair<std::multimap<std::string, std::string>::const_iterator,
-              std::multimap<std::string, std::string>::const_iterator> 
-        range;
-    if (!headers_future_.valid()) {
-      range = added_headers_.equal_range(name);
-    } else {
-      std::multimap<std::string, std::string> const& headers_ = 
-          headers_future_.get();
-      range = headers_.equal_range(name);
-    }
-    
-    for (auto it = range.first; it != range.second; ++it) {
-      inserter(it->first, it->second);
     }
+    headers_.for_each([&](boost::string_ref name, boost::string_ref value) {
+      if (!removed_headers_.contains(name))
+        visitor(name, value);
+    });
+  }
+
+  void visit_headers(std::function<
+      void(boost::string_ref, boost::string_ref)> const& visitor,
+      boost::string_ref name) {
+    if (removed_headers_.contains(name))
+      return;
+
+    header_map const& headers_ =
+        headers_future_.valid() ? headers_future_.get() : added_headers_;
+    headers_.for_each(name, visitor);
   }
   void get_headers(
       std::function<bool(std::string const&, std::string const&)> predicate,
@@ -119,54 +116,98 @@ struct response_pimpl {
     /* FIXME: Do something! */
   }
 
+  // A body received by the client comes through body_future_, while a body
+  // set by the owner of the response is kept in body_, where copies of the
+  // response share it.
   void set_body(std::string const& body) {
-    std::promise<std::string> body_promise;
-    body_promise.set_value(body);
-    std::future<std::string> tmp_future = body_promise.get_future();
-    body_future_ = std::move(tmp_future);
+    body_future_ = std::shared_future<std::string>();
+    body_.assign(body);
   }
 
-  void append_body(std::string const& data) { /* FIXME: Do something! */
+  void set_body(std::string&& body) {
+    body_future_ = std::shared_future<std::string>();
+    body_.assign(std::move(body));
+  }
+
+  void append_body(std::string const& data) {
+    take_received_body();
+    body_.append(data);
+  }
+
+  void append_body(std::string&& data) {
+    take_received_body();
+    body_.append(std::move(data));
+  }
+
+  void append_body(shared_body::buffer const& data) {
+    take_received_body();
+    body_.append(data);
   }
 
   void get_body(std::string& body) {
+    std::string tmp;
+    visit_body([&tmp](boost::string_ref chunk) {
+      tmp.append(chunk.data(), chunk.size());
+    });
+    body.swap(tmp);
+  }
+
+  // Passes the body to the visitor without copying it. A chunked body is
+  // passed one chunk at a time.
+  void visit_body(std::function<void(boost::string_ref)> const& visitor) {
     if (!body_future_.valid()) {
-      body = "";
-    } else {
-      std::string partial_parsed = body_future_.get();
-      bool chunked = false;
-      auto check = [&](std::string const& key, std::string const& value) {
-        chunked = chunked || boost::iequals(value, "chunked");
-      };
-      get_headers(std::string("Transfer-Encoding"), check);
-      if (chunked) {
-        auto begin = partial_parsed.begin();
-        std::string crlf = "\r\n";
-        for (auto iter = std::search(begin,partial_parsed.end(), crlf.begin(), crlf.end());
-            iter != partial_parsed.end(); 
-            iter = std::search(begin,partial_parsed.end(), crlf.begin(), crlf.end())) {
-          std::string line(begin, iter);
-          if (line.empty()) break;
-          std::stringstream stream(line);
-          int len;
-          stream >> std::hex >> len;
-          iter += 2;
-          if (!len) break;
-          if (len <= partial_parsed.end() - iter) {
-            body.insert(body.end(), iter, iter + len);
-            iter += len;
-          }
-          begin = iter;
-        }
-      } else {
-        std::swap(body, partial_parsed);
+      body_.for_each(visitor);
+      return;
+    }
+    std::string const& partial_parsed = body_future_.get();
+    bool chunked = false;
+    visit_headers([&](boost::string_ref, boost::string_ref value) {
+      chunked = chunked || ascii::iequals(value, "chunked");
+    }, "Transfer-Encoding");
+    if (!chunked) {
+      if (!partial_parsed.empty())
+        visitor(partial_parsed);
+      return;
+    }
+    auto begin = partial_parsed.begin();
+    std::string crlf = "\r\n";
+    for (auto iter = std::search(begin,partial_parsed.end(), crlf.begin(), crlf.end());
+        iter != partial_parsed.end(); 
+        iter = std::search(begin,partial_parsed.end(), crlf.begin(), crlf.end())) {
+      std::string line(begin, iter);
+      if (line.empty()) break;
+      std::stringstream stream(line);
+      int len;
+      stream >> std::hex >> len;
+      iter += 2;
+      if (!len) break;
+      if (len <= partial_parsed.end() - iter) {
+        visitor(boost::string_ref(&*iter, len));
+        iter += len;
       }
+      begin = iter;
     }
   }
 
+  // Reads at most up to the end of the current segment, so that the chunk
+  // can be passed without copying it.
   void get_body(
       std::function<void(std::string::const_iterator, size_t)> chunk_reader,
-      size_t size) { /* FIXME: Do something! */
+      size_t size) {
+    take_received_body();
+    size_t offset = body_read_pos_;
+    for (size_t i = 0; i < body_.segment_count(); ++i) {
+      std::string const& segment = body_.segment(i);
+      if (offset < segment.size()) {
+        size_t max_read = std::min(segment.size() - offset, size);
+        body_read_pos_ += max_read;
+        chunk_reader(segment.begin() + offset, max_read);
+        return;
+      }
+      offset -= segment.size();
+    }
+    static std::string const empty;
+    chunk_reader(empty.end(), 0);
   }
 
   void set_status(boost::uint16_t status) {
@@ -224,10 +265,8 @@ struct response_pimpl {
     destination_future_ = std::move(tmp_future);
   }
 
-  void set_headers_promise(
-      std::promise<std::multimap<std::string, std::string>>& promise_) {
-    std::future<std::multimap<std::string, std::string>> tmp_future =
-        promise_.get_future();
+  void set_headers_promise(std::promise<header_map>& promise_) {
+    std::future<header_map> tmp_future = promise_.get_future();
     headers_future_ = std::move(tmp_future);
   }
 
@@ -249,6 +288,7 @@ struct response_pimpl {
   void set_body_promise(std::promise<std::string>& promise_) {
     std::future<std::string> tmp_future = promise_.get_future();
     body_future_ = std::move(tmp_future);
+    body_.clear();
   }
 
   bool equals(response_pimpl const& other) {
@@ -314,6 +354,8 @@ struct response_pimpl {
     } else {
       if (other.body_future_.valid())
         return false;
+      if (body_ != other.body_)
+        return false;
     }
     if (other.added_headers_ != added_headers_ ||
         other.removed_headers_ != removed_headers_)
@@ -322,17 +364,31 @@ struct response_pimpl {
   }
 
  private:
+  // Moves a body received by the client into body_, decoding it if it is
+  // chunked.
+  void take_received_body() {
+    if (!body_future_.valid())
+      return;
+    shared_body received;
+    visit_body([&received](boost::string_ref chunk) {
+      received.append(chunk.data(), chunk.size());
+    });
+    body_future_ = std::shared_future<std::string>();
+    body_.swap(received);
+  }
+
   mutable std::shared_future<std::string> source_future_;
   mutable std::shared_future<std::string> destination_future_;
-  mutable std::shared_future<
-      std::multimap<std::string, std::string>> headers_future_;
+  mutable std::shared_future<header_map> headers_future_;
   mutable std::shared_future<boost::uint16_t> status_future_;
   mutable std::shared_future<std::string> status_message_future_;
   mutable std::shared_future<std::string> version_future_;
   mutable std::shared_future<std::string> body_future_;
-  // TODO: use unordered_map and unordered_set here.
-  std::multimap<std::string, std::string> added_headers_;
-  std::set<std::string> removed_headers_;
+  header_map added_headers_;
+  // Only the names of the removed headers are used.
+  header_map removed_headers_;
+  shared_body body_;
+  size_t body_read_pos_;
 
   response_pimpl(response_pimpl const& other)
       : source_future_(other.source_future_),
@@ -343,7 +399,9 @@ struct response_pimpl {
         version_future_(other.version_future_),
         body_future_(other.body_future_),
         added_headers_(other.added_headers_),
-        removed_headers_(other.removed_headers_) {}
+        removed_headers_(other.removed_headers_),
+        body_(other.body_),
+        body_read_pos_(0) {}
 };
 
 response::response() : pimpl_(new (std::nothrow) response_pimpl) {}
@@ -386,6 +444,18 @@ void response::append_body(std::string const& data) {
   pimpl_->append_body(data);
 }
 
+void response::set_body(std::string&& body) {
+  pimpl_->set_body(std::move(body));
+}
+
+void response::append_body(std::string&& data) {
+  pimpl_->append_body(std::move(data));
+}
+
+void response::append_body(std::shared_ptr<std::string const> data) {
+  pimpl_->append_body(data);
+}
+
 void response::get_destination(std::string& destination) const {
   pimpl_->get_destination(destination);
 }
@@ -421,6 +491,16 @@ void response::get_body(
   pimpl_->get_body(chunk_reader, size);
 }
 
+void response::visit_headers(std::function<
+    void(boost::string_ref, boost::string_ref)> visitor) const {
+  pimpl_->visit_headers(visitor);
+}
+
+void response::visit_body(
+    std::function<void(boost::string_ref)> visitor) const {
+  pimpl_->visit_body(visitor);
+}
+
 void response::set_status(boost::uint16_t new_status) {
   pimpl_->set_status(new_status);
 }
@@ -459,8 +539,7 @@ void response::set_status_message_promise(std::promise<std::string>& promise) {
   return pimpl_->set_status_message_promise(promise);
 }
 
-void response::set_headers_promise(
-    std::promise<std::multimap<std::string, std::string>>& promise) {
+void response::set_headers_promise(std::promise<header_map>& promise) {
   return pimpl_->set_headers_promise(promise);
 }
 
@@ -543,11 +543,13 @@ class async_server_connection
     if (!ec) {
       headers_buffer.consume(headers_buffer.size());
       headers_already_sent = true;
-      thread_pool().post(callback);
+      // These continue a write that is done, so they jump the queue of
+      // request handlers.
+      thread_pool().post(callback, concurrency::priority_lane::io_completion);
       pending_actions_list::iterator start = pending_actions.begin(),
                                              end = pending_actions.end();
       while (start != end) {
-        thread_pool().post(*start++);
+        thread_pool().post(*start++, concurrency::priority_lane::io_completion);
       }
       pending_actions_list().swap(pending_actions);
     } else {
@@ -562,7 +564,8 @@ class async_server_connection
       boost::system::error_code const& ec,
       std::size_t bytes_transferred) {
     // we want to forget the temporaries and buffers
-    thread_pool().post(std::bind(callback, ec));
+    thread_pool().post(std::bind(callback, ec),
+                       concurrency::priority_lane::io_completion);
   }
 
   template <class Range>
@@ -0,0 +1,155 @@
+// Copyright 2026 (c) agent <agent@local>
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_PROTOCOL_HTTP_SERVER_CONNECTION_FORM_DATA_HPP_20261018
+#define NETWORK_PROTOCOL_HTTP_SERVER_CONNECTION_FORM_DATA_HPP_20261018
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <boost/range/begin.hpp>
+#include <boost/system/error_code.hpp>
+#include <http/server/form_data.hpp>
+#include <network/protocol/http/request.hpp>
+
+namespace network {
+namespace http {
+
+// Called once the whole body has been read and decoded, or on the first
+// error. Decoding errors are reported as errc::bad_message.
+typedef std::function<void(boost::system::error_code const&,
+                           std::shared_ptr<form_data const>)>
+    form_data_callback;
+
+namespace impl {
+
+// Connection is async_server_connection, or anything with the same read.
+template <class Connection>
+class form_data_reader
+    : public std::enable_shared_from_this<form_data_reader<Connection>> {
+ public:
+  typedef std::shared_ptr<Connection> connection_ptr;
+
+  form_data_reader(std::string const& content_type, std::size_t content_length,
+                   form_data_options const& options,
+                   form_data_callback callback)
+      : decoder_(content_type, options),
+        remaining_(content_length),
+        callback_(callback) {}
+
+  void read(connection_ptr connection) {
+    if (remaining_ == 0) {
+      done();
+      return;
+    }
+    connection->read(std::bind(&form_data_reader::handle_read,
+                               this->shared_from_this(),
+                               std::placeholders::_1,
+                               std::placeholders::_2,
+                               std::placeholders::_3,
+                               std::placeholders::_4));
+  }
+
+ private:
+  // If this fails, the decoder goes with the reader once the connection
+  // lets go of it, and takes the files spooled so far with it.
+  void handle_read(typename Connection::input_range input,
+                   boost::system::error_code ec,
+                   std::size_t bytes_transferred,
+                   connection_ptr connection) {
+    std::size_t size = std::min(bytes_transferred, remaining_);
+    try {
+      decoder_.feed(boost::string_ref(boost::begin(input), size));
+    }
+    catch (form_data_error const&) {
+      fail(boost::system::errc::make_error_code(
+          boost::system::errc::bad_message));
+      return;
+    }
+    remaining_ -= size;
+    if (remaining_ == 0)
+      done();
+    else if (ec)
+      fail(ec);
+    else
+      read(connection);
+  }
+
+  void done() {
+    try {
+      decoder_.finish();
+    }
+    catch (form_data_error const&) {
+      fail(boost::system::errc::make_error_code(
+          boost::system::errc::bad_message));
+      return;
+    }
+    callback_(boost::system::error_code(),
+              std::make_shared<form_data const>(decoder_.result()));
+  }
+
+  void fail(boost::system::error_code const& ec) {
+    callback_(ec, std::shared_ptr<form_data const>());
+  }
+
+  form_data_decoder decoder_;
+  std::size_t remaining_;
+  form_data_callback callback_;
+};
+
+}  // namespace impl
+
+// Reads a multipart/form-data request body from the connection, and decodes
+// it as it arrives: the files are spooled to disk, or passed to the file
+// handler of the options, a chunk at a time, and only the fields are kept in
+// memory. The body is delimited by the Content-Length of the request.
+//
+//     void handler(request const& req, connection_ptr connection) {
+//       read_form_data(connection, req, form_data_options(),
+//                      [=](boost::system::error_code const& ec,
+//                          std::shared_ptr<form_data const> form) { ... });
+//     }
+template <class Connection>
+void read_form_data(std::shared_ptr<Connection> connection,
+                    request const& req,
+                    form_data_options const& options,
+                    form_data_callback callback) {
+  std::string content_type, content_length;
+  req.get_headers("Content-Type",
+                  [&](std::string const&, std::string const& value) {
+    content_type = value;
+  });
+  req.get_headers("Content-Length",
+                  [&](std::string const&, std::string const& value) {
+    content_length = value;
+  });
+  if (content_type.empty() || content_length.empty()) {
+    callback(boost::system::errc::make_error_code(
+                 boost::system::errc::bad_message),
+             std::shared_ptr<form_data const>());
+    return;
+  }
+
+  std::shared_ptr<impl::form_data_reader<Connection>> reader;
+  try {
+    reader = std::make_shared<impl::form_data_reader<Connection>>(
+        content_type, std::strtoul(content_length.c_str(), nullptr, 10),
+        options, callback);
+  }
+  catch (form_data_error const&) {
+    callback(boost::system::errc::make_error_code(
+                 boost::system::errc::bad_message),
+             std::shared_ptr<form_data const>());
+    return;
+  }
+  reader->read(connection);
+}
+
+}  // namespace http
+}  // namespace network
+
+#endif  // NETWORK_PROTOCOL_HTTP_SERVER_CONNECTION_FORM_DATA_HPP_20261018
@@ -265,7 +265,6 @@ class sync_server_connection
   void flatten_response() {
     uint16_t status = http::status(response_);
     std::string status_message = http::status_message(response_);
-    headers_wrapper::container_type headers = network::headers(response_);
     std::ostringstream status_line;
     status_line << status << constants::space() << status_message
                 << constants::space() << constants::http_slash()
@@ -273,13 +272,11 @@ class sync_server_connection
                 << constants::crlf();
     segmented_write(status_line.str());
     std::ostringstream header_stream;
-    auto it = std::begin(headers), end = std::end(headers);
-    for (; it != end; ++it) {
-      const auto& header = *it;
-      //for (auto const &header : headers) {
-      header_stream << header.first << constants::colon() << constants::space()
-                    << header.second << constants::crlf();
-    }
+    response_.visit_headers([&header_stream](boost::string_ref name,
+                                             boost::string_ref value) {
+      header_stream << name << constants::colon() << constants::space()
+                    << value << constants::crlf();
+    });
     header_stream << constants::crlf();
     segmented_write(header_stream.str());
     bool done = false;
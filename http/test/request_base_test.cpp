@@ -21,6 +21,7 @@ struct request_test : http::request_storage_base {
   using base_type::read;
   using base_type::flatten;
   using base_type::clear;
+  using base_type::visit;
 
   explicit request_test(size_t chunk_size) : base_type(chunk_size) {}
 
@@ -65,3 +66,20 @@ TEST(request_test, request_storage_copy) {
   original.flatten(flattened);
   ASSERT_EQ(flattened, std::string(quick_brown, sizeof(quick_brown)));
 }
+
+TEST(request_test, request_storage_visitor_may_reenter) {
+  request_test storage(64);
+  storage.append("Hello, ", 7);
+  std::string visited;
+  storage.visit([&](boost::string_ref chunk) {
+    visited.append(chunk.data(), chunk.size());
+    storage.append("World!", 6);
+    std::string flattened;
+    storage.flatten(flattened);
+    ASSERT_EQ(std::string("Hello, World!"), flattened);
+  });
+  ASSERT_EQ(std::string("Hello, "), visited);
+  std::string flattened;
+  storage.flatten(flattened);
+  ASSERT_EQ(std::string("Hello, World!"), flattened);
+}
@@ -65,3 +65,19 @@ TEST(response_test, response_setters_and_getters) {
   ASSERT_EQ(version, std::string("HTTP/1.1"));
   ASSERT_TRUE(expected_headers == headers);
 }
+
+TEST(response_test, response_body_chunks) {
+  http::response response;
+  response.set_body(std::string("Hello, "));
+  response.append_body(std::make_shared<std::string const>("World!"));
+  http::response copy(response);
+  std::string body;
+  bool done = false;
+  while (!done) {
+    copy.get_body([&](std::string::const_iterator start, size_t length) {
+      done = length == 0;
+      body.append(start, start + length);
+    }, 4);
+  }
+  ASSERT_EQ(body, std::string("Hello, World!"));
+}
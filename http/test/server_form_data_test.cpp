@@ -0,0 +1,316 @@
+// Copyright 2026 (c) agent <agent@local>
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+#include <http/server/form_data.hpp>
+#include <network/protocol/http/server/connection/form_data.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+
+namespace http = ::network::http;
+
+namespace {
+
+char const content_type[] = "multipart/form-data; boundary=AaB03x";
+
+std::string const body =
+    "--AaB03x\r\n"
+    "Content-Disposition: form-data; name=\"submit-name\"\r\n"
+    "\r\n"
+    "Larry\r\n"
+    "--AaB03x\r\n"
+    "Content-Disposition: form-data; name=\"files\"; filename=\"file1.txt\"\r\n"
+    "Content-Type: text/plain\r\n"
+    "\r\n"
+    "... contents of file1.txt ...\r\n"
+    "--AaB03x\r\n"
+    "Content-Disposition: form-data; name=\"comment\"\r\n"
+    "\r\n"
+    "two\r\nlines\r\n"
+    "--AaB03x--\r\n";
+
+void feed(http::form_data_decoder& decoder, std::string const& data,
+          std::size_t fragment) {
+  for (std::size_t pos = 0; pos < data.size(); pos += fragment)
+    decoder.feed(boost::string_ref(data).substr(pos, fragment));
+  decoder.finish();
+}
+
+std::string read_file(std::string const& path) {
+  std::ifstream in(path.c_str(), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in),
+                     std::istreambuf_iterator<char>());
+}
+
+// A spool directory of its own, so that the test can tell whether the
+// decoder left anything in it.
+struct spool_directory {
+  spool_directory()
+      : path(boost::filesystem::temp_directory_path() /
+             boost::filesystem::unique_path("cpp-netlib-test-%%%%-%%%%")) {
+    boost::filesystem::create_directory(path);
+  }
+  ~spool_directory() { boost::filesystem::remove_all(path); }
+
+  http::form_data_options options() const {
+    return http::form_data_options().spool_directory(path.string());
+  }
+
+  bool empty() const {
+    return boost::filesystem::directory_iterator(path) ==
+           boost::filesystem::directory_iterator();
+  }
+
+  boost::filesystem::path path;
+};
+
+// Hands the data to the reader a few bytes at a time, the way
+// async_server_connection::read does, and then reports the end of the
+// stream.
+struct fake_connection : std::enable_shared_from_this<fake_connection> {
+  typedef boost::iterator_range<char const*> input_range;
+  typedef std::function<void(input_range, boost::system::error_code,
+                             std::size_t, std::shared_ptr<fake_connection>)>
+      read_callback_function;
+
+  fake_connection(std::string const& data, std::size_t chunk)
+      : data(data), position(0), chunk(chunk) {}
+
+  void read(read_callback_function callback) {
+    std::size_t size = std::min(chunk, data.size() - position);
+    boost::system::error_code ec;
+    if (size == 0) ec = boost::asio::error::eof;
+    char const* start = data.data() + position;
+    position += size;
+    callback(input_range(start, start + size), ec, size, shared_from_this());
+  }
+
+  std::string data;
+  std::size_t position, chunk;
+};
+
+network::http::request form_request(std::size_t content_length) {
+  network::http::request req;
+  req.append_header("Content-Type", content_type);
+  req.append_header("Content-Length", std::to_string(content_length));
+  return req;
+}
+
+}  // namespace
+
+TEST(server_form_data, fields_and_spooled_files) {
+  for (std::size_t fragment = 1; fragment <= body.size(); fragment *= 3) {
+    http::form_data_decoder decoder(content_type);
+    feed(decoder, body, fragment);
+    http::form_data const& form = decoder.result();
+    ASSERT_EQ(2u, form.fields.size());
+    EXPECT_EQ("submit-name", form.fields[0].first);
+    EXPECT_EQ("Larry", form.fields[0].second);
+    EXPECT_EQ("comment", form.fields[1].first);
+    EXPECT_EQ("two\r\nlines", form.fields[1].second);
+
+    ASSERT_EQ(1u, form.files.size());
+    http::form_file const& file = form.files[0];
+    EXPECT_EQ("files", file.name);
+    EXPECT_EQ("file1.txt", file.filename);
+    EXPECT_EQ("text/plain", file.content_type);
+    EXPECT_EQ(29u, file.size);
+    ASSERT_FALSE(file.path.empty());
+    EXPECT_EQ("... contents of file1.txt ...", read_file(file.path));
+    boost::filesystem::remove(file.path);
+  }
+}
+
+TEST(server_form_data, file_handler) {
+  std::map<std::string, std::string> contents;
+  std::size_t completed = 0;
+  http::form_data_options options;
+  options.file_handler([&](http::form_file const& file,
+                           boost::string_ref chunk) {
+    if (chunk.empty())
+      ++completed;
+    else
+      contents[file.filename].append(chunk.begin(), chunk.end());
+  });
+  http::form_data_decoder decoder(content_type, options);
+  feed(decoder, body, 7);
+  EXPECT_EQ(1u, completed);
+  EXPECT_EQ("... contents of file1.txt ...", contents["file1.txt"]);
+  ASSERT_EQ(1u, decoder.result().files.size());
+  EXPECT_TRUE(decoder.result().files[0].path.empty());
+}
+
+TEST(server_form_data, field_too_large) {
+  http::form_data_decoder decoder(
+      content_type, http::form_data_options().max_field_size(4));
+  EXPECT_THROW(feed(decoder, body, body.size()), http::form_data_error);
+}
+
+TEST(server_form_data, not_form_data) {
+  EXPECT_THROW(http::form_data_decoder("text/plain"), http::form_data_error);
+  EXPECT_THROW(http::form_data_decoder("multipart/form-data"),
+               http::form_data_error);
+}
+
+TEST(server_form_data, unterminated_body) {
+  spool_directory spool;
+  {
+    http::form_data_decoder decoder(content_type, spool.options());
+    decoder.feed(body.substr(0, body.size() - 12));
+    EXPECT_THROW(decoder.finish(), http::form_data_error);
+  }
+  EXPECT_TRUE(spool.empty());
+}
+
+TEST(server_form_data, abandoned_body_leaves_no_files) {
+  spool_directory spool;
+  {
+    // Stops in the middle of the file.
+    http::form_data_decoder decoder(content_type, spool.options());
+    decoder.feed(body.substr(0, body.find("file1.txt ...")));
+    EXPECT_FALSE(spool.empty());
+  }
+  EXPECT_TRUE(spool.empty());
+
+  {
+    // Stops after the file is complete, but before finish.
+    http::form_data_decoder decoder(content_type, spool.options());
+    decoder.feed(body.substr(0, body.find("comment")));
+    ASSERT_EQ(1u, decoder.result().files.size());
+  }
+  EXPECT_TRUE(spool.empty());
+}
+
+TEST(server_form_data, failed_body_leaves_no_files) {
+  spool_directory spool;
+  {
+    http::form_data_decoder decoder(content_type, spool.options());
+    std::string broken = body.substr(0, body.find("comment"));
+    broken += "\r\nno header here\r\n";
+    EXPECT_THROW(decoder.feed(broken), http::form_data_error);
+  }
+  EXPECT_TRUE(spool.empty());
+}
+
+TEST(server_form_data, finished_files_belong_to_the_caller) {
+  spool_directory spool;
+  std::string path;
+  {
+    http::form_data_decoder decoder(content_type, spool.options());
+    feed(decoder, body, body.size());
+    ASSERT_EQ(1u, decoder.result().files.size());
+    path = decoder.result().files[0].path;
+  }
+  EXPECT_TRUE(boost::filesystem::exists(path));
+}
+
+TEST(server_form_data, too_many_fields) {
+  spool_directory spool;
+  {
+    http::form_data_decoder decoder(content_type,
+                                    spool.options().max_fields(2));
+    EXPECT_THROW(feed(decoder, body, body.size()), http::form_data_error);
+  }
+  EXPECT_TRUE(spool.empty());
+
+  http::form_data_decoder decoder(content_type, spool.options().max_fields(3));
+  feed(decoder, body, body.size());
+  EXPECT_EQ(2u, decoder.result().fields.size());
+}
+
+TEST(server_form_data, fields_too_large_together) {
+  // "Larry" and "two\r\nlines" are each small enough on their own.
+  http::form_data_decoder decoder(
+      content_type,
+      http::form_data_options().max_field_size(10).max_total_field_size(14));
+  EXPECT_THROW(feed(decoder, body, 5), http::form_data_error);
+
+  http::form_data_decoder enough(
+      content_type,
+      http::form_data_options().max_field_size(10).max_total_field_size(15));
+  feed(enough, body, 5);
+  EXPECT_EQ(2u, enough.result().fields.size());
+}
+
+TEST(server_form_data, headers_too_large) {
+  std::string const folded =
+      "--AaB03x\r\n"
+      "Content-Disposition: form-data;\r\n"
+      "\tname=\"folded\"\r\n" +
+      std::string(200, ' ') + "x\r\n"
+      "\r\n"
+      "value\r\n"
+      "--AaB03x--\r\n";
+  http::form_data_decoder decoder(
+      content_type, http::form_data_options().max_header_size(128));
+  EXPECT_THROW(feed(decoder, folded, 16), http::form_data_error);
+
+  http::form_data_decoder enough(
+      content_type, http::form_data_options().max_header_size(512));
+  feed(enough, folded, 16);
+  ASSERT_EQ(1u, enough.result().fields.size());
+  EXPECT_EQ("folded", enough.result().fields[0].first);
+}
+
+TEST(server_form_data, read_from_connection) {
+  spool_directory spool;
+  boost::system::error_code result;
+  std::shared_ptr<http::form_data const> form;
+  http::read_form_data(
+      std::make_shared<fake_connection>(body, 7), form_request(body.size()),
+      spool.options(),
+      [&](boost::system::error_code const& ec,
+          std::shared_ptr<http::form_data const> decoded) {
+        result = ec;
+        form = decoded;
+      });
+  ASSERT_FALSE(result);
+  ASSERT_TRUE(form);
+  ASSERT_EQ(2u, form->fields.size());
+  EXPECT_EQ("Larry", form->fields[0].second);
+  ASSERT_EQ(1u, form->files.size());
+  EXPECT_EQ("... contents of file1.txt ...", read_file(form->files[0].path));
+}
+
+TEST(server_form_data, read_from_closed_connection) {
+  spool_directory spool;
+  boost::system::error_code result;
+  bool called = false;
+  std::string const truncated = body.substr(0, body.find("comment"));
+  http::read_form_data(
+      std::make_shared<fake_connection>(truncated, 7),
+      form_request(body.size()), spool.options(),
+      [&](boost::system::error_code const& ec,
+          std::shared_ptr<http::form_data const> decoded) {
+        called = true;
+        result = ec;
+        EXPECT_FALSE(decoded);
+      });
+  ASSERT_TRUE(called);
+  EXPECT_EQ(boost::asio::error::eof, result);
+  EXPECT_TRUE(spool.empty());
+}
+
+TEST(server_form_data, read_malformed_from_connection) {
+  boost::system::error_code result;
+  network::http::request req;
+  req.append_header("Content-Type", "text/plain");
+  req.append_header("Content-Length", "4");
+  http::read_form_data(
+      std::make_shared<fake_connection>("text", 7), req,
+      http::form_data_options(),
+      [&](boost::system::error_code const& ec,
+          std::shared_ptr<http::form_data const>) { result = ec; });
+  EXPECT_EQ(boost::system::errc::make_error_code(
+                boost::system::errc::bad_message),
+            result);
+}
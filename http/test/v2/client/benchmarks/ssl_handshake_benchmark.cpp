@@ -0,0 +1,170 @@
+// Copyright (C) 2026 agent (agent@local)
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the rate of TLS handshakes against a loopback server using
+// a certificate generated at start up, for:
+//  - a new SSL context for each connection (the previous behaviour),
+//  - a shared SSL context with no session reuse (full handshakes),
+//  - a shared SSL context with its session cache (resumed handshakes).
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include "network/http/v2/client/connection/ssl_connection.hpp"
+
+namespace http = network::http::v2;
+namespace http_cc = http::client_connection;
+using boost::asio::ip::tcp;
+
+namespace {
+  // Creates a self-signed certificate for "localhost".
+  void use_test_certificate(boost::asio::ssl::context &context) {
+    EVP_PKEY *key = nullptr;
+    auto key_context = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    EVP_PKEY_keygen_init(key_context);
+    EVP_PKEY_CTX_set_ec_paramgen_curve_nid(key_context, NID_X9_62_prime256v1);
+    EVP_PKEY_keygen(key_context, &key);
+    EVP_PKEY_CTX_free(key_context);
+
+    auto certificate = X509_new();
+    X509_set_version(certificate, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+    X509_gmtime_adj(X509_get_notBefore(certificate), 0);
+    X509_gmtime_adj(X509_get_notAfter(certificate), 60 * 60 * 24);
+    X509_set_pubkey(certificate, key);
+    auto name = X509_get_subject_name(certificate);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                               reinterpret_cast<const unsigned char *>("localhost"),
+                               -1, -1, 0);
+    X509_set_issuer_name(certificate, name);
+    X509_sign(certificate, key, EVP_sha256());
+
+    SSL_CTX_use_certificate(context.native_handle(), certificate);
+    SSL_CTX_use_PrivateKey(context.native_handle(), key);
+    X509_free(certificate);
+    EVP_PKEY_free(key);
+  }
+
+  class loopback_server {
+
+  public:
+
+    loopback_server()
+      : context_(boost::asio::ssl::context::sslv23)
+      , acceptor_(io_service_, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0)) {
+      use_test_certificate(context_);
+      accept();
+      thread_ = std::thread([this] () { io_service_.run(); });
+    }
+
+    ~loopback_server() {
+      io_service_.stop();
+      thread_.join();
+    }
+
+    tcp::endpoint endpoint() const {
+      return acceptor_.local_endpoint();
+    }
+
+  private:
+
+    typedef boost::asio::ssl::stream<tcp::socket> stream;
+
+    void accept() {
+      auto socket = std::make_shared<stream>(io_service_, context_);
+      acceptor_.async_accept(socket->lowest_layer(),
+                             [=] (const boost::system::error_code &ec) {
+                               if (!ec) {
+                                 handshake(socket);
+                               }
+                               accept();
+                             });
+    }
+
+    void handshake(std::shared_ptr<stream> socket) {
+      socket->async_handshake(boost::asio::ssl::stream_base::server,
+                              [=] (const boost::system::error_code &ec) {
+                                if (!ec) {
+                                  // Writing a response lets the client
+                                  // read the TLS 1.3 session tickets.
+                                  boost::asio::async_write(
+                                      *socket, boost::asio::buffer("ok", 2),
+                                      [socket] (const boost::system::error_code &,
+                                                std::size_t) { });
+                                }
+                              });
+    }
+
+    boost::asio::io_service io_service_;
+    boost::asio::ssl::context context_;
+    tcp::acceptor acceptor_;
+    std::thread thread_;
+
+  };
+
+  enum class mode {
+    context_per_connection, full_handshake, resumed_handshake,
+  };
+
+  void run(const char *name, mode m, const tcp::endpoint &endpoint, int connections) {
+    http::client_options options;
+    auto shared_context = std::make_shared<http_cc::client_ssl_context>(options);
+    boost::asio::io_service io_service;
+    int resumed = 0, failed = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < connections; ++i) {
+      std::unique_ptr<http_cc::ssl_connection> connection;
+      if (m == mode::context_per_connection) {
+        connection.reset(new http_cc::ssl_connection(io_service, options));
+      }
+      else {
+        if (m == mode::full_handshake) {
+          shared_context->session_cache().clear();
+        }
+        connection.reset(new http_cc::ssl_connection(io_service, shared_context));
+      }
+
+      boost::asio::streambuf buffer;
+      connection->async_connect(
+          endpoint, "localhost",
+          [&] (const boost::system::error_code &ec) {
+            if (ec) {
+              ++failed;
+              return;
+            }
+            connection->async_read(buffer, [] (const boost::system::error_code &,
+                                               std::size_t) { });
+          });
+      io_service.run();
+      io_service.reset();
+      resumed += connection->session_reused()? 1 : 0;
+      connection->disconnect();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    std::cout << name << ": " << connections << " handshakes in "
+              << elapsed.count() / 1000.0 << " ms ("
+              << connections * 1000000.0 / elapsed.count() << "/s), "
+              << resumed << " resumed, " << failed << " failed" << std::endl;
+  }
+} // namespace
+
+int
+main(int argc, char *argv[]) {
+  int connections = (argc > 1)? std::atoi(argv[1]) : 1000;
+  loopback_server server;
+  run("context per connection", mode::context_per_connection, server.endpoint(), connections);
+  run("full handshake", mode::full_handshake, server.endpoint(), connections);
+  run("resumed handshake", mode::resumed_handshake, server.endpoint(), connections);
+  return 0;
+}
@@ -0,0 +1,237 @@
+// Copyright (C) 2026 agent (agent@local)
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+#include "network/http/v2/client/circuit_breaker.hpp"
+
+namespace http = network::http::v2;
+
+namespace {
+  http::circuit_breaker_options breaker_options() {
+    return http::circuit_breaker_options()
+      .enabled(true)
+      .window_size(10)
+      .minimum_requests(4)
+      .failure_rate_threshold(0.5)
+      .open_time(std::chrono::milliseconds(1000));
+  }
+} // namespace
+
+TEST(circuit_breaker_test, disabled_breaker_always_allows) {
+  http::circuit_breaker breaker{http::circuit_breaker_options()};
+  for (int i = 0; i < 100; ++i) {
+    auto permit = breaker.try_acquire();
+    ASSERT_TRUE(permit);
+    permit.record(false, std::chrono::microseconds(0));
+  }
+  ASSERT_TRUE(http::circuit_state::closed == breaker.state());
+}
+
+TEST(circuit_breaker_test, opens_when_failure_rate_reached) {
+  http::circuit_breaker breaker{breaker_options()};
+  breaker.try_acquire().record(true, std::chrono::microseconds(0));
+  breaker.try_acquire().record(true, std::chrono::microseconds(0));
+  breaker.try_acquire().record(false, std::chrono::microseconds(0));
+  ASSERT_TRUE(http::circuit_state::closed == breaker.state());
+  breaker.try_acquire().record(false, std::chrono::microseconds(0));
+  ASSERT_TRUE(http::circuit_state::open == breaker.state());
+  ASSERT_FALSE(breaker.try_acquire());
+}
+
+TEST(circuit_breaker_test, slow_requests_count_as_failures) {
+  http::circuit_breaker breaker{
+    breaker_options().slow_request_threshold(std::chrono::milliseconds(10))};
+  for (int i = 0; i < 4; ++i) {
+    breaker.try_acquire().record(true, std::chrono::microseconds(20000));
+  }
+  ASSERT_TRUE(http::circuit_state::open == breaker.state());
+}
+
+TEST(circuit_breaker_test, half_open_probe_closes_circuit) {
+  auto now = http::circuit_breaker::clock::now();
+  http::circuit_breaker breaker{breaker_options()};
+  for (int i = 0; i < 4; ++i) {
+    breaker.try_acquire(now).record(false, std::chrono::microseconds(0), now);
+  }
+  ASSERT_FALSE(breaker.try_acquire(now));
+
+  auto later = now + std::chrono::milliseconds(1000);
+  auto probe = breaker.try_acquire(later);
+  ASSERT_TRUE(probe);
+  ASSERT_TRUE(http::circuit_state::half_open == breaker.state(later));
+  ASSERT_FALSE(breaker.try_acquire(later));
+  probe.record(true, std::chrono::microseconds(0), later);
+  ASSERT_TRUE(http::circuit_state::closed == breaker.state(later));
+  ASSERT_TRUE(breaker.try_acquire(later));
+}
+
+TEST(circuit_breaker_test, half_open_failure_reopens_circuit) {
+  auto now = http::circuit_breaker::clock::now();
+  http::circuit_breaker breaker{breaker_options()};
+  for (int i = 0; i < 4; ++i) {
+    breaker.try_acquire(now).record(false, std::chrono::microseconds(0), now);
+  }
+
+  auto later = now + std::chrono::milliseconds(1000);
+  auto probe = breaker.try_acquire(later);
+  ASSERT_TRUE(probe);
+  probe.record(false, std::chrono::microseconds(0), later);
+  ASSERT_TRUE(http::circuit_state::open == breaker.state(later));
+  ASSERT_FALSE(breaker.try_acquire(later));
+}
+
+TEST(circuit_breaker_test, open_circuit_reports_half_open_after_open_time) {
+  auto now = http::circuit_breaker::clock::now();
+  http::circuit_breaker breaker{breaker_options()};
+  for (int i = 0; i < 4; ++i) {
+    breaker.try_acquire(now).record(false, std::chrono::microseconds(0), now);
+  }
+  ASSERT_TRUE(http::circuit_state::open == breaker.state(now));
+  ASSERT_TRUE(http::circuit_state::half_open ==
+              breaker.state(now + std::chrono::milliseconds(1000)));
+}
+
+TEST(circuit_breaker_test, abandoned_probe_counts_as_failure) {
+  auto now = http::circuit_breaker::clock::now();
+  http::circuit_breaker breaker{breaker_options()};
+  for (int i = 0; i < 4; ++i) {
+    breaker.try_acquire(now).record(false, std::chrono::microseconds(0), now);
+  }
+
+  auto later = now + std::chrono::milliseconds(1000);
+  {
+    auto probe = breaker.try_acquire(later);
+    ASSERT_TRUE(probe);
+  }
+  ASSERT_TRUE(http::circuit_state::open == breaker.state(later));
+
+  // Opened again when the probe was abandoned, so it can probe again
+  // once the open time is over.
+  auto retry = breaker.try_acquire(later + std::chrono::seconds(60));
+  ASSERT_TRUE(retry);
+  retry.record(true, std::chrono::microseconds(0));
+  ASSERT_TRUE(http::circuit_state::closed == breaker.state());
+}
+
+TEST(circuit_breaker_test, stale_outcomes_are_ignored) {
+  auto now = http::circuit_breaker::clock::now();
+  http::circuit_breaker breaker{breaker_options()};
+
+  // Let through while the circuit is closed, finished after it opened.
+  auto slow = breaker.try_acquire(now);
+  ASSERT_TRUE(slow);
+  auto unsent = breaker.try_acquire(now);
+  ASSERT_TRUE(unsent);
+  for (int i = 0; i < 4; ++i) {
+    breaker.try_acquire(now).record(false, std::chrono::microseconds(0), now);
+  }
+
+  auto later = now + std::chrono::milliseconds(1000);
+  auto probe = breaker.try_acquire(later);
+  ASSERT_TRUE(probe);
+  slow.record(true, std::chrono::microseconds(0), later);
+  ASSERT_TRUE(http::circuit_state::half_open == breaker.state(later));
+
+  // Cancelling a stale permit doesn't free the place of the probe.
+  unsent.cancel();
+  ASSERT_FALSE(breaker.try_acquire(later));
+  probe.record(false, std::chrono::microseconds(0), later);
+  ASSERT_TRUE(http::circuit_state::open == breaker.state(later));
+}
+
+TEST(concurrency_limiter_test, limits_requests_in_flight) {
+  http::concurrency_limiter limiter{
+    http::concurrency_limit_options().enabled(true).initial_limit(2)};
+  ASSERT_TRUE(limiter.try_acquire());
+  ASSERT_TRUE(limiter.try_acquire());
+  ASSERT_FALSE(limiter.try_acquire());
+  limiter.cancel();
+  ASSERT_TRUE(limiter.try_acquire());
+}
+
+TEST(concurrency_limiter_test, failure_decreases_limit) {
+  http::concurrency_limiter limiter{
+    http::concurrency_limit_options().enabled(true).initial_limit(10).backoff_ratio(0.5)};
+  ASSERT_TRUE(limiter.try_acquire());
+  limiter.release(false, std::chrono::microseconds(100));
+  ASSERT_EQ(5, limiter.limit());
+}
+
+TEST(concurrency_limiter_test, fast_requests_increase_limit) {
+  http::concurrency_limiter limiter{
+    http::concurrency_limit_options().enabled(true).initial_limit(2)};
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(limiter.try_acquire());
+    limiter.release(true, std::chrono::microseconds(100));
+  }
+  ASSERT_LT(2, limiter.limit());
+}
+
+TEST(concurrency_limiter_test, slow_requests_decrease_limit) {
+  http::concurrency_limiter limiter{
+    http::concurrency_limit_options().enabled(true).initial_limit(10).backoff_ratio(0.5)};
+  ASSERT_TRUE(limiter.try_acquire());
+  limiter.release(true, std::chrono::microseconds(100));
+  ASSERT_TRUE(limiter.try_acquire());
+  limiter.release(true, std::chrono::microseconds(1000));
+  ASSERT_EQ(5, limiter.limit());
+}
+
+TEST(concurrency_limiter_test, limit_is_bounded) {
+  http::concurrency_limiter limiter{
+    http::concurrency_limit_options().enabled(true).initial_limit(4).min_limit(2)};
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(limiter.try_acquire());
+    limiter.release(false, std::chrono::microseconds(100));
+  }
+  ASSERT_EQ(2, limiter.limit());
+}
+
+TEST(origin_guard_test, reports_reason_for_refusal) {
+  auto guard = std::make_shared<http::origin_guard>(
+    http::circuit_breaker_options(),
+    http::concurrency_limit_options().enabled(true).initial_limit(1));
+  auto admitted = guard->admit();
+  ASSERT_TRUE(admitted);
+  ASSERT_FALSE(admitted.error());
+  auto refused = guard->admit();
+  ASSERT_FALSE(refused);
+  ASSERT_TRUE(refused.error());
+  ASSERT_TRUE(http::client_error::concurrency_limit_exceeded == *refused.error());
+}
+
+TEST(origin_guard_test, abandoned_permit_is_released) {
+  auto guard = std::make_shared<http::origin_guard>(
+    breaker_options().minimum_requests(1),
+    http::concurrency_limit_options().enabled(true).initial_limit(1));
+  {
+    auto permit = guard->admit();
+    ASSERT_TRUE(permit);
+    ASSERT_EQ(1, guard->status("").in_flight);
+  }
+  auto status = guard->status("");
+  ASSERT_EQ(0, status.in_flight);
+  ASSERT_TRUE(http::circuit_state::open == status.state);
+}
+
+TEST(origin_guard_test, origins_are_not_case_sensitive) {
+  http::origin_guards guards{breaker_options(), http::concurrency_limit_options()};
+  auto guard = guards.get("http://Example.COM:80");
+  ASSERT_EQ(guard, guards.get("http://example.com:80"));
+  auto status = guards.status();
+  ASSERT_EQ(1, status.size());
+  ASSERT_EQ("http://example.com:80", status[0].origin);
+}
+
+TEST(origin_guard_test, status_of_each_origin) {
+  http::origin_guards guards{breaker_options(), http::concurrency_limit_options()};
+  guards.get("http://example.com:80");
+  guards.get("https://example.com:443");
+  guards.get("http://example.com:80");
+  auto status = guards.status();
+  ASSERT_EQ(2, status.size());
+  ASSERT_EQ("http://example.com:80", status[0].origin);
+  ASSERT_TRUE(http::circuit_state::closed == status[0].state);
+}
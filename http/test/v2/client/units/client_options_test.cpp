@@ -76,3 +76,48 @@ TEST(client_options_test, set_always_verify_peer) {
   opts.always_verify_peer(true);
   ASSERT_TRUE(opts.always_verify_peer());
 }
+
+TEST(client_options_test, default_options_load_balancing) {
+  network::http::v2::client_options opts;
+  ASSERT_TRUE(network::http::v2::load_balancing_policy::first_available == opts.load_balancing());
+}
+
+TEST(client_options_test, set_option_load_balancing) {
+  network::http::v2::client_options opts;
+  opts.load_balancing(network::http::v2::load_balancing_policy::round_robin);
+  ASSERT_TRUE(network::http::v2::load_balancing_policy::round_robin == opts.load_balancing());
+}
+
+TEST(client_options_test, set_option_max_endpoint_failures) {
+  network::http::v2::client_options opts;
+  opts.max_endpoint_failures(3);
+  ASSERT_EQ(3, opts.max_endpoint_failures());
+}
+
+TEST(client_options_test, set_option_endpoint_ejection_time) {
+  network::http::v2::client_options opts;
+  opts.endpoint_ejection_time(std::chrono::milliseconds(1000));
+  ASSERT_EQ(std::chrono::milliseconds(1000), opts.endpoint_ejection_time());
+}
+
+TEST(client_options_test, default_options_alpn_protocols) {
+  network::http::v2::client_options opts;
+  ASSERT_TRUE(opts.alpn_protocols().empty());
+}
+
+TEST(client_options_test, set_option_alpn_protocol) {
+  network::http::v2::client_options opts;
+  opts.alpn_protocol("h2").alpn_protocol("http/1.1");
+  ASSERT_EQ((std::vector<std::string>{"h2", "http/1.1"}), opts.alpn_protocols());
+}
+
+TEST(client_options_test, default_options_kernel_tls) {
+  network::http::v2::client_options opts;
+  ASSERT_FALSE(opts.kernel_tls());
+}
+
+TEST(client_options_test, set_option_kernel_tls) {
+  network::http::v2::client_options opts;
+  opts.kernel_tls(true);
+  ASSERT_TRUE(opts.kernel_tls());
+}
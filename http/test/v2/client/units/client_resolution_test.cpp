@@ -3,6 +3,9 @@
 // (See accompanying file LICENSE_1_0.txt or copy at
 // http://www.boost.org/LICENSE_1_0.txt)
 
+#include <chrono>
+#include <future>
+#include <thread>
 #include <gtest/gtest.h>
 #include "network/http/v2/client/connection/async_resolver.hpp"
 #include "network/http/v2/client/connection/async_connection.hpp"
@@ -89,3 +92,84 @@ TEST_F(client_resolution_test, host_not_found) {
   auto future_response = client_->head(request);
   ASSERT_THROW(future_response.get(), std::system_error);
 }
+
+class resolving_async_resolver : public http_cc::async_resolver {
+public:
+
+  virtual ~resolving_async_resolver() noexcept { }
+
+  virtual void async_resolve(const std::string &host, std::uint16_t port,
+                             resolve_callback callback) {
+    boost::asio::ip::tcp::endpoint endpoint(
+      boost::asio::ip::address::from_string("127.0.0.1"), port);
+    callback(boost::system::error_code(),
+             boost::asio::ip::tcp::resolver::results_type::create(
+               endpoint, host, std::to_string(port)));
+  }
+
+  virtual void clear_resolved_cache() { }
+
+};
+
+// Takes 10ms to connect, of which 5ms are spent in a handshake, and then
+// fails.
+class handshaking_async_connection : public fake_async_connection {
+public:
+
+  virtual ~handshaking_async_connection() noexcept { }
+
+  virtual void async_connect(const boost::asio::ip::tcp::endpoint &,
+                             const std::string &,
+                             connect_callback callback) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    callback(boost::asio::error::connection_refused);
+  }
+
+  virtual std::chrono::microseconds handshake_duration() const {
+    return std::chrono::milliseconds(5);
+  }
+
+};
+
+TEST(client_timings_test, handshake_is_not_counted_in_connect) {
+  std::promise<http::request_timings> timings;
+  http::client client(
+    std::unique_ptr<http_cc::async_resolver>(new resolving_async_resolver{}),
+    std::unique_ptr<http_cc::async_connection>(new handshaking_async_connection{}),
+    http::client_options()
+      .timeout(std::chrono::milliseconds(0))
+      .timings([&timings] (const http::request_timings &t) {
+          timings.set_value(t);
+        }));
+  http::request request;
+  request
+    .method(http::method::get)
+    .url(network::uri("http://127.0.0.1/"))
+    .version("1.1");
+  auto future_response = client.get(request);
+  ASSERT_THROW(future_response.get(), std::system_error);
+
+  auto result = timings.get_future().get();
+  ASSERT_EQ(std::chrono::microseconds(5000), result.tls_handshake);
+  ASSERT_LE(std::chrono::microseconds(4000), result.connect);
+}
+
+TEST(client_timings_test, request_without_host_is_invalid) {
+  http::client client(
+    std::unique_ptr<http_cc::async_resolver>(new resolving_async_resolver{}),
+    std::unique_ptr<http_cc::async_connection>(new handshaking_async_connection{}),
+    http::client_options().timeout(std::chrono::milliseconds(0)));
+  http::request request;
+  request
+    .method(http::method::get)
+    .path("/")
+    .version("1.1");
+  auto future_response = client.get(request);
+  try {
+    future_response.get();
+    FAIL() << "the request has no host";
+  }
+  catch (const http::client_exception &e) {
+    ASSERT_EQ(make_error_code(http::client_error::invalid_request), e.code());
+  }
+}
@@ -0,0 +1,122 @@
+// Copyright (C) 2026 agent (agent@local)
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+#include "network/http/v2/client/connection/endpoint_selector.hpp"
+
+namespace http = network::http::v2;
+namespace http_cc = http::client_connection;
+using boost::asio::ip::tcp;
+
+class endpoint_selector_test : public ::testing::Test {
+
+protected:
+
+  void SetUp() {
+    endpoints_.push_back(tcp::endpoint(boost::asio::ip::address::from_string("10.0.0.1"), 80));
+    endpoints_.push_back(tcp::endpoint(boost::asio::ip::address::from_string("10.0.0.2"), 80));
+    endpoints_.push_back(tcp::endpoint(boost::asio::ip::address::from_string("10.0.0.3"), 80));
+  }
+
+  std::vector<tcp::endpoint> endpoints_;
+
+};
+
+TEST_F(endpoint_selector_test, first_available_keeps_resolver_order) {
+  http_cc::first_available_selector selector;
+  ASSERT_EQ(endpoints_, selector.select("example.com", endpoints_));
+  ASSERT_EQ(endpoints_, selector.select("example.com", endpoints_));
+}
+
+TEST_F(endpoint_selector_test, round_robin_rotates) {
+  http_cc::round_robin_selector selector;
+  ASSERT_EQ(endpoints_[0], selector.select("example.com", endpoints_).front());
+  ASSERT_EQ(endpoints_[1], selector.select("example.com", endpoints_).front());
+  ASSERT_EQ(endpoints_[2], selector.select("example.com", endpoints_).front());
+  ASSERT_EQ(endpoints_[0], selector.select("example.com", endpoints_).front());
+}
+
+TEST_F(endpoint_selector_test, round_robin_ignores_host_case) {
+  http_cc::round_robin_selector selector;
+  ASSERT_EQ(endpoints_[0], selector.select("example.com", endpoints_).front());
+  ASSERT_EQ(endpoints_[1], selector.select("EXAMPLE.com", endpoints_).front());
+}
+
+TEST_F(endpoint_selector_test, round_robin_returns_every_endpoint) {
+  http_cc::round_robin_selector selector;
+  selector.select("example.com", endpoints_);
+  ASSERT_EQ(3, selector.select("example.com", endpoints_).size());
+}
+
+TEST_F(endpoint_selector_test, least_outstanding_prefers_idle_endpoint) {
+  http_cc::least_outstanding_selector selector;
+  selector.select("example.com", endpoints_);
+  selector.request_started("example.com", endpoints_[0]);
+  selector.request_started("example.com", endpoints_[1]);
+  ASSERT_EQ(endpoints_[2], selector.select("example.com", endpoints_).front());
+}
+
+TEST_F(endpoint_selector_test, power_of_two_choices_prefers_faster_endpoint) {
+  std::vector<tcp::endpoint> endpoints(endpoints_.begin(), endpoints_.begin() + 2);
+  http_cc::power_of_two_choices_selector selector;
+  selector.select("example.com", endpoints);
+  selector.request_started("example.com", endpoints[0]);
+  selector.request_finished("example.com", endpoints[0], true, std::chrono::microseconds(10000));
+  selector.request_started("example.com", endpoints[1]);
+  selector.request_finished("example.com", endpoints[1], true, std::chrono::microseconds(100));
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(endpoints[1], selector.select("example.com", endpoints).front());
+  }
+}
+
+TEST_F(endpoint_selector_test, failing_endpoint_is_ejected) {
+  http_cc::first_available_selector selector(2, std::chrono::milliseconds(60000));
+  selector.select("example.com", endpoints_);
+  selector.request_started("example.com", endpoints_[0]);
+  selector.request_finished("example.com", endpoints_[0], false, std::chrono::microseconds(0));
+  ASSERT_EQ(endpoints_[0], selector.select("example.com", endpoints_).front());
+  selector.request_started("example.com", endpoints_[0]);
+  selector.request_finished("example.com", endpoints_[0], false, std::chrono::microseconds(0));
+  auto selected = selector.select("example.com", endpoints_);
+  ASSERT_EQ(endpoints_[1], selected.front());
+  ASSERT_EQ(endpoints_[0], selected.back());
+}
+
+TEST_F(endpoint_selector_test, ejected_endpoint_returns_after_ejection_time) {
+  http_cc::first_available_selector selector(1, std::chrono::milliseconds(0));
+  selector.select("example.com", endpoints_);
+  selector.request_started("example.com", endpoints_[0]);
+  selector.request_finished("example.com", endpoints_[0], false, std::chrono::microseconds(0));
+  ASSERT_EQ(endpoints_[0], selector.select("example.com", endpoints_).front());
+}
+
+TEST_F(endpoint_selector_test, success_resets_failures) {
+  http_cc::first_available_selector selector;
+  selector.select("example.com", endpoints_);
+  selector.request_started("example.com", endpoints_[0]);
+  selector.request_finished("example.com", endpoints_[0], false, std::chrono::microseconds(0));
+  selector.request_started("example.com", endpoints_[0]);
+  selector.request_finished("example.com", endpoints_[0], true, std::chrono::microseconds(100));
+  auto health = selector.health("example.com");
+  ASSERT_EQ(3, health.size());
+  ASSERT_EQ(0, health[0].consecutive_failures);
+  ASSERT_EQ(0, health[0].outstanding);
+}
+
+TEST_F(endpoint_selector_test, unresolved_endpoints_are_forgotten) {
+  http_cc::first_available_selector selector;
+  selector.select("example.com", endpoints_);
+  std::vector<tcp::endpoint> endpoints(endpoints_.begin() + 1, endpoints_.end());
+  selector.select("example.com", endpoints);
+  ASSERT_EQ(2, selector.health("example.com").size());
+}
+
+TEST_F(endpoint_selector_test, make_endpoint_selector_from_options) {
+  http::client_options options;
+  options.load_balancing(http::load_balancing_policy::round_robin);
+  auto selector = http_cc::make_endpoint_selector(options);
+  ASSERT_EQ(endpoints_[0], selector->select("example.com", endpoints_).front());
+  ASSERT_EQ(endpoints_[1], selector->select("example.com", endpoints_).front());
+}
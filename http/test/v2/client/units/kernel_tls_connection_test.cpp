@@ -0,0 +1,190 @@
+// Copyright (C) 2026 agent (agent@local)
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include "network/http/v2/client/connection/kernel_tls_connection.hpp"
+
+namespace http = network::http::v2;
+namespace http_cc = http::client_connection;
+using boost::asio::ip::tcp;
+
+namespace {
+  // Creates a self-signed certificate for "localhost".
+  void use_test_certificate(boost::asio::ssl::context &context) {
+    EVP_PKEY *key = nullptr;
+    auto key_context = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    EVP_PKEY_keygen_init(key_context);
+    EVP_PKEY_CTX_set_ec_paramgen_curve_nid(key_context, NID_X9_62_prime256v1);
+    EVP_PKEY_keygen(key_context, &key);
+    EVP_PKEY_CTX_free(key_context);
+
+    auto certificate = X509_new();
+    X509_set_version(certificate, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+    X509_gmtime_adj(X509_get_notBefore(certificate), 0);
+    X509_gmtime_adj(X509_get_notAfter(certificate), 60 * 60 * 24);
+    X509_set_pubkey(certificate, key);
+    auto name = X509_get_subject_name(certificate);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                               reinterpret_cast<const unsigned char *>("localhost"),
+                               -1, -1, 0);
+    X509_set_issuer_name(certificate, name);
+    X509_sign(certificate, key, EVP_sha256());
+
+    SSL_CTX_use_certificate(context.native_handle(), certificate);
+    SSL_CTX_use_PrivateKey(context.native_handle(), key);
+    X509_free(certificate);
+    EVP_PKEY_free(key);
+  }
+
+  // Tests if the kernel has the TLS upper layer protocol that kernel TLS
+  // is set up with.
+  bool kernel_has_tls() {
+    boost::asio::io_service io_service;
+    tcp::acceptor acceptor(io_service, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    tcp::socket client(io_service), server(io_service);
+    client.connect(acceptor.local_endpoint());
+    acceptor.accept(server);
+    return setsockopt(client.native_handle(), SOL_TCP, TCP_ULP, "tls", sizeof("tls")) == 0;
+  }
+
+  // Answers a single connection: echoes the first line, then closes the
+  // TLS session.
+  class echo_server {
+
+  public:
+
+    echo_server()
+      : context_(boost::asio::ssl::context::sslv23)
+      , acceptor_(io_service_, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0)) {
+      use_test_certificate(context_);
+      // A cipher that kernels with TLS support can all offload.
+      SSL_CTX_set_ciphersuites(context_.native_handle(), "TLS_AES_128_GCM_SHA256");
+      thread_ = std::thread([this] () { serve(); });
+    }
+
+    ~echo_server() {
+      thread_.join();
+    }
+
+    tcp::endpoint endpoint() const {
+      return acceptor_.local_endpoint();
+    }
+
+  private:
+
+    void serve() {
+      boost::asio::ssl::stream<tcp::socket> socket(io_service_, context_);
+      boost::system::error_code ec;
+      acceptor_.accept(socket.lowest_layer(), ec);
+      if (!ec) {
+        socket.handshake(boost::asio::ssl::stream_base::server, ec);
+      }
+      boost::asio::streambuf line;
+      if (!ec) {
+        boost::asio::read_until(socket, line, "\r\n", ec);
+      }
+      if (!ec) {
+        boost::asio::write(socket, line, ec);
+      }
+      if (!ec) {
+        // Sends close_notify, then waits for the client's or for the
+        // client to close the socket.
+        socket.shutdown(ec);
+      }
+      socket.lowest_layer().close(ec);
+    }
+
+    boost::asio::io_service io_service_;
+    boost::asio::ssl::context context_;
+    tcp::acceptor acceptor_;
+    std::thread thread_;
+
+  };
+} // namespace
+
+class kernel_tls_connection_test : public ::testing::Test {
+
+protected:
+
+  kernel_tls_connection_test()
+    : context_(std::make_shared<http_cc::client_ssl_context>(
+                 http::client_options().kernel_tls(true)))
+    , connection_(io_service_, context_) { }
+
+  echo_server server_;
+  boost::asio::io_service io_service_;
+  std::shared_ptr<http_cc::client_ssl_context> context_;
+  http_cc::kernel_tls_connection connection_;
+
+};
+
+TEST_F(kernel_tls_connection_test, openssl_works_on_the_socket) {
+  boost::system::error_code connect_ec;
+  connection_.async_connect(server_.endpoint(), "localhost",
+                            [&] (const boost::system::error_code &ec) {
+                              connect_ec = ec;
+                            });
+  io_service_.run();
+  connection_.disconnect();
+  ASSERT_FALSE(connect_ec) << connect_ec.message();
+
+  // OpenSSL is asked for kernel TLS, and has the socket rather than
+  // asio's memory buffers, so nothing stops it from using kernel TLS.
+  auto ssl = connection_.native_handle();
+  ASSERT_NE(0u, SSL_get_options(ssl) & SSL_OP_ENABLE_KTLS);
+  ASSERT_EQ(BIO_TYPE_SOCKET, BIO_method_type(SSL_get_wbio(ssl)));
+  ASSERT_EQ(BIO_TYPE_SOCKET, BIO_method_type(SSL_get_rbio(ssl)));
+  if (kernel_has_tls()) {
+    ASSERT_TRUE(connection_.kernel_tls_send());
+  }
+  else {
+    // Falls back to encrypting in user space.
+    ASSERT_FALSE(connection_.kernel_tls_send());
+    ASSERT_FALSE(connection_.kernel_tls_recv());
+  }
+}
+
+TEST_F(kernel_tls_connection_test, exchanges_data_until_the_session_closes) {
+  boost::asio::streambuf request, response;
+  std::ostream(&request) << "ping\r\n";
+  boost::system::error_code write_ec, read_ec, end_ec;
+  std::string line;
+  connection_.async_connect(
+      server_.endpoint(), "localhost",
+      [&] (const boost::system::error_code &ec) {
+        ASSERT_FALSE(ec) << ec.message();
+        connection_.async_write(request, [&] (const boost::system::error_code &ec, std::size_t) {
+            write_ec = ec;
+            connection_.async_read_until(
+                response, "\r\n",
+                [&] (const boost::system::error_code &ec, std::size_t length) {
+                  read_ec = ec;
+                  line.assign(boost::asio::buffers_begin(response.data()),
+                              boost::asio::buffers_begin(response.data()) + length);
+                  response.consume(length);
+                  connection_.async_read(response, [&] (const boost::system::error_code &ec,
+                                                        std::size_t) {
+                      end_ec = ec;
+                    });
+                });
+          });
+      });
+  io_service_.run();
+  connection_.disconnect();
+  ASSERT_FALSE(write_ec) << write_ec.message();
+  ASSERT_FALSE(read_ec) << read_ec.message();
+  ASSERT_EQ("ping\r\n", line);
+  ASSERT_EQ(boost::asio::error::eof, end_ec);
+}
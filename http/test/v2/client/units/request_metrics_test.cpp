@@ -0,0 +1,79 @@
+// Copyright (C) 2026 agent (agent@local)
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+#include "network/http/v2/client/request_metrics.hpp"
+
+namespace http = network::http::v2;
+
+TEST(latency_histogram_test, empty_histogram) {
+  http::latency_histogram histogram;
+  ASSERT_EQ(0, histogram.count());
+  ASSERT_EQ(std::chrono::microseconds(0), histogram.mean());
+  ASSERT_EQ(std::chrono::microseconds(0), histogram.percentile(99));
+}
+
+TEST(latency_histogram_test, durations_are_bucketed_by_power_of_two) {
+  http::latency_histogram histogram;
+  histogram.record(std::chrono::microseconds(0));
+  histogram.record(std::chrono::microseconds(1));
+  histogram.record(std::chrono::microseconds(3));
+  histogram.record(std::chrono::microseconds(1024));
+  ASSERT_EQ(2, histogram.bucket(0));
+  ASSERT_EQ(1, histogram.bucket(1));
+  ASSERT_EQ(1, histogram.bucket(10));
+  ASSERT_EQ(4, histogram.count());
+}
+
+TEST(latency_histogram_test, percentile_is_bucket_upper_bound) {
+  http::latency_histogram histogram;
+  for (int i = 0; i < 99; ++i) {
+    histogram.record(std::chrono::microseconds(100));
+  }
+  histogram.record(std::chrono::microseconds(100000));
+  ASSERT_EQ(std::chrono::microseconds(127), histogram.percentile(50));
+  ASSERT_EQ(std::chrono::microseconds(131071), histogram.percentile(99.9));
+}
+
+TEST(latency_histogram_test, overflow_bucket_percentile_is_the_max) {
+  http::latency_histogram histogram;
+  histogram.record(std::chrono::microseconds(100));
+  histogram.record(std::chrono::hours(24));
+  ASSERT_EQ(std::chrono::microseconds(std::chrono::hours(24)), histogram.max());
+  ASSERT_EQ(std::chrono::microseconds(std::chrono::hours(24)), histogram.percentile(99));
+
+  http::latency_histogram other;
+  other.record(std::chrono::hours(48));
+  histogram.merge(other);
+  ASSERT_EQ(std::chrono::microseconds(std::chrono::hours(48)), histogram.percentile(100));
+}
+
+TEST(latency_histogram_test, merge) {
+  http::latency_histogram first, second;
+  first.record(std::chrono::microseconds(10));
+  second.record(std::chrono::microseconds(30));
+  first.merge(second);
+  ASSERT_EQ(2, first.count());
+  ASSERT_EQ(std::chrono::microseconds(20), first.mean());
+}
+
+TEST(client_metrics_test, record_timings) {
+  http::request_timings timings;
+  timings.connect = std::chrono::microseconds(500);
+  timings.bytes_written = 100;
+  timings.bytes_read = 1000;
+  timings.success = true;
+
+  http::client_metrics metrics;
+  metrics.record(timings);
+  timings.success = false;
+  metrics.record(timings);
+
+  ASSERT_EQ(2, metrics.requests);
+  ASSERT_EQ(1, metrics.failures);
+  ASSERT_EQ(200, metrics.bytes_written);
+  ASSERT_EQ(2000, metrics.bytes_read);
+  ASSERT_EQ(2, metrics.connect.bucket(8));
+}
@@ -0,0 +1,399 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef NETWORK_NO_LIB
+#undef NETWORK_NO_LIB
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <network/logging/async_log_handler.hpp>
+
+namespace network {
+namespace logging {
+namespace handler {
+namespace {
+
+// A record, copied out of a log_record. The filename and the message are
+// stored one after the other in text, or on the heap if they don't fit.
+struct slot {
+  static std::size_t const size = 256;
+
+  unsigned long line;
+  std::uint32_t filename_size;
+  std::uint32_t message_size;
+  std::string* spill;
+  log_level level;
+  char text[size - sizeof(unsigned long) - 2 * sizeof(std::uint32_t) -
+            sizeof(std::string*) - sizeof(log_level)];
+
+  char const* data() const { return spill ? spill->data() : text; }
+};
+
+// A ring of slots with one producer, the thread that logs, and one
+// consumer, the writer. Each side keeps its own copy of the other's index,
+// and only reads the shared one when its copy says the ring is full (or
+// empty).
+class ring {
+ public:
+  explicit ring(std::size_t capacity)
+      : abandoned(false), closed(false), tail_(0), head_cache_(0),
+        head_(0), tail_cache_(0) {
+    std::size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    slots_.resize(size);
+    mask_ = size - 1;
+  }
+
+  ~ring() {
+    while (slot* s = front()) {
+      delete s->spill;
+      pop();
+    }
+  }
+
+  // Producer: the slot to fill, or nullptr if the ring is full.
+  slot* claim() {
+    std::uint64_t const tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ == slots_.size()) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ == slots_.size()) {
+        return nullptr;
+      }
+    }
+    return &slots_[tail & mask_];
+  }
+
+  // Producer: makes the claimed slot visible to the writer. This is
+  // sequentially consistent so that the writer either sees it or is seen
+  // sleeping.
+  void publish() {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1);
+  }
+
+  // Consumer: the oldest slot, or nullptr if the ring is empty.
+  slot* front() {
+    std::uint64_t const head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_) {
+        return nullptr;
+      }
+    }
+    return &slots_[head & mask_];
+  }
+
+  // Consumer: frees the oldest slot.
+  void pop() {
+    head_.store(head_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  bool empty() const { return head_.load() == tail_.load(); }
+
+  std::uint64_t published() const { return tail_.load(); }
+
+  std::uint64_t consumed() const {
+    return head_.load(std::memory_order_acquire);
+  }
+
+  // Set when the thread that logs exits, so that the writer can drop the
+  // ring once it is empty.
+  std::atomic<bool> abandoned;
+
+  // Set when the handler is destroyed, so that the thread can drop it.
+  std::atomic<bool> closed;
+
+ private:
+  std::vector<slot> slots_;
+  std::size_t mask_;
+
+  // The producer's side and the consumer's side are kept on different
+  // cache lines.
+  char padding0_[64];
+  std::atomic<std::uint64_t> tail_;
+  std::uint64_t head_cache_;
+  char padding1_[64];
+  std::atomic<std::uint64_t> head_;
+  std::uint64_t tail_cache_;
+  char padding2_[64];
+};
+
+// The rings of the calling thread, one for each handler it has logged to.
+struct thread_rings {
+  ~thread_rings() {
+    for (auto& entry : rings) {
+      entry.second->abandoned.store(true);
+    }
+  }
+
+  std::vector<std::pair<std::uint64_t, std::shared_ptr<ring>>> rings;
+};
+
+thread_local thread_rings this_thread_rings;
+
+std::atomic<std::uint64_t> next_handler_id(1);
+
+}  // namespace
+
+class async_log_handler::impl {
+ public:
+  impl(std::ostream* out, log_record_handler sink,
+       async_log_options const& options)
+      : id_(next_handler_id.fetch_add(1)),
+        capacity_(options.buffer_records() ? options.buffer_records() : 1),
+        overflow_(options.overflow()),
+        out_(out),
+        sink_(std::move(sink)),
+        rings_version_(0),
+        sleeping_(false),
+        stopping_(false),
+        dropped_(0) {
+    writer_ = std::thread([this] { run(); });
+  }
+
+  ~impl() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_.store(true);
+      wake_.notify_one();
+    }
+    writer_.join();
+    for (auto& r : rings_) {
+      r->closed.store(true);
+    }
+  }
+
+  void log(const log_record& record) {
+    ring& r = this_thread_ring();
+    slot* s = r.claim();
+    if (!s) {
+      // The writer mustn't wait for itself.
+      if (overflow_ == overflow_policy::drop ||
+          std::this_thread::get_id() == writer_.get_id()) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      while (!(s = r.claim())) {
+        wake();
+        std::this_thread::yield();
+      }
+    }
+
+    char const* filename = record.filename();
+    std::size_t const filename_size = std::strlen(filename);
+    std::size_t const message_size = record.message_size();
+    s->line = record.line();
+    s->level = record.level();
+    s->filename_size = static_cast<std::uint32_t>(filename_size);
+    s->message_size = static_cast<std::uint32_t>(message_size);
+    if (filename_size + message_size <= sizeof(s->text)) {
+      s->spill = nullptr;
+      std::memcpy(s->text, filename, filename_size);
+      std::memcpy(s->text + filename_size, record.message_data(),
+                  message_size);
+    } else {
+      s->spill = new std::string(filename, filename_size);
+      s->spill->append(record.message_data(), message_size);
+    }
+    r.publish();
+
+    if (sleeping_.load()) {
+      wake();
+    }
+  }
+
+  void flush() {
+    std::vector<std::pair<std::shared_ptr<ring>, std::uint64_t>> targets;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (auto const& r : rings_) {
+        targets.emplace_back(r, r->published());
+      }
+      wake_.notify_one();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto const& target : targets) {
+      while (target.first->consumed() < target.second) {
+        wake_.notify_one();
+        drained_.wait_for(lock, std::chrono::milliseconds(10));
+      }
+    }
+  }
+
+  std::uint64_t dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  ring& this_thread_ring() {
+    auto& entries = this_thread_rings.rings;
+    for (auto const& entry : entries) {
+      if (entry.first == id_) {
+        return *entry.second;
+      }
+    }
+
+    // The first record from this thread: drop the rings of the handlers
+    // that are gone, and register a new one.
+    for (auto it = entries.begin(); it != entries.end();) {
+      it = it->second->closed.load() ? entries.erase(it) : it + 1;
+    }
+    auto r = std::make_shared<ring>(capacity_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      rings_.push_back(r);
+      rings_version_.fetch_add(1);
+    }
+    entries.emplace_back(id_, r);
+    return *r;
+  }
+
+  void wake() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wake_.notify_one();
+  }
+
+  void run() {
+    std::vector<std::shared_ptr<ring>> rings;
+    std::size_t version = rings_version_.load() - 1;
+    for (;;) {
+      if (rings_version_.load() != version) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rings = rings_;
+        version = rings_version_.load();
+      }
+
+      bool wrote = false;
+      for (auto const& r : rings) {
+        while (slot* s = r->front()) {
+          write(*s);
+          delete s->spill;
+          r->pop();
+          wrote = true;
+        }
+      }
+      if (out_ && !batch_.empty()) {
+        // One write and one flush for everything drained in this pass.
+        out_->write(batch_.data(), batch_.size());
+        out_->flush();
+        batch_.clear();
+      }
+
+      std::unique_lock<std::mutex> lock(mutex_);
+      drained_.notify_all();
+      forget_abandoned();
+      if (wrote) {
+        continue;
+      }
+      if (stopping_.load()) {
+        bool empty = true;
+        for (auto const& r : rings_) {
+          empty = empty && r->empty();
+        }
+        if (empty) {
+          return;
+        }
+        continue;
+      }
+
+      sleeping_.store(true);
+      bool empty = true;
+      for (auto const& r : rings) {
+        empty = empty && r->empty();
+      }
+      if (empty && rings_version_.load() == version) {
+        wake_.wait_for(lock, std::chrono::milliseconds(100));
+      }
+      sleeping_.store(false);
+    }
+  }
+
+  // Called with the lock held.
+  void forget_abandoned() {
+    for (auto it = rings_.begin(); it != rings_.end();) {
+      if ((*it)->abandoned.load() && (*it)->empty()) {
+        it = rings_.erase(it);
+        rings_version_.fetch_add(1);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  void write(slot const& s) {
+    char const* filename = s.data();
+    char const* message = filename + s.filename_size;
+    if (out_) {
+      batch_.append("[network ");
+      batch_.append(filename, s.filename_size);
+      batch_.push_back(':');
+      batch_.append(std::to_string(s.line));
+      batch_.append("] ");
+      batch_.append(message, s.message_size);
+      batch_.push_back('\n');
+    } else if (sink_) {
+      // The record only refers to its filename.
+      std::string const record_filename(filename, s.filename_size);
+      log_record record(record_filename.c_str(), s.line, s.level);
+      record.write(message, s.message_size);
+      sink_(record);
+    }
+  }
+
+  std::uint64_t const id_;
+  std::size_t const capacity_;
+  overflow_policy const overflow_;
+  std::ostream* out_;
+  log_record_handler sink_;
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable drained_;
+  std::vector<std::shared_ptr<ring>> rings_;
+  std::atomic<std::size_t> rings_version_;
+  std::atomic<bool> sleeping_;
+  std::atomic<bool> stopping_;
+  std::atomic<std::uint64_t> dropped_;
+
+  // Only used by the writer.
+  std::string batch_;
+  std::thread writer_;
+};
+
+async_log_handler::async_log_handler(async_log_options const& options)
+    : pimpl_(std::make_shared<impl>(&std::cerr, log_record_handler(),
+                                    options)) {}
+
+async_log_handler::async_log_handler(std::ostream& out,
+                                     async_log_options const& options)
+    : pimpl_(std::make_shared<impl>(&out, log_record_handler(), options)) {}
+
+async_log_handler::async_log_handler(log_record_handler sink,
+                                     async_log_options const& options)
+    : pimpl_(std::make_shared<impl>(nullptr, std::move(sink), options)) {}
+
+void async_log_handler::operator()(const log_record& record) const {
+  pimpl_->log(record);
+}
+
+void async_log_handler::flush() const { pimpl_->flush(); }
+
+std::uint64_t async_log_handler::dropped() const { return pimpl_->dropped(); }
+
+}  // namespace handler
+}  // namespace logging
+}  // namespace network
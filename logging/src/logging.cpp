@@ -7,8 +7,12 @@
 #undef NETWORK_NO_LIB
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <vector>
 #include <network/logging/logging.hpp>
 
 namespace network {
@@ -16,11 +20,26 @@ namespace logging {
 
 const char* log_record::UNKNOWN_FILE_NAME = "unknown";
 
+namespace detail {
+std::atomic<int> log_threshold(static_cast<int>(log_level::debug));
+}
+
+void set_log_level(log_level level) {
+  detail::log_threshold.store(static_cast<int>(level),
+                              std::memory_order_relaxed);
+}
+
+log_level get_log_level() {
+  return static_cast<log_level>(
+      detail::log_threshold.load(std::memory_order_relaxed));
+}
+
 namespace handler {
 namespace {
 void std_log_handler(const log_record& log) {
-  std::cerr << "[network " << log.filename() << ":" << log.line() << "] "
-            << log.message() << std::endl;
+  std::cerr << "[network " << log.filename() << ":" << log.line() << "] ";
+  std::cerr.write(log.message_data(), log.message_size());
+  std::cerr << std::endl;
 }
 }
 
@@ -29,22 +48,136 @@ log_record_handler get_default_log_handler() { return &std_log_handler; }
 }
 
 namespace {
-// the log handler have to manage itself the thread safety on call
-static auto current_log_record_handler = std::make_shared<log_record_handler>(
-                                             &handler::std_log_handler);
+// log() calls the current handler through a plain pointer, without touching
+// a reference count that every logging thread shares. Null means the
+// default handler.
+std::atomic<const log_record_handler*> current_log_record_handler(nullptr);
+
+// The handler a thread is calling, published so that a replaced handler
+// isn't destroyed under it.
+struct handler_in_use {
+  handler_in_use() : handler(nullptr), depth(0) {}
+
+  std::atomic<const log_record_handler*> handler;
+  int depth;  // only used by the thread itself
+};
+
+struct handler_registry {
+  ~handler_registry() {
+    // Later records go to the default handler.
+    current_log_record_handler.store(nullptr);
+  }
+
+  // Called with the lock held: takes the replaced handlers that no thread is
+  // calling any more.
+  void take_unused(std::vector<std::unique_ptr<log_record_handler>>& unused) {
+    for (auto it = replaced.begin(); it != replaced.end();) {
+      bool used = false;
+      for (handler_in_use const* in_use : threads) {
+        used = used || in_use->handler.load() == it->get();
+      }
+      if (used) {
+        ++it;
+      } else {
+        unused.push_back(std::move(*it));
+        it = replaced.erase(it);
+      }
+    }
+  }
+
+  std::mutex mutex;
+  std::unique_ptr<log_record_handler> current;
+  std::vector<std::unique_ptr<log_record_handler>> replaced;
+  std::vector<handler_in_use*> threads;
+};
+
+handler_registry& registry() {
+  static handler_registry instance;
+  return instance;
+}
+
+struct thread_handler_in_use {
+  thread_handler_in_use() : registry_(registry()) {
+    std::lock_guard<std::mutex> lock(registry_.mutex);
+    registry_.threads.push_back(&in_use);
+  }
+
+  ~thread_handler_in_use() {
+    std::lock_guard<std::mutex> lock(registry_.mutex);
+    registry_.threads.erase(std::find(registry_.threads.begin(),
+                                      registry_.threads.end(), &in_use));
+  }
+
+  handler_in_use in_use;
+
+ private:
+  handler_registry& registry_;
+};
+
+thread_local thread_handler_in_use this_thread_handler;
 
 }
 
 void set_log_record_handler(log_record_handler handler) {
-  current_log_record_handler = std::make_shared<log_record_handler>(handler);
+  std::unique_ptr<log_record_handler> next(
+      new log_record_handler(std::move(handler)));
+  std::vector<std::unique_ptr<log_record_handler>> unused;
+  {
+    handler_registry& handlers = registry();
+    std::lock_guard<std::mutex> lock(handlers.mutex);
+    current_log_record_handler.store(next.get());
+    if (handlers.current) {
+      handlers.replaced.push_back(std::move(handlers.current));
+    }
+    handlers.current = std::move(next);
+    handlers.take_unused(unused);
+  }
+  // Destroyed without the lock: an async handler joins its writer, which
+  // may be logging.
 }
 
 void log(const log_record& log) {
-  auto log_handler = current_log_record_handler;
-  if (log_handler) {
+  if (!log_enabled(log.level())) {
+    return;
+  }
+
+  handler_in_use& in_use = this_thread_handler.in_use;
+  const log_record_handler* log_handler;
+  if (in_use.depth == 0) {
+    // Publishes the handler, then checks that it is still current, so that
+    // set_log_record_handler either sees it or hasn't replaced it yet.
+    log_handler = current_log_record_handler.load();
+    for (;;) {
+      in_use.handler.store(log_handler);
+      const log_record_handler* current = current_log_record_handler.load();
+      if (current == log_handler) {
+        break;
+      }
+      log_handler = current;
+    }
+  } else {
+    // Logging from inside a handler: stay with the one being called.
+    log_handler = in_use.handler.load(std::memory_order_relaxed);
+  }
+
+  struct in_call {
+    explicit in_call(handler_in_use& in_use) : in_use(in_use) {
+      ++in_use.depth;
+    }
+    ~in_call() {
+      if (--in_use.depth == 0) {
+        in_use.handler.store(nullptr, std::memory_order_release);
+      }
+    }
+    handler_in_use& in_use;
+  } call(in_use);
+
+  if (!log_handler) {
+    handler::std_log_handler(log);
+  } else if (*log_handler) {
     (*log_handler)(log);
   }
 }
 
 }
-}
\ No newline at end of file
+}
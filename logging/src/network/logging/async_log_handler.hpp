@@ -0,0 +1,105 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_LOGGING_ASYNC_LOG_HANDLER_HPP_20261018
+#define NETWORK_LOGGING_ASYNC_LOG_HANDLER_HPP_20261018
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <network/logging/logging.hpp>
+
+namespace network {
+namespace logging {
+namespace handler {
+
+/** What a thread that logs does when its buffer is full. */
+enum class overflow_policy {
+  /** Drop the record, and count it in async_log_handler::dropped(). */
+  drop,
+  /** Wait for the writer to make room. */
+  block
+};
+
+/** Options for constructing an async_log_handler. The setters return *this
+    so that they can be chained. */
+class async_log_options {
+ public:
+  async_log_options()
+      : buffer_records_(1024), overflow_(overflow_policy::drop) {}
+
+  /** The number of records each logging thread can buffer (rounded up to a
+      power of two); 1024 by default. */
+  async_log_options& buffer_records(std::size_t count) {
+    buffer_records_ = count;
+    return *this;
+  }
+
+  std::size_t buffer_records() const { return buffer_records_; }
+
+  /** What to do when a thread's buffer is full; drop by default. */
+  async_log_options& overflow(overflow_policy policy) {
+    overflow_ = policy;
+    return *this;
+  }
+
+  overflow_policy overflow() const { return overflow_; }
+
+ private:
+  std::size_t buffer_records_;
+  overflow_policy overflow_;
+};
+
+/** A log handler that returns without doing any I/O.
+
+    Each thread that logs copies its records into a buffer of fixed-size
+    slots of its own, a ring with a single producer and a single consumer,
+    so logging threads don't wait on each other. A background thread drains
+    the buffers and hands the records on in batches: to a stream, with one
+    write and one flush per batch, or to another handler.
+
+    Copies share the same buffers and writer thread. The writer writes
+    everything that was logged and stops when the last copy is destroyed.
+
+    \code
+    network::logging::set_log_record_handler(
+        network::logging::handler::async_log_handler());
+    \endcode
+*/
+class async_log_handler {
+ public:
+  /** Writes to std::cerr. */
+  explicit async_log_handler(
+      async_log_options const& options = async_log_options());
+
+  /** Writes to a stream, which must outlive the handler. */
+  explicit async_log_handler(
+      std::ostream& out,
+      async_log_options const& options = async_log_options());
+
+  /** Hands the records to another handler, from the writer thread. */
+  explicit async_log_handler(
+      log_record_handler sink,
+      async_log_options const& options = async_log_options());
+
+  void operator()(const log_record& record) const;
+
+  /** Waits until the records logged so far have been written. */
+  void flush() const;
+
+  /** Returns the number of records dropped because a buffer was full. */
+  std::uint64_t dropped() const;
+
+ private:
+  class impl;
+  std::shared_ptr<impl> pimpl_;
+};
+
+}  // namespace handler
+}  // namespace logging
+}  // namespace network
+
+#endif /* end of include guard: NETWORK_LOGGING_ASYNC_LOG_HANDLER_HPP_20261018 */
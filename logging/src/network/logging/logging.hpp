@@ -6,8 +6,15 @@
 #ifndef NETWORK_LOGGING_HPP_20121112
 #define NETWORK_LOGGING_HPP_20121112
 
-#include <sstream>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
 #include <functional>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+#include <utility>
 
 namespace network {
 namespace logging {
@@ -17,6 +24,8 @@ class log_record;
 //using log_record_handler = std::function< void (const std::string&) >; // use this when VS can compile it...
 typedef std::function<void(const log_record&)> log_record_handler;
 
+/** Replaces the handler. The one it replaces is destroyed once no thread is
+    calling it. */
 void set_log_record_handler(log_record_handler handler);
 void log(const log_record& message);
 
@@ -25,10 +34,217 @@ log_record_handler get_std_log_handler();
 log_record_handler get_default_log_handler();
 }
 
-/** Helper to build a log record as a stream. */
+/** The severity of a log record. */
+enum class log_level {
+  debug,
+  info,
+  warning,
+  error,
+  /** Only for set_log_level(): discards every record. */
+  off
+};
+
+/** Records below level are discarded; debug (everything) by default. */
+void set_log_level(log_level level);
+log_level get_log_level();
+
+namespace detail {
+extern std::atomic<int> log_threshold;
+}
+
+/** Returns true if records of this level are logged. Checking this before
+    building a record skips the formatting of the ones that aren't. */
+inline bool log_enabled(log_level level) {
+  return static_cast<int>(level) >=
+         detail::log_threshold.load(std::memory_order_relaxed);
+}
+
+namespace detail {
+
+/** The text of a log record: kept in the record itself up to
+    inline_capacity characters, and moved to the heap only beyond that. */
+class record_buffer {
+ public:
+  static const std::size_t inline_capacity = 256;
+
+  record_buffer() : size_(0) {}
+
+  void append(const char* data, std::size_t size) {
+    if (spill_.empty() && size_ + size <= inline_capacity) {
+      std::memcpy(inline_ + size_, data, size);
+      size_ += size;
+    } else {
+      if (spill_.empty()) {
+        spill_.reserve(2 * inline_capacity + size);
+        spill_.assign(inline_, size_);
+      }
+      spill_.append(data, size);
+    }
+  }
+
+  const char* data() const { return spill_.empty() ? inline_ : spill_.data(); }
+  std::size_t size() const { return spill_.empty() ? size_ : spill_.size(); }
+
+ private:
+  char inline_[inline_capacity];
+  std::size_t size_;
+  std::string spill_;
+};
+
+/** Lets an std::ostream write into a record_buffer, for the types that
+    have no faster overload of format(). */
+class record_streambuf : public std::streambuf {
+ public:
+  explicit record_streambuf(record_buffer& buffer) : buffer_(buffer) {}
+
+ protected:
+  int_type overflow(int_type c) {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      char const ch = traits_type::to_char_type(c);
+      buffer_.append(&ch, 1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  std::streamsize xsputn(const char* data, std::streamsize size) {
+    buffer_.append(data, static_cast<std::size_t>(size));
+    return size;
+  }
+
+ private:
+  record_buffer& buffer_;
+};
+
+/** What a stream keeps between writes: manipulators such as std::hex or
+    std::setprecision change it, and it applies to the writes that follow. */
+struct stream_state {
+  stream_state()
+      : flags(std::ios_base::skipws | std::ios_base::dec),
+        precision(6),
+        width(0),
+        fill(' ') {}
+
+  // Whether text and decimal integers are written as they are, so that
+  // they can bypass the stream.
+  bool plain() const { return width == 0; }
+
+  bool plain_integers() const {
+    return plain() &&
+           (flags & (std::ios_base::oct | std::ios_base::hex |
+                     std::ios_base::showpos)) == 0;
+  }
+
+  std::ios_base::fmtflags flags;
+  std::streamsize precision;
+  std::streamsize width;
+  char fill;
+};
+
+// Writes a value through an std::ostream with the record's stream state,
+// and keeps the state it leaves.
+template <typename T>
+void format_with_stream(record_buffer& buffer, stream_state& state,
+                        const T& value) {
+  record_streambuf streambuf(buffer);
+  std::ostream stream(&streambuf);
+  stream.flags(state.flags);
+  stream.precision(state.precision);
+  stream.width(state.width);
+  stream.fill(state.fill);
+  stream << value;
+  state.flags = stream.flags();
+  state.precision = stream.precision();
+  state.width = stream.width();
+  state.fill = stream.fill();
+}
+
+inline void format(record_buffer& buffer, stream_state& state,
+                   const char* text) {
+  if (state.plain()) {
+    buffer.append(text, std::strlen(text));
+  } else {
+    format_with_stream(buffer, state, text);
+  }
+}
+
+inline void format(record_buffer& buffer, stream_state& state,
+                   const std::string& text) {
+  if (state.plain()) {
+    buffer.append(text.data(), text.size());
+  } else {
+    format_with_stream(buffer, state, text);
+  }
+}
+
+inline void format(record_buffer& buffer, stream_state& state, char c) {
+  if (state.plain()) {
+    buffer.append(&c, 1);
+  } else {
+    format_with_stream(buffer, state, c);
+  }
+}
+
+// The integers, other than bool and the character types, which a stream
+// writes as a word or as characters.
+template <typename T>
+struct is_formatted_as_integer
+    : std::integral_constant<
+          bool, std::is_integral<T>::value &&
+                    !std::is_same<T, bool>::value &&
+                    !std::is_same<T, char>::value &&
+                    !std::is_same<T, signed char>::value &&
+                    !std::is_same<T, unsigned char>::value> {};
+
+template <typename T>
+void format_value(record_buffer& buffer, stream_state& state, T value,
+                  std::true_type) {
+  if (!state.plain_integers()) {
+    format_with_stream(buffer, state, value);
+    return;
+  }
+
+  typedef typename std::make_unsigned<T>::type unsigned_type;
+  char digits[3 * sizeof(T) + 1];
+  char* first = digits + sizeof(digits);
+  bool const negative = value < T();
+  unsigned_type magnitude =
+      negative ? unsigned_type(0) - static_cast<unsigned_type>(value)
+               : static_cast<unsigned_type>(value);
+  do {
+    *--first = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (negative) {
+    *--first = '-';
+  }
+  buffer.append(first,
+                static_cast<std::size_t>(digits + sizeof(digits) - first));
+}
+
+template <typename T>
+void format_value(record_buffer& buffer, stream_state& state, const T& value,
+                  std::false_type) {
+  format_with_stream(buffer, state, value);
+}
+
+template <typename T>
+void format(record_buffer& buffer, stream_state& state, const T& value) {
+  format_value(buffer, state, value, is_formatted_as_integer<T>());
+}
+
+}  // namespace detail
+
+/** Helper to build a log record as a stream.
+
+    The message is formatted into a buffer inside the record, so building a
+    short record doesn't allocate. Manipulators such as std::hex apply to
+    the writes that follow them, as with a stream. The filename isn't copied: it must
+    outlive the record, as __FILE__ does.
+*/
 class log_record {
  public:
-  log_record() : m_filename(UNKNOWN_FILE_NAME), m_line(0) {}  // = default;
+  log_record()
+      : m_filename(UNKNOWN_FILE_NAME), m_line(0), m_level(log_level::info) {}
 
   static const char* UNKNOWN_FILE_NAME;
 
@@ -36,18 +252,26 @@ class log_record {
   template <typename TypeOfSomething>
   log_record(TypeOfSomething && message)
       : m_filename(UNKNOWN_FILE_NAME),
-        m_line(0) {
+        m_line(0),
+        m_level(log_level::info) {
     write(std::forward<TypeOfSomething>(message));
   }
 
   // Construction with recording context informations.
-  log_record(std::string filename, unsigned long line)
+  log_record(const char* filename, unsigned long line,
+             log_level level = log_level::info)
       : m_filename(filename),
-        m_line(line) {}
+        m_line(line),
+        m_level(level) {}
 
   template <typename TypeOfSomething>
   log_record& write(TypeOfSomething && something) {
-    m_text_stream << std::forward<TypeOfSomething>(something);
+    detail::format(m_text, m_state, something);
+    return *this;
+  }
+
+  log_record& write(const char* text, std::size_t size) {
+    m_text.append(text, size);
     return *this;
   }
 
@@ -56,9 +280,17 @@ class log_record {
     return write(std::forward<TypeOfSomething>(something));
   }
 
-  std::string message() const { return m_text_stream.str(); }
-  const std::string& filename() const { return m_filename; }
+  std::string message() const {
+    return std::string(m_text.data(), m_text.size());
+  }
+
+  /** The message, without copying it. It isn't null-terminated. */
+  const char* message_data() const { return m_text.data(); }
+  std::size_t message_size() const { return m_text.size(); }
+
+  const char* filename() const { return m_filename; }
   unsigned long line() const { return m_line; }
+  log_level level() const { return m_level; }
 
  private:
 
@@ -66,9 +298,11 @@ class log_record {
   log_record(const log_record&);             // = delete;
   log_record& operator=(const log_record&);  // = delete;
 
-  std::ostringstream m_text_stream;  // stream in which we build the message
-  std::string m_filename;            // = UNKNOWN_FILE_NAME;
-  unsigned long m_line;              // = 0;
+  detail::record_buffer m_text;  // buffer in which we build the message
+  detail::stream_state m_state;  // flags, precision, width and fill
+  const char* m_filename;        // = UNKNOWN_FILE_NAME;
+  unsigned long m_line;          // = 0;
+  log_level m_level;             // = log_level::info;
 };
 
 }
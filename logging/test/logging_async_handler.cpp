@@ -0,0 +1,119 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <network/logging/logging.hpp>
+#include <network/logging/async_log_handler.hpp>
+
+using namespace network::logging;
+using namespace network::logging::handler;
+
+TEST(logging_async_handler, writes_records_in_order) {
+  std::ostringstream out;
+  std::ostringstream expected;
+  {
+    async_log_handler async(out);
+    for (int i = 0; i < 100; ++i) {
+      async(log_record("somewhere.cpp", i) << "record " << i);
+      expected << "[network somewhere.cpp:" << i << "] record " << i << "\n";
+    }
+    async.flush();
+    ASSERT_EQ(expected.str(), out.str());
+  }
+}
+
+TEST(logging_async_handler, writes_long_records) {
+  std::ostringstream out;
+  std::string const message(1000, 'x');
+  {
+    async_log_handler async(out);
+    async(log_record("somewhere.cpp", 42) << message);
+  }
+  ASSERT_EQ("[network somewhere.cpp:42] " + message + "\n", out.str());
+}
+
+TEST(logging_async_handler, blocks_until_every_record_is_written) {
+  std::ostringstream out;
+  {
+    async_log_handler async(
+        out, async_log_options().buffer_records(8).overflow(overflow_policy::block));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&async] {
+        for (int i = 0; i < 1000; ++i) {
+          async(log_record("somewhere.cpp", i) << "record");
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ASSERT_EQ(0u, async.dropped());
+  }
+
+  std::string const output = out.str();
+  ASSERT_EQ(4000, std::count(output.begin(), output.end(), '\n'));
+}
+
+TEST(logging_async_handler, drops_records_when_the_buffer_is_full) {
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::size_t written = 0;
+  auto slow_sink = [&](const log_record&) {
+    released.wait();
+    ++written;
+  };
+  {
+    async_log_handler async(slow_sink, async_log_options().buffer_records(4));
+    for (int i = 0; i < 100; ++i) {
+      async(log_record("somewhere.cpp", i) << "record");
+    }
+    ASSERT_LT(0u, async.dropped());
+    release.set_value();
+    async.flush();
+    ASSERT_EQ(100u, written + async.dropped());
+  }
+}
+
+TEST(logging_async_handler, is_a_log_record_handler) {
+  std::vector<std::string> messages;
+  auto sink = [&](const log_record& record) {
+    messages.push_back(std::string(record.filename()) + ":" +
+                       record.message());
+  };
+  async_log_handler async(sink);
+  set_log_record_handler(async);
+  log(log_record("somewhere.cpp", 1) << "first");
+  log(log_record("elsewhere.cpp", 2) << "second");
+  async.flush();
+  set_log_record_handler(get_default_log_handler());
+
+  ASSERT_EQ(2u, messages.size());
+  ASSERT_EQ("somewhere.cpp:first", messages[0]);
+  ASSERT_EQ("elsewhere.cpp:second", messages[1]);
+}
+
+TEST(logging_async_handler, stops_when_replaced) {
+  auto sink_state = std::make_shared<int>(0);
+  set_log_record_handler(async_log_handler(
+      [sink_state](const log_record&) { ++*sink_state; }));
+  log(log_record("somewhere.cpp", 1) << "first");
+  ASSERT_EQ(2, sink_state.use_count());
+
+  // The handler is destroyed, and with it the writer's copy of the sink,
+  // after the writer has written what was logged and stopped.
+  set_log_record_handler(get_default_log_handler());
+  ASSERT_EQ(1, sink_state.use_count());
+  ASSERT_EQ(1, *sink_state);
+}
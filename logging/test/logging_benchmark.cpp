@@ -0,0 +1,94 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the log calls per second that 1 to 16 threads make together:
+//  - sync: a handler that writes each record to a stream under a mutex,
+//    with a flush per line, the way the default handler writes to
+//    std::cerr,
+//  - async/drop and async/block: an async_log_handler that writes to the
+//    same stream, with each overflow policy.
+// The stream discards what is written, so that the terminal doesn't set the
+// pace.
+//
+// Usage: cpp-netlib-logging_benchmark [calls per thread in thousands
+//                                      (default 200)]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+#include <network/logging/logging.hpp>
+#include <network/logging/async_log_handler.hpp>
+
+namespace {
+
+using namespace network::logging;
+
+class null_buffer : public std::streambuf {
+ protected:
+  int_type overflow(int_type c) { return traits_type::not_eof(c); }
+  std::streamsize xsputn(const char*, std::streamsize n) { return n; }
+};
+
+null_buffer discard;
+std::ostream null_stream(&discard);
+
+std::mutex sync_mutex;
+
+void sync_handler(const log_record& record) {
+  std::lock_guard<std::mutex> lock(sync_mutex);
+  null_stream << "[network " << record.filename() << ":" << record.line()
+              << "] " << record.message() << std::endl;
+}
+
+double calls_per_second(log_record_handler handler, std::size_t threads,
+                        std::size_t calls) {
+  set_log_record_handler(handler);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> loggers;
+  for (std::size_t t = 0; t < threads; ++t) {
+    loggers.emplace_back([calls] {
+      for (std::size_t i = 0; i < calls; ++i) {
+        log(log_record(__FILE__, __LINE__) << "request " << i << " done");
+      }
+    });
+  }
+  for (auto& logger : loggers) {
+    logger.join();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  set_log_record_handler(handler::get_default_log_handler());
+  return threads * calls / std::chrono::duration<double>(elapsed).count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t const calls =
+      (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200) * 1000;
+
+  std::printf("%8s %14s %14s %14s %10s\n", "threads", "sync",
+              "async/drop", "async/block", "dropped");
+  for (std::size_t threads = 1; threads <= 16; threads *= 2) {
+    double const sync = calls_per_second(sync_handler, threads, calls);
+
+    handler::async_log_handler dropping(null_stream);
+    double const drop = calls_per_second(dropping, threads, calls);
+    dropping.flush();
+
+    handler::async_log_handler blocking(
+        null_stream,
+        handler::async_log_options().overflow(handler::overflow_policy::block));
+    double const block = calls_per_second(blocking, threads, calls);
+
+    std::printf("%8zu %14.0f %14.0f %14.0f %10llu\n", threads, sync, drop,
+                block, static_cast<unsigned long long>(dropping.dropped()));
+  }
+  return 0;
+}
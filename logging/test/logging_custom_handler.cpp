@@ -3,8 +3,12 @@
 // (See accompanying file LICENSE_1_0.txt or copy at
 // http://www.boost.org/LICENSE_1_0.txt)
 
-#include <string>
+#include <atomic>
+#include <memory>
 #include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -35,3 +39,34 @@ TEST(logging_custom_handler, custom_log_handler_output) {
   ASSERT_TRUE(!result_output.empty());
   ASSERT_TRUE(result_output == "[CPPNETLIB]<somewhere.cpp:42> " + message);
 }
+
+TEST(logging_custom_handler, replace_handler_while_logging) {
+  std::atomic<bool> done(false);
+  std::atomic<std::size_t> calls(0);
+  auto counting_handler = [&calls](int generation) {
+    auto state = std::make_shared<int>(generation);
+    return [state, &calls](const log_record&) {
+      if (*state >= 0) ++calls;
+    };
+  };
+
+  set_log_record_handler(counting_handler(0));
+  std::vector<std::thread> loggers;
+  for (int t = 0; t < 4; ++t) {
+    loggers.emplace_back([&] {
+      while (!done.load()) {
+        log(log_record(__FILE__, __LINE__) << "record");
+      }
+    });
+  }
+  for (int i = 1; i <= 1000; ++i) {
+    set_log_record_handler(counting_handler(i));
+    if (i % 100 == 0) std::this_thread::yield();
+  }
+  while (calls.load() == 0) std::this_thread::yield();
+  done.store(true);
+  for (auto& logger : loggers) {
+    logger.join();
+  }
+  set_log_record_handler(handler::get_default_log_handler());
+}
@@ -0,0 +1,96 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the cost of a single log call, and the heap allocations it makes:
+//  - enabled: a record that is formatted and handed to a handler that
+//    ignores it,
+//  - filtered out: a record below the log level, which isn't formatted,
+//  - ostringstream: the same message built the way log_record used to,
+//    with an std::ostringstream and a copy of the filename.
+//
+// Usage: cpp-netlib-logging_level_benchmark [calls in thousands
+//                                            (default 1000)]
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <network/logging/logging.hpp>
+#ifndef NETWORK_ENABLE_LOGGING
+#define NETWORK_ENABLE_LOGGING
+#endif
+#include <network/detail/debug.hpp>
+
+namespace {
+std::atomic<std::size_t> allocations(0);
+}
+
+void* operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+namespace {
+
+using namespace network::logging;
+
+std::size_t ignored_size = 0;
+
+void ignoring_handler(const log_record& record) {
+  ignored_size += record.message_size();
+}
+
+template <typename Call>
+void measure(const char* name, std::size_t calls, Call call) {
+  std::size_t const allocated = allocations.load();
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < calls; ++i) {
+    call(i);
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  std::printf(
+      "%-14s %10.1f %14.2f\n", name,
+      std::chrono::duration<double, std::nano>(elapsed).count() / calls,
+      static_cast<double>(allocations.load() - allocated) / calls);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t const calls =
+      (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000) * 1000;
+  std::string const address("127.0.0.1");
+
+  set_log_record_handler(ignoring_handler);
+  std::printf("%-14s %10s %14s\n", "", "ns/call", "allocs/call");
+
+  measure("enabled", calls, [&](std::size_t i) {
+    NETWORK_LOG(info, "request " << i << " from " << address << " done");
+  });
+
+  set_log_level(log_level::warning);
+  measure("filtered out", calls, [&](std::size_t i) {
+    NETWORK_LOG(info, "request " << i << " from " << address << " done");
+  });
+  set_log_level(log_level::debug);
+
+  measure("ostringstream", calls, [&](std::size_t i) {
+    std::string const filename(__FILE__);
+    std::ostringstream text;
+    text << "request " << i << " from " << address << " done";
+    ignored_size += filename.size() + text.str().size();
+  });
+
+  set_log_record_handler(handler::get_default_log_handler());
+  return ignored_size == 0;
+}
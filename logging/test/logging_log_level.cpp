@@ -0,0 +1,76 @@
+// Copyright (c) agent (agent@local) 2026.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <network/logging/logging.hpp>
+#ifndef NETWORK_ENABLE_LOGGING
+# define NETWORK_ENABLE_LOGGING
+#endif
+#include <network/detail/debug.hpp>
+
+using namespace network::logging;
+
+namespace {
+class logging_log_level : public ::testing::Test {
+ protected:
+  void SetUp() {
+    set_log_record_handler([this](const log_record& record) {
+      messages.push_back(record.message());
+    });
+  }
+
+  void TearDown() {
+    set_log_level(log_level::debug);
+    set_log_record_handler(handler::get_default_log_handler());
+  }
+
+  std::vector<std::string> messages;
+};
+
+int formatted = 0;
+
+int count_formatting() { return ++formatted; }
+}
+
+TEST_F(logging_log_level, logs_everything_by_default) {
+  ASSERT_EQ(log_level::debug, get_log_level());
+  NETWORK_LOG(debug, "debug");
+  NETWORK_MESSAGE("info");
+  ASSERT_EQ(2u, messages.size());
+}
+
+TEST_F(logging_log_level, discards_records_below_the_level) {
+  set_log_level(log_level::warning);
+  NETWORK_LOG(info, "info");
+  NETWORK_LOG(warning, "warning");
+  NETWORK_LOG(error, "error");
+  log(log_record(__FILE__, __LINE__, log_level::debug) << "debug");
+  ASSERT_EQ(2u, messages.size());
+  ASSERT_EQ("warning", messages[0]);
+  ASSERT_EQ("error", messages[1]);
+}
+
+TEST_F(logging_log_level, does_not_format_discarded_records) {
+  formatted = 0;
+  set_log_level(log_level::error);
+  NETWORK_MESSAGE("formatted " << count_formatting());
+  ASSERT_EQ(0, formatted);
+  ASSERT_TRUE(messages.empty());
+
+  set_log_level(log_level::off);
+  NETWORK_LOG(error, "formatted " << count_formatting());
+  ASSERT_EQ(0, formatted);
+  ASSERT_TRUE(messages.empty());
+}
+
+TEST_F(logging_log_level, records_keep_their_level) {
+  log_record record(__FILE__, __LINE__, log_level::warning);
+  ASSERT_EQ(log_level::warning, record.level());
+  ASSERT_EQ(log_level::info, log_record().level());
+}
@@ -3,6 +3,9 @@
 // (See accompanying file LICENSE_1_0.txt or copy at
 // http://www.boost.org/LICENSE_1_0.txt)
 
+#include <iomanip>
+#include <limits>
+#include <sstream>
 #include <string>
 
 #include <gtest/gtest.h>
@@ -76,3 +79,40 @@ TEST(logging_log_record, macro_log) {
   NETWORK_MESSAGE("This is a log through the macro, with a stream! Num="
                   << 42 << " - OK!");
 }
+
+TEST(logging_log_record, integers) {
+  log_record record;
+  record << 0 << ' ' << -42 << ' ' << 42u << ' '
+         << std::numeric_limits<long long>::min() << ' '
+         << std::numeric_limits<unsigned long long>::max();
+  std::ostringstream expected;
+  expected << 0 << ' ' << -42 << ' ' << 42u << ' '
+           << std::numeric_limits<long long>::min() << ' '
+           << std::numeric_limits<unsigned long long>::max();
+  ASSERT_EQ(expected.str(), record.message());
+}
+
+TEST(logging_log_record, other_types_are_written_as_by_a_stream) {
+  log_record record;
+  record << 'c' << true << 1.5 << static_cast<unsigned char>('u');
+  ASSERT_EQ("c11.5u", record.message());
+}
+
+TEST(logging_log_record, long_message) {
+  const std::string part(100, 'x');
+  log_record record;
+  for (int i = 0; i < 10; ++i) {
+    record << part;
+  }
+  ASSERT_EQ(1000u, record.message_size());
+  ASSERT_EQ(std::string(1000, 'x'), record.message());
+}
+
+TEST(logging_log_record, manipulators_apply_to_the_writes_that_follow) {
+  log_record record;
+  record << std::hex << 255 << ' ' << std::setprecision(2) << 3.14159 << ' '
+         << std::boolalpha << true << ' ' << std::dec << 255 << ' '
+         << std::setw(4) << std::setfill('0') << 7 << ' ' << std::setw(3)
+         << "ab";
+  ASSERT_EQ("ff 3.1 true 255 0007 0ab", record.message());
+}
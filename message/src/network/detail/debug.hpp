@@ -13,6 +13,10 @@
     useful when NETWORK_DEBUG is turned on. Otherwise the macro amounts to a
     no-op.
 
+    NETWORK_LOG does the same with a level (debug, info, warning or error);
+    NETWORK_MESSAGE logs at info. A record below the level set with
+    network::logging::set_log_level isn't formatted at all.
+
     The user can force the logging to be enabled by defining NETWORK_ENABLE_LOGGING.
 */
 #if defined(NETWORK_DEBUG) && !defined(NETWORK_ENABLE_LOGGING)
@@ -22,16 +26,26 @@
 #ifdef NETWORK_ENABLE_LOGGING
 
 #include <network/logging/logging.hpp>
-#ifndef NETWORK_MESSAGE
-#define NETWORK_MESSAGE(msg)                                                   \
+#ifndef NETWORK_LOG
+#define NETWORK_LOG(level, msg)                                                \
   {                                                                            \
-    network::logging::log(network::logging::log_record(__FILE__, __LINE__)     \
-                          << msg);                                             \
+    if (network::logging::log_enabled(network::logging::log_level::level)) {   \
+      network::logging::log(network::logging::log_record(                      \
+                                __FILE__, __LINE__,                            \
+                                network::logging::log_level::level)            \
+                            << msg);                                           \
+    }                                                                          \
   }
 #endif
+#ifndef NETWORK_MESSAGE
+#define NETWORK_MESSAGE(msg) NETWORK_LOG(info, msg)
+#endif
 
 #else
 
+#ifndef NETWORK_LOG
+#define NETWORK_LOG(level, msg)
+#endif
 #ifndef NETWORK_MESSAGE
 #define NETWORK_MESSAGE(msg)
 #endif
@@ -22,6 +22,8 @@
 #include <network/message/modifiers/body.hpp>
 
 #include <network/message/message.hpp>
+#include <network/message/header_map.hpp>
+#include <network/message/basic_message.hpp>
 
 #ifdef NETWORK_DEBUG
 #include <network/message/message_concept.hpp>
@@ -0,0 +1,136 @@
+// Copyright 2026 agent (agent@local).
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_MESSAGE_ASCII_HPP_20261018
+#define NETWORK_MESSAGE_ASCII_HPP_20261018
+
+#include <cstdint>
+#include <cstring>
+#include <boost/utility/string_ref.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NETWORK_MESSAGE_ASCII_SSE2
+#include <emmintrin.h>
+#endif
+
+// ASCII case folding for header names, methods, schemes and the like.
+//
+// Only the letters A-Z and a-z are folded: the result does not depend on the
+// locale, and bytes outside of ASCII are left alone. Sixteen bytes are
+// folded at a time with SSE2 where it is available, and eight at a time
+// otherwise.
+namespace network {
+namespace ascii {
+namespace detail {
+
+inline char fold_char(char c, char first) {
+  return (static_cast<unsigned char>(c - first) < 26)
+             ? static_cast<char>(c ^ 0x20)
+             : c;
+}
+
+#if defined(NETWORK_MESSAGE_ASCII_SSE2)
+
+// Flips the case of the letters from first to first + 25. The comparisons
+// are signed, so bytes outside of ASCII never match.
+inline __m128i fold_block(__m128i block, char first) {
+  __m128i above = _mm_cmpgt_epi8(block, _mm_set1_epi8(first - 1));
+  __m128i below = _mm_cmplt_epi8(block, _mm_set1_epi8(first + 26));
+  __m128i flip = _mm_and_si128(_mm_and_si128(above, below),
+                               _mm_set1_epi8(0x20));
+  return _mm_xor_si128(block, flip);
+}
+
+inline void fold(char* data, std::size_t size, char first) {
+  for (; size >= 16; data += 16, size -= 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data),
+                     fold_block(block, first));
+  }
+  for (; size != 0; ++data, --size) *data = fold_char(*data, first);
+}
+
+inline bool iequals(char const* left, char const* right, std::size_t size) {
+  for (; size >= 16; left += 16, right += 16, size -= 16) {
+    __m128i l = fold_block(
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(left)), 'A');
+    __m128i r = fold_block(
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(right)), 'A');
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(l, r)) != 0xffff) return false;
+  }
+  for (; size != 0; ++left, ++right, --size)
+    if (fold_char(*left, 'A') != fold_char(*right, 'A')) return false;
+  return true;
+}
+
+#else
+
+// Flips the case of the letters from first to first + 25 in each byte of
+// a word. Bytes outside of ASCII have their high bit set and never match.
+inline std::uint64_t fold_word(std::uint64_t word, char first) {
+  const std::uint64_t ones = 0x0101010101010101ull;
+  const std::uint64_t high = 0x8080808080808080ull;
+  std::uint64_t low_bits = word & ~high;
+  std::uint64_t at_least_first =
+      low_bits + ones * (0x80 - static_cast<unsigned char>(first));
+  std::uint64_t past_last =
+      low_bits + ones * (0x80 - static_cast<unsigned char>(first + 26));
+  std::uint64_t letters = (at_least_first ^ past_last) & ~word & high;
+  return word ^ (letters >> 2);
+}
+
+inline void fold(char* data, std::size_t size, char first) {
+  for (; size >= 8; data += 8, size -= 8) {
+    std::uint64_t word;
+    std::memcpy(&word, data, 8);
+    word = fold_word(word, first);
+    std::memcpy(data, &word, 8);
+  }
+  for (; size != 0; ++data, --size) *data = fold_char(*data, first);
+}
+
+inline bool iequals(char const* left, char const* right, std::size_t size) {
+  for (; size >= 8; left += 8, right += 8, size -= 8) {
+    std::uint64_t l, r;
+    std::memcpy(&l, left, 8);
+    std::memcpy(&r, right, 8);
+    if (l != r && fold_word(l, 'A') != fold_word(r, 'A')) return false;
+  }
+  for (; size != 0; ++left, ++right, --size)
+    if (fold_char(*left, 'A') != fold_char(*right, 'A')) return false;
+  return true;
+}
+
+#endif  // defined(NETWORK_MESSAGE_ASCII_SSE2)
+
+}  // namespace detail
+
+// Converts the letters of a buffer to lower case, in place.
+inline void to_lower(char* data, std::size_t size) {
+  detail::fold(data, size, 'A');
+}
+
+// Converts the letters of a buffer to upper case, in place.
+inline void to_upper(char* data, std::size_t size) {
+  detail::fold(data, size, 'a');
+}
+
+inline char to_lower(char c) { return detail::fold_char(c, 'A'); }
+
+inline char to_upper(char c) { return detail::fold_char(c, 'a'); }
+
+// Compares two strings, ignoring the case of ASCII letters.
+inline bool iequals(boost::string_ref left, boost::string_ref right) {
+  if (left.size() != right.size()) return false;
+  if (left.empty()) return true;
+  if (std::memcmp(left.data(), right.data(), left.size()) == 0) return true;
+  return detail::iequals(left.data(), right.data(), left.size());
+}
+
+}  // namespace ascii
+}  // namespace network
+
+#endif  // NETWORK_MESSAGE_ASCII_HPP_20261018
@@ -0,0 +1,255 @@
+// Copyright 2026 agent (agent@local).
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_MESSAGE_BASIC_MESSAGE_HPP_20261018
+#define NETWORK_MESSAGE_BASIC_MESSAGE_HPP_20261018
+
+#include <string>
+#include <utility>
+#include <boost/utility/string_ref.hpp>
+#include <network/message/header_map.hpp>
+#include <network/message/message_base.hpp>
+#include <network/message/shared_body.hpp>
+
+namespace network {
+
+// The storage of a basic_message. A storage policy provides the types used
+// for the destination and source, the headers and the body.
+struct default_message_storage {
+  typedef std::string string_type;
+  typedef header_map headers_type;
+  typedef shared_body body_type;
+};
+
+// A message with no virtual functions, no pimpl and no std::function
+// callbacks, for the library internals. Everything is inline, and the
+// headers and the body are handed out by reference.
+//
+// message_adaptor wraps a basic_message in the virtual message_base
+// interface, and network::message is built on basic_message<>.
+template <class Storage = default_message_storage>
+class basic_message {
+ public:
+  typedef Storage storage_type;
+  typedef typename Storage::string_type string_type;
+  typedef typename Storage::headers_type headers_type;
+  typedef typename Storage::body_type body_type;
+
+  // Mutators
+  void set_destination(string_type destination) {
+    destination_ = std::move(destination);
+  }
+
+  void set_source(string_type source) { source_ = std::move(source); }
+
+  void append_header(boost::string_ref name, boost::string_ref value) {
+    headers_.append(name, value);
+  }
+
+  void remove_headers(boost::string_ref name) { headers_.erase(name); }
+
+  void remove_headers() { headers_.clear(); }
+
+  void apply(header_edit const& edit) { headers_.apply(edit); }
+
+  void set_body(std::string const& body) { body_.assign(body); }
+
+  void set_body(std::string&& body) { body_.assign(std::move(body)); }
+
+  void append_body(std::string const& data) { body_.append(data); }
+
+  void append_body(std::string&& data) { body_.append(std::move(data)); }
+
+  void append_body(shared_body::buffer const& data) { body_.append(data); }
+
+  // Retrievers
+  string_type const& destination() const { return destination_; }
+
+  string_type& destination() { return destination_; }
+
+  string_type const& source() const { return source_; }
+
+  string_type& source() { return source_; }
+
+  headers_type const& headers() const { return headers_; }
+
+  headers_type& headers() { return headers_; }
+
+  body_type const& body() const { return body_; }
+
+  body_type& body() { return body_; }
+
+  void swap(basic_message& other) {
+    using std::swap;
+    swap(destination_, other.destination_);
+    swap(source_, other.source_);
+    swap(headers_, other.headers_);
+    swap(body_, other.body_);
+  }
+
+ private:
+  string_type destination_, source_;
+  headers_type headers_;
+  body_type body_;
+};
+
+template <class Storage>
+inline void swap(basic_message<Storage>& left, basic_message<Storage>& right) {
+  left.swap(right);
+}
+
+// Presents a basic_message through the virtual message_base interface. The
+// adaptor refers to the message, which must outlive it.
+template <class Message>
+class message_adaptor : public message_base {
+ public:
+  explicit message_adaptor(Message& message)
+      : message_(message), read_segment_(0), read_offset_(0) {}
+
+  Message& get() const { return message_; }
+
+  // Mutators
+  virtual void set_destination(std::string const& destination) {
+    message_.set_destination(destination);
+  }
+
+  virtual void set_source(std::string const& source) {
+    message_.set_source(source);
+  }
+
+  virtual void append_header(std::string const& name,
+                             std::string const& value) {
+    message_.append_header(name, value);
+  }
+
+  virtual void remove_headers(std::string const& name) {
+    message_.remove_headers(name);
+  }
+
+  virtual void remove_headers() { message_.remove_headers(); }
+
+  virtual void apply(header_edit const& edit) { message_.apply(edit); }
+
+  virtual void set_body(std::string const& body) { message_.set_body(body); }
+
+  virtual void set_body(std::string&& body) {
+    message_.set_body(std::move(body));
+  }
+
+  virtual void append_body(std::string const& data) {
+    message_.append_body(data);
+  }
+
+  virtual void append_body(std::string&& data) {
+    message_.append_body(std::move(data));
+  }
+
+  virtual void append_body(std::shared_ptr<std::string const> data) {
+    message_.append_body(data);
+  }
+
+  // Retrievers
+  virtual void get_destination(std::string& destination) const {
+    destination = message_.destination();
+  }
+
+  virtual void get_source(std::string& source) const {
+    source = message_.source();
+  }
+
+  virtual void get_headers(std::function<
+      void(std::string const&, std::string const&)> inserter) const {
+    message_.headers().for_each([&](boost::string_ref name,
+                                    boost::string_ref value) {
+      inserter(name.to_string(), value.to_string());
+    });
+  }
+
+  virtual void get_headers(
+      std::string const& name,
+      std::function<
+          void(std::string const&, std::string const&)> inserter) const {
+    message_.headers().for_each(name, [&](boost::string_ref name,
+                                          boost::string_ref value) {
+      inserter(name.to_string(), value.to_string());
+    });
+  }
+
+  virtual void get_headers(
+      std::function<bool(std::string const&, std::string const&)> predicate,
+      std::function<
+          void(std::string const&, std::string const&)> inserter) const {
+    message_.headers().for_each([&](boost::string_ref name,
+                                    boost::string_ref value) {
+      std::string name_string = name.to_string(),
+                  value_string = value.to_string();
+      if (predicate(name_string, value_string))
+        inserter(name_string, value_string);
+    });
+  }
+
+  virtual void get_body(std::string& body) const {
+    body.clear();
+    message_.body().flatten(body);
+  }
+
+  // Reads at most up to the end of the current segment, so that the chunk
+  // can be passed without copying it, and moves past what was read.
+  virtual void get_body(
+      std::function<void(std::string::const_iterator, size_t)> chunk_reader,
+      size_t size) const {
+    shared_body const& body = message_.body();
+    for (; read_segment_ < body.segment_count(); ++read_segment_) {
+      std::string const& segment = body.segment(read_segment_);
+      if (read_offset_ < segment.size()) {
+        size_t max_read = std::min(segment.size() - read_offset_, size);
+        std::string::const_iterator first = segment.begin() + read_offset_;
+        read_offset_ += max_read;
+        chunk_reader(first, max_read);
+        return;
+      }
+      read_offset_ = 0;
+    }
+    static std::string const empty;
+    chunk_reader(empty.end(), 0);
+  }
+
+  // Views
+  virtual void visit_headers(std::function<
+      void(boost::string_ref, boost::string_ref)> visitor) const {
+    message_.headers().for_each(visitor);
+  }
+
+  virtual void visit_body(
+      std::function<void(boost::string_ref)> visitor) const {
+    message_.body().for_each(visitor);
+  }
+
+  // Mutable views
+  virtual void modify_source(
+      std::function<void(char*, std::size_t)> modifier) {
+    if (!message_.source().empty())
+      modifier(&message_.source()[0], message_.source().size());
+  }
+
+  virtual void modify_destination(
+      std::function<void(char*, std::size_t)> modifier) {
+    if (!message_.destination().empty())
+      modifier(&message_.destination()[0], message_.destination().size());
+  }
+
+ private:
+  Message& message_;
+  mutable size_t read_segment_, read_offset_;
+};
+
+template <class Message>
+inline message_adaptor<Message> adapt(Message& message) {
+  return message_adaptor<Message>(message);
+}
+
+}  // namespace network
+
+#endif  // NETWORK_MESSAGE_BASIC_MESSAGE_HPP_20261018
@@ -10,6 +10,7 @@
 #include <network/message/directives/detail/string_directive.hpp>
 #include <network/message/directives/header.hpp>
 #include <network/message/directives/remove_header.hpp>
+#include <network/message/directives/batch.hpp>
 
 namespace network {
 
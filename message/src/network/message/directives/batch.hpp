@@ -0,0 +1,142 @@
+// Copyright 2026 agent (agent@local).
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_MESSAGE_DIRECTIVES_BATCH_HPP_20261018
+#define NETWORK_MESSAGE_DIRECTIVES_BATCH_HPP_20261018
+
+#include <cstddef>
+#include <tuple>
+#include <network/message/message_base.hpp>
+#include <network/message/header_map.hpp>
+#include <network/message/directives/header.hpp>
+#include <network/message/directives/remove_header.hpp>
+
+namespace network {
+namespace impl {
+
+// Collects the header and remove_header directives of a batch into a
+// header_edit, without allocating.
+template <std::size_t Size>
+struct header_edit_builder {
+  header_edit_builder() : removed_count(0), appended_count(0) {}
+
+  void remove(boost::string_ref name) {
+    // A header appended earlier in the batch is removed along with the
+    // message's own headers.
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < appended_count; ++i)
+      if (!header_map::iequals(appended[i].first, name))
+        appended[kept++] = appended[i];
+    appended_count = kept;
+    removed[removed_count++] = name;
+  }
+
+  void append(boost::string_ref name, boost::string_ref value) {
+    appended[appended_count++] = header_edit::header(name, value);
+  }
+
+  header_edit edit() const {
+    header_edit edit;
+    edit.removed = removed;
+    edit.removed_count = removed_count;
+    edit.appended = appended;
+    edit.appended_count = appended_count;
+    return edit;
+  }
+
+  boost::string_ref removed[Size];
+  std::size_t removed_count;
+  header_edit::header appended[Size];
+  std::size_t appended_count;
+};
+
+// Header directives are staged into the edit; every other directive is
+// applied to the message once the edit is done.
+template <std::size_t Size>
+struct stage_directive {
+  header_edit_builder<Size>& builder;
+
+  void operator()(header_directive const& directive) const {
+    builder.append(directive.name(), directive.value());
+  }
+
+  void operator()(remove_header_directive const& directive) const {
+    builder.remove(directive.name());
+  }
+
+  template <class Directive> void operator()(Directive const&) const {}
+};
+
+struct finish_directive {
+  message_base& message;
+
+  void operator()(header_directive const&) const {}
+
+  void operator()(remove_header_directive const&) const {}
+
+  template <class Directive>
+  void operator()(Directive const& directive) const {
+    directive(message);
+  }
+};
+
+template <std::size_t Index, std::size_t Size>
+struct for_each_directive {
+  template <class Tuple, class Function>
+  static void apply(Tuple const& directives, Function const& f) {
+    f(std::get<Index>(directives));
+    for_each_directive<Index + 1, Size>::apply(directives, f);
+  }
+};
+
+template <std::size_t Size>
+struct for_each_directive<Size, Size> {
+  template <class Tuple, class Function>
+  static void apply(Tuple const&, Function const&) {}
+};
+
+template <class... Directives>
+struct batch_directive {
+  explicit batch_directive(Directives const&... directives)
+      : directives_(directives...) {}
+
+  static_assert(sizeof...(Directives) != 0, "a batch needs a directive");
+
+  void operator()(message_base& msg) const {
+    static const std::size_t size = sizeof...(Directives);
+    header_edit_builder<size> builder;
+    for_each_directive<0, size>::apply(directives_,
+                                       stage_directive<size>{builder});
+    msg.apply(builder.edit());
+    for_each_directive<0, size>::apply(directives_, finish_directive{msg});
+  }
+
+ private:
+  std::tuple<Directives...> directives_;
+};
+
+}  // namespace impl
+
+// Applies several directives at once. The header and remove_header
+// directives are gathered into a single header_edit, so the headers are
+// scanned once for all the removals and reserved once for all the appends.
+// The other directives are applied after the headers are changed. For
+// header directives, the result is the same as applying the directives one
+// after the other.
+// Like the directives it holds, a batch refers to its arguments and must be
+// applied in the expression that creates it:
+//
+//     request << batch(remove_header("Content-Type"),
+//                      header("Content-Type", "text/plain"),
+//                      body(content));
+template <class... Directives>
+inline impl::batch_directive<Directives...> const batch(
+    Directives const&... directives) {
+  return impl::batch_directive<Directives...>(directives...);
+}
+
+}  // namespace network
+
+#endif  // NETWORK_MESSAGE_DIRECTIVES_BATCH_HPP_20261018
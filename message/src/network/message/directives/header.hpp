@@ -16,6 +16,8 @@ namespace impl {
 struct header_directive {
   explicit header_directive(std::string const& name, std::string const& value);
   void operator()(message_base& msg) const;
+  std::string const& name() const { return name_; }
+  std::string const& value() const { return value_; }
  private:
   std::string const& name_;
   std::string const& value_;
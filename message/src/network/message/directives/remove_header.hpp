@@ -13,6 +13,7 @@ namespace impl {
 struct remove_header_directive {
   explicit remove_header_directive(std::string const& header_name);
   void operator()(message_base& msg) const;
+  std::string const& name() const { return header_name_; }
  private:
   std::string const& header_name_;
 };
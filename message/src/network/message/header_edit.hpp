@@ -0,0 +1,42 @@
+// Copyright 2026 agent (agent@local).
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_MESSAGE_HEADER_EDIT_HPP_20261018
+#define NETWORK_MESSAGE_HEADER_EDIT_HPP_20261018
+
+#include <cstddef>
+#include <utility>
+#include <boost/utility/string_ref.hpp>
+
+namespace network {
+
+// A set of changes to the headers of a message, applied at once: every
+// header with one of the removed names is removed, then the appended
+// headers are added in order. The edit refers to names and values owned by
+// the caller.
+struct header_edit {
+  typedef boost::string_ref string_ref;
+  typedef std::pair<string_ref, string_ref> header;
+
+  header_edit()
+      : removed(0), removed_count(0), appended(0), appended_count(0) {}
+
+  // The number of characters in the appended names and values.
+  std::size_t appended_characters() const {
+    std::size_t characters = 0;
+    for (std::size_t i = 0; i < appended_count; ++i)
+      characters += appended[i].first.size() + appended[i].second.size();
+    return characters;
+  }
+
+  string_ref const* removed;
+  std::size_t removed_count;
+  header const* appended;
+  std::size_t appended_count;
+};
+
+}  // namespace network
+
+#endif  // NETWORK_MESSAGE_HEADER_EDIT_HPP_20261018
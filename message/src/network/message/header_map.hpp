@@ -0,0 +1,522 @@
+// Copyright 2026 agent (agent@local).
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_MESSAGE_HEADER_MAP_HPP_20261018
+#define NETWORK_MESSAGE_HEADER_MAP_HPP_20261018
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/optional.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <network/message/ascii.hpp>
+#include <network/message/header_edit.hpp>
+
+namespace network {
+
+// A flat, insertion-ordered container of message headers.
+//
+// Headers are visited in the order they were appended, which is the order
+// they have on the wire; the std::multimap this replaces visited them
+// sorted by name, and kept headers with the same name in insertion order.
+//
+// Names and values are stored back to back in a single character arena,
+// and each header is a small fixed-size entry holding their offsets along
+// with a hash of the case-folded name. The first entries live inline in the
+// map, so a message with a typical number of headers makes no allocation
+// besides the arena. Names are compared case-insensitively, and the most
+// common HTTP headers are indexed so that looking them up does not scan the
+// entries.
+class header_map {
+ public:
+  typedef boost::string_ref string_ref;
+
+  struct value_type {
+    string_ref name;
+    string_ref value;
+  };
+
+  class const_iterator;
+
+  static const std::size_t inline_capacity = 16;
+
+  header_map()
+      : data_(inline_), size_(0), capacity_(inline_capacity), garbage_(0) {
+    clear_index();
+  }
+
+  header_map(header_map const& other)
+      : data_(inline_), size_(0), capacity_(inline_capacity), garbage_(0) {
+    copy_from(other);
+  }
+
+  header_map(header_map&& other)
+      : data_(inline_), size_(0), capacity_(inline_capacity), garbage_(0) {
+    move_from(other);
+  }
+
+  header_map& operator=(header_map const& other) {
+    if (this != &other) copy_from(other);
+    return *this;
+  }
+
+  header_map& operator=(header_map&& other) {
+    if (this != &other) move_from(other);
+    return *this;
+  }
+
+  // Appends a header, keeping any other header with the same name. The
+  // name and value may refer to the headers of this map.
+  void append(string_ref name, string_ref value) {
+    if (in_arena(name) || in_arena(value)) {
+      std::string copy;
+      copy.reserve(name.size() + value.size());
+      copy.append(name.data(), name.size());
+      copy.append(value.data(), value.size());
+      append(string_ref(copy.data(), name.size()),
+             string_ref(copy.data() + name.size(), value.size()));
+      return;
+    }
+    if (arena_.capacity() == 0) arena_.reserve(initial_arena_size);
+    if (size_ == capacity_) grow(capacity_ * 2);
+    entry& e = data_[size_];
+    e.name_offset = static_cast<std::uint32_t>(arena_.size());
+    e.name_size = static_cast<std::uint32_t>(name.size());
+    arena_.append(name.data(), name.size());
+    e.value_offset = static_cast<std::uint32_t>(arena_.size());
+    e.value_size = static_cast<std::uint32_t>(value.size());
+    arena_.append(value.data(), value.size());
+    e.hash = hash(name);
+    index_entry(size_);
+    ++size_;
+  }
+
+  // Removes every header with the given name, and returns how many were
+  // removed.
+  std::size_t erase(string_ref name) {
+    std::uint32_t h = hash(name);
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < size_; ++i) {
+      if (matches(data_[i], h, name)) {
+        garbage_ += data_[i].name_size + data_[i].value_size;
+      } else {
+        data_[kept++] = data_[i];
+      }
+    }
+    std::size_t removed = size_ - kept;
+    if (removed != 0) {
+      size_ = kept;
+      if (garbage_ > arena_.size() / 2) compact();
+      rebuild_index();
+    }
+    return removed;
+  }
+
+  // Applies an edit with a single pass over the entries for the removed
+  // names, and a single reservation for the appended headers. The edit may
+  // refer to the headers of this map, even to those it removes.
+  void apply(header_edit const& edit) {
+    // Removing headers may compact the arena, and reserving room may move
+    // it, so appended headers that point into it are copied out first.
+    std::string copy;
+    bool copied = false;
+    for (std::size_t i = 0; i < edit.appended_count && !copied; ++i)
+      copied = in_arena(edit.appended[i].first) ||
+               in_arena(edit.appended[i].second);
+    if (copied) {
+      copy.reserve(edit.appended_characters());
+      for (std::size_t i = 0; i < edit.appended_count; ++i) {
+        copy.append(edit.appended[i].first.data(),
+                    edit.appended[i].first.size());
+        copy.append(edit.appended[i].second.data(),
+                    edit.appended[i].second.size());
+      }
+    }
+
+    if (edit.removed_count != 0) {
+      std::uint32_t hashes[removed_hashes];
+      std::size_t hashed = std::min<std::size_t>(edit.removed_count,
+                                                 removed_hashes);
+      for (std::size_t j = 0; j < hashed; ++j)
+        hashes[j] = hash(edit.removed[j]);
+      std::size_t kept = 0;
+      for (std::size_t i = 0; i < size_; ++i) {
+        bool removed = false;
+        for (std::size_t j = 0; j < edit.removed_count && !removed; ++j)
+          removed = matches(data_[i],
+                            j < hashed ? hashes[j] : hash(edit.removed[j]),
+                            edit.removed[j]);
+        if (removed) {
+          garbage_ += data_[i].name_size + data_[i].value_size;
+        } else {
+          data_[kept++] = data_[i];
+        }
+      }
+      if (kept != size_) {
+        size_ = kept;
+        if (garbage_ > arena_.size() / 2) compact();
+        rebuild_index();
+      }
+    }
+    if (edit.appended_count != 0) {
+      reserve(size_ + edit.appended_count,
+              std::max<std::size_t>(
+                  initial_arena_size,
+                  arena_.size() + edit.appended_characters()));
+      std::size_t offset = 0;
+      for (std::size_t i = 0; i < edit.appended_count; ++i) {
+        string_ref name = edit.appended[i].first;
+        string_ref value = edit.appended[i].second;
+        if (copied) {
+          name = string_ref(copy.data() + offset, name.size());
+          offset += name.size();
+          value = string_ref(copy.data() + offset, value.size());
+          offset += value.size();
+        }
+        append(name, value);
+      }
+    }
+  }
+
+  void clear() {
+    size_ = 0;
+    garbage_ = 0;
+    arena_.clear();
+    clear_index();
+  }
+
+  // Reserves room for a number of headers and of characters in names and
+  // values.
+  void reserve(std::size_t headers, std::size_t characters) {
+    if (headers > capacity_) grow(headers);
+    arena_.reserve(characters);
+  }
+
+  std::size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  // Gets the value of the first header with the given name.
+  boost::optional<string_ref> find(string_ref name) const {
+    std::size_t i = first(name, hash(name));
+    if (i == size_) return boost::none;
+    return value_of(data_[i]);
+  }
+
+  bool contains(string_ref name) const {
+    return first(name, hash(name)) != size_;
+  }
+
+  std::size_t count(string_ref name) const {
+    std::size_t n = 0;
+    for_each(name, [&n](string_ref, string_ref) { ++n; });
+    return n;
+  }
+
+  // Calls f(name, value) for every header, in insertion order.
+  template <class Function> void for_each(Function f) const {
+    for (std::size_t i = 0; i < size_; ++i)
+      f(name_of(data_[i]), value_of(data_[i]));
+  }
+
+  // Calls f(name, value) for every header with the given name, in insertion
+  // order.
+  template <class Function> void for_each(string_ref name, Function f) const {
+    std::uint32_t h = hash(name);
+    for (std::size_t i = first(name, h); i < size_; ++i) {
+      if (matches(data_[i], h, name)) f(name_of(data_[i]), value_of(data_[i]));
+    }
+  }
+
+  void swap(header_map& other) {
+    header_map tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  // Compares names case-insensitively and values exactly, in order.
+  bool equals(header_map const& other) const {
+    if (size_ != other.size_) return false;
+    for (std::size_t i = 0; i < size_; ++i) {
+      if (data_[i].hash != other.data_[i].hash ||
+          !iequals(name_of(data_[i]), other.name_of(other.data_[i])) ||
+          value_of(data_[i]) != other.value_of(other.data_[i]))
+        return false;
+    }
+    return true;
+  }
+
+  // Hashes a header name, ignoring case. The name is read eight bytes at a
+  // time with bit 5 of every byte set, which folds letters to lower case;
+  // the few other characters it conflates only cause a harmless collision,
+  // since matches are confirmed with iequals.
+  static std::uint32_t hash(string_ref name) {
+    const std::uint64_t fold_mask = 0x2020202020202020ull;
+    const std::uint64_t multiplier = 0x9e3779b97f4a7c15ull;
+    std::uint64_t h = name.size() * multiplier;
+    char const* data = name.data();
+    std::size_t size = name.size();
+    for (; size >= 8; data += 8, size -= 8) {
+      std::uint64_t word;
+      std::memcpy(&word, data, 8);
+      h = (h ^ (word | fold_mask)) * multiplier;
+      h ^= h >> 29;
+    }
+    if (size != 0) {
+      std::uint64_t word = 0;
+      std::memcpy(&word, data, size);
+      h = (h ^ (word | (fold_mask >> (8 * (8 - size))))) * multiplier;
+      h ^= h >> 29;
+    }
+    return static_cast<std::uint32_t>(h >> 32);
+  }
+
+  static bool iequals(string_ref left, string_ref right) {
+    return ascii::iequals(left, right);
+  }
+
+  // Gets the index slot that looking up a name goes through, or unindexed
+  // if the lookup scans the entries.
+  static std::size_t index_slot(string_ref name) {
+    return known_slot(hash(name), name);
+  }
+
+  enum { unindexed = 32 };
+
+ private:
+  struct entry {
+    std::uint32_t name_offset, name_size;
+    std::uint32_t value_offset, value_size;
+    std::uint32_t hash;
+  };
+
+  enum {
+    initial_arena_size = 512,
+    known_slots = unindexed,
+    known_buckets = 64,
+    removed_hashes = 8,
+    no_entry = 0xffff
+  };
+
+  // The headers that get an index slot: each one gets the slot of its
+  // position in this list.
+  static char const* const* known_names() {
+    static char const* const names[] = {
+        "host",          "content-length",   "content-type",
+        "connection",    "transfer-encoding", "accept",
+        "accept-encoding", "content-encoding", "user-agent",
+        "cookie",        "set-cookie",       "location",
+        "date",          "server",           "cache-control",
+        "authorization", "expect",           "upgrade",
+        0};
+    return names;
+  }
+
+  // Gets the index slot of a name, or known_slots if it is not one of the
+  // known headers. The known names are found by hash in a small
+  // open-addressed table, so names whose hashes collide still get a slot
+  // each.
+  static std::size_t known_slot(std::uint32_t h, string_ref name) {
+    struct table {
+      struct bucket {
+        string_ref name;
+        std::uint32_t hash;
+        std::size_t slot;
+      };
+      bucket buckets[known_buckets];
+      table() {
+        std::size_t slot = 0;
+        for (char const* const* name = known_names(); *name; ++name, ++slot) {
+          std::uint32_t h = hash(*name);
+          std::size_t b = h % known_buckets;
+          while (!buckets[b].name.empty()) b = (b + 1) % known_buckets;
+          buckets[b].name = *name;
+          buckets[b].hash = h;
+          buckets[b].slot = slot;
+        }
+      }
+    };
+    static const table known;
+    for (std::size_t b = h % known_buckets; !known.buckets[b].name.empty();
+         b = (b + 1) % known_buckets) {
+      if (known.buckets[b].hash == h && iequals(known.buckets[b].name, name))
+        return known.buckets[b].slot;
+    }
+    return known_slots;
+  }
+
+  string_ref name_of(entry const& e) const {
+    return string_ref(arena_.data() + e.name_offset, e.name_size);
+  }
+
+  string_ref value_of(entry const& e) const {
+    return string_ref(arena_.data() + e.value_offset, e.value_size);
+  }
+
+  // Whether a name or value points into the arena, where appending may move
+  // it.
+  bool in_arena(string_ref text) const {
+    std::less<char const*> before;
+    return !text.empty() && !before(text.data(), arena_.data()) &&
+           before(text.data(), arena_.data() + arena_.capacity());
+  }
+
+  bool matches(entry const& e, std::uint32_t h, string_ref name) const {
+    return e.hash == h && iequals(name_of(e), name);
+  }
+
+  // Gets the index of the first header with the given name, or size_.
+  std::size_t first(string_ref name, std::uint32_t h) const {
+    std::size_t slot = known_slot(h, name);
+    if (slot != known_slots) {
+      if (index_[slot] != no_entry) return index_[slot];
+      if (size_ < no_entry) return size_;
+    }
+    for (std::size_t i = 0; i < size_; ++i) {
+      if (matches(data_[i], h, name)) return i;
+    }
+    return size_;
+  }
+
+  void index_entry(std::size_t i) {
+    std::size_t slot = known_slot(data_[i].hash, name_of(data_[i]));
+    if (slot != known_slots && index_[slot] == no_entry && i < no_entry)
+      index_[slot] = static_cast<std::uint16_t>(i);
+  }
+
+  void clear_index() { std::fill(index_, index_ + known_slots, no_entry); }
+
+  void rebuild_index() {
+    clear_index();
+    for (std::size_t i = 0; i < size_; ++i) index_entry(i);
+  }
+
+  void grow(std::size_t capacity) {
+    std::unique_ptr<entry[]> heap(new entry[capacity]);
+    std::copy(data_, data_ + size_, heap.get());
+    heap_ = std::move(heap);
+    data_ = heap_.get();
+    capacity_ = capacity;
+  }
+
+  // Drops the characters of erased headers from the arena.
+  void compact() {
+    std::string arena;
+    arena.reserve(arena_.size() - garbage_);
+    for (std::size_t i = 0; i < size_; ++i) {
+      entry& e = data_[i];
+      std::uint32_t offset = static_cast<std::uint32_t>(arena.size());
+      arena.append(arena_, e.name_offset, e.name_size);
+      arena.append(arena_, e.value_offset, e.value_size);
+      e.name_offset = offset;
+      e.value_offset = offset + e.name_size;
+    }
+    arena_.swap(arena);
+    garbage_ = 0;
+  }
+
+  void copy_from(header_map const& other) {
+    size_ = 0;
+    if (other.size_ > capacity_) grow(other.size_);
+    std::copy(other.data_, other.data_ + other.size_, data_);
+    size_ = other.size_;
+    arena_ = other.arena_;
+    garbage_ = other.garbage_;
+    std::copy(other.index_, other.index_ + known_slots, index_);
+  }
+
+  void move_from(header_map& other) {
+    if (other.data_ == other.inline_) {
+      size_ = 0;
+      if (other.size_ > capacity_) grow(other.size_);
+      std::copy(other.data_, other.data_ + other.size_, data_);
+    } else {
+      heap_ = std::move(other.heap_);
+      data_ = heap_.get();
+      capacity_ = other.capacity_;
+    }
+    size_ = other.size_;
+    arena_ = std::move(other.arena_);
+    garbage_ = other.garbage_;
+    std::copy(other.index_, other.index_ + known_slots, index_);
+    other.data_ = other.inline_;
+    other.capacity_ = inline_capacity;
+    other.clear();
+  }
+
+  entry inline_[inline_capacity];
+  std::unique_ptr<entry[]> heap_;
+  entry* data_;
+  std::size_t size_, capacity_, garbage_;
+  std::string arena_;
+  std::uint16_t index_[known_slots];
+};
+
+class header_map::const_iterator
+    : public boost::iterator_facade<const_iterator,
+                                    header_map::value_type const,
+                                    boost::random_access_traversal_tag,
+                                    header_map::value_type> {
+ public:
+  const_iterator() : map_(0), index_(0) {}
+
+ private:
+  friend class boost::iterator_core_access;
+  friend class header_map;
+
+  const_iterator(header_map const* map, std::size_t index)
+      : map_(map), index_(index) {}
+
+  header_map::value_type dereference() const {
+    header_map::value_type v = {map_->name_of(map_->data_[index_]),
+                                map_->value_of(map_->data_[index_])};
+    return v;
+  }
+
+  bool equal(const_iterator const& other) const {
+    return index_ == other.index_;
+  }
+
+  void increment() { ++index_; }
+  void decrement() { --index_; }
+  void advance(std::ptrdiff_t n) { index_ += n; }
+
+  std::ptrdiff_t distance_to(const_iterator const& other) const {
+    return static_cast<std::ptrdiff_t>(other.index_) -
+           static_cast<std::ptrdiff_t>(index_);
+  }
+
+  header_map const* map_;
+  std::size_t index_;
+};
+
+inline header_map::const_iterator header_map::begin() const {
+  return const_iterator(this, 0);
+}
+
+inline header_map::const_iterator header_map::end() const {
+  return const_iterator(this, size_);
+}
+
+inline bool operator==(header_map const& left, header_map const& right) {
+  return left.equals(right);
+}
+
+inline bool operator!=(header_map const& left, header_map const& right) {
+  return !left.equals(right);
+}
+
+inline void swap(header_map& left, header_map& right) { left.swap(right); }
+
+}  // namespace network
+
+#endif  // NETWORK_MESSAGE_HEADER_MAP_HPP_20261018
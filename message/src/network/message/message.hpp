@@ -42,6 +42,10 @@ struct message : message_base {
   virtual void remove_headers();
   virtual void set_body(std::string const& body);
   virtual void append_body(std::string const& data);
+  virtual void set_body(std::string&& body);
+  virtual void append_body(std::string&& data);
+  virtual void append_body(std::shared_ptr<std::string const> data);
+  virtual void apply(header_edit const& edit);
 
   // Retrievers
   virtual void get_destination(std::string& destination) const;
@@ -61,6 +65,18 @@ struct message : message_base {
       std::function<void(std::string::const_iterator, size_t)> chunk_reader,
       size_t size) const;
 
+  // Views
+  virtual void visit_headers(std::function<
+      void(boost::string_ref, boost::string_ref)> visitor) const;
+  virtual void visit_body(
+      std::function<void(boost::string_ref)> visitor) const;
+
+  // Mutable views
+  virtual void modify_source(
+      std::function<void(char*, std::size_t)> modifier);
+  virtual void modify_destination(
+      std::function<void(char*, std::size_t)> modifier);
+
   void swap(message& other);
 
   // Destructor
@@ -11,108 +11,79 @@
 #include <utility>
 #include <algorithm>
 #include <network/message/message.hpp>
+#include <network/message/basic_message.hpp>
 
 namespace network {
 
+// The message pimpl keeps a basic_message<> and the position of the chunked
+// body reader; network::message only adds the virtual interface on top.
 struct message_pimpl {
-  message_pimpl()
-      : destination_(),
-        source_(),
-        headers_(),
-        body_(),
-        body_read_pos(0) {}
-
-  void set_destination(std::string const& destination) {
-    destination_ = destination;
-  }
-
-  void set_source(std::string const& source) { source_ = source; }
-
-  void append_header(std::string const& name, std::string const& value) {
-    headers_.insert(std::make_pair(name, value));
-  }
+  message_pimpl() : message_(), body_read_pos(0) {}
 
-  void remove_headers(std::string const& name) { headers_.erase(name); }
+  basic_message<>& get() { return message_; }
 
-  void remove_headers() {
-    std::multimap<std::string, std::string>().swap(headers_);
-  }
-
-  void set_body(std::string const& body) { body_ = body; }
-
-  void append_body(std::string const& data) { body_.append(data); }
+  basic_message<> const& get() const { return message_; }
 
   // Retrievers
-  void get_destination(std::string& destination) const {
-    destination = destination_;
-  }
-
-  void get_source(std::string& source) const { source = source_; }
-
   void get_headers(std::function<
       void(std::string const&, std::string const&)> inserter) const {
-    std::multimap<std::string, std::string>::const_iterator it =
-        headers_.begin(), end = headers_.end();
-    for (; it != end; ++it)
-      inserter(it->first, it->second);
+    message_.headers().for_each([&](boost::string_ref name,
+                                    boost::string_ref value) {
+      inserter(name.to_string(), value.to_string());
+    });
   }
 
   void get_headers(std::string const& name,
                    std::function<void(std::string const&,
                                       std::string const&)> inserter) const {
-    std::multimap<std::string, std::string>::const_iterator it =
-        headers_.find(name), end = headers_.end();
-    while (it != end) {
-      inserter(it->first, it->second);
-      ++it;
-    }
+    message_.headers().for_each(name, [&](boost::string_ref name,
+                                          boost::string_ref value) {
+      inserter(name.to_string(), value.to_string());
+    });
   }
 
   void get_headers(
       std::function<bool(std::string const&, std::string const&)> predicate,
       std::function<
           void(std::string const&, std::string const&)> inserter) const {
-    std::multimap<std::string, std::string>::const_iterator it =
-        headers_.begin(), end = headers_.end();
-    while (it != end) {
-      if (predicate(it->first, it->second))
-        inserter(it->first, it->second);
-      ++it;
-    }
+    message_.headers().for_each([&](boost::string_ref name,
+                                    boost::string_ref value) {
+      std::string name_string = name.to_string(),
+                  value_string = value.to_string();
+      if (predicate(name_string, value_string))
+        inserter(name_string, value_string);
+    });
   }
 
-  void get_body(std::string& body) { body = body_; }
-
+  // Reads at most up to the end of the current segment, so that the chunk
+  // can be passed without copying it.
   void get_body(
       std::function<void(std::string::const_iterator, size_t)> chunk_reader,
       size_t size) const {
-    if (body_read_pos == body_.size())
-      chunk_reader(body_.end(), 0);
-    std::string::const_iterator it = body_.begin(), end = body_.end();
-    std::advance(it, body_read_pos);
-    size_t max_size = std::distance(it, end);
-    size_t max_read = std::min(max_size, size);
-    std::string::const_iterator start = it;
-    end = start;
-    std::advance(end, max_read);
-    body_read_pos += max_read;
-    chunk_reader(start, max_read);
+    shared_body const& body = message_.body();
+    size_t offset = body_read_pos;
+    for (size_t i = 0; i < body.segment_count(); ++i) {
+      std::string const& segment = body.segment(i);
+      if (offset < segment.size()) {
+        size_t max_read = std::min(segment.size() - offset, size);
+        body_read_pos += max_read;
+        chunk_reader(segment.begin() + offset, max_read);
+        return;
+      }
+      offset -= segment.size();
+    }
+    static std::string const empty;
+    chunk_reader(empty.end(), 0);
   }
 
   message_pimpl* clone() {
     message_pimpl* other = new (std::nothrow) message_pimpl;
-    other->destination_ = this->destination_;
-    other->source_ = this->source_;
-    other->headers_ = this->headers_;
-    other->body_ = this->body_;
+    other->message_ = this->message_;
     return other;
   }
 
  private:
-  std::string destination_, source_;
-  std::multimap<std::string, std::string> headers_;
-  // TODO: use Boost.IOStreams here later on.
-  std::string body_;
+  basic_message<> message_;
   mutable size_t body_read_pos;
 };
 
@@ -133,33 +104,51 @@ message& message::operator=(message && other) {
 message::~message() { delete pimpl; }
 
 void message::set_destination(std::string const& destination) {
-  pimpl->set_destination(destination);
+  pimpl->get().set_destination(destination);
 }
 
 void message::set_source(std::string const& source) {
-  pimpl->set_source(source);
+  pimpl->get().set_source(source);
 }
 
 void message::append_header(std::string const& name, std::string const& value) {
-  pimpl->append_header(name, value);
+  pimpl->get().append_header(name, value);
 }
 
 void message::remove_headers(std::string const& name) {
-  pimpl->remove_headers(name);
+  pimpl->get().remove_headers(name);
+}
+
+void message::remove_headers() { pimpl->get().remove_headers(); }
+
+void message::set_body(std::string const& body) {
+  pimpl->get().set_body(body);
+}
+
+void message::append_body(std::string const& data) {
+  pimpl->get().append_body(data);
+}
+
+void message::set_body(std::string&& body) {
+  pimpl->get().set_body(std::move(body));
 }
 
-void message::remove_headers() { pimpl->remove_headers(); }
+void message::append_body(std::string&& data) {
+  pimpl->get().append_body(std::move(data));
+}
 
-void message::set_body(std::string const& body) { pimpl->set_body(body); }
+void message::append_body(std::shared_ptr<std::string const> data) {
+  pimpl->get().append_body(data);
+}
 
-void message::append_body(std::string const& data) { pimpl->append_body(data); }
+void message::apply(header_edit const& edit) { pimpl->get().apply(edit); }
 
 void message::get_destination(std::string& destination) const {
-  pimpl->get_destination(destination);
+  destination = pimpl->get().destination();
 }
 
 void message::get_source(std::string& source) const {
-  pimpl->get_source(source);
+  source = pimpl->get().source();
 }
 
 void message::get_headers(std::function<
@@ -181,7 +170,10 @@ void message::get_headers(
   pimpl->get_headers(predicate, inserter);
 }
 
-void message::get_body(std::string& body) const { pimpl->get_body(body); }
+void message::get_body(std::string& body) const {
+  body.clear();
+  pimpl->get().body().flatten(body);
+}
 
 void message::get_body(
     std::function<void(std::string::const_iterator, size_t)> chunk_reader,
@@ -189,6 +181,28 @@ void message::get_body(
   pimpl->get_body(chunk_reader, size);
 }
 
+void message::visit_headers(std::function<
+    void(boost::string_ref, boost::string_ref)> visitor) const {
+  pimpl->get().headers().for_each(visitor);
+}
+
+void message::visit_body(
+    std::function<void(boost::string_ref)> visitor) const {
+  pimpl->get().body().for_each(visitor);
+}
+
+void message::modify_source(
+    std::function<void(char*, std::size_t)> modifier) {
+  std::string& source = pimpl->get().source();
+  if (!source.empty()) modifier(&source[0], source.size());
+}
+
+void message::modify_destination(
+    std::function<void(char*, std::size_t)> modifier) {
+  std::string& destination = pimpl->get().destination();
+  if (!destination.empty()) modifier(&destination[0], destination.size());
+}
+
 void message::swap(message& other) { std::swap(this->pimpl, other.pimpl); }
 
 } /* network */
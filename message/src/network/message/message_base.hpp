@@ -8,7 +8,11 @@
 #define NETWORK_MESSAGE_BASE_HPP_20110910
 
 #include <functional>
+#include <memory>
+#include <string>
 #include <boost/range/iterator_range.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <network/message/header_edit.hpp>
 
 namespace network {
 
@@ -23,7 +27,21 @@ struct message_base {
   virtual void set_body(std::string const& body) = 0;
   virtual void append_body(std::string const& data) = 0;
 
+  // These take the body without copying it, when the message supports it.
+  // The default implementations copy.
+  virtual void set_body(std::string&& body);
+  virtual void append_body(std::string&& data);
+  virtual void append_body(std::shared_ptr<std::string const> data);
+
+  // Applies several header changes at once; this is what a batch of
+  // directives uses. The default implementation removes and appends the
+  // headers one at a time.
+  virtual void apply(header_edit const& edit);
+
   // Retrievers
+  //
+  // The headers are passed in the order they were appended. (They used to
+  // be passed sorted by name.)
   virtual void get_destination(std::string& destination) const = 0;
   virtual void get_source(std::string& source) const = 0;
   virtual void get_headers(std::function<
@@ -41,6 +59,27 @@ struct message_base {
       size_t size) const = 0;
   virtual void get_body(std::string& body) const = 0;
 
+  // Views
+  //
+  // These pass the headers and the body to a visitor without copying them;
+  // the views are only valid during the call. The body may be passed in
+  // several chunks. The default implementations go through the copying
+  // retrievers above.
+  virtual void visit_headers(std::function<
+      void(boost::string_ref, boost::string_ref)> visitor) const;
+  virtual void visit_body(
+      std::function<void(boost::string_ref)> visitor) const;
+
+  // Mutable views
+  //
+  // These pass the source or the destination to a function that modifies
+  // its characters in place. The default implementations copy it out and
+  // set it back.
+  virtual void modify_source(
+      std::function<void(char*, std::size_t)> modifier);
+  virtual void modify_destination(
+      std::function<void(char*, std::size_t)> modifier);
+
   // Destructor
   virtual ~message_base() = 0;  // pure virtual
 };
@@ -16,6 +16,60 @@ message_base::~message_base() {
   // is a pure virtual one.
 }
 
+void message_base::set_body(std::string&& body) {
+  set_body(static_cast<std::string const&>(body));
+}
+
+void message_base::append_body(std::string&& data) {
+  append_body(static_cast<std::string const&>(data));
+}
+
+void message_base::append_body(std::shared_ptr<std::string const> data) {
+  if (data)
+    append_body(*data);
+}
+
+void message_base::apply(header_edit const& edit) {
+  for (std::size_t i = 0; i < edit.removed_count; ++i)
+    remove_headers(edit.removed[i].to_string());
+  for (std::size_t i = 0; i < edit.appended_count; ++i)
+    append_header(edit.appended[i].first.to_string(),
+                  edit.appended[i].second.to_string());
+}
+
+void message_base::visit_headers(std::function<
+    void(boost::string_ref, boost::string_ref)> visitor) const {
+  get_headers([&visitor](std::string const& name, std::string const& value) {
+    visitor(name, value);
+  });
+}
+
+void message_base::visit_body(
+    std::function<void(boost::string_ref)> visitor) const {
+  std::string body;
+  get_body(body);
+  if (!body.empty())
+    visitor(body);
+}
+
+void message_base::modify_source(
+    std::function<void(char*, std::size_t)> modifier) {
+  std::string source;
+  get_source(source);
+  if (source.empty()) return;
+  modifier(&source[0], source.size());
+  set_source(source);
+}
+
+void message_base::modify_destination(
+    std::function<void(char*, std::size_t)> modifier) {
+  std::string destination;
+  get_destination(destination);
+  if (destination.empty()) return;
+  modifier(&destination[0], destination.size());
+  set_destination(destination);
+}
+
 }  // namespace network
 
 #endif /* NETWORK_MESSAGE_BASE_IPP_20111020 */
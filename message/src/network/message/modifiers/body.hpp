@@ -13,10 +13,18 @@ inline void body(message_base& message, std::string const& body_) {
   message.set_body(body_);
 }
 
+inline void body(message_base& message, std::string&& body_) {
+  message.set_body(std::move(body_));
+}
+
 inline void append_body(message_base& message, std::string const& data) {
   message.append_body(data);
 }
 
+inline void append_body(message_base& message, std::string&& data) {
+  message.append_body(std::move(data));
+}
+
 }       // namespace network
 
 #endif  // NETWORK_MODIFIERS_BODY_HPP_20100824
@@ -0,0 +1,221 @@
+// Copyright 2026 agent (agent@local).
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETWORK_MESSAGE_SHARED_BODY_HPP_20261018
+#define NETWORK_MESSAGE_SHARED_BODY_HPP_20261018
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/utility/string_ref.hpp>
+
+namespace network {
+
+// A message body held as a list of reference-counted segments.
+//
+// Copying a body shares its segments instead of copying the bytes, and a
+// segment is never modified once it is shared: appending to a body whose
+// last segment is shared or has been handed out through segment() or
+// for_each() starts a new segment. Strings can be moved in, and
+// buffers owned elsewhere can be appended without a copy.
+class shared_body {
+ public:
+  typedef std::shared_ptr<std::string const> buffer;
+
+  // Small appends are coalesced into the last segment as long as it is not
+  // shared, has not been handed out and is smaller than coalesce_limit.
+  explicit shared_body(std::size_t coalesce_limit = 4096)
+      : coalesce_limit_(coalesce_limit), size_(0) {}
+
+  void assign(std::string const& data) {
+    clear();
+    append(data.data(), data.size());
+  }
+
+  void assign(std::string&& data) {
+    clear();
+    append(std::move(data));
+  }
+
+  void append(char const* data, std::size_t size) {
+    if (size == 0) return;
+    if (!segments_.empty() && segments_.back().owned &&
+        !tail_sealed_.value.load(std::memory_order_relaxed) &&
+        segments_.back().data.use_count() == 1 &&
+        segments_.back().data->size() < coalesce_limit_) {
+      std::string& tail = const_cast<std::string&>(*segments_.back().data);
+      tail.append(data, size);
+    } else {
+      std::shared_ptr<std::string> segment = std::make_shared<std::string>();
+      segment->reserve(std::max(size, coalesce_limit_));
+      segment->append(data, size);
+      segments_.push_back(entry(segment, true));
+      tail_sealed_.value.store(false, std::memory_order_relaxed);
+    }
+    size_ += size;
+  }
+
+  void append(std::string const& data) { append(data.data(), data.size()); }
+
+  void append(std::string&& data) {
+    if (data.size() < coalesce_limit_ / 2) {
+      append(data.data(), data.size());
+      return;
+    }
+    size_ += data.size();
+    segments_.push_back(
+        entry(std::make_shared<std::string>(std::move(data)), true));
+    tail_sealed_.value.store(false, std::memory_order_relaxed);
+  }
+
+  // Appends a buffer without copying it. The buffer must not be modified
+  // afterwards.
+  void append(buffer const& data) {
+    if (!data || data->empty()) return;
+    size_ += data->size();
+    segments_.push_back(entry(data, false));
+  }
+
+  void clear() {
+    segments_.clear();
+    tail_sealed_.value.store(false, std::memory_order_relaxed);
+    size_ = 0;
+  }
+
+  std::size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  std::size_t segment_count() const { return segments_.size(); }
+
+  // Gets a segment. Its iterators stay valid as long as the body holds it:
+  // a segment that has been handed out is never appended to in place.
+  std::string const& segment(std::size_t index) const {
+    seal();
+    return *segments_[index].data;
+  }
+
+  // Calls f(string_ref) for every segment, in order. The views stay valid
+  // as long as the body holds the segments.
+  template <class Function> void for_each(Function f) const {
+    seal();
+    for (auto const& segment : segments_)
+      f(boost::string_ref(*segment.data));
+  }
+
+  // Appends the whole body to a string.
+  void flatten(std::string& destination) const {
+    destination.reserve(destination.size() + size_);
+    for (auto const& segment : segments_) destination.append(*segment.data);
+  }
+
+  // Appends up to size bytes, starting at offset, to a string and returns
+  // the number of bytes appended.
+  std::size_t read(std::string& destination,
+                   std::size_t offset,
+                   std::size_t size) const {
+    std::size_t read_count = 0;
+    for (auto const& segment : segments_) {
+      if (size == 0) break;
+      std::string const& data = *segment.data;
+      if (offset >= data.size()) {
+        offset -= data.size();
+        continue;
+      }
+      std::size_t bytes_to_read = std::min(data.size() - offset, size);
+      destination.append(data, offset, bytes_to_read);
+      read_count += bytes_to_read;
+      size -= bytes_to_read;
+      offset = 0;
+    }
+    return read_count;
+  }
+
+  // Compares the contents of two bodies, whatever their segments.
+  bool equals(shared_body const& other) const {
+    if (size_ != other.size_) return false;
+    std::size_t i = 0, j = 0, offset = 0, other_offset = 0;
+    while (i < segments_.size() && j < other.segments_.size()) {
+      std::string const& left = *segments_[i].data;
+      std::string const& right = *other.segments_[j].data;
+      std::size_t n =
+          std::min(left.size() - offset, right.size() - other_offset);
+      if (std::memcmp(left.data() + offset, right.data() + other_offset, n))
+        return false;
+      offset += n;
+      other_offset += n;
+      if (offset == left.size()) {
+        ++i;
+        offset = 0;
+      }
+      if (other_offset == right.size()) {
+        ++j;
+        other_offset = 0;
+      }
+    }
+    return true;
+  }
+
+  void swap(shared_body& other) {
+    using std::swap;
+    swap(coalesce_limit_, other.coalesce_limit_);
+    swap(segments_, other.segments_);
+    swap(size_, other.size_);
+    bool sealed = tail_sealed_.value.load(std::memory_order_relaxed);
+    tail_sealed_.value.store(
+        other.tail_sealed_.value.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    other.tail_sealed_.value.store(sealed, std::memory_order_relaxed);
+  }
+
+ private:
+  struct entry {
+    entry(buffer data, bool owned) : data(std::move(data)), owned(owned) {}
+    buffer data;
+    // Only segments created by the body may be appended to in place.
+    bool owned;
+  };
+
+  // Set when the last segment has been handed out, so that appends stop
+  // growing it in place. Readers may set it concurrently, hence atomic.
+  struct seal_flag {
+    seal_flag() : value(false) {}
+    seal_flag(seal_flag const& other)
+        : value(other.value.load(std::memory_order_relaxed)) {}
+    seal_flag& operator=(seal_flag const& other) {
+      value.store(other.value.load(std::memory_order_relaxed),
+                  std::memory_order_relaxed);
+      return *this;
+    }
+    std::atomic<bool> value;
+  };
+
+  void seal() const {
+    if (!tail_sealed_.value.load(std::memory_order_relaxed))
+      tail_sealed_.value.store(true, std::memory_order_relaxed);
+  }
+
+  std::size_t coalesce_limit_;
+  std::vector<entry> segments_;
+  mutable seal_flag tail_sealed_;
+  std::size_t size_;
+};
+
+inline bool operator==(shared_body const& left, shared_body const& right) {
+  return left.equals(right);
+}
+
+inline bool operator!=(shared_body const& left, shared_body const& right) {
+  return !left.equals(right);
+}
+
+inline void swap(shared_body& left, shared_body& right) { left.swap(right); }
+
+}  // namespace network
+
+#endif  // NETWORK_MESSAGE_SHARED_BODY_HPP_20261018
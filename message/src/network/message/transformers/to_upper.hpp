@@ -8,14 +8,14 @@
 #ifndef NETWORK_MESSAGE_TRANSFORMERS_TO_UPPER_HPP
 #define NETWORK_MESSAGE_TRANSFORMERS_TO_UPPER_HPP
 
-#include <boost/algorithm/string.hpp>
+#include <network/message/ascii.hpp>
 #include <network/message/message_base.hpp>
 
 /** to_upper.hpp
  *
- * Implements the to_upper transformer. This applies
- * the to_upper string algorithm to a string, which
- * is selected by the appropriate selector.
+ * Implements the to_upper transformer. This converts
+ * the ASCII letters of a string to upper case in place,
+ * the string being selected by the appropriate selector.
  *
  * This defines a type, to be applied using template
  * metaprogramming on the selected string target.
@@ -27,10 +27,9 @@ template <class Selector> struct to_upper_transformer {};
 
 template <> struct to_upper_transformer<selectors::source_selector> {
   void operator()(message_base& message_) const {
-    std::string source_;
-    message_.get_source(source_);
-    boost::to_upper(source_);
-    message_.set_source(source_);
+    message_.modify_source([](char* data, std::size_t size) {
+      ascii::to_upper(data, size);
+    });
   }
 
  protected:
@@ -41,10 +40,9 @@ template <> struct to_upper_transformer<selectors::source_selector> {
 
 template <> struct to_upper_transformer<selectors::destination_selector> {
   void operator()(message_base& message_) const {
-    std::string destination_;
-    message_.get_destination(destination_);
-    boost::to_upper(destination_);
-    message_.set_destination(destination_);
+    message_.modify_destination([](char* data, std::size_t size) {
+      ascii::to_upper(data, size);
+    });
   }
 
  protected:
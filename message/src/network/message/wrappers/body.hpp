@@ -22,6 +22,8 @@ struct body_wrapper {
   std::string::const_iterator begin() const;
   std::string::const_iterator end() const;
  private:
+  std::string const& cached() const;
+
   message_base const& message_;
   mutable boost::optional<std::string> cache_;
 };
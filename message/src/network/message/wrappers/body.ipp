@@ -13,55 +13,40 @@ namespace network {
 
 body_wrapper::body_wrapper(message_base const& message) : message_(message) {}
 
-body_wrapper::operator std:: string() const {
-  if (cache_) {
-    return *cache_;
-  }
-  std::string tmp;
-  message_.get_body(tmp);
-  cache_ = tmp;
-  return *cache_;
-}
+body_wrapper::operator std:: string() const { return cached(); }
 
 std::size_t body_wrapper::size() const {
   if (cache_) {
     return cache_->size();
   }
-  std::string tmp;
-  message_.get_body(tmp);
-  cache_ = tmp;
-  return cache_->size();
+  std::size_t size = 0;
+  message_.visit_body([&size](boost::string_ref chunk) {
+    size += chunk.size();
+  });
+  return size;
 }
 
 body_wrapper::operator boost:: iterator_range< std:: string:: const_iterator>
     () const {
-  if (cache_) {
-    return boost::make_iterator_range(*cache_);
-  }
-  std::string tmp;
-  message_.get_body(tmp);
-  cache_ = tmp;
-  return boost::make_iterator_range(*cache_);
+  return boost::make_iterator_range(cached());
 }
 
 std::string::const_iterator body_wrapper::begin() const {
-  if (cache_) {
-    return cache_->begin();
-  }
-  std::string tmp;
-  message_.get_body(tmp);
-  cache_ = tmp;
-  return cache_->begin();
+  return cached().begin();
 }
 
 std::string::const_iterator body_wrapper::end() const {
-  if (cache_) {
-    return cache_->end();
+  return cached().end();
+}
+
+std::string const& body_wrapper::cached() const {
+  if (!cache_) {
+    cache_ = std::string();
+    message_.visit_body([this](boost::string_ref chunk) {
+      cache_->append(chunk.data(), chunk.size());
+    });
   }
-  std::string tmp;
-  message_.get_body(tmp);
-  cache_ = tmp;
-  return cache_->end();
+  return *cache_;
 }
 
 } /* network */
@@ -18,8 +18,8 @@ headers_wrapper::headers_wrapper(message_base const& message)
 
 template <class Map> struct kv_inserter {
   kv_inserter(Map& m) : m_(m) {}
-  void operator()(std::string const& k, std::string const& v) const {
-    m_.insert(std::make_pair(k, v));
+  void operator()(boost::string_ref k, boost::string_ref v) const {
+    m_.insert(std::make_pair(k.to_string(), v.to_string()));
   }
  private:
   Map& m_;
@@ -28,7 +28,7 @@ template <class Map> struct kv_inserter {
 headers_wrapper::operator headers_wrapper:: container_type() const {
   container_type tmp;
   kv_inserter<container_type> inserter(tmp);
-  message_.get_headers(inserter);
+  message_.visit_headers(inserter);
   return tmp;
 }
 
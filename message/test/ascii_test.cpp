@@ -0,0 +1,62 @@
+// Copyright 2026 agent (agent@local).
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+#include <network/message/ascii.hpp>
+#include <string>
+
+using namespace network;
+
+namespace {
+
+std::string lower(std::string input) {
+  ascii::to_lower(&input[0], input.size());
+  return input;
+}
+
+std::string upper(std::string input) {
+  ascii::to_upper(&input[0], input.size());
+  return input;
+}
+
+}  // namespace
+
+TEST(ascii_test, to_lower) {
+  ASSERT_EQ("content-length", lower("Content-Length"));
+  ASSERT_EQ("x-a-very-long-header-name-0123456789@[`{",
+            lower("X-A-VERY-LONG-HEADER-NAME-0123456789@[`{"));
+  ASSERT_EQ("\xc3\x89t\xc3\xa9", lower("\xc3\x89T\xc3\xa9"));
+}
+
+TEST(ascii_test, to_upper) {
+  ASSERT_EQ("CONTENT-LENGTH", upper("Content-Length"));
+  ASSERT_EQ("X-A-VERY-LONG-HEADER-NAME-0123456789@[`{",
+            upper("x-a-very-long-header-name-0123456789@[`{"));
+  ASSERT_EQ("\xc3\xa9T\xc3\x89", upper("\xc3\xa9t\xc3\x89"));
+}
+
+TEST(ascii_test, every_byte) {
+  std::string all;
+  for (int c = 0; c < 256; ++c) all.push_back(static_cast<char>(c));
+  std::string lowered = lower(all), uppered = upper(all);
+  for (int c = 0; c < 256; ++c) {
+    char expected_lower = (c >= 'A' && c <= 'Z') ? c + 32 : c;
+    char expected_upper = (c >= 'a' && c <= 'z') ? c - 32 : c;
+    ASSERT_EQ(static_cast<char>(expected_lower), lowered[c]) << c;
+    ASSERT_EQ(static_cast<char>(expected_upper), uppered[c]) << c;
+  }
+}
+
+TEST(ascii_test, iequals) {
+  ASSERT_TRUE(ascii::iequals("Content-Length", "content-LENGTH"));
+  ASSERT_TRUE(ascii::iequals("X-A-VERY-LONG-HEADER-NAME",
+                             "x-a-very-long-header-name"));
+  ASSERT_TRUE(ascii::iequals("", ""));
+  ASSERT_FALSE(ascii::iequals("Content-Length", "Content-Type"));
+  ASSERT_FALSE(ascii::iequals("X-A-VERY-LONG-HEADER-NAME",
+                              "x-a-very-long-header-namf"));
+  ASSERT_FALSE(ascii::iequals("@", "`"));
+  ASSERT_FALSE(ascii::iequals("[", "{"));
+}
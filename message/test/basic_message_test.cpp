@@ -0,0 +1,92 @@
+// Copyright 2026 agent (agent@local).
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+#include <network/message/basic_message.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace network;
+
+TEST(basic_message_test, default_constructed_is_empty) {
+  basic_message<> message;
+  ASSERT_TRUE(message.destination().empty());
+  ASSERT_TRUE(message.source().empty());
+  ASSERT_TRUE(message.headers().empty());
+  ASSERT_TRUE(message.body().empty());
+}
+
+TEST(basic_message_test, modify_and_retrieve) {
+  basic_message<> message;
+  message.set_destination("http://www.example.com/");
+  message.set_source("127.0.0.1");
+  message.append_header("Host", "www.example.com");
+  message.append_header("Accept", "*/*");
+  message.set_body("Hello, ");
+  message.append_body(std::string("World!"));
+  ASSERT_EQ("http://www.example.com/", message.destination());
+  ASSERT_EQ("127.0.0.1", message.source());
+  ASSERT_EQ("www.example.com", message.headers().find("host")->to_string());
+  std::string body;
+  message.body().flatten(body);
+  ASSERT_EQ("Hello, World!", body);
+  message.remove_headers("ACCEPT");
+  ASSERT_EQ(1u, message.headers().size());
+}
+
+TEST(basic_message_test, adaptor_forwards_to_message) {
+  basic_message<> message;
+  message_adaptor<basic_message<>> adaptor(message);
+  message_base& base = adaptor;
+  base.set_destination("http://www.example.com/");
+  base.append_header("Host", "www.example.com");
+  base.set_body(std::string("body"));
+  ASSERT_EQ("http://www.example.com/", message.destination());
+  ASSERT_TRUE(message.headers().contains("Host"));
+  std::vector<std::string> names;
+  base.get_headers([&](std::string const& name, std::string const&) {
+    names.push_back(name);
+  });
+  ASSERT_EQ(std::vector<std::string>{"Host"}, names);
+  std::string body;
+  base.get_body(body);
+  ASSERT_EQ("body", body);
+}
+
+TEST(basic_message_test, adaptor_reads_body_in_chunks) {
+  basic_message<> message;
+  message.append_body(std::make_shared<std::string const>("Hello"));
+  message.append_body(std::make_shared<std::string const>(", "));
+  message.append_body(std::make_shared<std::string const>("World!"));
+  ASSERT_EQ(3u, message.body().segment_count());
+  message_adaptor<basic_message<>> adaptor(message);
+  message_base const& base = adaptor;
+  std::string body;
+  std::vector<size_t> chunks;
+  for (int calls = 0; calls < 100; ++calls) {
+    size_t read = 0;
+    base.get_body([&](std::string::const_iterator first, size_t size) {
+      body.append(first, first + size);
+      read = size;
+    }, 4);
+    if (read == 0) break;
+    chunks.push_back(read);
+  }
+  ASSERT_EQ("Hello, World!", body);
+  ASSERT_EQ((std::vector<size_t>{4, 1, 2, 4, 2}), chunks);
+}
+
+TEST(basic_message_test, swap) {
+  basic_message<> left, right;
+  left.set_destination("left");
+  left.append_header("Host", "left.example.com");
+  right.set_body("right");
+  swap(left, right);
+  ASSERT_EQ("left", right.destination());
+  ASSERT_TRUE(right.headers().contains("host"));
+  ASSERT_TRUE(left.headers().empty());
+  ASSERT_EQ(5u, left.body().size());
+}
@@ -0,0 +1,78 @@
+// Copyright 2026 agent (agent@local).
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the Boost.StringAlgo case functions with the ASCII ones, over
+// the header names of a typical request:
+//  - to_lower: converting every name to lower case,
+//  - iequals: comparing every name with a differently cased copy of itself.
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <boost/algorithm/string.hpp>
+#include <network/message/ascii.hpp>
+
+namespace {
+
+template <class Function>
+double nanoseconds_per_iteration(std::size_t iterations, Function f) {
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i) f();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         iterations;
+}
+
+volatile std::size_t sink;
+
+}  // namespace
+
+int main() {
+  const std::size_t iterations = 200000;
+  std::vector<std::string> names = {
+      "Host", "User-Agent", "Accept", "Accept-Encoding", "Accept-Language",
+      "Connection", "Content-Type", "Content-Length", "Cookie",
+      "Cache-Control", "If-Modified-Since", "If-None-Match", "Referer",
+      "Authorization", "X-Forwarded-For", "Transfer-Encoding"};
+  std::vector<std::string> upper_names(names);
+  for (auto& name : upper_names) boost::to_upper(name);
+
+  std::vector<std::string> work(names);
+  double boost_to_lower = nanoseconds_per_iteration(iterations, [&] {
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      work[i] = names[i];
+      boost::to_lower(work[i]);
+    }
+    sink = work[0].size();
+  });
+  double ascii_to_lower = nanoseconds_per_iteration(iterations, [&] {
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      work[i] = names[i];
+      network::ascii::to_lower(&work[i][0], work[i].size());
+    }
+    sink = work[0].size();
+  });
+
+  double boost_iequals = nanoseconds_per_iteration(iterations, [&] {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < names.size(); ++i)
+      n += boost::iequals(names[i], upper_names[i]);
+    sink = n;
+  });
+  double ascii_iequals = nanoseconds_per_iteration(iterations, [&] {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < names.size(); ++i)
+      n += network::ascii::iequals(names[i], upper_names[i]);
+    sink = n;
+  });
+
+  std::printf("%zu header names\n", names.size());
+  std::printf("boost  to_lower %8.1f ns  iequals %8.1f ns\n", boost_to_lower,
+              boost_iequals);
+  std::printf("ascii  to_lower %8.1f ns  iequals %8.1f ns\n", ascii_to_lower,
+              ascii_iequals);
+  return 0;
+}
@@ -0,0 +1,113 @@
+// Copyright 2026 agent (agent@local).
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares header_map with the std::multimap it replaces, for messages with
+// 8, 16 and 32 headers:
+//  - append: building the headers of a message,
+//  - lookup: finding a known header (Content-Length) and a custom one,
+//  - iterate: visiting every header.
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include <network/message/header_map.hpp>
+
+namespace {
+
+typedef std::vector<std::pair<std::string, std::string>> header_list;
+
+header_list make_headers(std::size_t count) {
+  static char const* const common[][2] = {
+      {"Host", "www.example.com"},
+      {"User-Agent", "cpp-netlib/0.11"},
+      {"Accept", "text/html,application/xhtml+xml"},
+      {"Accept-Encoding", "gzip, deflate"},
+      {"Connection", "keep-alive"},
+      {"Content-Type", "application/json"},
+      {"Cookie", "session=0123456789abcdef"},
+      {"Content-Length", "1024"}};
+  header_list headers;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i < 8) {
+      headers.push_back(std::make_pair(common[i][0], common[i][1]));
+    } else {
+      headers.push_back(std::make_pair("X-Custom-Header-" + std::to_string(i),
+                                       "value-" + std::to_string(i)));
+    }
+  }
+  return headers;
+}
+
+template <class Function>
+double nanoseconds_per_iteration(std::size_t iterations, Function f) {
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i) f();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         iterations;
+}
+
+volatile std::size_t sink;
+
+void run(std::size_t count) {
+  const std::size_t iterations = 200000;
+  header_list input = make_headers(count);
+  std::string custom = input.back().first;
+
+  double multimap_append = nanoseconds_per_iteration(iterations, [&] {
+    std::multimap<std::string, std::string> headers;
+    for (auto const& header : input) headers.insert(header);
+    sink = headers.size();
+  });
+  double header_map_append = nanoseconds_per_iteration(iterations, [&] {
+    network::header_map headers;
+    for (auto const& header : input) headers.append(header.first, header.second);
+    sink = headers.size();
+  });
+
+  std::multimap<std::string, std::string> multimap_headers(input.begin(),
+                                                           input.end());
+  network::header_map flat_headers;
+  for (auto const& header : input)
+    flat_headers.append(header.first, header.second);
+
+  double multimap_lookup = nanoseconds_per_iteration(iterations, [&] {
+    sink = multimap_headers.count("Content-Length") +
+           multimap_headers.count(custom);
+  });
+  double header_map_lookup = nanoseconds_per_iteration(iterations, [&] {
+    sink = flat_headers.contains("content-length") +
+           flat_headers.contains(custom);
+  });
+
+  double multimap_iterate = nanoseconds_per_iteration(iterations, [&] {
+    std::size_t n = 0;
+    for (auto const& header : multimap_headers)
+      n += header.first.size() + header.second.size();
+    sink = n;
+  });
+  double header_map_iterate = nanoseconds_per_iteration(iterations, [&] {
+    std::size_t n = 0;
+    for (auto header : flat_headers) n += header.name.size() + header.value.size();
+    sink = n;
+  });
+
+  std::printf("%2zu headers  append %8.1f ns %8.1f ns  "
+              "lookup %6.1f ns %6.1f ns  iterate %6.1f ns %6.1f ns\n",
+              count, multimap_append, header_map_append, multimap_lookup,
+              header_map_lookup, multimap_iterate, header_map_iterate);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("(std::multimap first, then header_map)\n");
+  run(8);
+  run(16);
+  run(32);
+  return 0;
+}
@@ -0,0 +1,187 @@
+// Copyright 2026 agent (agent@local).
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+#include <network/message/header_map.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace network;
+
+TEST(header_map_test, default_constructed_is_empty) {
+  header_map headers;
+  ASSERT_TRUE(headers.empty());
+  ASSERT_EQ(headers.begin(), headers.end());
+  ASSERT_FALSE(headers.find("Host"));
+}
+
+TEST(header_map_test, keeps_insertion_order) {
+  header_map headers;
+  headers.append("Host", "example.com");
+  headers.append("Accept", "*/*");
+  headers.append("Content-Length", "42");
+  std::vector<std::string> names;
+  for (auto header : headers) names.push_back(header.name.to_string());
+  ASSERT_EQ((std::vector<std::string>{"Host", "Accept", "Content-Length"}),
+            names);
+}
+
+TEST(header_map_test, lookup_ignores_case) {
+  header_map headers;
+  headers.append("Content-Length", "42");
+  headers.append("X-Custom", "value");
+  ASSERT_EQ("42", headers.find("content-length")->to_string());
+  ASSERT_EQ("42", headers.find("CONTENT-LENGTH")->to_string());
+  ASSERT_EQ("value", headers.find("x-custom")->to_string());
+  ASSERT_FALSE(headers.find("Content-Type"));
+}
+
+TEST(header_map_test, finds_every_value_of_a_name) {
+  header_map headers;
+  headers.append("Set-Cookie", "a=1");
+  headers.append("Host", "example.com");
+  headers.append("set-cookie", "b=2");
+  std::vector<std::string> values;
+  headers.for_each("SET-COOKIE", [&](header_map::string_ref,
+                                     header_map::string_ref value) {
+    values.push_back(value.to_string());
+  });
+  ASSERT_EQ((std::vector<std::string>{"a=1", "b=2"}), values);
+  ASSERT_EQ(2u, headers.count("Set-Cookie"));
+}
+
+TEST(header_map_test, erase_removes_every_value_of_a_name) {
+  header_map headers;
+  headers.append("Host", "example.com");
+  headers.append("Accept", "text/html");
+  headers.append("accept", "*/*");
+  ASSERT_EQ(2u, headers.erase("ACCEPT"));
+  ASSERT_EQ(1u, headers.size());
+  ASSERT_FALSE(headers.contains("Accept"));
+  ASSERT_EQ("example.com", headers.find("host")->to_string());
+}
+
+TEST(header_map_test, erase_reindexes_known_headers) {
+  header_map headers;
+  headers.append("Accept", "*/*");
+  headers.append("Host", "example.com");
+  headers.erase("Accept");
+  ASSERT_EQ("example.com", headers.find("Host")->to_string());
+  headers.append("Accept", "text/html");
+  ASSERT_EQ("text/html", headers.find("Accept")->to_string());
+}
+
+TEST(header_map_test, grows_past_inline_capacity) {
+  header_map headers;
+  for (std::size_t i = 0; i < 3 * header_map::inline_capacity; ++i)
+    headers.append("X-Header-" + std::to_string(i), std::to_string(i));
+  headers.append("Content-Type", "text/plain");
+  ASSERT_EQ(3 * header_map::inline_capacity + 1, headers.size());
+  ASSERT_EQ("17", headers.find("x-header-17")->to_string());
+  ASSERT_EQ("text/plain", headers.find("content-type")->to_string());
+}
+
+TEST(header_map_test, copy_and_move) {
+  header_map headers;
+  headers.append("Host", "example.com");
+  header_map copy(headers);
+  ASSERT_EQ(headers, copy);
+  header_map moved(std::move(copy));
+  ASSERT_EQ(headers, moved);
+  ASSERT_TRUE(copy.empty());
+  moved.append("Accept", "*/*");
+  ASSERT_NE(headers, moved);
+}
+
+TEST(header_map_test, swap) {
+  header_map left, right;
+  left.append("Host", "example.com");
+  for (std::size_t i = 0; i < 2 * header_map::inline_capacity; ++i)
+    right.append("X-Header", std::to_string(i));
+  swap(left, right);
+  ASSERT_EQ(1u, right.size());
+  ASSERT_EQ(2 * header_map::inline_capacity, left.size());
+  ASSERT_EQ("example.com", right.find("Host")->to_string());
+}
+
+TEST(header_map_test, known_headers_have_slots_of_their_own) {
+  char const* const names[] = {
+      "host",          "content-length",    "content-type",
+      "connection",    "transfer-encoding", "accept",
+      "accept-encoding", "content-encoding", "user-agent",
+      "cookie",        "set-cookie",        "location",
+      "date",          "server",            "cache-control",
+      "authorization", "expect",            "upgrade"};
+  std::vector<std::size_t> slots;
+  for (char const* name : names) {
+    std::size_t slot = header_map::index_slot(name);
+    ASSERT_NE(std::size_t(header_map::unindexed), slot) << name;
+    ASSERT_EQ(slots.end(), std::find(slots.begin(), slots.end(), slot))
+        << name;
+    slots.push_back(slot);
+  }
+  ASSERT_EQ(std::size_t(header_map::unindexed), header_map::index_slot("X-Custom"));
+}
+
+TEST(header_map_test, finds_host_and_content_length_through_their_slots) {
+  ASSERT_NE(std::size_t(header_map::unindexed), header_map::index_slot("Host"));
+  ASSERT_NE(std::size_t(header_map::unindexed), header_map::index_slot("Content-Length"));
+  ASSERT_NE(header_map::index_slot("Host"),
+            header_map::index_slot("Content-Length"));
+  ASSERT_NE(header_map::index_slot("Content-Encoding"),
+            header_map::index_slot("Date"));
+
+  header_map headers;
+  headers.append("Location", "/elsewhere");
+  headers.append("Content-Length", "42");
+  headers.append("Host", "example.com");
+  ASSERT_EQ("example.com", headers.find("host")->to_string());
+  ASSERT_EQ("42", headers.find("CONTENT-LENGTH")->to_string());
+  ASSERT_EQ("/elsewhere", headers.find("location")->to_string());
+  headers.erase("Content-Length");
+  ASSERT_FALSE(headers.find("Content-Length"));
+  ASSERT_EQ("example.com", headers.find("Host")->to_string());
+}
+
+TEST(header_map_test, appends_its_own_headers) {
+  header_map headers;
+  headers.append("X-Seed", std::string(100, 'x'));
+  // Every append copies the previous header, and the arena grows under it.
+  for (int i = 0; i < 64; ++i) {
+    header_map::value_type last = *(headers.end() - 1);
+    headers.append(last.name, last.value);
+  }
+  ASSERT_EQ(65u, headers.count("X-Seed"));
+  headers.for_each("X-Seed", [](header_map::string_ref,
+                                header_map::string_ref value) {
+    ASSERT_EQ(std::string(100, 'x'), value.to_string());
+  });
+}
+
+TEST(header_map_test, applies_an_edit_of_its_own_headers) {
+  header_map headers;
+  headers.append("X-Old", std::string(300, 'o'));
+  headers.append("Host", "example.com");
+  for (int i = 0; i < 20; ++i) headers.append("X-Filler", "filler");
+
+  // Moves X-Old to X-New: the value comes from a removed header, and the
+  // removal compacts the arena.
+  header_map::string_ref removed[] = {"X-Old", "X-Filler"};
+  header_edit::header appended[] = {
+      {"X-New", *headers.find("X-Old")},
+      {"X-Host", *headers.find("Host")}};
+  header_edit edit;
+  edit.removed = removed;
+  edit.removed_count = 2;
+  edit.appended = appended;
+  edit.appended_count = 2;
+  headers.apply(edit);
+
+  ASSERT_EQ(3u, headers.size());
+  ASSERT_FALSE(headers.find("X-Old"));
+  ASSERT_EQ(std::string(300, 'o'), headers.find("X-New")->to_string());
+  ASSERT_EQ("example.com", headers.find("X-Host")->to_string());
+}
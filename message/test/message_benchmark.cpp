@@ -0,0 +1,133 @@
+// Copyright 2026 agent (agent@local).
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares network::message, used through message_base, with basic_message<>
+// for what a request costs the library internals:
+//  - build: setting the destination, 16 headers and a body,
+//  - read: looking up two headers, visiting every header and the body.
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <network/message/message.hpp>
+#include <network/message/basic_message.hpp>
+
+namespace {
+
+typedef std::vector<std::pair<std::string, std::string>> header_list;
+
+header_list make_headers(std::size_t count) {
+  static char const* const common[][2] = {
+      {"Host", "www.example.com"},
+      {"User-Agent", "cpp-netlib/0.11"},
+      {"Accept", "text/html,application/xhtml+xml"},
+      {"Accept-Encoding", "gzip, deflate"},
+      {"Connection", "keep-alive"},
+      {"Content-Type", "application/json"},
+      {"Cookie", "session=0123456789abcdef"},
+      {"Content-Length", "1024"}};
+  header_list headers;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i < 8) {
+      headers.push_back(std::make_pair(common[i][0], common[i][1]));
+    } else {
+      headers.push_back(std::make_pair("X-Custom-Header-" + std::to_string(i),
+                                       "value-" + std::to_string(i)));
+    }
+  }
+  return headers;
+}
+
+template <class Function>
+double nanoseconds_per_iteration(std::size_t iterations, Function f) {
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i) f();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         iterations;
+}
+
+volatile std::size_t sink;
+
+void build(network::message_base& message, header_list const& input,
+           std::string const& body) {
+  message.set_destination("http://www.example.com/index.html");
+  for (auto const& header : input)
+    message.append_header(header.first, header.second);
+  message.set_body(body);
+}
+
+void build(network::basic_message<>& message, header_list const& input,
+           std::string const& body) {
+  message.set_destination("http://www.example.com/index.html");
+  for (auto const& header : input)
+    message.append_header(header.first, header.second);
+  message.set_body(body);
+}
+
+std::size_t read(network::message_base const& message) {
+  std::size_t n = 0;
+  message.get_headers("Content-Length", [&](std::string const&,
+                                            std::string const& value) {
+    n += value.size();
+  });
+  message.get_headers("Host", [&](std::string const&,
+                                  std::string const& value) {
+    n += value.size();
+  });
+  message.visit_headers([&](boost::string_ref name, boost::string_ref value) {
+    n += name.size() + value.size();
+  });
+  message.visit_body([&](boost::string_ref chunk) { n += chunk.size(); });
+  return n;
+}
+
+std::size_t read(network::basic_message<> const& message) {
+  std::size_t n = 0;
+  n += message.headers().find("Content-Length")->size();
+  n += message.headers().find("Host")->size();
+  for (auto header : message.headers())
+    n += header.name.size() + header.value.size();
+  message.body().for_each([&](boost::string_ref chunk) { n += chunk.size(); });
+  return n;
+}
+
+}  // namespace
+
+int main() {
+  const std::size_t iterations = 200000;
+  header_list input = make_headers(16);
+  std::string body(1024, 'x');
+
+  double message_build = nanoseconds_per_iteration(iterations, [&] {
+    network::message message;
+    build(message, input, body);
+  });
+  double basic_message_build = nanoseconds_per_iteration(iterations, [&] {
+    network::basic_message<> message;
+    build(message, input, body);
+    sink = message.headers().size();
+  });
+
+  network::message message;
+  build(message, input, body);
+  network::basic_message<> fast_message;
+  build(fast_message, input, body);
+
+  double message_read = nanoseconds_per_iteration(iterations, [&] {
+    sink = read(message);
+  });
+  double basic_message_read = nanoseconds_per_iteration(iterations, [&] {
+    sink = read(fast_message);
+  });
+
+  std::printf("16 headers, 1 KiB body\n");
+  std::printf("message        build %8.1f ns  read %8.1f ns\n", message_build,
+              message_read);
+  std::printf("basic_message  build %8.1f ns  read %8.1f ns\n",
+              basic_message_build, basic_message_read);
+  return 0;
+}
@@ -8,6 +8,8 @@
 #include <gtest/gtest.h>
 #include <network/message.hpp>
 #include <algorithm>
+#include <string>
+#include <vector>
 
 using namespace network;
 
@@ -69,3 +71,44 @@ TEST(message_test, remove_header_directive) {
   message::headers_range range = instance_headers.equal_range("name");
   ASSERT_TRUE(boost::begin(range) == boost::end(range));
 }
+
+TEST(message_test, visit_headers) {
+  message instance;
+  instance << header("Host", "example.com") << header("Accept", "*/*");
+  std::vector<std::string> visited;
+  instance.visit_headers([&](boost::string_ref name, boost::string_ref value) {
+    visited.push_back(name.to_string() + ": " + value.to_string());
+  });
+  ASSERT_EQ(2u, visited.size());
+  ASSERT_EQ("Host: example.com", visited[0]);
+  ASSERT_EQ("Accept: */*", visited[1]);
+}
+
+TEST(message_test, visit_body) {
+  message instance;
+  instance << ::network::body("body");
+  std::string visited;
+  instance.visit_body([&](boost::string_ref chunk) {
+    visited.append(chunk.data(), chunk.size());
+  });
+  ASSERT_EQ("body", visited);
+  ASSERT_EQ(4u, body(instance).size());
+}
+
+TEST(message_test, batch_directive) {
+  message instance;
+  instance << header("Content-Type", "text/html") << header("Accept", "*/*");
+  instance << batch(remove_header("Content-Type"),
+                    header("Content-Type", "text/plain"),
+                    header("X-Dropped", "value"),
+                    remove_header("x-dropped"),
+                    ::network::body("body"));
+  std::vector<std::string> visited;
+  instance.visit_headers([&](boost::string_ref name, boost::string_ref value) {
+    visited.push_back(name.to_string() + ": " + value.to_string());
+  });
+  ASSERT_EQ(2u, visited.size());
+  ASSERT_EQ("Accept: */*", visited[0]);
+  ASSERT_EQ("Content-Type: text/plain", visited[1]);
+  ASSERT_EQ("body", std::string(body(instance)));
+}
@@ -0,0 +1,118 @@
+// Copyright 2026 agent (agent@local).
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+#include <network/message.hpp>
+#include <network/message/shared_body.hpp>
+#include <string>
+
+using namespace network;
+
+namespace {
+
+std::string flatten(shared_body const& body) {
+  std::string result;
+  body.flatten(result);
+  return result;
+}
+
+}  // namespace
+
+TEST(shared_body_test, coalesces_small_appends) {
+  shared_body body;
+  body.append("Hello, ");
+  body.append(std::string("World!"));
+  ASSERT_EQ(1u, body.segment_count());
+  ASSERT_EQ("Hello, World!", flatten(body));
+  ASSERT_EQ(13u, body.size());
+}
+
+TEST(shared_body_test, moves_large_strings_in) {
+  std::string payload(1 << 20, 'x');
+  char const* data = payload.data();
+  shared_body body;
+  body.assign(std::move(payload));
+  ASSERT_EQ(1u, body.segment_count());
+  ASSERT_EQ(data, body.segment(0).data());
+}
+
+TEST(shared_body_test, appends_buffers_without_copying) {
+  shared_body::buffer buffer = std::make_shared<std::string const>("data");
+  shared_body body;
+  body.append("some ");
+  body.append(buffer);
+  ASSERT_EQ(buffer->data(), body.segment(1).data());
+  ASSERT_EQ("some data", flatten(body));
+}
+
+TEST(shared_body_test, copies_share_segments) {
+  shared_body body;
+  body.append(std::string(1 << 16, 'x'));
+  shared_body copy(body);
+  ASSERT_EQ(body.segment(0).data(), copy.segment(0).data());
+  copy.append("y");
+  ASSERT_EQ(1u, body.segment_count());
+  ASSERT_EQ(2u, copy.segment_count());
+  ASSERT_EQ((1u << 16) + 1, copy.size());
+}
+
+TEST(shared_body_test, shared_segments_are_not_modified) {
+  shared_body body;
+  body.append("abc");
+  shared_body copy(body);
+  copy.append("def");
+  ASSERT_EQ("abc", flatten(body));
+  ASSERT_EQ("abcdef", flatten(copy));
+}
+
+TEST(shared_body_test, handed_out_segments_are_not_grown) {
+  shared_body body;
+  body.append("Hello, ");
+  std::string const& first = body.segment(0);
+  std::string::const_iterator begin = first.begin();
+  char const* data = first.data();
+  body.append(std::string(100, 'x'));
+  ASSERT_EQ(2u, body.segment_count());
+  ASSERT_EQ(data, first.data());
+  ASSERT_EQ("Hello, ", std::string(begin, first.end()));
+
+  std::size_t segments = 0;
+  body.for_each([&segments](boost::string_ref) { ++segments; });
+  body.append("!");
+  ASSERT_EQ(segments + 1, body.segment_count());
+  ASSERT_EQ("Hello, " + std::string(100, 'x') + "!", flatten(body));
+}
+
+TEST(shared_body_test, read_spans_segments) {
+  shared_body body(4);
+  body.append("abcd");
+  body.append("efgh");
+  body.append("ij");
+  std::string result;
+  ASSERT_EQ(5u, body.read(result, 2, 5));
+  ASSERT_EQ("cdefg", result);
+}
+
+TEST(shared_body_test, equals_ignores_segmentation) {
+  shared_body left(4), right(2);
+  left.append("abcdef");
+  right.append("ab");
+  right.append("cd");
+  right.append("ef");
+  ASSERT_EQ(left, right);
+  right.append("g");
+  ASSERT_NE(left, right);
+}
+
+TEST(shared_body_test, message_copies_share_the_body) {
+  message instance;
+  instance.set_body(std::string(1 << 16, 'x'));
+  message copy(instance);
+  char const* original = 0;
+  char const* copied = 0;
+  instance.visit_body([&](boost::string_ref chunk) { original = chunk.data(); });
+  copy.visit_body([&](boost::string_ref chunk) { copied = chunk.data(); });
+  ASSERT_EQ(original, copied);
+}
@@ -13,6 +13,11 @@
 #include <string>
 #include <vector>
 #include <iosfwd>
+#include <istream>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <cstring>
 
 #include <boost/spirit/include/qi.hpp>
 #include <boost/fusion/include/std_pair.hpp>
@@ -21,10 +26,14 @@
 #include <boost/fusion/adapted/struct.hpp>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
 #include <boost/format.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <boost/mime/codecs.hpp>
+
 
 // #define	DUMP_MIME_DATA	1
 
@@ -37,6 +46,72 @@ public:
     explicit mime_parsing_error ( const std::string & msg ) : std::runtime_error ( msg ) {}
 	};
 
+//	A body that refers to a range of a shared, immutable buffer - typically,
+//	the message it was parsed from. Copies share the buffer, so parsing a
+//	message into buffer_body parts, or copying such a part, does not copy the
+//	body data. Use it as the body_type of the traits:
+//
+//	struct my_traits {
+//		typedef	std::string string_type;
+//		typedef boost::mime::buffer_body body_type;
+//		};
+class buffer_body {
+public:
+	typedef char									value_type;
+	typedef const char *							const_iterator;
+	typedef const char *							iterator;
+	typedef std::reverse_iterator<const_iterator>	const_reverse_iterator;
+	typedef const_reverse_iterator					reverse_iterator;
+	typedef const char &							const_reference;
+	typedef const char &							reference;
+	typedef std::size_t								size_type;
+	typedef std::ptrdiff_t							difference_type;
+	typedef boost::shared_ptr<const std::vector<char> >	buffer_ptr;
+
+	buffer_body () : m_begin ( NULL ), m_end ( NULL ) {}
+
+//	Copies the range into a buffer of its own
+	template <typename Iterator>
+	buffer_body ( Iterator first, Iterator last ) {
+		boost::shared_ptr<std::vector<char> > buffer ( new std::vector<char> ( first, last ));
+		m_begin = buffer->empty () ? NULL : &(*buffer) [ 0 ];
+		m_end = m_begin + buffer->size ();
+		m_buffer = buffer;
+		}
+
+//	Refers to [first, last), which must lie in the buffer
+	buffer_body ( const buffer_ptr &buffer, const char *first, const char *last )
+		: m_buffer ( buffer ), m_begin ( first ), m_end ( last ) {}
+
+	const_iterator			begin  () const { return m_begin; }
+	const_iterator			end    () const { return m_end; }
+	const_reverse_iterator	rbegin () const { return const_reverse_iterator ( m_end ); }
+	const_reverse_iterator	rend   () const { return const_reverse_iterator ( m_begin ); }
+	const char *			data   () const { return m_begin; }
+	size_type				size   () const { return m_end - m_begin; }
+	bool					empty  () const { return m_begin == m_end; }
+	const_reference operator [] ( size_type idx ) const { return m_begin [ idx ]; }
+
+	const buffer_ptr &buffer () const { return m_buffer; }
+
+	void swap ( buffer_body &rhs ) throw () {
+		m_buffer.swap ( rhs.m_buffer );
+		std::swap ( m_begin, rhs.m_begin );
+		std::swap ( m_end,   rhs.m_end );
+		}
+
+private:
+	buffer_ptr	m_buffer;
+	const char	*m_begin;
+	const char	*m_end;
+	};
+
+inline bool operator == ( const buffer_body &lhs, const buffer_body &rhs ) {
+	return lhs.size () == rhs.size () && std::equal ( lhs.begin (), lhs.end (), rhs.begin ());
+	}
+
+inline bool operator != ( const buffer_body &lhs, const buffer_body &rhs ) { return !( lhs == rhs ); }
+
 template <class traits> class basic_mime;
 
 namespace detail {
@@ -46,6 +121,25 @@ namespace detail {
 	static const char *k_package_version		= "0.1";
 	static const char *k_content_type_header	= "Content-Type";
 	static const char *k_mime_version_header	= "Mime-Version";
+	static const char *k_content_transfer_encoding_header	= "Content-Transfer-Encoding";
+
+//	Compares a string with a name, ignoring the case of ASCII letters.
+//	Header names, types and parameter names are ASCII; unlike boost::iequals,
+//	this does not consult the locale for every character.
+	inline char ascii_fold ( char c ) {
+		return static_cast<unsigned char> ( c - 'A' ) < 26 ? static_cast<char> ( c | 0x20 ) : c;
+		}
+
+	template<typename String>
+	bool ascii_iequals ( const String &left, const char *right ) {
+		const std::size_t size = std::strlen ( right );
+		if ( left.size () != size )
+			return false;
+		for ( std::size_t i = 0; i < size; ++i )
+			if ( ascii_fold ( left [ i ] ) != ascii_fold ( right [ i ] ))
+				return false;
+		return true;
+		}
 
 	struct default_types {
 		typedef	std::string string_type;
@@ -57,7 +151,7 @@ namespace detail {
 	template<typename string_type>
 	struct find_mime_header {
 		find_mime_header ( const char *str ) : searchFor ( str ) {}
-		bool operator () ( const std::pair<std::string, string_type> &val ) const { return boost::iequals ( val.first, searchFor ); }
+		bool operator () ( const std::pair<std::string, string_type> &val ) const { return ascii_iequals ( val.first, searchFor ); }
 	private:
 		const char *searchFor;
 		};
@@ -207,7 +301,7 @@ namespace detail {
 		tracer t ( __func__ );
 		mime_content_type mc = parse_content_type ( ctString );
 		for ( phrase_container_t::const_iterator iter = mc.phrases.begin (); iter != mc.phrases.end (); ++iter )
-			if ( boost::iequals ( iter->first, key ))
+			if ( detail::ascii_iequals ( iter->first, key ))
 				return iter->second;
 		
 		throw std::runtime_error ( str ( boost::format ( "Couldn't find Content-Type phrase (%s)" ) % key ));
@@ -223,8 +317,7 @@ namespace detail {
 
 
 	//	Read the body of a multipart 
-	//	Return a Container of containers, where the first is the actual body,
-	//	and the rest are the sub-parts.
+	//	The body is split into the body (prolog), the sub-parts and the epilog.
 	//	Note that the body of the multipart can be empty.
 	//	If this is the case, then the first separator need not have a crlf
 
@@ -246,96 +339,256 @@ namespace detail {
 	//	--abcde
 	//		sub part #2
 	//	--abcde--
-	
-	typedef	std::vector<char>		sub_part_t;
-	typedef std::vector<sub_part_t>	sub_parts_t;
 
-	template<typename bodyContainer>
-	struct multipart_body_type {
-		bool							prolog_is_missing;
-		bodyContainer					body_prolog;
-		sub_parts_t						sub_parts;
-		 bodyContainer					body_epilog;	
+//	Finds a pattern in a buffer, using Boyer-Moore-Horspool.
+//	The last byte of the window is looked at first; when the window does not match,
+//	it is moved along by the distance from the end of the pattern to the last
+//	occurrence of that byte in it. For a delimiter like CRLF--boundary, most
+//	windows are rejected with a single comparison, and moved along by the
+//	length of the delimiter.
+	class boundary_searcher {
+	public:
+		explicit boundary_searcher ( const std::string &pattern = std::string ()) { reset ( pattern ); }
+
+		void reset ( const std::string &pattern ) {
+			m_pattern = pattern;
+			const std::size_t size = m_pattern.size ();
+			for ( std::size_t i = 0; i < 256; ++i )
+				m_skip [ i ] = size;
+			for ( std::size_t i = 0; i + 1 < size; ++i )
+				m_skip [ static_cast<unsigned char> ( m_pattern [ i ] ) ] = size - 1 - i;
+			}
+
+		const std::string &pattern () const { return m_pattern; }
+
+	//	Returns the start of the first occurrence of the pattern in [first, last), or last.
+		const char *find ( const char *first, const char *last ) const {
+			const std::size_t size = m_pattern.size ();
+			if ( size == 0 )
+				return first;
+			if ( static_cast<std::size_t> ( last - first ) < size )
+				return last;
+
+			const char *pattern = m_pattern.data ();
+			const char final = pattern [ size - 1 ];
+			const char *stop = last - size;
+			for ( const char *p = first; p <= stop; p += m_skip [ static_cast<unsigned char> ( p [ size - 1 ] ) ] )
+				if ( p [ size - 1 ] == final && std::memcmp ( p, pattern, size - 1 ) == 0 )
+					return p;
+			return last;
+			}
+
+	private:
+		std::string	m_pattern;
+		std::size_t	m_skip [ 256 ];
 		};
 
+//	A multipart body, as slices of the buffer that holds it.
+	template<typename Iterator>
+	struct multipart_body_type {
+		typedef std::pair<Iterator, Iterator>	slice;
 
-	//	Parse a mulitpart body.
-	//	Either "--boundaryCRLF" -- in which case the body is empty
-	//	or		<some sequence of chars> "CRLF--boundaryCRLF" -- in which case we return the sequence
-	//	
-	//	I am deliberately not checking for a termination separator here
-	template <typename Iterator, typename Container>
-	struct multipart_body_parser : qi::grammar<Iterator, Container()> {
-		multipart_body_parser( const std::string &boundary, bool &isMissing ) : multipart_body_parser::base_type(mimeBody), m_is_missing ( isMissing ) {
-			m_is_missing = false;
-		//	Thanks to Michael Caisse for the hint to get this working
-			mimeBody	%= bareSep [ phx::ref ( m_is_missing ) = true ] | (+(qi::char_ - sep) >> sep ) ;
-			bareSep	    = qi::lit("--") >> boundary >> crlf;
-			sep	        = crlf >> bareSep;
-			crlf 		= qi::lit ( k_crlf );
-			}
-	
-		bool &m_is_missing;
-		qi::rule<Iterator, Container()> mimeBody;
-		qi::rule<Iterator> bareSep, sep, crlf;
+		bool							prolog_is_missing;
+		slice							body_prolog;
+		std::vector<slice>				sub_parts;
+		slice							body_epilog;
 		};
-	
-	
-	//	Break up a multi-part into its' constituent sub parts.
-	template <typename Iterator, typename Container>
-	struct multipart_part_parser : qi::grammar<Iterator, Container()> {
-		multipart_part_parser( const std::string &boundary ) : multipart_part_parser::base_type(mimeParts) {
-			mimeParts	= (+(qi::char_ - sep) % (sep >> crlf)) > terminator ;
-			sep	        = crlf >> qi::lit("--") >> boundary ;
-			terminator	= sep >> qi::lit("--") >> crlf ;
-			crlf 		= qi::lit ( k_crlf );
+
+//	What follows a CRLF--boundary delimiter: "--" ends the multipart, and
+//	optional whitespace then CRLF starts the next sub-part.
+//	Returns the start of what follows the delimiter line.
+	inline const char *read_delimiter_end ( const char *begin, const char *end, bool &isLast ) {
+		if ( end - begin >= 2 && begin [ 0 ] == '-' && begin [ 1 ] == '-' ) {
+			isLast = true;
+			begin += 2;
+			if ( end - begin >= 2 && std::memcmp ( begin, k_crlf, 2 ) == 0 )
+				begin += 2;
+			return begin;
 			}
-		qi::rule<Iterator, Container()> mimeParts;
-		qi::rule<Iterator> sep, terminator, crlf;
-		};
 
+		isLast = false;
+		while ( begin != end && ( *begin == ' ' || *begin == '\t' ))
+			++begin;
+		if ( end - begin < 2 || std::memcmp ( begin, k_crlf, 2 ) != 0 )
+			throw mime_parsing_error ( "Failed to parse mime body(2)" );
+		return begin + 2;
+		}
 
-	template<typename Iterator, typename bodyContainer>
-	static void read_multipart_body ( Iterator &begin, Iterator end, multipart_body_type<bodyContainer> &mp_body, const std::string &separator ) {
+//	Split a multipart body into its' constituent sub parts.
+//	The parts are slices of [begin, end); nothing is copied.
+	inline void read_multipart_body ( const char *begin, const char *end, multipart_body_type<const char *> &mp_body, const std::string &separator ) {
 		tracer t ( __func__ );
-		typedef bodyContainer innerC;
-		innerC mpBody;
-		multipart_body_parser <Iterator, innerC> mb_parser (separator, mp_body.prolog_is_missing );
-		if ( !qi::parse ( begin, end, mb_parser, mp_body.body_prolog ))
-			throw mime_parsing_error ("Failed to parse mime body(1)");
-		
-		multipart_part_parser <Iterator, sub_parts_t> mp_parser ( separator );
-		if ( !qi::parse ( begin, end, mp_parser, mp_body.sub_parts ))
-			throw mime_parsing_error ( "Failed to parse mime body(2)");
-		std::copy ( begin, end, std::back_inserter ( mp_body.body_epilog ));
+		typedef multipart_body_type<const char *>::slice slice;
+
+		const boundary_searcher searcher ( std::string ( k_crlf ) + "--" + separator );
+		const std::string &delimiter = searcher.pattern ();
+
+	//	The body ends at the first delimiter. If there is no body, the
+	//	first delimiter has no CRLF in front of it.
+		const char *after;
+		if ( static_cast<std::size_t> ( end - begin ) >= delimiter.size () - 2 &&
+				std::memcmp ( begin, delimiter.data () + 2, delimiter.size () - 2 ) == 0 ) {
+			mp_body.prolog_is_missing = true;
+			mp_body.body_prolog = slice ( begin, begin );
+			after = begin + delimiter.size () - 2;
+			}
+		else {
+			const char *found = searcher.find ( begin, end );
+			if ( found == end )
+				throw mime_parsing_error ( "Failed to parse mime body(1)" );
+			mp_body.prolog_is_missing = false;
+			mp_body.body_prolog = slice ( begin, found );
+			after = found + delimiter.size ();
+			}
+
+	//	Each sub-part runs up to the next delimiter, until the closing one
+		bool isLast = false;
+		const char *part = read_delimiter_end ( after, end, isLast );
+		while ( !isLast ) {
+			const char *found = searcher.find ( part, end );
+			if ( found == end )
+				throw mime_parsing_error ( "Failed to parse mime body(2)" );
+			mp_body.sub_parts.push_back ( slice ( part, found ));
+			part = read_delimiter_end ( found + delimiter.size (), end, isLast );
+			}
+		mp_body.body_epilog = slice ( part, end );
 		
 	#ifdef	DUMP_MIME_DATA
 			std::cout << std::endl << ">>****Multipart Body*******" << std::endl;
-			std::cout << str ( boost::format ( "Body size %d, sub part count = %d, trailer size = %d %s" ) % mp_body.body_prolog.size () % mp_body.sub_parts.size () % mp_body.body_epilog.size () % ( mp_body.prolog_is_missing ? "(missing)" : "" )) << std::endl;
+			std::cout << str ( boost::format ( "Body size %d, sub part count = %d, trailer size = %d %s" ) % ( mp_body.body_prolog.second - mp_body.body_prolog.first ) % mp_body.sub_parts.size () % ( mp_body.body_epilog.second - mp_body.body_epilog.first ) % ( mp_body.prolog_is_missing ? "(missing)" : "" )) << std::endl;
 			std::cout << std::endl << "****** Multipart Body Prolog *******" << std::endl;
-			std::copy ( mp_body.body_prolog.begin (), mp_body.body_prolog.end(), std::ostream_iterator<char> ( std::cout ));
+			std::copy ( mp_body.body_prolog.first, mp_body.body_prolog.second, std::ostream_iterator<char> ( std::cout ));
 			std::cout << std::endl << "****** Multipart Body Epilog *******" << std::endl;
-			std::copy ( mp_body.body_epilog.begin (), mp_body.body_epilog.end(), std::ostream_iterator<char> ( std::cout ));
+			std::copy ( mp_body.body_epilog.first, mp_body.body_epilog.second, std::ostream_iterator<char> ( std::cout ));
 			std::cout << std::endl << "<<****Multipart Body*******" << std::endl;
 	#endif
 		}
 
+//	Messages are parsed in place when the iterators point into a contiguous
+//	buffer of chars; from any other iterators, the message is copied into a
+//	buffer first.
+	template<typename Iterator>
+	struct contiguous_chars { static const bool value = false; };
 
-	template<typename Container, typename Iterator>
-	static Container read_simplepart_body ( Iterator &begin, Iterator end ) {
-		tracer t ( __func__ );
-		Container retVal;
-		std::copy ( begin, end, std::back_inserter(retVal));
-		
-#ifdef	DUMP_MIME_DATA
-		std::cout << std::endl << ">>****SinglePart Body*******" << std::endl;
-		std::cout << str ( boost::format ( "Body size %d" ) % retVal.size ()) << std::endl;
-		std::copy ( retVal.begin (), retVal.end(), std::ostream_iterator<char> ( std::cout ));
-		std::cout << std::endl << "<<****SinglePart Body*******" << std::endl;
-#endif
+	template<> struct contiguous_chars<const char *>						{ static const bool value = true; };
+	template<> struct contiguous_chars<char *>								{ static const bool value = true; };
+	template<> struct contiguous_chars<std::string::const_iterator>			{ static const bool value = true; };
+	template<> struct contiguous_chars<std::string::iterator>				{ static const bool value = true; };
+	template<> struct contiguous_chars<std::vector<char>::const_iterator>	{ static const bool value = true; };
+	template<> struct contiguous_chars<std::vector<char>::iterator>			{ static const bool value = true; };
+
+	typedef boost::shared_ptr<std::vector<char> >	input_buffer_ptr;
+
+	inline std::pair<const char *, const char *> buffer_range ( const std::vector<char> &buffer ) {
+		const char *data = buffer.empty () ? NULL : &buffer [ 0 ];
+		return std::make_pair ( data, data + buffer.size ());
+		}
+
+	template<typename Iterator>
+	std::pair<const char *, const char *> input_buffer ( Iterator &begin, Iterator end, input_buffer_ptr &, boost::true_type ) {
+		const std::size_t size = std::distance ( begin, end );
+		const char *data = size > 0 ? &*begin : NULL;
+		begin = end;
+		return std::make_pair ( data, data + size );
+		}
+
+	template<typename Iterator>
+	std::pair<const char *, const char *> input_buffer ( Iterator &begin, Iterator end, input_buffer_ptr &buffer, boost::false_type ) {
+		buffer.reset ( new std::vector<char> ( begin, end ));
+		begin = end;
+		return buffer_range ( *buffer );
+		}
+
+//	Reads a stream to its end, a block at a time
+	inline input_buffer_ptr read_stream ( std::istream &in ) {
+		static const std::size_t k_block_size = 64 * 1024;
+		input_buffer_ptr retVal ( new std::vector<char> );
+		std::size_t size = 0;
+		while ( in ) {
+			retVal->resize ( size + k_block_size );
+			in.read ( &(*retVal) [ size ], k_block_size );
+			size += in.gcount ();
+			}
+		retVal->resize ( size );
+		return retVal;
+		}
+
+//	Makes a body from a range of the buffer the message is parsed from.
+//	Bodies are copied out of the buffer, unless they can share it.
+	template<typename Container>
+	struct body_maker {
+		static const bool shares_buffer = false;
+		static Container make ( const input_buffer_ptr &, const char *first, const char *last ) {
+			return Container ( first, last );
+			}
+		};
+
+	template<>
+	struct body_maker<buffer_body> {
+		static const bool shares_buffer = true;
+		static buffer_body make ( const input_buffer_ptr &buffer, const char *first, const char *last ) {
+			return buffer ? buffer_body ( buffer, first, last ) : buffer_body ( first, last );
+			}
+		};
+
+
+//	The Content-Transfer-Encodings that change the body; the others ("7bit",
+//	"8bit", "binary", and anything unknown) leave it as it is.
+	typedef enum { identity_encoding, base64_encoding, quoted_printable_encoding } transfer_encoding;
+
+	template<typename String>
+	transfer_encoding transfer_encoding_from_string ( const String &value ) {
+		typename String::const_iterator first = value.begin (), last = value.end ();
+		while ( first != last && ( *first == ' ' || *first == '\t' ))
+			++first;
+		while ( first != last && ( last [ -1 ] == ' ' || last [ -1 ] == '\t' ))
+			--last;
+		const std::string name ( first, last );
+		if ( ascii_iequals ( name, "base64" ))
+			return base64_encoding;
+		if ( ascii_iequals ( name, "quoted-printable" ))
+			return quoted_printable_encoding;
+		return identity_encoding;
+		}
+
+//	True for the Content-Transfer-Encodings RFC 2045 defines: the ones above,
+//	and "7bit", "8bit" and "binary", which leave the body as it is.
+	template<typename String>
+	bool is_known_transfer_encoding ( const String &value ) {
+		if ( transfer_encoding_from_string ( value ) != identity_encoding )
+			return true;
+		typename String::const_iterator first = value.begin (), last = value.end ();
+		while ( first != last && ( *first == ' ' || *first == '\t' ))
+			++first;
+		while ( first != last && ( last [ -1 ] == ' ' || last [ -1 ] == '\t' ))
+			--last;
+		const std::string name ( first, last );
+		return ascii_iequals ( name, "7bit" ) || ascii_iequals ( name, "8bit" ) || ascii_iequals ( name, "binary" );
+		}
+
+	inline input_buffer_ptr transfer_decode ( transfer_encoding encoding, const char *first, const char *last ) {
+		input_buffer_ptr retVal ( new std::vector<char> );
+		if ( encoding == base64_encoding )
+			mime::base64_decode ( first, last, *retVal );
+		else if ( encoding == quoted_printable_encoding )
+			mime::qp_decode ( first, last, *retVal );
+		else
+			retVal->assign ( first, last );
+		return retVal;
+		}
+
+	inline input_buffer_ptr transfer_encode ( transfer_encoding encoding, const char *first, const char *last ) {
+		input_buffer_ptr retVal ( new std::vector<char> );
+		if ( encoding == base64_encoding )
+			mime::base64_encode ( first, last, *retVal );
+		else if ( encoding == quoted_printable_encoding )
+			mime::qp_encode ( first, last, *retVal );
+		else
+			retVal->assign ( first, last );
 		return retVal;
 		}
 
+
 //	FIXME: Need to break the headers at 80 chars...
 	template<typename headerList>
 	void write_headers ( std::ostream &out, const headerList &headers ) {
@@ -346,11 +599,28 @@ namespace detail {
 		out << detail::k_crlf;
 		}
 	
+	template <typename bodyContainer>
+	void write_body ( std::ostream &out, const bodyContainer &body, boost::true_type ) {
+		if ( !body.empty ())
+			out.write ( &*body.begin (), body.size ());
+		}
+
+	template <typename bodyContainer>
+	void write_body ( std::ostream &out, const bodyContainer &body, boost::false_type ) {
+		std::copy ( body.begin (), body.end (), std::ostreambuf_iterator<char> ( out ));
+		}
+
 	template <typename bodyContainer>
 	void write_body ( std::ostream &out, const bodyContainer &body ) {
-		std::copy ( body.begin (), body.end (), std::ostream_iterator<char> ( out ));
+		write_body ( out, body, boost::integral_constant<bool,
+				contiguous_chars<typename bodyContainer::const_iterator>::value> ());
 		}
 	
+//	FIXME: Make boundary strings (more?) unique
+	inline std::string make_boundary () {
+		return str ( boost::format ( "------=_NextPart-%s.%08ld" ) % k_package_name % std::clock ());
+		}
+
 	inline void write_boundary ( std::ostream &out, std::string boundary, bool isLast, bool leadingCR = true ) {
 		if ( leadingCR )
 			out << detail::k_crlf;
@@ -363,6 +633,9 @@ namespace detail {
 
 	template<typename Iterator, typename traits>
 	static boost::shared_ptr< basic_mime<traits> > parse_mime ( Iterator &begin, Iterator end, const char *default_content_type = "text/plain" );
+
+	template<typename traits>
+	static boost::shared_ptr< basic_mime<traits> > parse_part ( const char *begin, const char *end, const input_buffer_ptr &buffer, const char *default_content_type );
 	}
 
 
@@ -385,15 +658,18 @@ public:
 	typedef	typename partList::const_iterator	constPartIter;
 
 //	Type for the body
-	typedef	typename traits::body_type			bodyContainer;
-	typedef boost::shared_ptr<bodyContainer>	mimeBody;
+//	Bodies are immutable once made, and shared between copies of a part;
+//	the set_body calls replace the body rather than change it.
+	typedef	typename traits::body_type					bodyContainer;
+	typedef boost::shared_ptr<const bodyContainer>	mimeBody;
 	
 // -----------------------------------------------------------
 //	Constructors, destructor, assignment, and swap
 // -----------------------------------------------------------
 
 	basic_mime ( const char *type, const char *subtype )
-		: m_body_prolog_is_missing ( false ), m_body ( new bodyContainer ), m_body_epilog ( new bodyContainer ) {
+		: m_body_prolog_is_missing ( false ), m_body ( new bodyContainer ), m_body_epilog ( new bodyContainer ),
+			m_decoded_encoding ( detail::identity_encoding ) {
 		if ( NULL == type || NULL == subtype || 0 == std::strlen ( type ) || 0 == std::strlen ( subtype ))
 			throw std::runtime_error ( "Can't create a mime part w/o a type or subtype" );
 		
@@ -407,7 +683,7 @@ public:
 	
 	basic_mime ( const headerList &theHeaders, const string_type &default_content_type )
 		: m_body_prolog_is_missing ( false ), m_body ( new bodyContainer ), m_body_epilog ( new bodyContainer ),
-			m_default_content_type ( default_content_type ) {
+			m_default_content_type ( default_content_type ), m_decoded_encoding ( detail::identity_encoding ) {
 		string_type ct = m_default_content_type;
 	
 		constHeaderIter found = std::find_if ( theHeaders.begin (), theHeaders.end (), 
@@ -420,10 +696,12 @@ public:
 		m_headers = theHeaders;
 		}
 	
+//	The copy shares the bodies, which are immutable, but not the parts
 	basic_mime ( const basic_mime &rhs )
 			: m_part_kind ( rhs.m_part_kind ), m_headers ( rhs.m_headers ), m_body_prolog_is_missing ( rhs.m_body_prolog_is_missing ), 
-		  	m_body ( new bodyContainer ( *rhs.m_body )), m_body_epilog ( new bodyContainer ( *rhs.m_body_epilog )),
-		/*	m_subparts ( rhs.m_subparts ), */ m_default_content_type ( rhs.m_default_content_type )
+		  	m_body ( rhs.m_body ), m_body_epilog ( rhs.m_body_epilog ),
+		/*	m_subparts ( rhs.m_subparts ), */ m_default_content_type ( rhs.m_default_content_type ),
+			m_decoded_body ( rhs.m_decoded_body ), m_decoded_from ( rhs.m_decoded_from ), m_decoded_encoding ( rhs.m_decoded_encoding )
 		{
 	//	Copy the parts -- not just the shared pointers
 		for ( typename partList::const_iterator iter = rhs.subpart_begin (); iter != rhs.subpart_end (); ++iter )
@@ -446,6 +724,9 @@ public:
 		std::swap ( m_body_epilog,				rhs.m_body_epilog );
 		std::swap ( m_subparts,					rhs.m_subparts );
 		std::swap ( m_default_content_type, 	rhs.m_default_content_type );
+		std::swap ( m_decoded_body,				rhs.m_decoded_body );
+		std::swap ( m_decoded_from,				rhs.m_decoded_from );
+		std::swap ( m_decoded_encoding,			rhs.m_decoded_encoding );
 		}
 
 	~basic_mime () {}
@@ -548,19 +829,71 @@ public:
 	std::size_t body_size () const { return m_body->size (); }
 
 	template <typename Iterator>
-	void set_body ( Iterator begin, Iterator end ) {
-		bodyContainer temp;
-		std::copy ( begin, end, std::back_inserter ( temp ));
-		m_body->swap ( temp );
-		}
+	void set_body ( Iterator begin, Iterator end ) { m_body.reset ( new bodyContainer ( begin, end )); }
 
 	void set_body ( const char *contents, size_t sz ) { set_body ( contents, contents + sz ); }
-	void set_body ( std::istream &in )                { set_body ( std::istream_iterator<char> ( in ), std::istream_iterator<char> ()); }
-	void set_body ( const bodyContainer &new_body )   { *m_body = new_body; }
+	void set_body ( const bodyContainer &new_body )   { m_body.reset ( new bodyContainer ( new_body )); }
+	void set_body ( const mimeBody &new_body )        { m_body = new_body; }	// share another part's body
+
+//	Reads the stream to its end
+	void set_body ( std::istream &in ) {
+		const detail::input_buffer_ptr buffer = detail::read_stream ( in );
+		const std::pair<const char *, const char *> range = detail::buffer_range ( *buffer );
+		m_body.reset ( new bodyContainer ( detail::body_maker<bodyContainer>::make ( buffer, range.first, range.second )));
+		}
 
 	void set_multipart_prolog_is_missing ( bool isMissing ) { m_body_prolog_is_missing = isMissing; }
-	void set_body_prolog ( const bodyContainer &new_body_prolog ) { *m_body        = new_body_prolog; }
-	void set_body_epilog ( const bodyContainer &new_body_epilog ) { *m_body_epilog = new_body_epilog; }
+	bool multipart_prolog_is_missing () const { return m_body_prolog_is_missing; }
+	void set_body_prolog ( const bodyContainer &new_body_prolog ) { m_body.reset        ( new bodyContainer ( new_body_prolog )); }
+	void set_body_epilog ( const bodyContainer &new_body_epilog ) { m_body_epilog.reset ( new bodyContainer ( new_body_epilog )); }
+	void set_body_prolog ( const mimeBody &new_body_prolog ) { m_body        = new_body_prolog; }
+	void set_body_epilog ( const mimeBody &new_body_epilog ) { m_body_epilog = new_body_epilog; }
+
+// -----------------------------------------------------------
+//	Content-Transfer-Encoding
+// -----------------------------------------------------------
+
+//	The body with its base64 or quoted-printable encoding undone; a body in
+//	any other encoding is returned as it is. The body is decoded on the first
+//	call, and the result kept until the body or its encoding changes. (Like
+//	set_body, the first call must not race with other calls on the part.)
+	mimeBody decoded_body () const {
+		const detail::transfer_encoding encoding = get_transfer_encoding ();
+		if ( encoding == detail::identity_encoding )
+			return m_body;
+		if ( m_decoded_encoding != encoding || m_decoded_from.lock () != m_body ) {
+			detail::input_buffer_ptr copy;
+			const std::pair<const char *, const char *> range = body_chars ( *m_body, copy );
+			m_decoded_body = make_body ( detail::transfer_decode ( encoding, range.first, range.second ));
+			m_decoded_from = m_body;
+			m_decoded_encoding = encoding;
+			}
+		return m_decoded_body;
+		}
+
+//	Re-encodes the body in another Content-Transfer-Encoding - "base64",
+//	"quoted-printable", or one that leaves the body as it is, like "8bit" -
+//	and sets the header to match. Any other encoding is rejected, since the
+//	body could not be encoded to match the header.
+	void set_transfer_encoding ( const char *encoding ) {
+		if ( !detail::is_known_transfer_encoding ( std::string ( encoding )))
+			throw std::runtime_error ( str ( boost::format ( "Unknown Content-Transfer-Encoding (%s)" ) % encoding ));
+		const detail::transfer_encoding new_encoding = detail::transfer_encoding_from_string ( std::string ( encoding ));
+		if ( new_encoding != detail::identity_encoding && m_part_kind != simple_part )
+			throw std::runtime_error ( "Only simple mime parts can be base64 or quoted-printable encoded" );
+
+		const mimeBody decoded = decoded_body ();
+		detail::input_buffer_ptr copy;
+		const std::pair<const char *, const char *> range = body_chars ( *decoded, copy );
+		m_body = make_body ( detail::transfer_encode ( new_encoding, range.first, range.second ));
+		set_header_value ( detail::k_content_transfer_encoding_header, string_type ( encoding ),
+			header_exists ( detail::k_content_transfer_encoding_header ));
+
+	//	The decoded body is at hand already
+		m_decoded_body = decoded;
+		m_decoded_from = m_body;
+		m_decoded_encoding = new_encoding;
+		}
 
 // -----------------------------------------------------------
 //	Output
@@ -582,8 +915,7 @@ public:
 			std::string boundary;
 			try { boundary = detail::get_boundary ( get_content_type_header ()); }
 			catch ( std::runtime_error & ) {
-			//	FIXME: Make boundary strings (more?) unique
-				boundary = str ( boost::format ( "------=_NextPart-%s.%08ld" ) % detail::k_package_name % std::clock ());
+				boundary = detail::make_boundary ();
 				append_phrase_to_content_type ( "boundary", boundary );
 				}
 			
@@ -619,16 +951,34 @@ public:
 		}
 
 //	Build a mime part from a stream
+//	The stream is read to its end, a block at a time
 	static boost::shared_ptr < basic_mime > parse_mime ( std::istream &in ) {
-		boost::spirit::istream_iterator first (in);
-		boost::spirit::istream_iterator last;
-		return parse_mime ( first, last );
+		const detail::input_buffer_ptr buffer = detail::read_stream ( in );
+		const std::pair<const char *, const char *> range = detail::buffer_range ( *buffer );
+		return detail::parse_part<traits> ( range.first, range.second, buffer, "text/plain" );
 		}
 		
 
 private:
 	basic_mime ();	// Can't create a part w/o a type
 
+	detail::transfer_encoding get_transfer_encoding () const {
+		constHeaderIter found = find_header ( detail::k_content_transfer_encoding_header );
+		return found != header_end () ? detail::transfer_encoding_from_string ( found->second ) : detail::identity_encoding;
+		}
+
+//	The chars of a body, copied into a buffer if the body isn't one
+	static std::pair<const char *, const char *> body_chars ( const bodyContainer &body, detail::input_buffer_ptr &copy ) {
+		typename bodyContainer::const_iterator begin = body.begin ();
+		return detail::input_buffer ( begin, body.end (), copy, boost::integral_constant<bool,
+				detail::contiguous_chars<typename bodyContainer::const_iterator>::value> ());
+		}
+
+	static mimeBody make_body ( const detail::input_buffer_ptr &buffer ) {
+		const std::pair<const char *, const char *> range = detail::buffer_range ( *buffer );
+		return mimeBody ( new bodyContainer ( detail::body_maker<bodyContainer>::make ( buffer, range.first, range.second )));
+		}
+
 	headerIter	find_header ( const char *key ) {
 		return std::find_if ( header_begin (), header_end (), detail::find_mime_header<string_type> ( key ));
 		}
@@ -638,7 +988,7 @@ private:
 		}
 
 	static part_kind part_kind_from_string_pair ( const std::string &type, const std::string &sub_type ) {
-		if ( boost::iequals ( type, "multipart" ))
+		if ( detail::ascii_iequals ( type, "multipart" ))
 			return multi_part;
 			
 		part_kind retVal = simple_part;
@@ -649,8 +999,8 @@ private:
 	//	The body of a message/delivery-status consists of one or more
 	//	   "fields" formatted according to the ABNF of RFC 822 header "fields"
 	//	   (see [RFC822]).  
-		if ( boost::iequals ( type, "message" ))
-			if ( !boost::iequals ( sub_type, "delivery-status" ))
+		if ( detail::ascii_iequals ( type, "message" ))
+			if ( !detail::ascii_iequals ( sub_type, "delivery-status" ))
 				retVal = message_part;
 		return retVal;
 		}
@@ -691,15 +1041,24 @@ private:
 	mimeBody	m_body_epilog;				// only for multiparts
 	partList	m_subparts;					// only for multiparts or message
 	string_type	m_default_content_type;
+
+//	decoded_body, kept for as long as m_body and the encoding are what it was decoded from
+	mutable mimeBody							m_decoded_body;
+	mutable boost::weak_ptr<const bodyContainer>	m_decoded_from;
+	mutable detail::transfer_encoding			m_decoded_encoding;
 	};
 
 
 namespace detail {
 
-	template<typename Iterator, typename traits>
-	static boost::shared_ptr< basic_mime<traits> > parse_mime ( Iterator &begin, Iterator end, const char *default_content_type ) {
+//	Parse a part from [begin, end), which lies in buffer (if buffer is set).
+	template<typename traits>
+	static boost::shared_ptr< basic_mime<traits> > parse_part ( const char *begin, const char *end, const input_buffer_ptr &buffer, const char *default_content_type ) {
 		tracer t ( __func__ );
 		typedef	typename boost::mime::basic_mime<traits>	mime_part;
+		typedef typename mime_part::bodyContainer			body_type;
+		typedef typename mime_part::mimeBody				mimeBody;
+		typedef body_maker<body_type>						maker;
 		
 		shared_ptr < mime_part > retVal (
 			new mime_part ( detail::read_headers<typename mime_part::headerList> ( begin, end ), default_content_type ));
@@ -711,35 +1070,49 @@ namespace detail {
 		std::cout << str ( boost::format ( "retVal->get_part_kind () = %d" ) % ((int) retVal->get_part_kind ())) << std::endl;
 #endif
 
-		if ( retVal->get_part_kind () == mime_part::simple_part )
-			retVal->set_body ( detail::read_simplepart_body<typename mime_part::bodyContainer, Iterator> ( begin, end ));
+		if ( retVal->get_part_kind () == mime_part::simple_part ) {
+			retVal->set_body ( mimeBody ( new body_type ( maker::make ( buffer, begin, end ))));
+#ifdef	DUMP_MIME_DATA
+			std::cout << std::endl << ">>****SinglePart Body*******" << std::endl;
+			std::cout << str ( boost::format ( "Body size %d" ) % ( end - begin )) << std::endl;
+			std::copy ( begin, end, std::ostream_iterator<char> ( std::cout ));
+			std::cout << std::endl << "<<****SinglePart Body*******" << std::endl;
+#endif
+			}
 		else if ( retVal->get_part_kind () == mime_part::message_part ) {
 		//	If we've got a message/xxxx, then there is no body, and we have a single
 		//	embedded mime_part (which, of course, could be a multipart)
-			retVal->append_part ( parse_mime<Iterator, traits> ( begin, end ));
+			retVal->append_part ( parse_part<traits> ( begin, end, buffer, "text/plain" ));
 			}
 		else /* multi_part */ {
 		//	Find or invent a boundary string
 			std::string part_separator = detail::get_boundary ( retVal->get_content_type_header ());
-			const char *cont_type = boost::iequals ( content_type, "multipart/digest" ) ? "message/rfc822" : "text/plain";
+			const char *cont_type = detail::ascii_iequals ( content_type, "multipart/digest" ) ? "message/rfc822" : "text/plain";
 			
-			detail::multipart_body_type<typename traits::body_type> body_and_subParts;
+			detail::multipart_body_type<const char *> body_and_subParts;
 			detail::read_multipart_body ( begin, end, body_and_subParts, part_separator );
 
-			retVal->set_body_prolog ( body_and_subParts.body_prolog );
+			retVal->set_body_prolog ( mimeBody ( new body_type ( maker::make ( buffer, body_and_subParts.body_prolog.first, body_and_subParts.body_prolog.second ))));
 			retVal->set_multipart_prolog_is_missing ( body_and_subParts.prolog_is_missing );
-			for ( typename sub_parts_t::const_iterator iter = body_and_subParts.sub_parts.begin ();
-					iter != body_and_subParts.sub_parts.end (); ++iter ) {
-				typedef typename sub_part_t::const_iterator iter_type;
-				iter_type b = iter->begin ();
-				iter_type e = iter->end ();
-				retVal->append_part ( parse_mime<iter_type, traits> ( b, e, cont_type ));
-				}
-			retVal->set_body_epilog ( body_and_subParts.body_epilog );
+			for ( std::vector<std::pair<const char *, const char *> >::const_iterator iter = body_and_subParts.sub_parts.begin ();
+					iter != body_and_subParts.sub_parts.end (); ++iter )
+				retVal->append_part ( parse_part<traits> ( iter->first, iter->second, buffer, cont_type ));
+			retVal->set_body_epilog ( mimeBody ( new body_type ( maker::make ( buffer, body_and_subParts.body_epilog.first, body_and_subParts.body_epilog.second ))));
 			}
 		
 		return retVal;
 		}	
+
+//	The message is parsed in place if the iterators point into a buffer of chars,
+//	unless the bodies are to share the buffer; then, it is copied into one.
+	template<typename Iterator, typename traits>
+	static boost::shared_ptr< basic_mime<traits> > parse_mime ( Iterator &begin, Iterator end, const char *default_content_type ) {
+		typedef body_maker<typename traits::body_type> maker;
+		input_buffer_ptr buffer;
+		const std::pair<const char *, const char *> range = input_buffer ( begin, end, buffer,
+				boost::integral_constant<bool, contiguous_chars<Iterator>::value && !maker::shares_buffer> ());
+		return parse_part<traits> ( range.first, range.second, buffer, default_content_type );
+		}
 	
 	}
 
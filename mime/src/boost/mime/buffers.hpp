@@ -0,0 +1,175 @@
+//
+//          Copyright agent (agent@local) 2026
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+//
+
+#ifndef	_BOOST_MIME_BUFFERS_HPP
+#define	_BOOST_MIME_BUFFERS_HPP
+
+#include <boost/mime.hpp>
+#include <boost/asio/buffer.hpp>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+//	Serializes a mime part into a sequence of const buffers, for a gathering
+//	write (boost::asio::async_write, say) instead of an ostream.
+//
+//	The headers and the boundary lines are formatted into blocks of text,
+//	and the buffers for the bodies refer to the bodies themselves, which are
+//	kept alive by the mime_buffers; no body byte is copied. (Bodies whose
+//	container is not a contiguous buffer of chars are copied into the text.)
+//
+//		boost::mime::mime_buffers<my_traits> buffers ( part );
+//		boost::asio::async_write ( socket, buffers.buffers (), handler );
+//
+//	The mime_buffers must outlive the write. The output is the same as that
+//	of operator <<, except that a multipart without a boundary is given one
+//	in the output only: the part itself is not changed.
+
+namespace boost { namespace mime {
+
+template <typename traits>
+class mime_buffers {
+public:
+	typedef basic_mime<traits>							mime_part;
+	typedef std::vector<boost::asio::const_buffer>		buffers_type;
+
+//	If with_headers is false, the top level headers are left out: for an HTTP
+//	body, say, where the Content-Type goes into the HTTP headers.
+	explicit mime_buffers ( const mime_part &part, bool with_headers = true ) : m_size ( 0 ) {
+		append_part ( part, with_headers );
+		flush_text ();
+		}
+
+	const buffers_type &buffers () const { return m_buffers; }
+
+//	The total size of the buffers
+	std::size_t size () const { return m_size; }
+
+private:
+	typedef typename mime_part::bodyContainer	bodyContainer;
+	typedef typename mime_part::mimeBody		mimeBody;
+
+	mime_buffers ( const mime_buffers & );
+	mime_buffers & operator = ( const mime_buffers & );
+
+	void append_part ( const mime_part &part, bool with_headers ) {
+		if ( part.get_part_kind () == mime_part::simple_part ) {
+			if ( with_headers )
+				append_headers ( part, std::string ());
+			append_body ( part.body ());
+			}
+		else if ( part.get_part_kind () == mime_part::message_part ) {
+			if ( part.part_count () != 1 )
+				throw std::runtime_error ( "message part w/wrong number of sub-parts - should be 1" );
+			if ( with_headers )
+				append_headers ( part, std::string ());
+			append_part ( *part [ 0 ], true );
+			}
+		else {
+		//	Use the boundary of the part, or invent one
+			std::string boundary, invented;
+			try { boundary = detail::get_boundary ( part.get_content_type_header ()); }
+			catch ( std::runtime_error & ) { boundary = invented = detail::make_boundary (); }
+
+			if ( with_headers )
+				append_headers ( part, invented );
+		//	See stream_out for the CRLF in front of the first boundary
+			bool writeCR = part.body_prolog ()->size () > 0 || !part.multipart_prolog_is_missing ();
+			append_body ( part.body_prolog ());
+			for ( typename mime_part::constPartIter iter = part.subpart_begin (); iter != part.subpart_end (); ++iter ) {
+				append_boundary ( boundary, false, writeCR );
+				append_part ( **iter, true );
+				writeCR = true;
+				}
+			append_boundary ( boundary, true, true );
+			append_body ( part.body_epilog ());
+			}
+		}
+
+//	If boundary is set, it is added to the Content-Type header
+	void append_headers ( const mime_part &part, const std::string &boundary ) {
+		bool needs_content_type = !boundary.empty ();
+		for ( typename mime_part::constHeaderIter iter = part.header_begin (); iter != part.header_end (); ++iter ) {
+			m_text.append ( iter->first );
+			m_text += ':';
+			m_text.append ( iter->second.begin (), iter->second.end ());
+			if ( needs_content_type && detail::ascii_iequals ( iter->first, detail::k_content_type_header )) {
+				append_boundary_phrase ( boundary );
+				needs_content_type = false;
+				}
+			m_text += detail::k_crlf;
+			}
+		if ( needs_content_type ) {
+			const typename mime_part::string_type content_type = part.get_content_type_header ();
+			m_text.append ( detail::k_content_type_header );
+			m_text += ':';
+			m_text.append ( content_type.begin (), content_type.end ());
+			append_boundary_phrase ( boundary );
+			m_text += detail::k_crlf;
+			}
+		m_text += detail::k_crlf;
+		}
+
+	void append_boundary_phrase ( const std::string &boundary ) {
+		m_text += "; boundary=\"";
+		m_text += boundary;
+		m_text += '"';
+		}
+
+	void append_boundary ( const std::string &boundary, bool isLast, bool leadingCR ) {
+		if ( leadingCR )
+			m_text += detail::k_crlf;
+		m_text += "--";
+		m_text += boundary;
+		if ( isLast )
+			m_text += "--";
+		m_text += detail::k_crlf;
+		}
+
+	void append_body ( const mimeBody &body ) {
+		append_body ( body, boost::integral_constant<bool,
+				detail::contiguous_chars<typename bodyContainer::const_iterator>::value> ());
+		}
+
+	void append_body ( const mimeBody &body, boost::true_type ) {
+		if ( body->empty ())
+			return;
+		flush_text ();
+		m_bodies.push_back ( body );
+		push_buffer ( &*body->begin (), body->size ());
+		}
+
+	void append_body ( const mimeBody &body, boost::false_type ) {
+		m_text.append ( body->begin (), body->end ());
+		}
+
+//	The text so far becomes a buffer; the strings in a deque stay put.
+	void flush_text () {
+		if ( m_text.empty ())
+			return;
+		m_texts.push_back ( std::string ());
+		m_texts.back ().swap ( m_text );
+		push_buffer ( m_texts.back ().data (), m_texts.back ().size ());
+		}
+
+	void push_buffer ( const char *data, std::size_t size ) {
+		m_buffers.push_back ( boost::asio::const_buffer ( data, size ));
+		m_size += size;
+		}
+
+	std::string					m_text;		// not flushed yet
+	std::deque<std::string>		m_texts;
+	std::vector<mimeBody>		m_bodies;
+	buffers_type				m_buffers;
+	std::size_t					m_size;
+	};
+
+}}
+
+#endif	// _BOOST_MIME_BUFFERS_HPP
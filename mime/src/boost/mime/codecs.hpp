@@ -0,0 +1,834 @@
+//
+//          Copyright agent (agent@local) 2026
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+//
+
+#ifndef	_BOOST_MIME_CODECS_HPP
+#define	_BOOST_MIME_CODECS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+//	Codecs for the base64 and quoted-printable Content-Transfer-Encodings
+//	(RFC 2045, sections 6.7 and 6.8).
+//
+//	Each codec is a class that is fed the input in chunks of any size and
+//	appends its output to a container, followed by a call to finish, which
+//	flushes what the codec was holding back for the next chunk:
+//
+//		boost::mime::base64_decoder decoder;
+//		std::vector<char> body;
+//		while ( ... )
+//			decoder.decode ( chunk, chunk + size, body );
+//		decoder.finish ( body );
+//
+//	The free functions (base64_encode, base64_decode, qp_encode, qp_decode) do
+//	the same for a whole buffer. The output container is a std::string or a
+//	std::vector<char> (anything with size, resize, insert and contiguous
+//	storage).
+//
+//	The inner loops use SSE2, SSSE3 or AVX2 when the compiler targets them
+//	(-msse2 is the default on x86-64; -mssse3 or -mavx2 add the rest), and
+//	plain C++ otherwise. Define BOOST_MIME_NO_SIMD to use plain C++ anyway.
+
+#if !defined ( BOOST_MIME_NO_SIMD )
+#	if defined ( __AVX2__ )
+#		define	BOOST_MIME_AVX2		1
+#	endif
+#	if defined ( __SSSE3__ )
+#		define	BOOST_MIME_SSSE3	1
+#	endif
+#	if defined ( __SSE2__ ) || defined ( _M_X64 ) || ( defined ( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#		define	BOOST_MIME_SSE2		1
+#	endif
+#endif
+
+#if defined ( BOOST_MIME_AVX2 )
+#	include <immintrin.h>
+#elif defined ( BOOST_MIME_SSSE3 )
+#	include <tmmintrin.h>
+#elif defined ( BOOST_MIME_SSE2 )
+#	include <emmintrin.h>
+#endif
+
+#if defined ( _MSC_VER )
+#	include <intrin.h>
+#endif
+
+namespace boost { namespace mime {
+
+namespace detail {
+
+	static const char k_base64_alphabet [] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	static const char k_hex_digits []      = "0123456789ABCDEF";
+
+	inline unsigned first_set_bit ( unsigned mask ) {
+#if defined ( _MSC_VER )
+		unsigned long index;
+		_BitScanForward ( &index, mask );
+		return index;
+#else
+		return __builtin_ctz ( mask );
+#endif
+		}
+
+//	The values of the base64 chars; -1 for everything else
+	struct base64_value_table {
+		base64_value_table () {
+			std::fill ( values, values + 256, -1 );
+			for ( int i = 0; i < 64; ++i )
+				values [ static_cast<unsigned char> ( k_base64_alphabet [ i ] ) ] = static_cast<signed char> ( i );
+			}
+		signed char values [ 256 ];
+		};
+
+	inline const signed char *base64_values () {
+		static const base64_value_table table;
+		return table.values;
+		}
+
+// -----------------------------------------------------------
+//	base64
+// -----------------------------------------------------------
+
+//	Encodes size bytes, a multiple of 3, one group at a time
+	inline char *encode_base64_scalar ( const char *in, std::size_t size, char *out ) {
+		const unsigned char *p = reinterpret_cast<const unsigned char *> ( in );
+		for ( const unsigned char *end = p + size; p != end; p += 3, out += 4 ) {
+			const unsigned long bits = ( static_cast<unsigned long> ( p [ 0 ] ) << 16 ) | ( p [ 1 ] << 8 ) | p [ 2 ];
+			out [ 0 ] = k_base64_alphabet [ bits >> 18 ];
+			out [ 1 ] = k_base64_alphabet [ ( bits >> 12 ) & 0x3F ];
+			out [ 2 ] = k_base64_alphabet [ ( bits >> 6 ) & 0x3F ];
+			out [ 3 ] = k_base64_alphabet [ bits & 0x3F ];
+			}
+		return out;
+		}
+
+//	The vector kernels follow Wojciech Mula and Daniel Lemire, "Faster Base64
+//	Encoding and Decoding Using AVX2 Instructions" (2018): the bytes of each
+//	group of 3 are spread into 4 bytes of 6 bits with a shuffle and two
+//	multiplies, and a shuffle of a 16 entry table maps those to (or from) the
+//	alphabet by the range they fall in.
+#if defined ( BOOST_MIME_SSSE3 )
+	inline __m128i encode_base64_ssse3 ( __m128i in ) {
+		in = _mm_shuffle_epi8 ( in, _mm_set_epi8 ( 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1 ));
+		const __m128i hi = _mm_mulhi_epu16 ( _mm_and_si128 ( in, _mm_set1_epi32 ( 0x0FC0FC00 )), _mm_set1_epi32 ( 0x04000040 ));
+		const __m128i lo = _mm_mullo_epi16 ( _mm_and_si128 ( in, _mm_set1_epi32 ( 0x003F03F0 )), _mm_set1_epi32 ( 0x01000010 ));
+		const __m128i values = _mm_or_si128 ( hi, lo );
+
+	//	0..25 -> 0, 26..51 -> 1, 52..61 -> 2..11, 62 -> 12, 63 -> 13
+		const __m128i range = _mm_sub_epi8 ( _mm_subs_epu8 ( values, _mm_set1_epi8 ( 51 )), _mm_cmpgt_epi8 ( values, _mm_set1_epi8 ( 25 )));
+		const __m128i offsets = _mm_setr_epi8 ( 'A', 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 0, 0 );
+		return _mm_add_epi8 ( values, _mm_shuffle_epi8 ( offsets, range ));
+		}
+
+//	Sets valid to false if any of the 16 chars is not in the alphabet
+	inline __m128i decode_base64_ssse3 ( __m128i in, bool &valid ) {
+		const __m128i mask_2F = _mm_set1_epi8 ( 0x2F );
+		const __m128i hi_nibbles = _mm_and_si128 ( _mm_srli_epi32 ( in, 4 ), mask_2F );
+		const __m128i lo_nibbles = _mm_and_si128 ( in, mask_2F );
+		const __m128i lut_lo = _mm_setr_epi8 ( 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A );
+		const __m128i lut_hi = _mm_setr_epi8 ( 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 );
+		const __m128i invalid = _mm_and_si128 ( _mm_shuffle_epi8 ( lut_lo, lo_nibbles ), _mm_shuffle_epi8 ( lut_hi, hi_nibbles ));
+		valid = _mm_movemask_epi8 ( _mm_cmpeq_epi8 ( invalid, _mm_setzero_si128 ())) == 0xFFFF;
+
+		const __m128i lut_roll = _mm_setr_epi8 ( 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0 );
+		const __m128i roll = _mm_shuffle_epi8 ( lut_roll, _mm_add_epi8 ( _mm_cmpeq_epi8 ( in, mask_2F ), hi_nibbles ));
+		const __m128i values = _mm_add_epi8 ( in, roll );
+
+		const __m128i pairs = _mm_maddubs_epi16 ( values, _mm_set1_epi32 ( 0x01400140 ));
+		const __m128i groups = _mm_madd_epi16 ( pairs, _mm_set1_epi32 ( 0x00011000 ));
+		return _mm_shuffle_epi8 ( groups, _mm_setr_epi8 ( 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 ));
+		}
+#endif
+
+#if defined ( BOOST_MIME_AVX2 )
+	inline __m256i broadcast_lanes ( __m128i lane ) {
+		return _mm256_broadcastsi128_si256 ( lane );
+		}
+
+//	The same as the SSSE3 kernels, on two lanes of 16
+	inline __m256i encode_base64_avx2 ( __m256i in ) {
+		in = _mm256_shuffle_epi8 ( in, broadcast_lanes ( _mm_set_epi8 ( 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1 )));
+		const __m256i hi = _mm256_mulhi_epu16 ( _mm256_and_si256 ( in, _mm256_set1_epi32 ( 0x0FC0FC00 )), _mm256_set1_epi32 ( 0x04000040 ));
+		const __m256i lo = _mm256_mullo_epi16 ( _mm256_and_si256 ( in, _mm256_set1_epi32 ( 0x003F03F0 )), _mm256_set1_epi32 ( 0x01000010 ));
+		const __m256i values = _mm256_or_si256 ( hi, lo );
+
+		const __m256i range = _mm256_sub_epi8 ( _mm256_subs_epu8 ( values, _mm256_set1_epi8 ( 51 )), _mm256_cmpgt_epi8 ( values, _mm256_set1_epi8 ( 25 )));
+		const __m256i offsets = broadcast_lanes ( _mm_setr_epi8 ( 'A', 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 0, 0 ));
+		return _mm256_add_epi8 ( values, _mm256_shuffle_epi8 ( offsets, range ));
+		}
+
+	inline __m256i decode_base64_avx2 ( __m256i in, bool &valid ) {
+		const __m256i mask_2F = _mm256_set1_epi8 ( 0x2F );
+		const __m256i hi_nibbles = _mm256_and_si256 ( _mm256_srli_epi32 ( in, 4 ), mask_2F );
+		const __m256i lo_nibbles = _mm256_and_si256 ( in, mask_2F );
+		const __m256i lut_lo = broadcast_lanes ( _mm_setr_epi8 ( 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A ));
+		const __m256i lut_hi = broadcast_lanes ( _mm_setr_epi8 ( 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 ));
+		const __m256i invalid = _mm256_and_si256 ( _mm256_shuffle_epi8 ( lut_lo, lo_nibbles ), _mm256_shuffle_epi8 ( lut_hi, hi_nibbles ));
+		valid = _mm256_movemask_epi8 ( _mm256_cmpeq_epi8 ( invalid, _mm256_setzero_si256 ())) == -1;
+
+		const __m256i lut_roll = broadcast_lanes ( _mm_setr_epi8 ( 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0 ));
+		const __m256i roll = _mm256_shuffle_epi8 ( lut_roll, _mm256_add_epi8 ( _mm256_cmpeq_epi8 ( in, mask_2F ), hi_nibbles ));
+		const __m256i values = _mm256_add_epi8 ( in, roll );
+
+		const __m256i pairs = _mm256_maddubs_epi16 ( values, _mm256_set1_epi32 ( 0x01400140 ));
+		const __m256i groups = _mm256_madd_epi16 ( pairs, _mm256_set1_epi32 ( 0x00011000 ));
+		const __m256i packed = _mm256_shuffle_epi8 ( groups, broadcast_lanes ( _mm_setr_epi8 ( 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 )));
+	//	12 bytes from each lane, together at the front
+		return _mm256_permutevar8x32_epi32 ( packed, _mm256_setr_epi32 ( 0, 1, 2, 4, 5, 6, 7, 7 ));
+		}
+#endif
+
+//	Encodes as much of [in, end) as the vector kernels can, in groups of 12
+//	or 24 bytes; the kernels read 4 bytes past each group, so they stop short
+//	of the end.
+	inline char *encode_base64_blocks ( const char *&in, const char *end, char *out ) {
+#if defined ( BOOST_MIME_AVX2 )
+		for ( ; end - in >= 28; in += 24, out += 32 ) {
+			const __m256i chunk = _mm256_inserti128_si256 ( _mm256_castsi128_si256 (
+				_mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( in ))),
+				_mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( in + 12 )), 1 );
+			_mm256_storeu_si256 ( reinterpret_cast<__m256i *> ( out ), encode_base64_avx2 ( chunk ));
+			}
+#endif
+#if defined ( BOOST_MIME_SSSE3 )
+		for ( ; end - in >= 16; in += 12, out += 16 )
+			_mm_storeu_si128 ( reinterpret_cast<__m128i *> ( out ),
+				encode_base64_ssse3 ( _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( in ))));
+#endif
+#if !defined ( BOOST_MIME_AVX2 ) && !defined ( BOOST_MIME_SSSE3 )
+	//	No kernels: the scalar encoder does all of it
+		(void) in;
+		(void) end;
+#endif
+		return out;
+		}
+
+//	Encodes size bytes, a multiple of 3
+	inline char *encode_base64 ( const char *in, std::size_t size, char *out ) {
+		const char *end = in + size;
+		out = encode_base64_blocks ( in, end, out );
+		return encode_base64_scalar ( in, end - in, out );
+		}
+
+//	The decoder may write this many bytes past its output
+	static const std::size_t k_base64_decode_slack = 8;
+
+//	Decodes runs of chars from the alphabet, and stops at the first block of
+//	input with anything else in it (a line break, the padding), or when less
+//	than a group of 4 is left.
+	inline char *decode_base64_blocks ( const char *&in, const char *end, char *out ) {
+#if defined ( BOOST_MIME_AVX2 )
+		for ( ; end - in >= 32; in += 32, out += 24 ) {
+			bool valid;
+			const __m256i bytes = decode_base64_avx2 ( _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( in )), valid );
+			if ( !valid )
+				break;
+			_mm256_storeu_si256 ( reinterpret_cast<__m256i *> ( out ), bytes );
+			}
+#endif
+#if defined ( BOOST_MIME_SSSE3 )
+		for ( ; end - in >= 16; in += 16, out += 12 ) {
+			bool valid;
+			const __m128i bytes = decode_base64_ssse3 ( _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( in )), valid );
+			if ( !valid )
+				break;
+			_mm_storeu_si128 ( reinterpret_cast<__m128i *> ( out ), bytes );
+			}
+#endif
+		const signed char *values = base64_values ();
+		for ( ; end - in >= 4; in += 4, out += 3 ) {
+			const int a = values [ static_cast<unsigned char> ( in [ 0 ] ) ];
+			const int b = values [ static_cast<unsigned char> ( in [ 1 ] ) ];
+			const int c = values [ static_cast<unsigned char> ( in [ 2 ] ) ];
+			const int d = values [ static_cast<unsigned char> ( in [ 3 ] ) ];
+			if (( a | b | c | d ) < 0 )
+				break;
+			const unsigned long bits = ( a << 18 ) | ( b << 12 ) | ( c << 6 ) | d;
+			out [ 0 ] = static_cast<char> ( bits >> 16 );
+			out [ 1 ] = static_cast<char> ( bits >> 8 );
+			out [ 2 ] = static_cast<char> ( bits );
+			}
+		return out;
+		}
+
+// -----------------------------------------------------------
+//	quoted-printable
+// -----------------------------------------------------------
+
+//	The chars that quoted-printable leaves as they are: '!' through '~',
+//	except for '=', and space and tab (unless they end a line).
+	inline bool qp_is_literal ( char c ) {
+		return ( c >= ' ' && c <= '~' && c != '=' ) || c == '\t';
+		}
+
+	inline bool qp_is_white ( char c ) { return c == ' ' || c == '\t'; }
+
+	inline int qp_hex_value ( char c ) {
+		if ( c >= '0' && c <= '9' ) return c - '0';
+		if ( c >= 'A' && c <= 'F' ) return c - 'A' + 10;
+		if ( c >= 'a' && c <= 'f' ) return c - 'a' + 10;	// not allowed, but seen
+		return -1;
+		}
+
+//	The end of the run of literal chars that starts at p
+	inline const char *qp_literal_run ( const char *p, const char *last ) {
+#if defined ( BOOST_MIME_AVX2 )
+		for ( ; last - p >= 32; p += 32 ) {
+			const __m256i v = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( p ));
+			const __m256i printable = _mm256_and_si256 ( _mm256_cmpgt_epi8 ( v, _mm256_set1_epi8 ( ' ' - 1 )), _mm256_cmpgt_epi8 ( _mm256_set1_epi8 ( '~' + 1 ), v ));
+			const __m256i literal = _mm256_or_si256 ( _mm256_andnot_si256 ( _mm256_cmpeq_epi8 ( v, _mm256_set1_epi8 ( '=' )), printable ),
+				_mm256_cmpeq_epi8 ( v, _mm256_set1_epi8 ( '\t' )));
+			const unsigned mask = ~static_cast<unsigned> ( _mm256_movemask_epi8 ( literal ));
+			if ( mask != 0 )
+				return p + first_set_bit ( mask );
+			}
+#endif
+#if defined ( BOOST_MIME_SSE2 )
+		for ( ; last - p >= 16; p += 16 ) {
+			const __m128i v = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( p ));
+			const __m128i printable = _mm_and_si128 ( _mm_cmpgt_epi8 ( v, _mm_set1_epi8 ( ' ' - 1 )), _mm_cmplt_epi8 ( v, _mm_set1_epi8 ( '~' + 1 )));
+			const __m128i literal = _mm_or_si128 ( _mm_andnot_si128 ( _mm_cmpeq_epi8 ( v, _mm_set1_epi8 ( '=' )), printable ),
+				_mm_cmpeq_epi8 ( v, _mm_set1_epi8 ( '\t' )));
+			const unsigned mask = _mm_movemask_epi8 ( literal ) ^ 0xFFFF;
+			if ( mask != 0 )
+				return p + first_set_bit ( mask );
+			}
+#endif
+		while ( p != last && qp_is_literal ( *p ))
+			++p;
+		return p;
+		}
+
+//	The first '=', CR or LF at or after p
+	inline const char *qp_find_special ( const char *p, const char *last ) {
+#if defined ( BOOST_MIME_AVX2 )
+		for ( ; last - p >= 32; p += 32 ) {
+			const __m256i v = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( p ));
+			const __m256i special = _mm256_or_si256 ( _mm256_cmpeq_epi8 ( v, _mm256_set1_epi8 ( '=' )),
+				_mm256_or_si256 ( _mm256_cmpeq_epi8 ( v, _mm256_set1_epi8 ( '\r' )), _mm256_cmpeq_epi8 ( v, _mm256_set1_epi8 ( '\n' ))));
+			const unsigned mask = static_cast<unsigned> ( _mm256_movemask_epi8 ( special ));
+			if ( mask != 0 )
+				return p + first_set_bit ( mask );
+			}
+#endif
+#if defined ( BOOST_MIME_SSE2 )
+		for ( ; last - p >= 16; p += 16 ) {
+			const __m128i v = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( p ));
+			const __m128i special = _mm_or_si128 ( _mm_cmpeq_epi8 ( v, _mm_set1_epi8 ( '=' )),
+				_mm_or_si128 ( _mm_cmpeq_epi8 ( v, _mm_set1_epi8 ( '\r' )), _mm_cmpeq_epi8 ( v, _mm_set1_epi8 ( '\n' ))));
+			const unsigned mask = _mm_movemask_epi8 ( special );
+			if ( mask != 0 )
+				return p + first_set_bit ( mask );
+			}
+#endif
+		while ( p != last && *p != '=' && *p != '\r' && *p != '\n' )
+			++p;
+		return p;
+		}
+
+	inline char *qp_trim ( char *out, const char *keep ) {
+		while ( out != keep && qp_is_white ( out [ -1 ] ))
+			--out;
+		return out;
+		}
+
+//	Decodes [p, last) into out (which is moved along), and returns how far it
+//	got. Unless final is set, it stops at a tail that can't be decoded without
+//	what follows: an '=' that may start an escape or a soft line break, a CR,
+//	or white space that is dropped if a line break follows it.
+	inline const char *decode_qp_run ( const char *p, const char *last, char *&out, bool final ) {
+		char *o = out;
+	//	Everything written since keep is a copy of the input just before p, and
+	//	white space at its end is trailing white space.
+		char *keep = o;
+		while ( p != last ) {
+			const char *special = qp_find_special ( p, last );
+			std::memcpy ( o, p, special - p );
+			o += special - p;
+			p = special;
+			if ( p == last )
+				break;
+
+			if ( *p == '=' ) {
+				if ( last - p >= 3 && qp_hex_value ( p [ 1 ] ) >= 0 && qp_hex_value ( p [ 2 ] ) >= 0 ) {
+					*o++ = static_cast<char> ( qp_hex_value ( p [ 1 ] ) << 4 | qp_hex_value ( p [ 2 ] ));
+					keep = o;
+					p += 3;
+					continue;
+					}
+				if ( !final && ( last - p == 1 || ( last - p == 2 && qp_hex_value ( p [ 1 ] ) >= 0 )))
+					break;
+
+			//	A soft line break: '=', white space, and a line break (or the end)
+				const char *q = p + 1;
+				while ( q != last && qp_is_white ( *q ))
+					++q;
+				if ( q == last || ( *q == '\r' && q + 1 == last )) {
+					if ( !final )
+						break;
+					if ( q == last ) {
+						p = last;
+						keep = o;
+						continue;
+						}
+					}
+				else if ( *q == '\n' || ( *q == '\r' && q [ 1 ] == '\n' )) {
+					p = q + ( *q == '\n' ? 1 : 2 );
+					keep = o;
+					continue;
+					}
+			//	Not an escape: keep it as it is
+				*o++ = *p++;
+				}
+			else if ( *p == '\r' ) {
+				if ( p + 1 == last && !final )
+					break;
+				if ( p + 1 != last && p [ 1 ] == '\n' ) {
+					o = qp_trim ( o, keep );
+					*o++ = '\r';
+					*o++ = '\n';
+					p += 2;
+					keep = o;
+					}
+				else
+					*o++ = *p++;
+				}
+			else {
+				o = qp_trim ( o, keep );
+				*o++ = *p++;
+				keep = o;
+				}
+			}
+
+	//	Trailing white space waits for what follows it; at the end of the data,
+	//	it is dropped.
+		char *trimmed = qp_trim ( o, keep );
+		if ( !final )
+			p -= o - trimmed;
+		out = trimmed;
+		return p;
+		}
+	}
+
+// -----------------------------------------------------------
+//	base64
+// -----------------------------------------------------------
+
+//	Encodes to base64, in lines of line_length chars (rounded down to a
+//	multiple of 4) separated by CRLFs; 0 for a single line. There is no line
+//	break after the last line.
+class base64_encoder {
+public:
+	explicit base64_encoder ( std::size_t line_length = 76 )
+		: m_line_length ( line_length == 0 ? 0 : std::max<std::size_t> ( 4, line_length / 4 * 4 )), m_column ( 0 ), m_tail_size ( 0 ) {}
+
+	template <typename Container>
+	void encode ( const char *first, const char *last, Container &out ) {
+		if ( first == last )
+			return;
+
+	//	Finish the group left from the last chunk
+		char group [ 3 ] = { 0, 0, 0 };
+		std::size_t group_size = 0;
+		if ( m_tail_size > 0 ) {
+			while ( m_tail_size < 3 && first != last )
+				m_tail [ m_tail_size++ ] = *first++;
+			if ( m_tail_size < 3 )
+				return;
+			std::memcpy ( group, m_tail, 3 );
+			group_size = 3;
+			m_tail_size = 0;
+			}
+
+		const std::size_t whole = ( last - first ) / 3 * 3;
+		const std::size_t old_size = out.size ();
+		out.resize ( old_size + max_size ( group_size + whole ));
+		char *o = &out [ 0 ] + old_size;
+		o = put_groups ( group, group_size, o );
+		o = put_groups ( first, whole, o );
+		out.resize ( o - &out [ 0 ] );
+
+		first += whole;
+		m_tail_size = last - first;
+		std::copy ( first, last, m_tail );
+		}
+
+//	Pads the last group, if there is one, and starts over
+	template <typename Container>
+	void finish ( Container &out ) {
+		if ( m_tail_size > 0 ) {
+			char group [ 3 ] = { m_tail [ 0 ], m_tail_size > 1 ? m_tail [ 1 ] : '\0', '\0' };
+			char text [ 6 ];
+			char *o = text;
+			o = break_line ( o );
+			detail::encode_base64_scalar ( group, 3, o );
+			if ( m_tail_size == 1 )
+				o [ 2 ] = '=';
+			o [ 3 ] = '=';
+			out.insert ( out.end (), text, o + 4 );
+			}
+		m_column = 0;
+		m_tail_size = 0;
+		}
+
+private:
+//	Line breaks come before the group that needs them, so that there is none
+//	at the end.
+	char *break_line ( char *o ) {
+		if ( m_line_length != 0 && m_column == m_line_length ) {
+			*o++ = '\r';
+			*o++ = '\n';
+			m_column = 0;
+			}
+		return o;
+		}
+
+	char *put_groups ( const char *in, std::size_t size, char *o ) {
+		if ( m_line_length == 0 )
+			return detail::encode_base64 ( in, size, o );
+		while ( size > 0 ) {
+			o = break_line ( o );
+			const std::size_t chunk = std::min ( size, ( m_line_length - m_column ) / 4 * 3 );
+			o = detail::encode_base64 ( in, chunk, o );
+			in += chunk;
+			size -= chunk;
+			m_column += chunk / 3 * 4;
+			}
+		return o;
+		}
+
+	std::size_t max_size ( std::size_t size ) const {
+		const std::size_t chars = size / 3 * 4;
+		return chars + ( m_line_length == 0 ? 0 : 2 * ( chars / m_line_length + 1 ));
+		}
+
+	std::size_t	m_line_length;
+	std::size_t	m_column;
+	char		m_tail [ 3 ];	// the bytes of an incomplete group
+	std::size_t	m_tail_size;
+	};
+
+//	Decodes base64. As RFC 2045 asks, chars that are not in the alphabet (line
+//	breaks, mostly) are ignored; the input ends at the first '='. A group that
+//	is cut short, with or without its padding, gives the bytes it has.
+class base64_decoder {
+public:
+	base64_decoder () : m_bits ( 0 ), m_count ( 0 ), m_done ( false ) {}
+
+	template <typename Container>
+	void decode ( const char *first, const char *last, Container &out ) {
+		if ( first == last || m_done )
+			return;
+
+		const std::size_t old_size = out.size ();
+		out.resize ( old_size + ( m_count + ( last - first )) / 4 * 3 + 2 + detail::k_base64_decode_slack );
+		char *o = &out [ 0 ] + old_size;
+		const signed char *values = detail::base64_values ();
+		while ( first != last && !m_done ) {
+			if ( m_count == 0 ) {
+				o = detail::decode_base64_blocks ( first, last, o );
+				if ( first == last )
+					break;
+				}
+
+		//	Go past what stopped the blocks, a char at a time, to the end of a group
+			const char *stop = first + std::min<std::ptrdiff_t> ( 16, last - first );
+			while ( first != last && ( first < stop || m_count != 0 )) {
+				const char c = *first++;
+				const int value = values [ static_cast<unsigned char> ( c ) ];
+				if ( value >= 0 ) {
+					m_bits = ( m_bits << 6 ) | value;
+					if ( ++m_count == 4 ) {
+						o [ 0 ] = static_cast<char> ( m_bits >> 16 );
+						o [ 1 ] = static_cast<char> ( m_bits >> 8 );
+						o [ 2 ] = static_cast<char> ( m_bits );
+						o += 3;
+						m_bits = 0;
+						m_count = 0;
+						}
+					}
+				else if ( c == '=' ) {
+					o = flush ( o );
+					m_done = true;
+					break;
+					}
+				}
+			}
+		out.resize ( o - &out [ 0 ] );
+		}
+
+//	Decodes what is left of the last group, and starts over
+	template <typename Container>
+	void finish ( Container &out ) {
+		char bytes [ 2 ];
+		out.insert ( out.end (), bytes, flush ( bytes ));
+		m_done = false;
+		}
+
+private:
+	char *flush ( char *o ) {
+		if ( m_count == 2 )
+			*o++ = static_cast<char> ( m_bits >> 4 );
+		else if ( m_count == 3 ) {
+			*o++ = static_cast<char> ( m_bits >> 10 );
+			*o++ = static_cast<char> ( m_bits >> 2 );
+			}
+		m_bits = 0;
+		m_count = 0;
+		return o;
+		}
+
+	unsigned long	m_bits;		// of the group so far
+	std::size_t		m_count;	// chars in the group so far
+	bool			m_done;		// the padding has been seen
+	};
+
+// -----------------------------------------------------------
+//	quoted-printable
+// -----------------------------------------------------------
+
+//	Encodes to quoted-printable, in lines of at most line_length chars
+//	(counting the '=' of a soft line break); 0 for no limit. A CRLF in the
+//	input is a line break in the output; any other CR or LF is escaped.
+class qp_encoder {
+public:
+	explicit qp_encoder ( std::size_t line_length = 76 )
+		: m_limit ( line_length == 0 ? std::size_t ( -1 ) : line_length - 1 ), m_column ( 0 ), m_pending ( '\0' ) {
+		if ( line_length != 0 && line_length < 4 )
+			throw std::invalid_argument ( "A quoted-printable line must be at least 4 chars long" );
+		}
+
+	template <typename Container>
+	void encode ( const char *first, const char *last, Container &out ) {
+		if ( first == last )
+			return;
+
+		const std::size_t old_size = out.size ();
+		out.resize ( old_size + max_size ( last - first + 1 ));
+		char *o = &out [ 0 ] + old_size;
+
+	//	Settle the char left from the last chunk
+		if ( m_pending != '\0' ) {
+			const char c = m_pending;
+			m_pending = '\0';
+			if ( c == '\r' && *first == '\n' ) {
+				o = hard_break ( o );
+				++first;
+				}
+			else if ( c == '\r' || *first == '\r' )
+				o = put_escaped ( o, c );
+			else
+				o = put_literal ( o, c );
+			}
+
+		while ( first != last ) {
+			const char *run = detail::qp_literal_run ( first, last );
+			if ( run != first ) {
+			//	White space before a line break (or maybe before one) is escaped
+				const char *literal_end = run;
+				if ( detail::qp_is_white ( run [ -1 ] ) && ( run == last || *run == '\r' ))
+					--literal_end;
+				o = put_literals ( o, first, literal_end );
+				first = run;
+				if ( literal_end != run ) {
+					if ( run == last ) {
+						m_pending = *literal_end;
+						break;
+						}
+					o = put_escaped ( o, *literal_end );
+					}
+				if ( first == last )
+					break;
+				}
+
+			const char c = *first++;
+			if ( c == '\r' ) {
+				if ( first == last ) {
+					m_pending = c;
+					break;
+					}
+				if ( *first == '\n' ) {
+					o = hard_break ( o );
+					++first;
+					continue;
+					}
+				}
+			o = put_escaped ( o, c );
+			}
+		out.resize ( o - &out [ 0 ] );
+		}
+
+//	Escapes the white space or CR left at the end, and starts over
+	template <typename Container>
+	void finish ( Container &out ) {
+		if ( m_pending != '\0' ) {
+			char text [ 6 ];
+			out.insert ( out.end (), text, put_escaped ( text, m_pending ));
+			}
+		m_column = 0;
+		m_pending = '\0';
+		}
+
+private:
+	char *soft_break ( char *o ) {
+		o [ 0 ] = '=';
+		o [ 1 ] = '\r';
+		o [ 2 ] = '\n';
+		m_column = 0;
+		return o + 3;
+		}
+
+	char *hard_break ( char *o ) {
+		o [ 0 ] = '\r';
+		o [ 1 ] = '\n';
+		m_column = 0;
+		return o + 2;
+		}
+
+	char *put_literal ( char *o, char c ) {
+		if ( m_column == m_limit )
+			o = soft_break ( o );
+		*o++ = c;
+		++m_column;
+		return o;
+		}
+
+	char *put_literals ( char *o, const char *first, const char *last ) {
+		while ( first != last ) {
+			if ( m_column == m_limit )
+				o = soft_break ( o );
+			const std::size_t size = std::min<std::size_t> ( last - first, m_limit - m_column );
+			std::memcpy ( o, first, size );
+			o += size;
+			first += size;
+			m_column += size;
+			}
+		return o;
+		}
+
+	char *put_escaped ( char *o, char c ) {
+		if ( m_column + 3 > m_limit )
+			o = soft_break ( o );
+		o [ 0 ] = '=';
+		o [ 1 ] = detail::k_hex_digits [ static_cast<unsigned char> ( c ) >> 4 ];
+		o [ 2 ] = detail::k_hex_digits [ static_cast<unsigned char> ( c ) & 0x0F ];
+		m_column += 3;
+		return o + 3;
+		}
+
+//	Each byte is at most 3 chars, and a soft line break (3 more) comes after
+//	at least m_limit - 2 of them.
+	std::size_t max_size ( std::size_t size ) const {
+		const std::size_t chars = 3 * size;
+		return chars + ( m_limit == std::size_t ( -1 ) ? 0 : 3 * ( chars / ( m_limit - 2 ) + 1 ));
+		}
+
+	std::size_t	m_limit;	// chars on a line, before the '=' of a soft line break
+	std::size_t	m_column;
+	char		m_pending;	// white space or a CR at the end of the last chunk
+	};
+
+//	Decodes quoted-printable: escapes are decoded, soft line breaks dropped,
+//	and so is white space at the end of a line. As RFC 2045 suggests, an '='
+//	that starts neither is kept as it is.
+class qp_decoder {
+public:
+	template <typename Container>
+	void decode ( const char *first, const char *last, Container &out ) {
+		if ( first == last )
+			return;
+
+		const std::size_t old_size = out.size ();
+		out.resize ( old_size + m_tail.size () + ( last - first ));
+		char *o = &out [ 0 ] + old_size;
+
+	//	Decode the tail of the last chunk, with enough of this one to settle it
+		while ( !m_tail.empty () && first != last ) {
+			const char *settle = first;
+			while ( settle != last && detail::qp_is_white ( *settle ))
+				++settle;
+			settle += std::min<std::ptrdiff_t> ( 3, last - settle );
+
+			const std::size_t tail_size = m_tail.size ();
+			m_tail.append ( first, settle );
+			const char *tail = m_tail.data ();
+			const std::size_t used = detail::decode_qp_run ( tail, tail + m_tail.size (), o, false ) - tail;
+			if ( used >= tail_size ) {
+				first += used - tail_size;
+				m_tail.clear ();
+				}
+			else {
+				m_tail.erase ( 0, used );
+				first = settle;
+				}
+			}
+
+		if ( m_tail.empty ()) {
+			const char *stop = detail::decode_qp_run ( first, last, o, false );
+			m_tail.assign ( stop, last );
+			}
+		out.resize ( o - &out [ 0 ] );
+		}
+
+//	Decodes what was held back, and starts over
+	template <typename Container>
+	void finish ( Container &out ) {
+		if ( m_tail.empty ())
+			return;
+		const std::size_t old_size = out.size ();
+		out.resize ( old_size + m_tail.size ());
+		char *o = &out [ 0 ] + old_size;
+		detail::decode_qp_run ( m_tail.data (), m_tail.data () + m_tail.size (), o, true );
+		out.resize ( o - &out [ 0 ] );
+		m_tail.clear ();
+		}
+
+private:
+	std::string	m_tail;		// input that waits for what follows it
+	};
+
+// -----------------------------------------------------------
+//	Whole buffers
+// -----------------------------------------------------------
+
+template <typename Container>
+void base64_encode ( const char *first, const char *last, Container &out, std::size_t line_length = 76 ) {
+	base64_encoder encoder ( line_length );
+	encoder.encode ( first, last, out );
+	encoder.finish ( out );
+	}
+
+template <typename Container>
+void base64_decode ( const char *first, const char *last, Container &out ) {
+	base64_decoder decoder;
+	decoder.decode ( first, last, out );
+	decoder.finish ( out );
+	}
+
+template <typename Container>
+void qp_encode ( const char *first, const char *last, Container &out, std::size_t line_length = 76 ) {
+	qp_encoder encoder ( line_length );
+	encoder.encode ( first, last, out );
+	encoder.finish ( out );
+	}
+
+template <typename Container>
+void qp_decode ( const char *first, const char *last, Container &out ) {
+	qp_decoder decoder;
+	decoder.decode ( first, last, out );
+	decoder.finish ( out );
+	}
+
+}}
+
+#endif	// _BOOST_MIME_CODECS_HPP
@@ -0,0 +1,423 @@
+//
+//          Copyright agent (agent@local) 2026
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+//
+
+#ifndef	_BOOST_MIME_PUSH_PARSER_HPP
+#define	_BOOST_MIME_PUSH_PARSER_HPP
+
+#include <boost/mime.hpp>
+
+#include <cctype>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//	An incremental ("push") mime parser.
+//
+//	basic_mime::parse_mime needs the whole message up front. A push_parser is fed
+//	the message in fragments of any size, as they arrive from a socket or a file,
+//	and reports what it finds to a handler as it goes:
+//
+//	struct handler {
+//		void part_begin ();		// a part (or the message itself) starts
+//		void header ( const std::string &name, const std::string &value );
+//		void headers_end ();	// the headers of the current part are done
+//		void body ( const char *data, std::size_t size );	// a body (or multipart prolog) chunk
+//		void epilog ( const char *data, std::size_t size );	// a multipart epilog chunk
+//		void part_end ();
+//		};
+//
+//	Parts nest the way they do in basic_mime: the sub-parts of a multipart come
+//	between its body (the prolog) and its epilog, and a message/xxx part holds a
+//	single embedded part.
+//
+//	The chunks passed to body and epilog point into the fragment being fed, or into
+//	the parser for the few bytes of a boundary split between two fragments, and are
+//	only valid during the call. Besides those bytes, the parser only keeps the header
+//	it is reading; the headers of a part may take max_header_size bytes in all,
+//	folded lines included.
+
+namespace boost { namespace mime {
+
+namespace detail {
+
+//	Finds a delimiter in a stream of fragments. Bytes that are not part of the
+//	delimiter are passed on; the longest tail of a fragment that could start the
+//	delimiter is held back until the next fragment tells whether it does.
+	class delimiter_scanner {
+	public:
+		delimiter_scanner () : m_virtual ( 0 ), m_found ( false ) {}
+
+	//	If at_line_start is set, the scanner behaves as if a CRLF had been seen
+	//	just before the first fragment (and does not pass it on), so that a
+	//	"--boundary" at the very start of a multipart body is found.
+		void reset ( const std::string &delimiter, bool at_line_start ) {
+			if ( delimiter != m_searcher.pattern ())
+				m_searcher.reset ( delimiter );
+			m_lookbehind.clear ();
+			m_virtual = 0;
+			if ( at_line_start ) {
+				m_lookbehind = k_crlf;
+				m_virtual = m_lookbehind.size ();
+				}
+			m_found = false;
+			}
+
+		bool found () const { return m_found; }
+
+	//	Scans a fragment, calling emit ( data, size ) for the bytes before the
+	//	delimiter. Returns the number of bytes used; if found (), the delimiter
+	//	ends there.
+		template <typename Emit>
+		std::size_t scan ( const char *data, std::size_t size, Emit &emit ) {
+			const std::string &delimiter = m_searcher.pattern ();
+			const std::size_t dsize = delimiter.size ();
+			m_found = false;
+
+		//	First, a delimiter starting in the held back bytes
+			for ( std::size_t pos = 0; pos < m_lookbehind.size (); ++pos ) {
+				const std::size_t held = m_lookbehind.size () - pos;
+				if ( std::memcmp ( m_lookbehind.data () + pos, delimiter.data (), held ) != 0 )
+					continue;
+				const std::size_t rest = dsize - held;
+				const std::size_t avail = rest < size ? rest : size;
+				if ( std::memcmp ( data, delimiter.data () + held, avail ) != 0 )
+					continue;
+				emit_lookbehind ( pos, emit );
+				if ( avail < rest ) {	// still undecided
+					m_lookbehind.erase ( 0, pos );
+					m_lookbehind.append ( data, size );
+					return size;
+					}
+				m_lookbehind.clear ();
+				m_virtual = 0;
+				m_found = true;
+				return rest;
+				}
+			emit_lookbehind ( m_lookbehind.size (), emit );
+			m_lookbehind.clear ();
+
+		//	Then, one in the fragment
+			const std::size_t at = find ( data, size );
+			if ( at != size ) {
+				if ( at > 0 )
+					emit ( data, at );
+				m_found = true;
+				return at + dsize;
+				}
+
+		//	Hold back the longest tail that starts the delimiter
+			std::size_t keep = size > dsize - 1 ? size - ( dsize - 1 ) : 0;
+			for ( ; keep < size; ++keep )
+				if ( std::memcmp ( data + keep, delimiter.data (), size - keep ) == 0 )
+					break;
+			if ( keep > 0 )
+				emit ( data, keep );
+			m_lookbehind.assign ( data + keep, size - keep );
+			return size;
+			}
+
+	private:
+	//	Returns the offset of the first complete delimiter in the fragment, or size.
+		std::size_t find ( const char *data, std::size_t size ) const {
+			return m_searcher.find ( data, data + size ) - data;
+			}
+
+		template <typename Emit>
+		void emit_lookbehind ( std::size_t count, Emit &emit ) {
+			const std::size_t skip = m_virtual < count ? m_virtual : count;
+			if ( count > skip )
+				emit ( m_lookbehind.data () + skip, count - skip );
+			m_virtual -= skip;
+			}
+
+		boundary_searcher	m_searcher;
+		std::string	m_lookbehind;
+		std::size_t	m_virtual;		// leading bytes of m_lookbehind that were not in the input
+		bool		m_found;
+		};
+
+	static const std::size_t k_max_header_size = 64 * 1024;
+	}
+
+
+template <typename Handler>
+class push_parser {
+public:
+	explicit push_parser ( Handler &handler, const char *default_content_type = "text/plain" )
+		: m_handler ( handler ), m_state ( start_state ), m_default_content_type ( default_content_type ),
+			m_max_header_size ( detail::k_max_header_size ), m_header_size ( 0 ), m_after ( '\0' ) {}
+
+//	Sets the most bytes the headers of a single part may take, line ends and
+//	folded lines included. A part with more is a parsing error.
+	void max_header_size ( std::size_t size ) { m_max_header_size = size; }
+	std::size_t max_header_size () const { return m_max_header_size; }
+
+//	Parses the next fragment of the message.
+	void feed ( const char *data, std::size_t size ) {
+		if ( m_state == start_state )
+			begin_part ( m_default_content_type );
+		while ( size > 0 ) {
+			std::size_t used = 0;
+			switch ( m_state ) {
+				case headers_state:			used = read_header_line ( data, size );	break;
+				case body_state:			used = read_body ( data, size );		break;
+				case delimiter_state:		used = read_after_delimiter ( *data );	break;
+				case close_state:			used = read_after_close ( *data );		break;
+				case close_cr_state:		used = read_after_close_cr ( *data );	break;
+				case start_state:
+				case done_state:
+					throw mime_parsing_error ( "Mime data after the end of the message" );
+				}
+			data += used;
+			size -= used;
+			}
+		}
+
+	void feed ( const std::string &data ) { feed ( data.data (), data.size ()); }
+
+//	Signals the end of the message, and ends every part still open.
+	void finish () {
+		if ( m_state == start_state )
+			begin_part ( m_default_content_type );
+		if ( m_state == headers_state )
+			throw mime_parsing_error ( "Failed to parse headers" );
+	//	Every multipart must have been closed
+		if ( m_state == delimiter_state || active_multipart () != npos )
+			throw mime_parsing_error ( "Failed to parse mime body(2)" );
+		while ( !m_parts.empty ())
+			end_part ();
+		m_state = done_state;
+		}
+
+//	How many parts are open; 1 while reading the top level part.
+	std::size_t depth () const { return m_parts.size (); }
+
+private:
+	enum state { start_state, headers_state, body_state, delimiter_state, close_state, close_cr_state, done_state };
+	enum kind { simple_kind, multi_kind, message_kind };
+	static const std::size_t npos = static_cast<std::size_t> ( -1 );
+
+	struct part {
+		explicit part ( const std::string &default_ct )
+			: m_kind ( simple_kind ), m_closed ( false ), m_default_content_type ( default_ct ) {}
+
+		kind		m_kind;
+		bool		m_closed;					// multiparts: the closing delimiter was seen
+		std::string	m_default_content_type;
+		std::string	m_content_type;
+		std::string	m_delimiter;				// multiparts: CRLF--boundary
+		std::string	m_child_content_type;		// default for the sub-parts
+		};
+
+//	Passes body bytes to the handler, as body or epilog of the innermost part.
+	struct emitter {
+		explicit emitter ( push_parser &p ) : m_parser ( p ) {}
+		void operator () ( const char *data, std::size_t size ) {
+			part &p = m_parser.m_parts.back ();
+			if ( p.m_kind == multi_kind && p.m_closed )
+				m_parser.m_handler.epilog ( data, size );
+			else
+				m_parser.m_handler.body ( data, size );
+			}
+		push_parser &m_parser;
+		};
+
+	void begin_part ( const std::string &default_ct ) {
+		m_parts.push_back ( part ( default_ct ));
+		m_line.clear ();
+		m_header_name.clear ();
+		m_header_value.clear ();
+		m_header_size = 0;
+		m_state = headers_state;
+		m_handler.part_begin ();
+		}
+
+	void end_part () {
+		m_parts.pop_back ();
+		m_handler.part_end ();
+		}
+
+//	The innermost multipart whose closing delimiter was not seen yet
+	std::size_t active_multipart () const {
+		for ( std::size_t i = m_parts.size (); i > 0; --i )
+			if ( m_parts [ i - 1 ].m_kind == multi_kind && !m_parts [ i - 1 ].m_closed )
+				return i - 1;
+		return npos;
+		}
+
+	void scan_for ( std::size_t idx, bool at_line_start ) {
+		if ( idx != npos )
+			m_scanner.reset ( m_parts [ idx ].m_delimiter, at_line_start );
+		}
+
+// -----------------------------------------------------------
+//	Headers
+// -----------------------------------------------------------
+	std::size_t read_header_line ( const char *data, std::size_t size ) {
+		const char *nl = static_cast<const char *> ( std::memchr ( data, '\n', size ));
+		const std::size_t used = nl ? nl - data + 1 : size;
+		if ( m_header_size + used > m_max_header_size )
+			throw mime_parsing_error ( "Failed to parse headers" );
+		m_header_size += used;
+		m_line.append ( data, used );
+		if ( nl ) {
+			if ( m_line.size () < 2 || m_line [ m_line.size () - 2 ] != '\r' )
+				throw mime_parsing_error ( "Failed to parse headers" );
+			m_line.resize ( m_line.size () - 2 );
+			header_line ();
+			m_line.clear ();
+			}
+		return used;
+		}
+
+	void header_line () {
+		if ( m_line.empty ()) {
+			flush_header ();
+			headers_done ();
+			}
+		else if ( m_line [ 0 ] == ' ' || m_line [ 0 ] == '\t' ) {
+			if ( m_header_name.empty ())
+				throw mime_parsing_error ( "Failed to parse headers" );
+			m_header_value += detail::k_crlf;
+			m_header_value += m_line;
+			}
+		else {
+			flush_header ();
+			const std::string::size_type colon = m_line.find ( ':' );
+			if ( colon == std::string::npos || !valid_name ( m_line, colon ))
+				throw mime_parsing_error ( "Failed to parse headers" );
+			m_header_name.assign ( m_line, 0, colon );
+			m_header_value.assign ( m_line, colon + 1, std::string::npos );
+			}
+		}
+
+//	Header names are as in the header grammar: a letter, then letters, digits, '_' and '-'
+	static bool valid_name ( const std::string &line, std::size_t size ) {
+		if ( size == 0 || !std::isalpha ( static_cast<unsigned char> ( line [ 0 ] )))
+			return false;
+		for ( std::size_t i = 1; i < size; ++i ) {
+			const unsigned char c = line [ i ];
+			if ( !std::isalnum ( c ) && c != '_' && c != '-' )
+				return false;
+			}
+		return true;
+		}
+
+	void flush_header () {
+		if ( m_header_name.empty ())
+			return;
+		part &p = m_parts.back ();
+		if ( p.m_content_type.empty () && detail::ascii_iequals ( m_header_name, detail::k_content_type_header ))
+			p.m_content_type = m_header_value;
+		m_handler.header ( m_header_name, m_header_value );
+		m_header_name.clear ();
+		m_header_value.clear ();
+		}
+
+	void headers_done () {
+		part &p = m_parts.back ();
+		const std::string ct = p.m_content_type.empty () ? p.m_default_content_type : p.m_content_type;
+		detail::mime_content_type mct = detail::parse_content_type ( ct );
+		if ( detail::ascii_iequals ( mct.type, "multipart" )) {
+			p.m_kind = multi_kind;
+			p.m_delimiter = std::string ( detail::k_crlf ) + "--" + detail::get_boundary ( ct );
+			p.m_child_content_type =
+				detail::ascii_iequals ( mct.sub_type, "digest" ) ? "message/rfc822" : "text/plain";
+			}
+		else if ( detail::ascii_iequals ( mct.type, "message" ) && !detail::ascii_iequals ( mct.sub_type, "delivery-status" ))
+			p.m_kind = message_kind;
+
+		m_handler.headers_end ();
+		if ( p.m_kind == message_kind )
+			begin_part ( "text/plain" );
+		else {
+			m_state = body_state;
+			if ( p.m_kind == multi_kind )
+				scan_for ( m_parts.size () - 1, true );
+			}
+		}
+
+// -----------------------------------------------------------
+//	Bodies and delimiters
+// -----------------------------------------------------------
+	std::size_t read_body ( const char *data, std::size_t size ) {
+		emitter e ( *this );
+		const std::size_t idx = active_multipart ();
+		if ( idx == npos ) {	// runs to the end of the message
+			e ( data, size );
+			return size;
+			}
+		const std::size_t used = m_scanner.scan ( data, size, e );
+		if ( m_scanner.found ()) {
+			while ( m_parts.size () > idx + 1 )
+				end_part ();
+			m_state = delimiter_state;
+			}
+		return used;
+		}
+
+//	After CRLF--boundary comes either "--" (the last one), or optional
+//	whitespace and a CRLF before the next sub-part.
+	std::size_t read_after_delimiter ( char c ) {
+		if ( c == '-' && m_after == '\0' )
+			m_after = '-';
+		else if ( c == '-' && m_after == '-' ) {
+			m_after = '\0';
+			m_parts.back ().m_closed = true;
+			m_state = close_state;
+			}
+		else if (( c == ' ' || c == '\t' || c == '\r' ) && ( m_after == '\0' || m_after == ' ' ))
+			m_after = c == '\r' ? '\r' : ' ';
+		else if ( c == '\n' && m_after == '\r' ) {
+			m_after = '\0';
+			begin_part ( m_parts.back ().m_child_content_type );
+			}
+		else
+			throw mime_parsing_error ( "Failed to parse mime body(2)" );
+		return 1;
+		}
+
+//	The closing delimiter is followed by a CRLF, then the epilog, which runs
+//	to the next delimiter of an enclosing multipart.
+	std::size_t read_after_close ( char c ) {
+		if ( c == '\r' ) {
+			m_state = close_cr_state;
+			return 1;
+			}
+		scan_for ( active_multipart (), false );
+		m_state = body_state;
+		return 0;
+		}
+
+	std::size_t read_after_close_cr ( char c ) {
+		m_state = body_state;
+		if ( c == '\n' ) {
+			scan_for ( active_multipart (), true );
+			return 1;
+			}
+		scan_for ( active_multipart (), false );
+		read_body ( "\r", 1 );
+		return 0;
+		}
+
+	Handler							&m_handler;
+	state							m_state;
+	std::string						m_default_content_type;
+	std::vector<part>				m_parts;
+	detail::delimiter_scanner		m_scanner;
+	std::string						m_line;
+	std::string						m_header_name;
+	std::string						m_header_value;
+	std::size_t						m_max_header_size;
+	std::size_t						m_header_size;	// of the part being read so far
+	char							m_after;	// what followed a delimiter so far
+	};
+
+}}
+
+#endif	// _BOOST_MIME_PUSH_PARSER_HPP
@@ -0,0 +1,171 @@
+/*
+	Time the base64 and quoted-printable codecs.
+
+	Encodes and decodes a buffer of random bytes (for base64) and of text with
+	some non-ASCII in it (for quoted-printable), and reports the throughput of:
+		- a plain decoder that looks at one char at a time, for comparison,
+		- each codec on the whole buffer,
+		- each codec fed in 4k chunks.
+	The throughput is of the unencoded bytes. Build with -mssse3 or -mavx2 to
+	time the vector kernels, and with -DBOOST_MIME_NO_SIMD to time plain C++.
+
+	Usage: mime-codecs-benchmark [size in MB (default 64)]
+*/
+
+#include <boost/mime/codecs.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+	std::string random_bytes ( std::size_t size ) {
+		std::srand ( 1 );
+		std::string retVal ( size, '\0' );
+		for ( std::size_t i = 0; i < size; ++i )
+			retVal [ i ] = static_cast<char> ( std::rand () & 0xFF );
+		return retVal;
+		}
+
+//	Mostly ASCII lines, with an accented letter now and then
+	std::string make_text ( std::size_t size ) {
+		const std::string line = "Le c\xC5\x93ur a ses raisons que la raison ne conna\xC3\xAEt point. = Pascal\r\n";
+		std::string retVal;
+		retVal.reserve ( size + line.size ());
+		while ( retVal.size () < size )
+			retVal += line;
+		return retVal;
+		}
+
+	template <typename Function>
+	double megabytes_per_second ( std::size_t size, Function f ) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+		f ();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+		return size / ( 1024.0 * 1024.0 ) / elapsed.count ();
+		}
+
+	template <typename Codec>
+	void run_chunked ( Codec &codec, void ( Codec::*process ) ( const char *, const char *, std::vector<char> & ),
+			const std::string &in, std::vector<char> &out ) {
+		const std::size_t chunk_size = 4096;
+		for ( std::size_t pos = 0; pos < in.size (); pos += chunk_size ) {
+			const char *chunk = in.data () + pos;
+			( codec.*process ) ( chunk, chunk + std::min ( chunk_size, in.size () - pos ), out );
+			}
+		codec.finish ( out );
+		}
+
+//	One char at a time, skipping anything not in the alphabet
+	void naive_base64_decode ( const std::string &in, std::vector<char> &out ) {
+		const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		int values [ 256 ];
+		std::fill ( values, values + 256, -1 );
+		for ( int i = 0; i < 64; ++i )
+			values [ static_cast<unsigned char> ( alphabet [ i ] ) ] = i;
+
+		unsigned long bits = 0;
+		int count = 0;
+		for ( std::string::const_iterator iter = in.begin (); iter != in.end () && *iter != '='; ++iter ) {
+			const int value = values [ static_cast<unsigned char> ( *iter ) ];
+			if ( value < 0 )
+				continue;
+			bits = ( bits << 6 ) | value;
+			if ( ++count == 4 ) {
+				out.push_back ( static_cast<char> ( bits >> 16 ));
+				out.push_back ( static_cast<char> ( bits >> 8 ));
+				out.push_back ( static_cast<char> ( bits ));
+				bits = 0;
+				count = 0;
+				}
+			}
+		}
+
+	volatile std::size_t sink;
+}
+
+
+int main ( int argc, char *argv [] ) {
+	const std::size_t size = ( argc > 1 ? std::atoi ( argv [ 1 ] ) : 64 ) * 1024 * 1024;
+	const std::string bytes = random_bytes ( size );
+	const std::string text = make_text ( size );
+
+	std::vector<char> base64;
+	const double base64_encode = megabytes_per_second ( bytes.size (), [&] {
+		boost::mime::base64_encode ( bytes.data (), bytes.data () + bytes.size (), base64 );
+		});
+	const std::string encoded ( base64.begin (), base64.end ());
+
+	const double base64_encode_chunked = megabytes_per_second ( bytes.size (), [&] {
+		std::vector<char> out;
+		boost::mime::base64_encoder encoder;
+		run_chunked ( encoder, &boost::mime::base64_encoder::encode<std::vector<char> >, bytes, out );
+		sink = out.size ();
+		});
+
+	const double base64_naive = megabytes_per_second ( bytes.size (), [&] {
+		std::vector<char> out;
+		naive_base64_decode ( encoded, out );
+		sink = out.size ();
+		});
+
+	std::vector<char> decoded;
+	const double base64_decode = megabytes_per_second ( bytes.size (), [&] {
+		boost::mime::base64_decode ( encoded.data (), encoded.data () + encoded.size (), decoded );
+		});
+	if ( std::string ( decoded.begin (), decoded.end ()) != bytes ) {
+		std::fprintf ( stderr, "base64 round trip failed\n" );
+		return 1;
+		}
+
+	const double base64_decode_chunked = megabytes_per_second ( bytes.size (), [&] {
+		std::vector<char> out;
+		boost::mime::base64_decoder decoder;
+		run_chunked ( decoder, &boost::mime::base64_decoder::decode<std::vector<char> >, encoded, out );
+		sink = out.size ();
+		});
+
+	std::vector<char> qp;
+	const double qp_encode = megabytes_per_second ( text.size (), [&] {
+		boost::mime::qp_encode ( text.data (), text.data () + text.size (), qp );
+		});
+	const std::string qp_encoded ( qp.begin (), qp.end ());
+
+	const double qp_encode_chunked = megabytes_per_second ( text.size (), [&] {
+		std::vector<char> out;
+		boost::mime::qp_encoder encoder;
+		run_chunked ( encoder, &boost::mime::qp_encoder::encode<std::vector<char> >, text, out );
+		sink = out.size ();
+		});
+
+	std::vector<char> qp_decoded;
+	const double qp_decode = megabytes_per_second ( text.size (), [&] {
+		boost::mime::qp_decode ( qp_encoded.data (), qp_encoded.data () + qp_encoded.size (), qp_decoded );
+		});
+	if ( std::string ( qp_decoded.begin (), qp_decoded.end ()) != text ) {
+		std::fprintf ( stderr, "quoted-printable round trip failed\n" );
+		return 1;
+		}
+
+	const double qp_decode_chunked = megabytes_per_second ( text.size (), [&] {
+		std::vector<char> out;
+		boost::mime::qp_decoder decoder;
+		run_chunked ( decoder, &boost::mime::qp_decoder::decode<std::vector<char> >, qp_encoded, out );
+		sink = out.size ();
+		});
+
+	std::printf ( "%zu MB\n", size / ( 1024 * 1024 ));
+	std::printf ( "base64 encode          %8.1f MB/s\n", base64_encode );
+	std::printf ( "  (4k chunks)          %8.1f MB/s\n", base64_encode_chunked );
+	std::printf ( "base64 decode, naive   %8.1f MB/s\n", base64_naive );
+	std::printf ( "base64 decode          %8.1f MB/s\n", base64_decode );
+	std::printf ( "  (4k chunks)          %8.1f MB/s\n", base64_decode_chunked );
+	std::printf ( "qp encode              %8.1f MB/s\n", qp_encode );
+	std::printf ( "  (4k chunks)          %8.1f MB/s\n", qp_encode_chunked );
+	std::printf ( "qp decode              %8.1f MB/s\n", qp_decode );
+	std::printf ( "  (4k chunks)          %8.1f MB/s\n", qp_decode_chunked );
+	return 0;
+	}
@@ -0,0 +1,276 @@
+/*
+	Check the base64 and quoted-printable codecs against known encodings and a
+	plain reference encoder, whole and fed in chunks of various sizes, and the
+	decoding of bodies by basic_mime.
+
+	Returns 0 for success, non-zero for failure
+
+*/
+
+#include <boost/mime.hpp>
+#include <boost/mime/codecs.hpp>
+#include <functional>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+	struct my_traits {
+		typedef	std::string string_type;
+		typedef std::string body_type;
+		};
+
+	struct shared_traits {
+		typedef	std::string string_type;
+		typedef boost::mime::buffer_body body_type;
+		};
+
+	std::string random_bytes ( std::size_t size, unsigned seed ) {
+		std::srand ( seed );
+		std::string retVal ( size, '\0' );
+		for ( std::size_t i = 0; i < size; ++i )
+			retVal [ i ] = static_cast<char> ( std::rand () & 0xFF );
+		return retVal;
+		}
+
+//	A char at a time, the way the RFC describes it
+	std::string reference_base64 ( const std::string &in, std::size_t line_length ) {
+		const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		std::string chars;
+		for ( std::size_t i = 0; i < in.size (); i += 3 ) {
+			unsigned long bits = static_cast<unsigned char> ( in [ i ] ) << 16;
+			if ( i + 1 < in.size ()) bits |= static_cast<unsigned char> ( in [ i + 1 ] ) << 8;
+			if ( i + 2 < in.size ()) bits |= static_cast<unsigned char> ( in [ i + 2 ] );
+			chars += alphabet [ bits >> 18 ];
+			chars += alphabet [ ( bits >> 12 ) & 0x3F ];
+			chars += i + 1 < in.size () ? alphabet [ ( bits >> 6 ) & 0x3F ] : '=';
+			chars += i + 2 < in.size () ? alphabet [ bits & 0x3F ] : '=';
+			}
+		std::string retVal;
+		for ( std::size_t i = 0; i < chars.size (); i += line_length ) {
+			if ( i > 0 )
+				retVal += "\r\n";
+			retVal += chars.substr ( i, line_length );
+			}
+		return retVal;
+		}
+
+	template <typename Codec>
+	std::string run ( Codec codec, const std::string &in, std::size_t chunk_size,
+			void ( Codec::*process ) ( const char *, const char *, std::string & )) {
+		std::string retVal;
+		for ( std::size_t pos = 0; pos < in.size (); pos += chunk_size ) {
+			const char *chunk = in.data () + pos;
+			( codec.*process ) ( chunk, chunk + std::min ( chunk_size, in.size () - pos ), retVal );
+			}
+		codec.finish ( retVal );
+		return retVal;
+		}
+
+	std::string base64_encode ( const std::string &in, std::size_t chunk_size = 1000000, std::size_t line_length = 76 ) {
+		return run ( boost::mime::base64_encoder ( line_length ), in, chunk_size, &boost::mime::base64_encoder::encode<std::string> );
+		}
+
+	std::string base64_decode ( const std::string &in, std::size_t chunk_size = 1000000 ) {
+		return run ( boost::mime::base64_decoder (), in, chunk_size, &boost::mime::base64_decoder::decode<std::string> );
+		}
+
+	std::string qp_encode ( const std::string &in, std::size_t chunk_size = 1000000, std::size_t line_length = 76 ) {
+		return run ( boost::mime::qp_encoder ( line_length ), in, chunk_size, &boost::mime::qp_encoder::encode<std::string> );
+		}
+
+	std::string qp_decode ( const std::string &in, std::size_t chunk_size = 1000000 ) {
+		return run ( boost::mime::qp_decoder (), in, chunk_size, &boost::mime::qp_decoder::decode<std::string> );
+		}
+
+	const std::size_t k_chunk_sizes [] = { 1, 2, 3, 5, 16, 17, 63, 1000 };
+
+	void test_base64_vectors () {
+	//	From RFC 4648
+		BOOST_CHECK_EQUAL ( "",         base64_encode ( "" ));
+		BOOST_CHECK_EQUAL ( "Zg==",     base64_encode ( "f" ));
+		BOOST_CHECK_EQUAL ( "Zm8=",     base64_encode ( "fo" ));
+		BOOST_CHECK_EQUAL ( "Zm9v",     base64_encode ( "foo" ));
+		BOOST_CHECK_EQUAL ( "Zm9vYg==", base64_encode ( "foob" ));
+		BOOST_CHECK_EQUAL ( "Zm9vYmE=", base64_encode ( "fooba" ));
+		BOOST_CHECK_EQUAL ( "Zm9vYmFy", base64_encode ( "foobar" ));
+
+		BOOST_CHECK_EQUAL ( "foobar", base64_decode ( "Zm9vYmFy" ));
+		BOOST_CHECK_EQUAL ( "fooba",  base64_decode ( "Zm9vYmE=" ));
+		BOOST_CHECK_EQUAL ( "foob",   base64_decode ( "Zm9vYg==" ));
+		BOOST_CHECK_EQUAL ( "foob",   base64_decode ( "Zm9vYg" ));			// no padding
+		BOOST_CHECK_EQUAL ( "foobar", base64_decode ( "Zm9v\r\n YmFy\r\n" ));	// line breaks and junk are skipped
+		BOOST_CHECK_EQUAL ( "fo",     base64_decode ( "Zm8=Zm9v" ));			// nothing after the padding
+		}
+
+	void test_base64_random () {
+		for ( std::size_t size = 0; size < 300; ++size ) {
+			const std::string bytes = random_bytes ( size, size );
+			const std::string encoded = base64_encode ( bytes );
+			BOOST_REQUIRE_EQUAL ( reference_base64 ( bytes, 76 ), encoded );
+			BOOST_REQUIRE_EQUAL ( reference_base64 ( bytes, 1000 ), base64_encode ( bytes, 1000000, 0 ));
+			BOOST_REQUIRE ( bytes == base64_decode ( encoded ));
+			}
+
+	//	Long enough for the vector loops, fed in chunks of all sizes
+		const std::string bytes = random_bytes ( 100000, 42 );
+		const std::string encoded = reference_base64 ( bytes, 76 );
+		for ( std::size_t i = 0; i < sizeof ( k_chunk_sizes ) / sizeof ( k_chunk_sizes [ 0 ] ); ++i ) {
+			BOOST_CHECK ( encoded == base64_encode ( bytes, k_chunk_sizes [ i ] ));
+			BOOST_CHECK ( bytes == base64_decode ( encoded, k_chunk_sizes [ i ] ));
+			}
+		BOOST_CHECK ( bytes == base64_decode ( reference_base64 ( bytes, 1000000 )));
+		BOOST_CHECK ( bytes == base64_decode ( reference_base64 ( bytes, 64 )));
+		}
+
+	void test_qp_vectors () {
+		BOOST_CHECK_EQUAL ( "a=3Db",              qp_encode ( "a=b" ));
+		BOOST_CHECK_EQUAL ( "caf=C3=A9",          qp_encode ( "caf\xC3\xA9" ));
+		BOOST_CHECK_EQUAL ( "tab=09\r\nspace=20", qp_encode ( "tab\t\r\nspace " ));
+		BOOST_CHECK_EQUAL ( "a b\r\nc",           qp_encode ( "a b\r\nc" ));
+		BOOST_CHECK_EQUAL ( "\r\n=0A",           qp_encode ( "\r\n\n" ));
+		BOOST_CHECK_EQUAL ( "bare=0Dcr",          qp_encode ( "bare\rcr" ));
+
+		const std::string line ( 100, 'x' );
+		BOOST_CHECK_EQUAL ( line.substr ( 0, 75 ) + "=\r\n" + line.substr ( 75 ), qp_encode ( line ));
+
+		BOOST_CHECK_EQUAL ( "a=b",           qp_decode ( "a=3Db" ));
+		BOOST_CHECK_EQUAL ( "J",             qp_decode ( "=4a" ));				// lower case hex
+		BOOST_CHECK_EQUAL ( "soft break",    qp_decode ( "soft =\r\nbreak" ));
+		BOOST_CHECK_EQUAL ( "soft break",    qp_decode ( "soft =  \nbreak" ));
+		BOOST_CHECK_EQUAL ( "trailing\r\nx", qp_decode ( "trailing \t \r\nx" ));	// white space at the end of a line
+		BOOST_CHECK_EQUAL ( "end",           qp_decode ( "end  " ));
+		BOOST_CHECK_EQUAL ( "kept  \r\n",    qp_decode ( "kept =20\r\n" ));		// escaped white space stays
+		BOOST_CHECK_EQUAL ( "=ZZ =G",        qp_decode ( "=ZZ =G" ));				// not escapes
+		BOOST_CHECK_EQUAL ( "last",          qp_decode ( "last=" ));
+		}
+
+	void test_qp_random () {
+	//	Text with line breaks, runs of white space, and some binary
+		std::string text;
+		const std::string bytes = random_bytes ( 20000, 7 );
+		for ( std::size_t i = 0; i < bytes.size (); ++i ) {
+			const unsigned char b = static_cast<unsigned char> ( bytes [ i ] );
+			if ( b < 16 )
+				text += "\r\n";
+			else if ( b < 48 )
+				text += ' ';
+			else if ( b < 56 )
+				text += '\t';
+			else if ( b < 64 )
+				text += '=';
+			else if ( b < 240 )
+				text += static_cast<char> ( 'a' + b % 26 );
+			else
+				text += static_cast<char> ( b );
+			}
+
+		const std::string encoded = qp_encode ( text );
+		BOOST_CHECK ( text == qp_decode ( encoded ));
+
+	//	No line is too long, or ends in white space
+		std::size_t start = 0;
+		for ( std::size_t end; ( end = encoded.find ( "\r\n", start )) != std::string::npos; start = end + 2 ) {
+			BOOST_CHECK ( end - start <= 76 );
+			if ( end > start )
+				BOOST_CHECK ( encoded [ end - 1 ] != ' ' && encoded [ end - 1 ] != '\t' );
+			}
+		BOOST_CHECK ( encoded.size () - start <= 76 );
+
+		for ( std::size_t i = 0; i < sizeof ( k_chunk_sizes ) / sizeof ( k_chunk_sizes [ 0 ] ); ++i ) {
+			BOOST_CHECK ( encoded == qp_encode ( text, k_chunk_sizes [ i ] ));
+			BOOST_CHECK ( text == qp_decode ( encoded, k_chunk_sizes [ i ] ));
+			}
+
+	//	Binary, and no line limit
+		const std::string binary_encoded = qp_encode ( bytes, 1000000, 0 );
+		BOOST_CHECK ( std::string::npos == binary_encoded.find ( "\r\n" ));
+		BOOST_CHECK ( bytes == qp_decode ( binary_encoded ));
+		}
+
+	template <typename traits>
+	void test_decoded_body () {
+		typedef boost::mime::basic_mime<traits>	mime_part;
+		const std::string text = "Caf\xC3\xA9 = caf\xC3\xA9\r\n";
+
+		std::ostringstream message;
+		message << "Content-Type: multipart/mixed; boundary=\"b\"\r\n\r\n"
+				<< "--b\r\nContent-Type: text/plain\r\nContent-Transfer-Encoding: base64\r\n\r\n"
+				<< reference_base64 ( text, 76 )
+				<< "\r\n--b\r\nContent-Type: text/plain\r\nContent-Transfer-Encoding: Quoted-Printable \r\n\r\n"
+				<< "Caf=C3=A9 =3D caf=\r\n=C3=A9\r\n"
+				<< "\r\n--b\r\nContent-Type: text/plain\r\n\r\n"
+				<< "plain"
+				<< "\r\n--b--\r\n";
+		const std::string contents = message.str ();
+		std::string::const_iterator begin = contents.begin ();
+		boost::shared_ptr<mime_part> mp = mime_part::parse_mime ( begin, contents.end ());
+		BOOST_REQUIRE_EQUAL ( 3U, mp->part_count ());
+
+		mime_part &base64_part = *( *mp ) [ 0 ];
+		typename mime_part::mimeBody decoded = base64_part.decoded_body ();
+		BOOST_CHECK_EQUAL ( text, std::string ( decoded->begin (), decoded->end ()));
+		BOOST_CHECK ( decoded == base64_part.decoded_body ());		// decoded once
+		BOOST_CHECK ( decoded != base64_part.body ());
+
+		decoded = ( *mp ) [ 1 ]->decoded_body ();
+		BOOST_CHECK_EQUAL ( text, std::string ( decoded->begin (), decoded->end ()));
+
+		BOOST_CHECK ( ( *mp ) [ 2 ]->body () == ( *mp ) [ 2 ]->decoded_body ());
+
+	//	A new body is decoded again
+		const std::string zm9v = "Zm9v";
+		base64_part.set_body ( zm9v.begin (), zm9v.end ());
+		decoded = base64_part.decoded_body ();
+		BOOST_CHECK_EQUAL ( "foo", std::string ( decoded->begin (), decoded->end ()));
+
+	//	Re-encode, write out, and read back
+		mime_part &plain_part = *( *mp ) [ 2 ];
+		plain_part.set_transfer_encoding ( "base64" );
+		BOOST_CHECK_EQUAL ( "cGxhaW4=", std::string ( plain_part.body ()->begin (), plain_part.body ()->end ()));
+		BOOST_CHECK_EQUAL ( "base64", plain_part.header_value ( "Content-Transfer-Encoding" ));
+		( *mp ) [ 1 ]->set_transfer_encoding ( "8bit" );
+		BOOST_CHECK_EQUAL ( text, std::string ( ( *mp ) [ 1 ]->body ()->begin (), ( *mp ) [ 1 ]->body ()->end ()));
+
+		std::ostringstream out;
+		out << *mp;
+		const std::string written = out.str ();
+		begin = written.begin ();
+		boost::shared_ptr<mime_part> reparsed = mime_part::parse_mime ( begin, written.end ());
+		BOOST_REQUIRE_EQUAL ( 3U, reparsed->part_count ());
+		for ( std::size_t i = 0; i < 3; ++i ) {
+			const typename mime_part::mimeBody before = ( *mp ) [ i ]->decoded_body ();
+			const typename mime_part::mimeBody after  = ( *reparsed ) [ i ]->decoded_body ();
+			BOOST_CHECK_EQUAL ( std::string ( before->begin (), before->end ()), std::string ( after->begin (), after->end ()));
+			}
+
+		BOOST_CHECK_THROW ( mp->set_transfer_encoding ( "base64" ), std::runtime_error );
+
+	//	An encoding the body can't be put in leaves the part alone
+		BOOST_CHECK_THROW ( plain_part.set_transfer_encoding ( "x-uuencode" ), std::runtime_error );
+		BOOST_CHECK_EQUAL ( "base64", plain_part.header_value ( "Content-Transfer-Encoding" ));
+		BOOST_CHECK_EQUAL ( "cGxhaW4=", std::string ( plain_part.body ()->begin (), plain_part.body ()->end ()));
+		plain_part.set_transfer_encoding ( "Binary" );
+		BOOST_CHECK_EQUAL ( "plain", std::string ( plain_part.body ()->begin (), plain_part.body ()->end ()));
+		}
+}
+
+
+using namespace boost::unit_test;
+
+test_suite*
+init_unit_test_suite( int argc, char* argv[] )
+{
+    framework::master_test_suite().add ( BOOST_TEST_CASE( test_base64_vectors ));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( test_base64_random ));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( test_qp_vectors ));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( test_qp_random ));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( test_decoded_body<my_traits> ));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( test_decoded_body<shared_traits> ));
+    return 0;
+}
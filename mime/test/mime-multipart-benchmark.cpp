@@ -0,0 +1,157 @@
+/*
+	Time the splitting of a large multipart message.
+
+	Builds a multipart/mixed message of text parts (lines of text, each ending in
+	a CRLF, so that most CRs are not the start of a delimiter), and reports the
+	throughput of:
+		- finding every delimiter with a first byte filter (memchr, then memcmp),
+		- finding every delimiter with boundary_searcher (Boyer-Moore-Horspool),
+		- parse_mime on the whole message, copying the bodies into strings,
+		- parse_mime on the whole message, with buffer_body bodies,
+		- push_parser, fed in 64k fragments,
+		- writing the parsed message with operator <<, into a string,
+		- building the mime_buffers for the parsed message.
+
+	Usage: mime-multipart-benchmark [size in MB (default 256)] [part size in kB (default 64)]
+*/
+
+#include <boost/mime.hpp>
+#include <boost/mime/buffers.hpp>
+#include <boost/mime/push_parser.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+namespace {
+
+	const char *k_boundary = "------=_NextPart_000_0012_01CA5B4E.8A3C3B90";
+
+	std::string make_message ( std::size_t size, std::size_t part_size ) {
+		const std::string line = "The quick brown fox jumps over the lazy dog, again and again.\r\n";
+		std::string part_body;
+		while ( part_body.size () + line.size () <= part_size )
+			part_body += line;
+
+		std::string retVal;
+		retVal.reserve ( size + part_size + 1024 );
+		retVal += "Content-Type: multipart/mixed; boundary=\"";
+		retVal += k_boundary;
+		retVal += "\"\r\n\r\nThis is a multi-part message in MIME format.\r\n";
+		while ( retVal.size () < size ) {
+			retVal += "\r\n--";
+			retVal += k_boundary;
+			retVal += "\r\nContent-Type: text/plain\r\n\r\n";
+			retVal += part_body;
+			}
+		retVal += "\r\n--";
+		retVal += k_boundary;
+		retVal += "--\r\n";
+		return retVal;
+		}
+
+	template <typename Function>
+	double megabytes_per_second ( std::size_t size, Function f ) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+		f ();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+		return size / ( 1024.0 * 1024.0 ) / elapsed.count ();
+		}
+
+	struct my_traits {
+		typedef	std::string string_type;
+		typedef std::string body_type;
+		};
+
+	struct shared_traits {
+		typedef	std::string string_type;
+		typedef boost::mime::buffer_body body_type;
+		};
+
+	typedef boost::mime::basic_mime<my_traits>		mime_part;
+	typedef boost::mime::basic_mime<shared_traits>	shared_part;
+
+	struct counting_handler {
+		counting_handler () : parts ( 0 ), bytes ( 0 ) {}
+		void part_begin () { ++parts; }
+		void header ( const std::string &, const std::string & ) {}
+		void headers_end () {}
+		void body ( const char *, std::size_t size ) { bytes += size; }
+		void epilog ( const char *, std::size_t size ) { bytes += size; }
+		void part_end () {}
+
+		std::size_t	parts;
+		std::size_t	bytes;
+		};
+
+	volatile std::size_t sink;
+}
+
+
+int main ( int argc, char *argv [] ) {
+	const std::size_t size = ( argc > 1 ? std::atoi ( argv [ 1 ] ) : 256 ) * 1024 * 1024;
+	const std::size_t part_size = ( argc > 2 ? std::atoi ( argv [ 2 ] ) : 64 ) * 1024;
+	const std::string message = make_message ( size, part_size );
+	const std::string delimiter = std::string ( "\r\n--" ) + k_boundary;
+	const char *first = message.data ();
+	const char *last = first + message.size ();
+
+	std::size_t first_byte_count = 0;
+	const double first_byte = megabytes_per_second ( message.size (), [&] {
+		for ( const char *p = first; ( p = static_cast<const char *> ( std::memchr ( p, '\r', last - p ))) != NULL; ++p )
+			if ( static_cast<std::size_t> ( last - p ) >= delimiter.size () && std::memcmp ( p, delimiter.data (), delimiter.size ()) == 0 )
+				++first_byte_count;
+		});
+
+	std::size_t horspool_count = 0;
+	const double horspool = megabytes_per_second ( message.size (), [&] {
+		const boost::mime::detail::boundary_searcher searcher ( delimiter );
+		for ( const char *p = first; ( p = searcher.find ( p, last )) != last; p += delimiter.size ())
+			++horspool_count;
+		});
+
+	std::size_t parsed_parts = 0;
+	const double parse = megabytes_per_second ( message.size (), [&] {
+		std::string::const_iterator begin = message.begin ();
+		parsed_parts = mime_part::parse_mime ( begin, message.end ())->part_count ();
+		});
+
+	boost::shared_ptr<shared_part> parsed;
+	const double parse_shared = megabytes_per_second ( message.size (), [&] {
+		std::string::const_iterator begin = message.begin ();
+		parsed = shared_part::parse_mime ( begin, message.end ());
+		});
+
+	const double stream_out = megabytes_per_second ( message.size (), [&] {
+		std::ostringstream out;
+		out << *parsed;
+		sink = out.str ().size ();
+		});
+
+	const double buffers = megabytes_per_second ( message.size (), [&] {
+		boost::mime::mime_buffers<shared_traits> b ( *parsed );
+		sink = b.size ();
+		});
+
+	counting_handler handler;
+	const double push = megabytes_per_second ( message.size (), [&] {
+		boost::mime::push_parser<counting_handler> parser ( handler );
+		for ( std::size_t pos = 0; pos < message.size (); pos += 64 * 1024 )
+			parser.feed ( first + pos, std::min<std::size_t> ( 64 * 1024, message.size () - pos ));
+		parser.finish ();
+		});
+	sink = handler.bytes;
+
+	std::printf ( "%zu MB, %zu parts of %zu kB\n", message.size () / ( 1024 * 1024 ), parsed_parts, part_size / 1024 );
+	std::printf ( "first byte filter  %8.1f MB/s  (%zu delimiters)\n", first_byte, first_byte_count );
+	std::printf ( "boundary_searcher  %8.1f MB/s  (%zu delimiters)\n", horspool, horspool_count );
+	std::printf ( "parse_mime         %8.1f MB/s\n", parse );
+	std::printf ( "  (buffer_body)    %8.1f MB/s\n", parse_shared );
+	std::printf ( "operator <<        %8.1f MB/s\n", stream_out );
+	std::printf ( "mime_buffers       %8.1f MB/s\n", buffers );
+	std::printf ( "push_parser        %8.1f MB/s  (%zu parts)\n", push, handler.parts - 1 );
+	return 0;
+	}
@@ -0,0 +1,203 @@
+/*
+	Feed the test messages to a push_parser in fragments of various sizes,
+	and check that the structure it reports is the one parse_mime builds.
+
+	Returns 0 for success, non-zero for failure
+
+*/
+
+#include <boost/mime.hpp>
+#include <boost/mime/push_parser.hpp>
+#include <functional>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    std::string readfile ( const char *fileName ) {
+		std::ifstream in ( fileName, std::ios::binary );
+		if ( !in )
+			throw std::runtime_error ( std::string ( "Can't open file: " ) + fileName );
+		return std::string ( std::istreambuf_iterator<char> ( in ), std::istreambuf_iterator<char> ());
+		}
+
+	struct my_traits {
+		typedef	std::string string_type;
+		typedef std::string body_type;
+		};
+
+	typedef boost::mime::basic_mime<my_traits>	mime_part;
+	typedef boost::shared_ptr<mime_part> 		smp;
+
+//	What the push parser reported about a part
+	struct node {
+		std::vector<std::pair<std::string, std::string> >	headers;
+		std::string											body;
+		std::string											epilog;
+		std::vector<boost::shared_ptr<node> >				parts;
+		bool												headers_done;
+		node () : headers_done ( false ) {}
+		};
+
+	struct tree_builder {
+		void part_begin () {
+			boost::shared_ptr<node> n ( new node );
+			if ( stack.empty ())
+				root = n;
+			else
+				stack.back ()->parts.push_back ( n );
+			stack.push_back ( n.get ());
+			}
+		void header ( const std::string &name, const std::string &value ) {
+			stack.back ()->headers.push_back ( std::make_pair ( name, value ));
+			}
+		void headers_end () { stack.back ()->headers_done = true; }
+		void body ( const char *data, std::size_t size ) { stack.back ()->body.append ( data, size ); }
+		void epilog ( const char *data, std::size_t size ) { stack.back ()->epilog.append ( data, size ); }
+		void part_end () { stack.pop_back (); }
+
+		boost::shared_ptr<node>	root;
+		std::vector<node *>		stack;
+		};
+
+	void check_same ( const mime_part &expected, const node &actual ) {
+		BOOST_CHECK ( actual.headers_done );
+		BOOST_REQUIRE_EQUAL ( std::distance ( expected.header_begin (), expected.header_end ()), (std::ptrdiff_t) actual.headers.size ());
+		std::size_t i = 0;
+		for ( mime_part::constHeaderIter iter = expected.header_begin (); iter != expected.header_end (); ++iter, ++i ) {
+			BOOST_CHECK_EQUAL ( iter->first,  actual.headers [ i ].first );
+			BOOST_CHECK_EQUAL ( iter->second, actual.headers [ i ].second );
+			}
+		BOOST_CHECK ( *expected.body ()        == actual.body );
+		BOOST_CHECK ( *expected.body_epilog () == actual.epilog );
+		BOOST_REQUIRE_EQUAL ( expected.part_count (), actual.parts.size ());
+		i = 0;
+		for ( mime_part::constPartIter iter = expected.subpart_begin (); iter != expected.subpart_end (); ++iter, ++i )
+			check_same ( **iter, *actual.parts [ i ] );
+		}
+
+	void test_push_parse ( const char *fileName ) {
+		const std::string contents = readfile ( fileName );
+		std::string::const_iterator begin = contents.begin ();
+		smp expected = boost::mime::detail::parse_mime<std::string::const_iterator, my_traits> ( begin, contents.end (), "text/plain" );
+
+		const std::size_t fragment_sizes [] = { 1, 2, 3, 7, 64, 4096, contents.size () };
+		for ( std::size_t f = 0; f < sizeof ( fragment_sizes ) / sizeof ( fragment_sizes [ 0 ] ); ++f ) {
+			tree_builder builder;
+			boost::mime::push_parser<tree_builder> parser ( builder );
+			for ( std::size_t pos = 0; pos < contents.size (); pos += fragment_sizes [ f ] )
+				parser.feed ( contents.data () + pos, std::min ( fragment_sizes [ f ], contents.size () - pos ));
+			parser.finish ();
+			BOOST_REQUIRE ( builder.root );
+			BOOST_CHECK ( builder.stack.empty ());
+			check_same ( *expected, *builder.root );
+			}
+		}
+
+	void test_missing_prolog () {
+		const std::string message =
+			"Content-Type: multipart/mixed; boundary=\"b\"\r\n"
+			"\r\n"
+			"--b\r\n"
+			"Content-Type: multipart/digest; boundary=\"inner\"\r\n"
+			"\r\n"
+			"--inner\r\n"
+			"\r\n"
+			"Subject: embedded\r\n"
+			"\r\n"
+			"embedded body\r\n"
+			"--inner--\r\n"
+			"\r\n"
+			"--b  \r\n"
+			"\r\n"
+			"second\r\n"
+			"--b--\r\n"
+			"epilog";
+		tree_builder builder;
+		boost::mime::push_parser<tree_builder> parser ( builder );
+		for ( std::size_t pos = 0; pos < message.size (); ++pos )
+			parser.feed ( message.data () + pos, 1 );
+		parser.finish ();
+
+		const node &root = *builder.root;
+		BOOST_CHECK_EQUAL ( "", root.body );
+		BOOST_CHECK_EQUAL ( "epilog", root.epilog );
+		BOOST_REQUIRE_EQUAL ( 2U, root.parts.size ());
+
+	//	A multipart/digest holds message/rfc822 parts by default
+		const node &digest = *root.parts [ 0 ];
+		BOOST_CHECK_EQUAL ( "", digest.epilog );
+		BOOST_REQUIRE_EQUAL ( 1U, digest.parts.size ());
+		BOOST_REQUIRE_EQUAL ( 1U, digest.parts [ 0 ]->parts.size ());
+		const node &embedded = *digest.parts [ 0 ]->parts [ 0 ];
+		BOOST_REQUIRE_EQUAL ( 1U, embedded.headers.size ());
+		BOOST_CHECK_EQUAL ( " embedded", embedded.headers [ 0 ].second );
+		BOOST_CHECK_EQUAL ( "embedded body", embedded.body );
+
+		BOOST_CHECK_EQUAL ( "second", root.parts [ 1 ]->body );
+		}
+
+	void test_unterminated_multipart () {
+		tree_builder builder;
+		boost::mime::push_parser<tree_builder> parser ( builder );
+		parser.feed ( "Content-Type: multipart/mixed; boundary=\"b\"\r\n\r\n--b\r\n\r\npart\r\n" );
+		BOOST_CHECK_THROW ( parser.finish (), boost::mime::mime_parsing_error );
+		}
+
+//	Folded lines count towards the limit on the headers of a part, and each
+//	part has a limit of its own.
+	void test_header_size_limit () {
+		const std::string part_headers =
+			"X-Long: 0123456789\r\n\t0123456789\r\n\t0123456789\r\n\t0123456789\r\n\r\n";
+		const std::string message =
+			"Content-Type: multipart/mixed; boundary=\"b\"\r\n\r\n"
+			"--b\r\n" + part_headers + "one\r\n"
+			"--b\r\n" + part_headers + "two\r\n"
+			"--b--\r\n";
+		{
+			tree_builder builder;
+			boost::mime::push_parser<tree_builder> parser ( builder );
+			parser.max_header_size ( part_headers.size ());
+			parser.feed ( message );
+			parser.finish ();
+			BOOST_REQUIRE_EQUAL ( 2U, builder.root->parts.size ());
+			BOOST_CHECK_EQUAL ( "two", builder.root->parts [ 1 ]->body );
+		}
+
+		tree_builder builder;
+		boost::mime::push_parser<tree_builder> parser ( builder );
+		parser.max_header_size ( part_headers.size () - 1 );
+		BOOST_CHECK_THROW ( parser.feed ( message ), boost::mime::mime_parsing_error );
+
+		tree_builder folded;
+		boost::mime::push_parser<tree_builder> unending ( folded );
+		unending.max_header_size ( 1024 );
+		unending.feed ( "X-Folded: start\r\n" );
+		BOOST_CHECK_THROW (
+			for ( int i = 0; i < 1000; ++i )
+				unending.feed ( "\tmore\r\n" ),
+			boost::mime::mime_parsing_error );
+		}
+}
+
+
+using namespace boost::unit_test;
+
+test_suite*
+init_unit_test_suite( int argc, char* argv[] )
+{
+    framework::master_test_suite().add ( BOOST_TEST_CASE( std::bind ( test_push_parse, "TestMessages/00000001" )));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( std::bind ( test_push_parse, "TestMessages/00000019" )));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( std::bind ( test_push_parse, "TestMessages/00000431" )));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( std::bind ( test_push_parse, "TestMessages/00000975" )));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( test_missing_prolog ));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( test_unterminated_multipart ));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( test_header_size_limit ));
+    return 0;
+}
@@ -10,6 +10,7 @@
 */
 
 #include <boost/mime.hpp>
+#include <boost/mime/buffers.hpp>
 // #include <boost/bind.hpp>
 #include <functional>
 
@@ -49,6 +50,15 @@ namespace {
 	//using namespace boost::mime;
 	typedef boost::mime::basic_mime<my_traits>	mime_part;
 	typedef boost::shared_ptr<mime_part> 		smp;
+
+//	Parts whose bodies refer to the message they were parsed from
+	struct shared_traits {
+		typedef	std::string string_type;
+		typedef boost::mime::buffer_body body_type;
+		};
+
+	typedef boost::mime::basic_mime<shared_traits>	shared_part;
+	typedef boost::shared_ptr<shared_part> 			ssp;
 	
 	smp to_mime ( const char *fileName ) {
 		std::ifstream in ( fileName );
@@ -73,6 +83,107 @@ namespace {
 		BOOST_CHECK_EQUAL ( readfile ( fileName ), from_mime ( mp ));
 		}
 	
+	void test_roundtrip_shared ( const char *fileName ) {
+		const std::string contents = readfile ( fileName );
+		std::string::const_iterator begin = contents.begin ();
+		ssp mp;
+		BOOST_REQUIRE_NO_THROW( mp = shared_part::parse_mime ( begin, contents.end ()));
+		std::ostringstream oss;
+		oss << *mp;
+		BOOST_CHECK_EQUAL ( contents, oss.str ());
+
+	//	Every body refers to the same buffer, which is not the caller's
+		BOOST_REQUIRE ( mp->part_count () > 0 );
+		const boost::mime::buffer_body &first = *(*mp) [ 0 ]->body ();
+		BOOST_CHECK ( first.buffer ());
+		BOOST_CHECK ( first.buffer () == mp->body ()->buffer ());
+		BOOST_CHECK ( first.data () < contents.data () || first.data () > contents.data () + contents.size ());
+		}
+
+	void test_shallow_copy () {
+		mime_part mp ( "multipart", "mixed" );
+		mp.set_body ( "prolog", 6 );
+		smp sub ( new mime_part ( "text", "plain" ));
+		sub->set_body ( "sub part", 8 );
+		mp.append_part ( sub );
+
+	//	The copy shares the bodies, but not the parts
+		mime_part copy ( mp );
+		BOOST_CHECK ( copy.body () == mp.body ());
+		BOOST_CHECK ( copy [ 0 ] != mp [ 0 ]);
+		BOOST_CHECK ( copy [ 0 ]->body () == mp [ 0 ]->body ());
+
+	//	Setting a body does not change the copies
+		copy [ 0 ]->set_body ( "changed", 7 );
+		BOOST_CHECK_EQUAL ( "sub part", *mp [ 0 ]->body ());
+		BOOST_CHECK_EQUAL ( "changed", *copy [ 0 ]->body ());
+
+	//	A body can be shared on purpose
+		copy [ 0 ]->set_body ( mp [ 0 ]->body ());
+		BOOST_CHECK ( copy [ 0 ]->body () == mp [ 0 ]->body ());
+		}
+
+	void test_set_body_from_stream () {
+	//	Whitespace is part of the body
+		std::string contents ( "line one\r\n\tline two \r\n" );
+		while ( contents.size () < 200000 )
+			contents += contents;
+		std::istringstream in ( contents );
+		mime_part mp ( "text", "plain" );
+		mp.set_body ( in );
+		BOOST_CHECK ( contents == *mp.body ());
+		}
+
+	template <typename traits>
+	std::string from_buffers ( const boost::mime::mime_buffers<traits> &buffers ) {
+		std::string retVal;
+		for ( typename boost::mime::mime_buffers<traits>::buffers_type::const_iterator iter = buffers.buffers ().begin ();
+				iter != buffers.buffers ().end (); ++iter )
+			retVal.append ( static_cast<const char *> ( iter->data ()), iter->size ());
+		BOOST_CHECK_EQUAL ( buffers.size (), retVal.size ());
+		return retVal;
+		}
+
+	void test_buffers ( const char *fileName ) {
+		const std::string contents = readfile ( fileName );
+		std::string::const_iterator begin = contents.begin ();
+		ssp mp = shared_part::parse_mime ( begin, contents.end ());
+		boost::mime::mime_buffers<shared_traits> buffers ( *mp );
+		BOOST_CHECK_EQUAL ( contents, from_buffers ( buffers ));
+
+	//	The bodies are not copied: some buffers point into the parsed message
+		const std::vector<char> &message = *mp->body ()->buffer ();
+		std::size_t found = 0;
+		for ( std::size_t i = 0; i < buffers.buffers ().size (); ++i ) {
+			const char *data = static_cast<const char *> ( buffers.buffers () [ i ].data ());
+			if ( data >= &message [ 0 ] && data < &message [ 0 ] + message.size ())
+				++found;
+			}
+		BOOST_CHECK ( found > 0 );
+		}
+
+	void test_buffers_without_boundary () {
+		mime_part mp ( "multipart", "mixed" );
+		smp sub ( new mime_part ( "text", "plain" ));
+		sub->set_body ( "sub part", 8 );
+		mp.append_part ( sub );
+
+		boost::mime::mime_buffers<my_traits> buffers ( mp );
+		const std::string contents = from_buffers ( buffers );
+		BOOST_CHECK ( contents.find ( "boundary=" ) != std::string::npos );
+		BOOST_CHECK ( mp.get_content_type_header ().find ( "boundary=" ) == std::string::npos );
+
+		std::string::const_iterator begin = contents.begin ();
+		smp parsed = mime_part::parse_mime ( begin, contents.end ());
+		BOOST_REQUIRE_EQUAL ( 1U, parsed->part_count ());
+		BOOST_CHECK_EQUAL ( "sub part", *(*parsed) [ 0 ]->body ());
+
+	//	Without the headers, for an HTTP body
+		boost::mime::mime_buffers<my_traits> body_only ( *parsed, false );
+		const std::string body = from_buffers ( body_only );
+		BOOST_CHECK_EQUAL ( contents.substr ( contents.find ( "\r\n\r\n" ) + 4 ), body );
+		}
+
 	void test_expected_parse_fail ( const char *fileName ) {
 		}
 	
@@ -89,6 +200,13 @@ init_unit_test_suite( int argc, char* argv[] )
     framework::master_test_suite().add ( BOOST_TEST_CASE( std::bind ( test_roundtrip, "TestMessages/00000431" )));
     framework::master_test_suite().add ( BOOST_TEST_CASE( std::bind ( test_roundtrip, "TestMessages/00000975" )));
 
+    framework::master_test_suite().add ( BOOST_TEST_CASE( std::bind ( test_roundtrip_shared, "TestMessages/00000019" )));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( std::bind ( test_roundtrip_shared, "TestMessages/00000431" )));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( std::bind ( test_buffers, "TestMessages/00000019" )));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( std::bind ( test_buffers, "TestMessages/00000431" )));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( test_buffers_without_boundary ));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( test_shallow_copy ));
+    framework::master_test_suite().add ( BOOST_TEST_CASE( test_set_body_from_stream ));
 // Following test is removed because the file it used often tripped false-positives when scanned by virus checkers.
 //    framework::master_test_suite().add ( BOOST_TEST_CASE( std::bind ( test_roundtrip, "TestMessages/00001136" )));
 